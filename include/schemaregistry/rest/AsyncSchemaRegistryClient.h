@@ -0,0 +1,160 @@
+/**
+ * Confluent Schema Registry Async Client
+ * Asynchronous C++ client for interacting with Confluent Schema Registry
+ */
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "schemaregistry/rest/ClientConfiguration.h"
+#include "schemaregistry/rest/IAsyncSchemaRegistryClient.h"
+#include "schemaregistry/rest/RestClient.h"
+#include "schemaregistry/rest/RestException.h"
+#include "schemaregistry/rest/RevalidatingCache.h"
+#include "schemaregistry/rest/SchemaStore.h"
+#include "schemaregistry/rest/SingleFlight.h"
+#include "schemaregistry/rest/model/RegisteredSchema.h"
+#include "schemaregistry/rest/model/Schema.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Asynchronous Schema Registry Client implementation
+ *
+ * Requests run on the RestClient event loop, so many lookups proceed in
+ * parallel and retries wait on timers instead of blocking the caller. Cache
+ * hits complete immediately, and concurrent identical requests share a
+ * single future.
+ */
+class AsyncSchemaRegistryClient : public IAsyncSchemaRegistryClient {
+  private:
+    std::shared_ptr<schemaregistry::rest::RestClient> restClient;
+    std::shared_ptr<SchemaStore> store;
+
+    // Caches for latest versions
+    RevalidatingCache<std::string,
+                      schemaregistry::rest::model::RegisteredSchema>
+        latestVersionCache;
+    RevalidatingCache<std::string,
+                      schemaregistry::rest::model::RegisteredSchema>
+        latestWithMetadataCache;
+
+    // In-flight requests, keyed by request identity
+    SingleFlight<std::string, schemaregistry::rest::model::Schema>
+        schemaFlights;
+    SingleFlight<std::string, schemaregistry::rest::model::RegisteredSchema>
+        registeredSchemaFlights;
+    SingleFlight<std::string, std::vector<int32_t>> versionsFlights;
+    SingleFlight<std::string, std::vector<std::string>> subjectsFlights;
+
+    // Fetch latest versions from the registry, updating the caches
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    fetchLatestVersion(const std::string &subject,
+                       const std::optional<std::string> &format);
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    fetchLatestWithMetadata(
+        const std::string &subject,
+        const std::unordered_map<std::string, std::string> &metadata,
+        bool deleted, const std::optional<std::string> &format);
+
+    // HTTP request helpers
+    void sendHttpRequestAsync(
+        const std::string &path, const std::string &method,
+        const std::vector<std::pair<std::string, std::string>> &query,
+        const std::string &body,
+        std::function<void(const cpr::Response &)> callback) const;
+
+  public:
+    /**
+     * Constructor
+     */
+    AsyncSchemaRegistryClient(
+        std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+            config);
+
+    /**
+     * Constructor sending requests through the given REST client, which
+     * supplies the configuration
+     */
+    explicit AsyncSchemaRegistryClient(
+        std::shared_ptr<schemaregistry::rest::RestClient> rest_client);
+
+    /**
+     * Destructor, abandons requests still in flight
+     */
+    ~AsyncSchemaRegistryClient() override;
+
+    /**
+     * Factory method to create a client instance
+     * Returns MockAsyncSchemaRegistryClient for mock:// URLs, otherwise
+     * AsyncSchemaRegistryClient
+     */
+    static std::shared_ptr<IAsyncSchemaRegistryClient> newClient(
+        std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+            config);
+
+    /**
+     * Get client configuration
+     */
+    std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+    getConfiguration() const override;
+
+    // Implement IAsyncSchemaRegistryClient methods
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    registerSchema(const std::string &subject,
+                   const schemaregistry::rest::model::Schema &schema,
+                   bool normalize = false) override;
+
+    std::shared_future<schemaregistry::rest::model::Schema> getBySubjectAndId(
+        const std::optional<std::string> &subject, int32_t id,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::Schema> getByGuid(
+        const std::string &guid,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getBySchema(const std::string &subject,
+                const schemaregistry::rest::model::Schema &schema,
+                bool normalize = false, bool deleted = false) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getVersion(const std::string &subject, int32_t version,
+               bool deleted = false,
+               const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getLatestVersion(
+        const std::string &subject,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getLatestWithMetadata(
+        const std::string &subject,
+        const std::unordered_map<std::string, std::string> &metadata,
+        bool deleted = false,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<std::vector<int32_t>> getAllVersions(
+        const std::string &subject) override;
+
+    std::shared_future<std::vector<std::string>> getAllSubjects(
+        bool deleted = false) override;
+
+    void clearLatestCaches() override;
+
+    void clearCaches() override;
+
+    void close() override;
+};
+
+}  // namespace schemaregistry::rest
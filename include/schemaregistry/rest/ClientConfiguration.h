@@ -70,6 +70,18 @@ class ClientConfiguration {
     std::uint64_t getCacheLatestTtlSec() const;
     void setCacheLatestTtlSec(std::uint64_t cache_latest_ttl_sec);
 
+    // How long past cacheLatestTtlSec a latest version is still served while
+    // it is refreshed in the background (0 refreshes it synchronously)
+    std::uint64_t getCacheLatestStaleTtlSec() const;
+    void setCacheLatestStaleTtlSec(std::uint64_t cache_latest_stale_ttl_sec);
+
+    // How long a latest version, metadata, schema or DEK/KEK lookup that
+    // returned 404 is answered from cache instead of the registry (0
+    // disables negative caching). ID, GUID and version lookups are not
+    // cached when missing.
+    std::uint64_t getCacheNotFoundTtlSec() const;
+    void setCacheNotFoundTtlSec(std::uint64_t cache_not_found_ttl_sec);
+
     // Retry configuration
     std::uint32_t getMaxRetries() const;
     void setMaxRetries(std::uint32_t max_retries);
@@ -80,6 +92,15 @@ class ClientConfiguration {
     std::uint32_t getRetriesMaxWaitMs() const;
     void setRetriesMaxWaitMs(std::uint32_t retries_max_wait_ms);
 
+    // Connection pool configuration
+    std::uint32_t getConnectionPoolSize() const;
+    void setConnectionPoolSize(std::uint32_t connection_pool_size);
+
+    std::uint64_t getConnectionIdleTimeoutSec() const;
+    void setConnectionIdleTimeoutSec(std::uint64_t connection_idle_timeout_sec);
+
+    // Shared session. When set, all requests are serialized on this session
+    // instead of being dispatched through the connection pool.
     std::shared_ptr<cpr::Session> getSession() const;
     void setSession(std::shared_ptr<cpr::Session>);
 
@@ -95,11 +116,16 @@ class ClientConfiguration {
 
     std::uint64_t cache_capacity_;
     std::uint64_t cache_latest_ttl_sec_;
+    std::uint64_t cache_latest_stale_ttl_sec_;
+    std::uint64_t cache_not_found_ttl_sec_;
 
     std::uint32_t max_retries_;
     std::uint32_t retries_wait_ms_;
     std::uint32_t retries_max_wait_ms_;
 
+    std::uint32_t connection_pool_size_;
+    std::uint64_t connection_idle_timeout_sec_;
+
     std::shared_ptr<cpr::Session> session_;
 };
 
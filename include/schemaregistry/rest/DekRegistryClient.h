@@ -13,6 +13,7 @@
 #include "schemaregistry/rest/ClientConfiguration.h"
 #include "schemaregistry/rest/DekRegistryTypes.h"
 #include "schemaregistry/rest/IDekRegistryClient.h"
+#include "schemaregistry/rest/NotFoundCache.h"
 #include "schemaregistry/rest/RestClient.h"
 #include "schemaregistry/rest/RestException.h"
 
@@ -106,6 +107,8 @@ class DekRegistryClient : public IDekRegistryClient {
     std::shared_ptr<schemaregistry::rest::RestClient> restClient;
     std::shared_ptr<DekStore> store;
     std::shared_ptr<std::mutex> storeMutex;
+    // DEK and KEK lookups that returned 404, scoped by KEK and subject
+    std::shared_ptr<NotFoundCache> notFoundCache;
 
     // Helper methods
     std::string urlEncode(const std::string &str) const;
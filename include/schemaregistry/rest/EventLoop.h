@@ -0,0 +1,92 @@
+/**
+ * Event Loop Implementation
+ * Timer-driven task executor backing asynchronous requests
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace schemaregistry::rest {
+
+/**
+ * Executes posted tasks on a bounded set of worker threads, and runs delayed
+ * tasks from a dedicated timer thread.
+ *
+ * Delayed tasks do not occupy a worker while waiting, so a request backing off
+ * before its next retry does not block any other request. Tasks still pending
+ * when the loop is stopped are dropped.
+ */
+class EventLoop {
+  public:
+    using Task = std::function<void()>;
+
+    /**
+     * Constructor
+     * @param workers Number of worker threads executing tasks
+     */
+    explicit EventLoop(size_t workers);
+
+    /**
+     * Destructor, stops the loop
+     */
+    ~EventLoop();
+
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    /**
+     * Run a task on a worker thread as soon as one is available
+     */
+    void post(Task task);
+
+    /**
+     * Run a task on a worker thread once the delay has elapsed
+     */
+    void schedule(std::chrono::milliseconds delay, Task task);
+
+    /**
+     * Stop the loop and join its threads. Pending tasks are dropped.
+     * Must not be called from a task running on the loop.
+     */
+    void stop();
+
+  private:
+    struct Timer {
+        std::chrono::steady_clock::time_point due;
+        uint64_t seq;
+        Task task;
+
+        // Ordered so that the earliest timer is at the top of the heap
+        bool operator<(const Timer &other) const {
+            if (due != other.due) {
+                return due > other.due;
+            }
+            return seq > other.seq;
+        }
+    };
+
+    void runWorker();
+    void runTimers();
+
+    std::mutex mutex_;
+    std::condition_variable tasks_available_;
+    std::condition_variable timers_changed_;
+    std::deque<Task> tasks_;
+    std::priority_queue<Timer> timers_;
+    uint64_t next_seq_;
+    bool stopped_;
+    std::vector<std::thread> workers_;
+    std::thread timer_thread_;
+};
+
+}  // namespace schemaregistry::rest
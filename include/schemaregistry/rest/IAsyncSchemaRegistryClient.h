@@ -0,0 +1,124 @@
+/**
+ * Confluent Schema Registry Async Client Interface
+ * Pure virtual, future-returning interface for schema lookups and registration
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "schemaregistry/rest/ClientConfiguration.h"
+#include "schemaregistry/rest/model/RegisteredSchema.h"
+#include "schemaregistry/rest/model/Schema.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Interface for asynchronous Schema Registry Client
+ *
+ * Covers the lookup and registration calls made on the serialization path.
+ * Each call returns immediately; the returned future becomes ready with the
+ * result, or with the exception the synchronous client would have thrown.
+ * Administrative calls are only available on ISchemaRegistryClient.
+ */
+class IAsyncSchemaRegistryClient {
+  public:
+    virtual ~IAsyncSchemaRegistryClient() = default;
+
+    /**
+     * Get client configuration
+     */
+    virtual std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+    getConfiguration() const = 0;
+
+    /**
+     * Register a schema for the given subject
+     */
+    virtual std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    registerSchema(const std::string &subject,
+                   const schemaregistry::rest::model::Schema &schema,
+                   bool normalize = false) = 0;
+
+    /**
+     * Get schema by subject and ID
+     */
+    virtual std::shared_future<schemaregistry::rest::model::Schema>
+    getBySubjectAndId(
+        const std::optional<std::string> &subject, int32_t id,
+        const std::optional<std::string> &format = std::nullopt) = 0;
+
+    /**
+     * Get schema by GUID
+     */
+    virtual std::shared_future<schemaregistry::rest::model::Schema> getByGuid(
+        const std::string &guid,
+        const std::optional<std::string> &format = std::nullopt) = 0;
+
+    /**
+     * Get registered schema by subject and schema
+     */
+    virtual std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getBySchema(const std::string &subject,
+                const schemaregistry::rest::model::Schema &schema,
+                bool normalize = false, bool deleted = false) = 0;
+
+    /**
+     * Get registered schema by subject and version
+     */
+    virtual std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getVersion(const std::string &subject, int32_t version,
+               bool deleted = false,
+               const std::optional<std::string> &format = std::nullopt) = 0;
+
+    /**
+     * Get latest version of schema for subject
+     */
+    virtual std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getLatestVersion(
+        const std::string &subject,
+        const std::optional<std::string> &format = std::nullopt) = 0;
+
+    /**
+     * Get latest version with metadata
+     */
+    virtual std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getLatestWithMetadata(
+        const std::string &subject,
+        const std::unordered_map<std::string, std::string> &metadata,
+        bool deleted = false,
+        const std::optional<std::string> &format = std::nullopt) = 0;
+
+    /**
+     * Get all versions for subject
+     */
+    virtual std::shared_future<std::vector<int32_t>> getAllVersions(
+        const std::string &subject) = 0;
+
+    /**
+     * Get all subjects
+     */
+    virtual std::shared_future<std::vector<std::string>> getAllSubjects(
+        bool deleted = false) = 0;
+
+    /**
+     * Clear latest version caches
+     */
+    virtual void clearLatestCaches() = 0;
+
+    /**
+     * Clear all caches
+     */
+    virtual void clearCaches() = 0;
+
+    /**
+     * Close client
+     */
+    virtual void close() = 0;
+};
+
+}  // namespace schemaregistry::rest
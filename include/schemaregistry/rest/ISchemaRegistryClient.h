@@ -53,6 +53,30 @@ class ISchemaRegistryClient {
         const std::string &guid,
         const std::optional<std::string> &format = std::nullopt) = 0;
 
+    /**
+     * Get shared, immutable schema by subject and ID. Implementations with
+     * a schema cache return the cached instance instead of a copy.
+     */
+    virtual std::shared_ptr<const schemaregistry::rest::model::Schema>
+    getSchemaHandleBySubjectAndId(
+        const std::optional<std::string> &subject, int32_t id,
+        const std::optional<std::string> &format = std::nullopt) {
+        return std::make_shared<const schemaregistry::rest::model::Schema>(
+            getBySubjectAndId(subject, id, format));
+    }
+
+    /**
+     * Get shared, immutable schema by GUID. Implementations with a schema
+     * cache return the cached instance instead of a copy.
+     */
+    virtual std::shared_ptr<const schemaregistry::rest::model::Schema>
+    getSchemaHandleByGuid(
+        const std::string &guid,
+        const std::optional<std::string> &format = std::nullopt) {
+        return std::make_shared<const schemaregistry::rest::model::Schema>(
+            getByGuid(guid, format));
+    }
+
     /**
      * Get registered schema by subject and schema
      */
@@ -0,0 +1,104 @@
+/**
+ * Mock Async Schema Registry Client
+ * Asynchronous facade over MockSchemaRegistryClient for testing
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "schemaregistry/rest/ClientConfiguration.h"
+#include "schemaregistry/rest/IAsyncSchemaRegistryClient.h"
+#include "schemaregistry/rest/MockSchemaRegistryClient.h"
+#include "schemaregistry/rest/model/RegisteredSchema.h"
+#include "schemaregistry/rest/model/Schema.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Mock async Schema Registry Client
+ *
+ * Delegates to a MockSchemaRegistryClient and returns futures that are
+ * already ready. The underlying mock can be shared with synchronous
+ * serializers, so both see the same registered schemas.
+ */
+class MockAsyncSchemaRegistryClient : public IAsyncSchemaRegistryClient {
+  private:
+    std::shared_ptr<MockSchemaRegistryClient> client;
+
+  public:
+    /**
+     * Constructor, creating a new mock client
+     */
+    MockAsyncSchemaRegistryClient(
+        std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+            config);
+
+    /**
+     * Constructor, wrapping an existing mock client
+     */
+    explicit MockAsyncSchemaRegistryClient(
+        std::shared_ptr<MockSchemaRegistryClient> client);
+
+    /**
+     * Get the underlying synchronous mock client
+     */
+    std::shared_ptr<MockSchemaRegistryClient> getClient() const;
+
+    std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+    getConfiguration() const override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    registerSchema(const std::string &subject,
+                   const schemaregistry::rest::model::Schema &schema,
+                   bool normalize = false) override;
+
+    std::shared_future<schemaregistry::rest::model::Schema> getBySubjectAndId(
+        const std::optional<std::string> &subject, int32_t id,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::Schema> getByGuid(
+        const std::string &guid,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getBySchema(const std::string &subject,
+                const schemaregistry::rest::model::Schema &schema,
+                bool normalize = false, bool deleted = false) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getVersion(const std::string &subject, int32_t version,
+               bool deleted = false,
+               const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getLatestVersion(
+        const std::string &subject,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+    getLatestWithMetadata(
+        const std::string &subject,
+        const std::unordered_map<std::string, std::string> &metadata,
+        bool deleted = false,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_future<std::vector<int32_t>> getAllVersions(
+        const std::string &subject) override;
+
+    std::shared_future<std::vector<std::string>> getAllSubjects(
+        bool deleted = false) override;
+
+    void clearLatestCaches() override;
+
+    void clearCaches() override;
+
+    void close() override;
+};
+
+}  // namespace schemaregistry::rest
@@ -0,0 +1,174 @@
+/**
+ * Not Found Cache Implementation
+ * Thread-safe, TTL-bounded cache of lookups that returned HTTP 404
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+
+#include "schemaregistry/rest/RestException.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Negative cache remembering which lookups returned 404 Not Found.
+ *
+ * Entries are grouped by scope (typically the subject), so that creating
+ * something in a scope can invalidate every cached miss of that scope at
+ * once. Each entry expires a fixed TTL after it was recorded; hits do not
+ * extend it, so a key registered by another process is picked up at most
+ * one TTL later. A TTL of zero disables the cache.
+ *
+ * When capacity is reached, expired entries are dropped first; if the cache
+ * is still full it is emptied, which only costs a few extra lookups.
+ */
+class NotFoundCache {
+  private:
+    struct Entry {
+        std::string message;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    mutable std::mutex mutex_;
+    absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, Entry>>
+        scopes_;
+    size_t size_ = 0;
+    size_t capacity_;
+    std::chrono::seconds ttl_;
+
+    // Drop expired entries (must be called with mutex held)
+    void purge_expired_unsafe(std::chrono::steady_clock::time_point now) {
+        for (auto it = scopes_.begin(); it != scopes_.end();) {
+            auto &entries = it->second;
+            size_ -= absl::erase_if(entries, [now](const auto &entry) {
+                return entry.second.expiry <= now;
+            });
+            if (entries.empty()) {
+                scopes_.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+  public:
+    /**
+     * Constructor
+     * @param capacity Maximum number of entries to store
+     * @param ttl Time after which a cached miss is looked up again
+     */
+    NotFoundCache(size_t capacity, std::chrono::seconds ttl)
+        : capacity_(capacity), ttl_(ttl) {}
+
+    NotFoundCache(const NotFoundCache &) = delete;
+    NotFoundCache &operator=(const NotFoundCache &) = delete;
+
+    /**
+     * Whether misses are cached at all
+     */
+    bool enabled() const { return capacity_ > 0 && ttl_.count() > 0; }
+
+    /**
+     * Remember that key, within scope, was not found
+     */
+    void put(const std::string &scope, const std::string &key,
+             const RestException &error) {
+        if (!enabled()) {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (size_ >= capacity_) {
+            purge_expired_unsafe(now);
+            if (size_ >= capacity_) {
+                scopes_.clear();
+                size_ = 0;
+            }
+        }
+        auto result = scopes_[scope].insert_or_assign(
+            key, Entry{error.what(), now + ttl_});
+        if (result.second) {
+            ++size_;
+        }
+    }
+
+    /**
+     * Throw the remembered 404 RestException if key, within scope, is known
+     * to be missing
+     */
+    void check(const std::string &scope, const std::string &key) const {
+        if (!enabled()) {
+            return;
+        }
+        std::string message;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto scopeIt = scopes_.find(scope);
+            if (scopeIt == scopes_.end()) {
+                return;
+            }
+            auto it = scopeIt->second.find(key);
+            if (it == scopeIt->second.end() ||
+                it->second.expiry <= std::chrono::steady_clock::now()) {
+                return;
+            }
+            message = it->second.message;
+        }
+        throw RestException(message, 404);
+    }
+
+    /**
+     * Run fn for key unless key is known to be missing, remembering a 404
+     * thrown by fn
+     */
+    template <typename F>
+    auto run(const std::string &scope, const std::string &key, F &&fn)
+        -> decltype(fn()) {
+        check(scope, key);
+        try {
+            return fn();
+        } catch (const RestException &e) {
+            if (e.getStatus() == 404) {
+                put(scope, key, e);
+            }
+            throw;
+        }
+    }
+
+    /**
+     * Forget all cached misses of scope
+     */
+    void invalidate(const std::string &scope) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = scopes_.find(scope);
+        if (it != scopes_.end()) {
+            size_ -= it->second.size();
+            scopes_.erase(it);
+        }
+    }
+
+    /**
+     * Clear all entries from cache
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scopes_.clear();
+        size_ = 0;
+    }
+
+    /**
+     * Get current number of entries, including expired ones not yet purged
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+};
+
+}  // namespace schemaregistry::rest
@@ -25,7 +25,9 @@
 #include <vector>
 
 #include "schemaregistry/rest/ClientConfiguration.h"
+#include "schemaregistry/rest/EventLoop.h"
 #include "schemaregistry/rest/RestException.h"
+#include "schemaregistry/rest/SessionPool.h"
 
 namespace schemaregistry::rest {
 
@@ -43,12 +45,28 @@ class RestClient {
         const std::map<std::string, std::string> &headers,
         const std::string &body) const;
 
-  private:
-    cpr::Response sendRequest(
-        const std::string &url, const std::string &method,
+    /**
+     * Send a request asynchronously, with the same failover and retry
+     * behaviour as sendRequestUrls. Backoff between retries is a timer on the
+     * event loop, so no thread is blocked while waiting. The callback is
+     * invoked on an event loop thread.
+     */
+    void sendRequestUrlsAsync(
+        const std::string &path, const std::string &method,
         const std::vector<std::pair<std::string, std::string>> &query,
         const std::map<std::string, std::string> &headers,
-        const std::string &body) const;
+        const std::string &body,
+        std::function<void(const cpr::Response &)> callback) const;
+
+  private:
+    struct AsyncRequest;
+
+    // Perform one attempt of an async request, then schedule the next one
+    // or complete it
+    void attemptAsync(std::shared_ptr<AsyncRequest> request) const;
+
+    // Get the event loop, starting it on first use
+    std::shared_ptr<EventLoop> getEventLoop() const;
 
     cpr::Response tryRequest(
         const std::string &base_url, const std::string &path,
@@ -58,8 +76,22 @@ class RestClient {
         const std::string &body) const;
 
   protected:
+    /**
+     * Send a single request to one base URL, without failover or retries.
+     * This is the transport underneath all other requests.
+     */
+    virtual cpr::Response sendRequest(
+        const std::string &base_url, const std::string &path,
+        const std::string &method,
+        const std::vector<std::pair<std::string, std::string>> &query,
+        const std::map<std::string, std::string> &headers,
+        const std::string &body) const;
+
     std::shared_ptr<const ClientConfiguration> configuration_;
     mutable std::mutex session_mutex_;
+    std::shared_ptr<SessionPool> session_pool_;
+    mutable std::mutex event_loop_mutex_;
+    mutable std::shared_ptr<EventLoop> event_loop_;
 };
 
 }  // namespace schemaregistry::rest
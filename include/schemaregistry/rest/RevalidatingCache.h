@@ -0,0 +1,133 @@
+/**
+ * Revalidating Cache Implementation
+ * TTL LRU cache serving stale entries while they are refreshed
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "schemaregistry/rest/TtlLruCache.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Cache implementing stale-while-revalidate on top of TtlLruCache.
+ *
+ * Entries are fresh for ttl after they were put. Once stale, they are still
+ * returned for up to stale_ttl more, and the first reader of a stale entry is
+ * asked to refresh it in the background; readers never block on a refresh.
+ * Past ttl + stale_ttl the entry is hard-expired and reported as missing, so
+ * that a registry which keeps failing refreshes cannot pin old values.
+ *
+ * A failed refresh is claimed again by the first stale read after
+ * kRefreshRetryInterval. With a stale_ttl of zero the cache behaves exactly
+ * as a TtlLruCache with the given ttl.
+ */
+template <typename K, typename V>
+class RevalidatingCache {
+  public:
+    static constexpr std::chrono::seconds kRefreshRetryInterval{1};
+
+    /**
+     * Result of a lookup
+     */
+    struct Lookup {
+        std::optional<V> value;  // Set unless missing or hard-expired
+        bool stale = false;      // Value is past its ttl
+        bool refresh = false;    // Caller should refresh value in background
+    };
+
+    /**
+     * Constructor
+     * @param capacity Maximum number of entries to store
+     * @param ttl Time after which an entry is stale
+     * @param stale_ttl Time a stale entry is still served while refreshed
+     */
+    RevalidatingCache(size_t capacity, std::chrono::seconds ttl,
+                      std::chrono::seconds stale_ttl)
+        : cache_(capacity, stale_ttl.count() > 0 ? ttl + stale_ttl : ttl),
+          ttl_(ttl),
+          stale_ttl_(stale_ttl) {}
+
+    /**
+     * Whether stale entries are served while refreshed
+     */
+    bool revalidating() const { return stale_ttl_.count() > 0; }
+
+    /**
+     * Get value from cache, claiming its refresh if stale
+     * @param key The key to lookup
+     */
+    Lookup get(const K &key) {
+        Lookup result;
+        auto entry = cache_.get(key);
+        if (!entry.has_value()) {
+            return result;
+        }
+        if (!revalidating()) {
+            result.value = std::move(entry->value);
+            return result;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto age = now - entry->fetched;
+        if (age > ttl_ + stale_ttl_) {
+            return result;
+        }
+        result.value = std::move(entry->value);
+        if (age <= ttl_) {
+            return result;
+        }
+
+        // Stale: the first reader past the due time refreshes it
+        result.stale = true;
+        int64_t ticks = now.time_since_epoch().count();
+        int64_t due = entry->refresh_due->load();
+        int64_t next =
+            (now + kRefreshRetryInterval).time_since_epoch().count();
+        result.refresh =
+            ticks >= due &&
+            entry->refresh_due->compare_exchange_strong(due, next);
+        return result;
+    }
+
+    /**
+     * Put freshly fetched value into cache
+     * @param key The key to store
+     * @param value The value to store
+     */
+    void put(const K &key, const V &value) {
+        cache_.put(key, Entry{value, std::chrono::steady_clock::now(),
+                              std::make_shared<std::atomic<int64_t>>(0)});
+    }
+
+    /**
+     * Clear all entries from cache
+     */
+    void clear() { cache_.clear(); }
+
+    /**
+     * Get current cache size, including hard-expired entries not yet purged
+     */
+    size_t size() const { return cache_.size(); }
+
+  private:
+    struct Entry {
+        V value;
+        std::chrono::steady_clock::time_point fetched;
+        // Earliest time a refresh may be claimed, shared by all copies
+        std::shared_ptr<std::atomic<int64_t>> refresh_due;
+    };
+
+    TtlLruCache<K, Entry> cache_;
+    std::chrono::seconds ttl_;
+    std::chrono::seconds stale_ttl_;
+};
+
+}  // namespace schemaregistry::rest
@@ -0,0 +1,79 @@
+/**
+ * Schema Interner Implementation
+ * Process-wide table of shared, immutable schema bodies
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "absl/container/flat_hash_map.h"
+
+#include "schemaregistry/rest/model/Schema.h"
+#include "schemaregistry/rest/model/SchemaFingerprint.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Deduplicates schema bodies by content.
+ *
+ * intern() returns the shared instance already holding an equal schema, or
+ * adopts the given one. Entries are held weakly, so a body is freed once no
+ * cache or caller references it; dead entries are purged as the table grows.
+ * Interned schemas are immutable and their fingerprint is already memoized,
+ * so handles can be shared freely between threads, caches and serdes.
+ */
+class SchemaInterner {
+  public:
+    using SchemaPtr = std::shared_ptr<const schemaregistry::rest::model::Schema>;
+
+    SchemaInterner() = default;
+
+    SchemaInterner(const SchemaInterner &) = delete;
+    SchemaInterner &operator=(const SchemaInterner &) = delete;
+
+    /**
+     * Process-wide instance shared by all clients and serdes
+     */
+    static SchemaInterner &global();
+
+    /**
+     * Get the shared instance equal to schema, copying schema only if no
+     * such instance exists yet
+     */
+    SchemaPtr intern(const schemaregistry::rest::model::Schema &schema);
+
+    /**
+     * Get the shared instance equal to *schema, adopting schema itself if no
+     * such instance exists yet
+     */
+    SchemaPtr intern(SchemaPtr schema);
+
+    /**
+     * Get number of table entries, including dead ones not yet purged
+     */
+    size_t size() const;
+
+  private:
+    // Return live entry equal to schema, or nullptr (must be called with
+    // mutex held)
+    SchemaPtr find_unsafe(
+        const schemaregistry::rest::model::SchemaFingerprint &fingerprint,
+        const schemaregistry::rest::model::Schema &schema) const;
+
+    // Insert schema, purging dead entries first if the table has doubled
+    // since the last purge (must be called with mutex held)
+    void insert_unsafe(
+        const schemaregistry::rest::model::SchemaFingerprint &fingerprint,
+        const SchemaPtr &schema);
+
+    mutable std::mutex mutex_;
+    absl::flat_hash_map<schemaregistry::rest::model::SchemaFingerprint,
+                        std::weak_ptr<const schemaregistry::rest::model::Schema>>
+        entries_;
+    size_t purge_threshold_ = 64;
+};
+
+}  // namespace schemaregistry::rest
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -15,11 +16,14 @@
 #include <vector>
 
 #include "schemaregistry/rest/ClientConfiguration.h"
+#include "schemaregistry/rest/EventLoop.h"
 #include "schemaregistry/rest/ISchemaRegistryClient.h"
+#include "schemaregistry/rest/NotFoundCache.h"
 #include "schemaregistry/rest/RestClient.h"
 #include "schemaregistry/rest/RestException.h"
+#include "schemaregistry/rest/RevalidatingCache.h"
 #include "schemaregistry/rest/SchemaStore.h"
-#include "schemaregistry/rest/TtlLruCache.h"
+#include "schemaregistry/rest/SingleFlight.h"
 #include "schemaregistry/rest/model/Association.h"
 #include "schemaregistry/rest/model/RegisteredSchema.h"
 #include "schemaregistry/rest/model/Schema.h"
@@ -34,20 +38,41 @@ class SchemaRegistryClient : public ISchemaRegistryClient {
   private:
     std::shared_ptr<schemaregistry::rest::RestClient> restClient;
     std::shared_ptr<SchemaStore> store;
-    std::shared_ptr<std::mutex> storeMutex;
 
     // Caches for latest versions
-    TtlLruCache<std::string, schemaregistry::rest::model::RegisteredSchema>
+    RevalidatingCache<std::string,
+                      schemaregistry::rest::model::RegisteredSchema>
         latestVersionCache;
-    TtlLruCache<std::string, schemaregistry::rest::model::RegisteredSchema>
+    RevalidatingCache<std::string,
+                      schemaregistry::rest::model::RegisteredSchema>
         latestWithMetadataCache;
 
-    // Helper methods
-    std::string urlEncode(const std::string &str) const;
+    // Latest version, metadata and schema lookups that returned 404, scoped
+    // by subject
+    NotFoundCache notFoundCache;
 
-    std::string createMetadataKey(
+    // In-flight lookups, keyed by request identity, so that concurrent cache
+    // misses for the same request share a single HTTP round trip
+    SingleFlight<std::string, schemaregistry::rest::model::Schema>
+        schemaFlights;
+    SingleFlight<std::string, schemaregistry::rest::model::RegisteredSchema>
+        registeredSchemaFlights;
+
+    // Refreshes stale latest versions, only created when they are served
+    // while revalidating
+    std::unique_ptr<EventLoop> refresher;
+
+    // Fetch latest versions from the registry, updating the caches
+    schemaregistry::rest::model::RegisteredSchema fetchLatestVersion(
+        const std::string &subject, const std::optional<std::string> &format);
+
+    schemaregistry::rest::model::RegisteredSchema fetchLatestWithMetadata(
         const std::string &subject,
-        const std::unordered_map<std::string, std::string> &metadata) const;
+        const std::unordered_map<std::string, std::string> &metadata,
+        bool deleted, const std::optional<std::string> &format);
+
+    // Run refresh on the refresher; failures keep the stale value served
+    void refreshInBackground(std::function<void()> refresh);
 
     // JSON processing helpers
     schemaregistry::rest::model::Schema parseSchemaFromJson(
@@ -114,6 +139,16 @@ class SchemaRegistryClient : public ISchemaRegistryClient {
         const std::string &guid,
         const std::optional<std::string> &format = std::nullopt) override;
 
+    std::shared_ptr<const schemaregistry::rest::model::Schema>
+    getSchemaHandleBySubjectAndId(
+        const std::optional<std::string> &subject, int32_t id,
+        const std::optional<std::string> &format = std::nullopt) override;
+
+    std::shared_ptr<const schemaregistry::rest::model::Schema>
+    getSchemaHandleByGuid(
+        const std::string &guid,
+        const std::optional<std::string> &format = std::nullopt) override;
+
     schemaregistry::rest::model::RegisteredSchema getBySchema(
         const std::string &subject,
         const schemaregistry::rest::model::Schema &schema,
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -18,45 +21,71 @@ namespace schemaregistry::rest {
 
 /**
  * Schema store for caching schema and registered schema information
+ *
+ * Thread-safe. Readers look up an immutable snapshot of the indexes without
+ * taking a lock: each thread keeps the snapshot it last loaded for a store,
+ * and only loads the published one again once a write has bumped the
+ * store's generation. Writers are serialized, build the next snapshot and
+ * publish it atomically. Per-subject maps and cached schemas are shared
+ * between snapshots, so a write only copies the maps it modifies. A thread
+ * holds on to its last snapshot of a store until its next read of it, or
+ * of another store sharing its slot. Schema bodies are
+ * interned, so each distinct schema is held once however many subjects,
+ * ids and versions refer to it.
  */
 class SchemaStore {
+  public:
+    using SchemaPtr = std::shared_ptr<const schemaregistry::rest::model::Schema>;
+    using RegisteredSchemaPtr =
+        std::shared_ptr<const schemaregistry::rest::model::RegisteredSchema>;
+
   private:
-    // Maps subject -> schema_id -> (guid, schema)
-    absl::flat_hash_map<
-        std::string,
-        absl::flat_hash_map<int32_t,
-                            std::pair<std::optional<std::string>,
-                                      schemaregistry::rest::model::Schema>>>
-        schemaIdIndex;
-
-    // Maps guid -> schema
-    absl::flat_hash_map<std::string, schemaregistry::rest::model::Schema>
-        schemaGuidIndex;
-
-    // Maps subject -> schema -> schema_id
-    absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, int32_t>>
-        schemaIndex;
-
-    // Maps subject -> schema_id -> registered_schema
-    absl::flat_hash_map<
-        std::string,
-        absl::flat_hash_map<int32_t,
-                            schemaregistry::rest::model::RegisteredSchema>>
-        rsIdIndex;
-
-    // Maps subject -> version -> registered_schema
-    absl::flat_hash_map<
-        std::string,
-        absl::flat_hash_map<int32_t,
-                            schemaregistry::rest::model::RegisteredSchema>>
-        rsVersionIndex;
-
-    // Maps subject -> schema -> registered_schema
-    absl::flat_hash_map<
-        std::string,
+
+    template <typename K, typename V>
+    using SubjectIndex =
         absl::flat_hash_map<std::string,
-                            schemaregistry::rest::model::RegisteredSchema>>
-        rsSchemaIndex;
+                            std::shared_ptr<const absl::flat_hash_map<K, V>>>;
+
+    struct Snapshot {
+        // Maps subject -> schema_id -> (guid, schema)
+        SubjectIndex<int32_t, std::pair<std::optional<std::string>, SchemaPtr>>
+            schemaIdIndex;
+
+        // Maps guid -> schema
+        absl::flat_hash_map<std::string, SchemaPtr> schemaGuidIndex;
+
+        // Maps subject -> schema fingerprint -> schema_id
+        SubjectIndex<schemaregistry::rest::model::SchemaFingerprint, int32_t>
+            schemaIndex;
+
+        // Maps subject -> schema_id -> registered_schema
+        SubjectIndex<int32_t, RegisteredSchemaPtr> rsIdIndex;
+
+        // Maps subject -> version -> registered_schema
+        SubjectIndex<int32_t, RegisteredSchemaPtr> rsVersionIndex;
+
+        // Maps subject -> schema fingerprint -> registered_schema
+        SubjectIndex<schemaregistry::rest::model::SchemaFingerprint,
+                     RegisteredSchemaPtr>
+            rsSchemaIndex;
+    };
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot;
+#else
+    // Accessed with std::atomic_load / std::atomic_store
+    std::shared_ptr<const Snapshot> snapshot;
+#endif
+
+    // Bumped after each published snapshot, telling readers to reload
+    std::atomic<uint64_t> generation{0};
+
+    // Tells stores apart in the per-thread snapshot caches, as a new store
+    // may be allocated where a destroyed one was
+    const uint64_t storeId;
+
+    // Serializes writers
+    std::mutex writeMutex;
 
   public:
     SchemaStore();
@@ -85,12 +114,23 @@ class SchemaStore {
                             schemaregistry::rest::model::Schema>>
     getSchemaById(const std::string &subject, int32_t schemaId) const;
 
+    /**
+     * Get shared schema handle by subject and id, without copying the schema
+     */
+    std::optional<std::pair<std::optional<std::string>, SchemaPtr>>
+    getSchemaHandleById(const std::string &subject, int32_t schemaId) const;
+
     /**
      * Get schema by guid
      */
     std::optional<schemaregistry::rest::model::Schema> getSchemaByGuid(
         const std::string &guid) const;
 
+    /**
+     * Get shared schema handle by guid, or nullptr if not cached
+     */
+    SchemaPtr getSchemaHandleByGuid(const std::string &guid) const;
+
     /**
      * Get schema id by subject and schema
      */
@@ -124,9 +164,19 @@ class SchemaStore {
     void clear();
 
   private:
-    // Helper to create a string hash for schemas
-    std::string createSchemaHash(
-        const schemaregistry::rest::model::Schema &schema) const;
+    // Current snapshot, as cached by the calling thread. The reference is
+    // valid until the thread's next call for this store or another one.
+    const Snapshot &loadSnapshot() const;
+
+    void storeSnapshot(std::shared_ptr<const Snapshot> next);
+
+    // Add schema information to a snapshot being built (must be called with
+    // writeMutex held)
+    void setSchemaInSnapshot(Snapshot &next,
+                             const std::optional<std::string> &subject,
+                             const std::optional<int32_t> &schemaId,
+                             const std::optional<std::string> &schemaGuid,
+                             const SchemaPtr &schema) const;
 };
 
-}  // namespace schemaregistry::rest
\ No newline at end of file
+}  // namespace schemaregistry::rest
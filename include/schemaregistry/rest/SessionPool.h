@@ -0,0 +1,136 @@
+/**
+ * Session Pool Implementation
+ * Thread-safe, bounded pool of keep-alive HTTP sessions
+ */
+
+#pragma once
+
+#include <cpr/cpr.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Bounded pool of cpr sessions, checked out per request.
+ *
+ * Idle sessions are kept per base URL so that a checked out session is
+ * likely to reuse an already established keep-alive connection to the same
+ * host. At most max_sessions sessions exist at any time; when the pool is
+ * exhausted, callers block until a session is returned. Sessions left idle
+ * for longer than the idle timeout are dropped.
+ */
+class SessionPool {
+  public:
+    /**
+     * RAII handle to a checked out session. The session is returned to the
+     * pool when the lease is destroyed, unless it has been discarded.
+     */
+    class Lease {
+      public:
+        Lease() = default;
+        ~Lease();
+
+        Lease(Lease &&other) noexcept;
+        Lease &operator=(Lease &&other) noexcept;
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        cpr::Session *operator->() const { return session_.get(); }
+        cpr::Session &operator*() const { return *session_; }
+        std::shared_ptr<cpr::Session> get() const { return session_; }
+
+        /**
+         * Drop the session instead of returning it to the pool, e.g. after a
+         * network error left its connection in an unknown state
+         */
+        void discard();
+
+      private:
+        friend class SessionPool;
+
+        Lease(SessionPool *pool, std::string base_url,
+              std::shared_ptr<cpr::Session> session);
+
+        void release();
+
+        SessionPool *pool_ = nullptr;
+        std::string base_url_;
+        std::shared_ptr<cpr::Session> session_;
+    };
+
+    /**
+     * Constructor
+     * @param max_sessions Maximum number of live sessions (idle + in use)
+     * @param idle_timeout Time after which an idle session is dropped
+     */
+    SessionPool(size_t max_sessions, std::chrono::seconds idle_timeout);
+
+    ~SessionPool() = default;
+
+    SessionPool(const SessionPool &) = delete;
+    SessionPool &operator=(const SessionPool &) = delete;
+
+    /**
+     * Check out a session for the given base URL, blocking while all
+     * sessions are in use
+     */
+    Lease acquire(const std::string &base_url);
+
+    /**
+     * Get number of live sessions (idle + in use)
+     */
+    size_t size() const;
+
+    /**
+     * Get number of idle sessions
+     */
+    size_t idleCount() const;
+
+    /**
+     * Get pool capacity
+     */
+    size_t capacity() const { return max_sessions_; }
+
+    /**
+     * Drop all idle sessions
+     */
+    void clear();
+
+  private:
+    struct IdleSession {
+        std::shared_ptr<cpr::Session> session;
+        std::chrono::steady_clock::time_point last_used;
+    };
+
+    void release(const std::string &base_url,
+                 std::shared_ptr<cpr::Session> session);
+    void discard();
+
+    // Drop sessions idle for longer than the idle timeout (must be called
+    // with mutex held)
+    void evict_expired_unsafe(std::chrono::steady_clock::time_point now);
+
+    // Drop the least recently used idle session (must be called with mutex
+    // held)
+    bool evict_lru_unsafe();
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    // Maps base url -> idle sessions, least recently used at front
+    absl::flat_hash_map<std::string, std::deque<IdleSession>> idle_;
+    size_t idle_count_;
+    size_t live_count_;
+    size_t max_sessions_;
+    std::chrono::seconds idle_timeout_;
+};
+
+}  // namespace schemaregistry::rest
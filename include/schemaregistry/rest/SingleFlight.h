@@ -0,0 +1,165 @@
+/**
+ * Single Flight Implementation
+ * Thread-safe coalescing of concurrent calls that share a key
+ */
+
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+
+namespace schemaregistry::rest {
+
+/**
+ * Coalesces concurrent calls for the same key into a single execution.
+ *
+ * The first caller for a key (the leader) runs the supplied function; callers
+ * arriving while it is still running (followers) block and receive the
+ * leader's result, or rethrow the leader's exception. Once the leader
+ * finishes the key is forgotten, so results are never cached here.
+ */
+template <typename K, typename V>
+class SingleFlight {
+  private:
+    mutable std::mutex mutex_;
+    absl::flat_hash_map<K, std::shared_future<V>> calls_;
+
+  public:
+    /**
+     * Completion handle of an asynchronous call started with runAsync. The
+     * key is forgotten once the call completes, or when the handle is
+     * dropped without completing (which breaks the promise).
+     */
+    class Completion {
+      public:
+        Completion(SingleFlight *flight, K key)
+            : flight_(flight), key_(std::move(key)) {}
+
+        ~Completion() {
+            if (!completed_) {
+                flight_->forget(key_);
+            }
+        }
+
+        Completion(const Completion &) = delete;
+        Completion &operator=(const Completion &) = delete;
+
+        std::shared_future<V> getFuture() {
+            return promise_.get_future().share();
+        }
+
+        bool isCompleted() const { return completed_.load(); }
+
+        void setValue(V value) {
+            completed_ = true;
+            flight_->forget(key_);
+            promise_.set_value(std::move(value));
+        }
+
+        void setException(std::exception_ptr e) {
+            completed_ = true;
+            flight_->forget(key_);
+            promise_.set_exception(e);
+        }
+
+      private:
+        SingleFlight *flight_;
+        K key_;
+        std::promise<V> promise_;
+        std::atomic<bool> completed_{false};
+    };
+
+    SingleFlight() = default;
+
+    SingleFlight(const SingleFlight &) = delete;
+    SingleFlight &operator=(const SingleFlight &) = delete;
+
+    /**
+     * Run fn for key, or wait for the in-flight call for key to complete
+     * @param key Identity of the call
+     * @param fn Function producing the value, only invoked by the leader
+     */
+    template <typename F>
+    V run(const K &key, F &&fn) {
+        std::promise<V> promise;
+        std::shared_future<V> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = calls_.find(key);
+            if (it != calls_.end()) {
+                pending = it->second;
+            } else {
+                calls_.emplace(key, promise.get_future().share());
+            }
+        }
+
+        if (pending.valid()) {
+            return pending.get();
+        }
+
+        try {
+            V value = fn();
+            promise.set_value(value);
+            forget(key);
+            return value;
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            forget(key);
+            throw;
+        }
+    }
+
+    /**
+     * Start fn for key, or join the call for key already in flight, without
+     * waiting for it
+     * @param key Identity of the call
+     * @param fn Function starting the call, only invoked by the leader. It
+     *           receives a std::shared_ptr<Completion> that it must complete,
+     *           possibly from another thread.
+     */
+    template <typename F>
+    std::shared_future<V> runAsync(const K &key, F &&fn) {
+        std::shared_ptr<Completion> completion;
+        std::shared_future<V> future;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = calls_.find(key);
+            if (it != calls_.end()) {
+                return it->second;
+            }
+            completion = std::make_shared<Completion>(this, key);
+            future = completion->getFuture();
+            calls_.emplace(key, future);
+        }
+
+        try {
+            fn(completion);
+        } catch (...) {
+            if (!completion->isCompleted()) {
+                completion->setException(std::current_exception());
+            }
+        }
+        return future;
+    }
+
+    /**
+     * Get number of calls currently in flight
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_.size();
+    }
+
+  private:
+    void forget(const K &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.erase(key);
+    }
+};
+
+}  // namespace schemaregistry::rest
@@ -5,74 +5,182 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
-#include <list>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <stdexcept>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 
 namespace schemaregistry::rest {
 
+/**
+ * Sharded cache with LRU eviction and an optional TTL.
+ *
+ * Keys are spread over independently locked shards, so concurrent lookups of
+ * different keys rarely contend. Each shard keeps its entries in a slab
+ * linked into an intrusive LRU list, so no allocation happens per access.
+ * Reading or writing an entry refreshes its timestamp and moves it to the
+ * front of the list, so the list is also ordered by age: expired entries are
+ * dropped from the tail in O(1) per entry, or lazily when looked up.
+ *
+ * The cache holds up to capacity entries, whichever shards they fall in:
+ * the entry count is shared by all shards. A new entry evicts the least
+ * recently used entry of its own shard, or, when it is alone there, of
+ * another shard, so LRU order is kept per shard. Small caches use a single
+ * shard and behave as a plain LRU.
+ */
 template <typename K, typename V>
 class TtlLruCache {
   private:
-    struct CacheEntry {
-        V value;
-        std::chrono::steady_clock::time_point timestamp;
-        typename std::list<K>::iterator lru_iterator;
+    static constexpr uint32_t kNil = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t kMaxShards = 16;
+    static constexpr size_t kMinEntriesPerShard = 32;
 
-        CacheEntry(V val, std::chrono::steady_clock::time_point ts,
-                   typename std::list<K>::iterator it)
-            : value(std::move(val)), timestamp(ts), lru_iterator(it) {}
+    struct Node {
+        K key;
+        std::optional<V> value;  // Reset when the slot is freed
+        std::chrono::steady_clock::time_point timestamp;
+        uint32_t prev;
+        uint32_t next;
     };
 
-    mutable std::mutex mutex_;
-    absl::flat_hash_map<K, CacheEntry> cache_;
-    std::list<K>
-        lru_list_;  // Most recently used at front, least recently used at back
-    size_t capacity_;
-    std::chrono::seconds ttl_;
+    struct Shard {
+        mutable std::mutex mutex;
+        absl::flat_hash_map<K, uint32_t> index;  // Maps key -> slot in nodes
+        std::vector<Node> nodes;
+        std::vector<uint32_t> free_slots;
+        uint32_t head = kNil;  // Most recently used
+        uint32_t tail = kNil;  // Least recently used
 
-    // Remove expired entries (must be called with mutex held)
-    void cleanup_expired_unsafe() {
-        if (ttl_ == std::chrono::seconds::max()) {
-            return;  // No TTL configured, skip cleanup
+        // Unlink slot from LRU list (must be called with mutex held)
+        void unlink_unsafe(uint32_t slot) {
+            Node &node = nodes[slot];
+            if (node.prev != kNil) {
+                nodes[node.prev].next = node.next;
+            } else {
+                head = node.next;
+            }
+            if (node.next != kNil) {
+                nodes[node.next].prev = node.prev;
+            } else {
+                tail = node.prev;
+            }
         }
-        auto now = std::chrono::steady_clock::now();
-        std::vector<K> expired_keys;
-        for (auto &pair : cache_) {
-            if (now - pair.second.timestamp > ttl_) {
-                lru_list_.erase(pair.second.lru_iterator);
-                expired_keys.push_back(pair.first);
+
+        // Link slot at front of LRU list (must be called with mutex held)
+        void push_front_unsafe(uint32_t slot) {
+            Node &node = nodes[slot];
+            node.prev = kNil;
+            node.next = head;
+            if (head != kNil) {
+                nodes[head].prev = slot;
+            }
+            head = slot;
+            if (tail == kNil) {
+                tail = slot;
             }
         }
-        for (const auto &key : expired_keys) {
-            cache_.erase(key);
+
+        // Move slot to front of LRU list (must be called with mutex held)
+        void move_to_front_unsafe(uint32_t slot) {
+            if (head == slot) {
+                return;
+            }
+            unlink_unsafe(slot);
+            push_front_unsafe(slot);
+        }
+
+        // Remove entry in slot, leaving the entry count to the caller (must
+        // be called with mutex held)
+        void remove_unsafe(uint32_t slot) {
+            unlink_unsafe(slot);
+            index.erase(nodes[slot].key);
+            nodes[slot].value.reset();
+            free_slots.push_back(slot);
+        }
+
+        void clear_unsafe() {
+            index.clear();
+            nodes.clear();
+            free_slots.clear();
+            head = kNil;
+            tail = kNil;
         }
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+    size_t capacity_;
+    std::chrono::seconds ttl_;
+    std::atomic<size_t> size_{0};  // Entries across shards
+
+    bool has_ttl() const { return ttl_ != std::chrono::seconds::max(); }
+
+    Shard &shard_for(const K &key) const {
+        uint64_t hash = absl::Hash<K>{}(key);
+        // Fold in the high bits, as the low bits also select slots within
+        // the shard's hash map
+        return shards_[(hash ^ (hash >> 32)) & (shard_count_ - 1)];
     }
 
-    // Move key to front of LRU list (must be called with mutex held)
-    void move_to_front_unsafe(const K& key) {
-        auto& entry = cache_.at(key);
-        // Remove from current position
-        lru_list_.erase(entry.lru_iterator);
-        // Add to front
-        lru_list_.push_front(key);
-        // Update iterator
-        entry.lru_iterator = lru_list_.begin();
+    // Remove entry in slot of shard and count it out (must be called with
+    // the shard's mutex held)
+    void erase_unsafe(Shard &shard, uint32_t slot) {
+        shard.remove_unsafe(slot);
+        size_.fetch_sub(1, std::memory_order_relaxed);
     }
 
-    // Evict least recently used entry (must be called with mutex held)
-    void evict_lru_unsafe() {
-        if (!lru_list_.empty()) {
-            const K& lru_key = lru_list_.back();
-            cache_.erase(lru_key);
-            lru_list_.pop_back();
+    // Remove expired entries from the tail of shard (must be called with the
+    // shard's mutex held)
+    void cleanup_expired_unsafe(Shard &shard,
+                                std::chrono::steady_clock::time_point now) {
+        while (shard.tail != kNil &&
+               now - shard.nodes[shard.tail].timestamp > ttl_) {
+            erase_unsafe(shard, shard.tail);
         }
     }
 
+    // Count one entry out if the cache is over capacity, for the caller to
+    // evict. Concurrent inserts each claim their own eviction, so they never
+    // evict more entries than they added.
+    bool claim_eviction() {
+        size_t size = size_.load(std::memory_order_relaxed);
+        while (size > capacity_) {
+            if (size_.compare_exchange_weak(size, size - 1,
+                                            std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Evict the least recently used entries of shards other than own while
+    // the cache is over capacity, locking one shard at a time. Returns the
+    // number of entries evicted.
+    size_t evict_from_other_shards(const Shard &own) {
+        size_t evicted = 0;
+        size_t first = static_cast<size_t>(&own - shards_.get());
+        for (size_t i = 1; i < shard_count_; ++i) {
+            Shard &shard = shards_[(first + i) & (shard_count_ - 1)];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            while (shard.tail != kNil) {
+                if (!claim_eviction()) {
+                    return evicted;
+                }
+                shard.remove_unsafe(shard.tail);
+                ++evicted;
+            }
+        }
+        return evicted;
+    }
+
   public:
     /**
      * Constructor with no TTL (entries never expire, eviction by LRU only)
@@ -87,11 +195,19 @@ class TtlLruCache {
      * @param ttl Time-to-live for cache entries
      */
     TtlLruCache(size_t capacity, std::chrono::seconds ttl)
-        : capacity_(capacity), ttl_(ttl) {
+        : shard_count_(1), capacity_(capacity), ttl_(ttl) {
         if (capacity == 0) {
             throw std::invalid_argument(
                 "Cache capacity must be greater than 0");
         }
+        if (capacity >= kNil) {
+            throw std::invalid_argument("Cache capacity is too large");
+        }
+        while (shard_count_ * 2 <= kMaxShards &&
+               capacity / (shard_count_ * 2) >= kMinEntriesPerShard) {
+            shard_count_ *= 2;
+        }
+        shards_ = std::make_unique<Shard[]>(shard_count_);
     }
 
     /**
@@ -99,85 +215,109 @@ class TtlLruCache {
      * @param key The key to lookup
      * @return Optional value if found and not expired, std::nullopt otherwise
      */
-    std::optional<V> get(const K& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        // Clean up expired entries periodically
-        cleanup_expired_unsafe();
+    std::optional<V> get(const K &key) {
+        Shard &shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto it = cache_.find(key);
-        if (it == cache_.end()) {
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
             return std::nullopt;
         }
+        uint32_t slot = it->second;
+        Node &node = shard.nodes[slot];
 
         // Check if entry is expired
-        if (ttl_ != std::chrono::seconds::max()) {
+        if (has_ttl()) {
             auto now = std::chrono::steady_clock::now();
-            if (now - it->second.timestamp > ttl_) {
-                // Remove expired entry
-                lru_list_.erase(it->second.lru_iterator);
-                cache_.erase(it);
+            if (now - node.timestamp > ttl_) {
+                erase_unsafe(shard, slot);
                 return std::nullopt;
             }
             // Update timestamp to extend TTL
-            it->second.timestamp = now;
+            node.timestamp = now;
         }
 
         // Move to front of LRU list (mark as recently used)
-        move_to_front_unsafe(key);
+        shard.move_to_front_unsafe(slot);
 
-        return it->second.value;
+        return node.value;
     }
 
     /**
      * Put value into cache
      * @param key The key to store
      * @param value The value to store
+     * @return Number of entries evicted to make room for the new one
      */
-    void put(const K& key, const V& value) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    size_t put(const K &key, const V &value) {
+        Shard &shard = shard_for(key);
+        std::unique_lock<std::mutex> lock(shard.mutex);
 
         auto now = std::chrono::steady_clock::now();
 
         // Check if key already exists
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
             // Update existing entry
-            it->second.value = value;
-            it->second.timestamp = now;
-            move_to_front_unsafe(key);
-            return;
+            Node &node = shard.nodes[it->second];
+            node.value = value;
+            node.timestamp = now;
+            shard.move_to_front_unsafe(it->second);
+            return 0;
         }
 
         // Clean up expired entries before adding new ones
-        cleanup_expired_unsafe();
+        if (has_ttl()) {
+            cleanup_expired_unsafe(shard, now);
+        }
 
-        // Check capacity and evict if necessary
-        while (cache_.size() >= capacity_) {
-            evict_lru_unsafe();
+        // Add new entry, reusing a free slot if possible
+        uint32_t slot;
+        if (!shard.free_slots.empty()) {
+            slot = shard.free_slots.back();
+            shard.free_slots.pop_back();
+            Node &node = shard.nodes[slot];
+            node.key = key;
+            node.value = value;
+            node.timestamp = now;
+        } else {
+            slot = static_cast<uint32_t>(shard.nodes.size());
+            shard.nodes.push_back(Node{key, value, now, kNil, kNil});
         }
+        shard.push_front_unsafe(slot);
+        shard.index.emplace(key, slot);
+        size_.fetch_add(1, std::memory_order_relaxed);
 
-        // Add new entry
-        lru_list_.push_front(key);
-        cache_.emplace(key, CacheEntry(value, now, lru_list_.begin()));
+        // Evict from this shard while it holds other entries than the new
+        // one, else from the others
+        size_t evicted = 0;
+        while (shard.index.size() > 1 && claim_eviction()) {
+            shard.remove_unsafe(shard.tail);
+            ++evicted;
+        }
+        lock.unlock();
+        if (size_.load(std::memory_order_relaxed) > capacity_) {
+            evicted += evict_from_other_shards(shard);
+        }
+        return evicted;
     }
 
     /**
      * Clear all entries from cache
      */
     void clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_.clear();
-        lru_list_.clear();
+        for (size_t i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            size_.fetch_sub(shards_[i].index.size(),
+                            std::memory_order_relaxed);
+            shards_[i].clear_unsafe();
+        }
     }
 
     /**
      * Get current cache size
      */
-    size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return cache_.size();
-    }
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
 
     /**
      * Get cache capacity
@@ -189,12 +329,23 @@ class TtlLruCache {
      */
     std::chrono::seconds ttl() const { return ttl_; }
 
+    /**
+     * Get number of shards
+     */
+    size_t shard_count() const { return shard_count_; }
+
     /**
      * Manually cleanup expired entries
      */
     void cleanup_expired() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cleanup_expired_unsafe();
+        if (!has_ttl()) {
+            return;  // No TTL configured, skip cleanup
+        }
+        auto now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < shard_count_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            cleanup_expired_unsafe(shards_[i], now);
+        }
     }
 };
 
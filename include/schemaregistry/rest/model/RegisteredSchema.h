@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
@@ -41,6 +42,11 @@ class RegisteredSchema {
                      const std::optional<std::string> &subject,
                      const std::optional<int32_t> &version,
                      const Schema &schema);
+    RegisteredSchema(const std::optional<int32_t> &id,
+                     const std::optional<std::string> &guid,
+                     const std::optional<std::string> &subject,
+                     const std::optional<int32_t> &version,
+                     std::shared_ptr<const Schema> schema);
 
     virtual ~RegisteredSchema() = default;
 
@@ -103,6 +109,15 @@ class RegisteredSchema {
 
     schemaregistry::rest::model::Schema toSchema() const;
 
+    /// <summary>
+    /// Shared, immutable schema body. Copies of a RegisteredSchema share it,
+    /// and setters of schema members replace it rather than modify it.
+    /// </summary>
+    std::shared_ptr<const schemaregistry::rest::model::Schema>
+    getSchemaHandle() const;
+    void setSchemaHandle(
+        std::shared_ptr<const schemaregistry::rest::model::Schema> value);
+
     friend void to_json(nlohmann::json &j, const RegisteredSchema &o);
     friend void from_json(const nlohmann::json &j, RegisteredSchema &o);
 
@@ -111,12 +126,12 @@ class RegisteredSchema {
     std::optional<std::string> guid_;
     std::optional<std::string> subject_;
     std::optional<int32_t> version_;
-    std::optional<std::string> schemaType_;
-    std::optional<std::vector<schemaregistry::rest::model::SchemaReference>>
-        references_;
-    std::optional<schemaregistry::rest::model::Metadata> metadata_;
-    std::optional<schemaregistry::rest::model::RuleSet> ruleSet_;
-    std::optional<std::string> schema_;
+    // Schema type, references, metadata, rule set and schema string
+    std::shared_ptr<const schemaregistry::rest::model::Schema> body_;
+
+  private:
+    // Copy-on-write access to body_ for setters
+    schemaregistry::rest::model::Schema &mutableBody();
 };
 
 }  // namespace schemaregistry::rest::model
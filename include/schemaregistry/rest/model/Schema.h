@@ -25,6 +25,7 @@
 
 #include "Metadata.h"
 #include "RuleSet.h"
+#include "SchemaFingerprint.h"
 #include "SchemaReference.h"
 
 namespace schemaregistry::rest::model {
@@ -74,6 +75,12 @@ class Schema {
     std::optional<std::string> getSchema() const;
     void setSchema(const std::optional<std::string> &value);
 
+    /// <summary>
+    /// Content fingerprint over all members, computed once and memoized
+    /// until a member changes
+    /// </summary>
+    schemaregistry::rest::model::SchemaFingerprint getFingerprint() const;
+
     friend void to_json(nlohmann::json &j, const Schema &o);
     friend void from_json(const nlohmann::json &j, Schema &o);
 
@@ -84,6 +91,9 @@ class Schema {
     std::optional<schemaregistry::rest::model::Metadata> metadata_;
     std::optional<schemaregistry::rest::model::RuleSet> ruleSet_;
     std::optional<std::string> schema_;
+
+  private:
+    schemaregistry::rest::model::SchemaFingerprintMemo fingerprint_;
 };
 
 }  // namespace schemaregistry::rest::model
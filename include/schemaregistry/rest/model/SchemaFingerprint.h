@@ -0,0 +1,108 @@
+/**
+ * Confluent Schema Registry Client
+ * 128-bit content fingerprint used to key schema caches
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace schemaregistry::rest::model {
+
+/**
+ * 128-bit content fingerprint of a schema (MurmurHash3 x64_128)
+ *
+ * Fingerprints are stable within a process and cheap to hash and compare,
+ * so they replace the full schema text as the key of schema caches.
+ */
+struct SchemaFingerprint {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    bool operator==(const SchemaFingerprint &rhs) const {
+        return hi == rhs.hi && lo == rhs.lo;
+    }
+    bool operator!=(const SchemaFingerprint &rhs) const {
+        return !(*this == rhs);
+    }
+
+    /**
+     * Hex representation, for logging and diagnostics
+     */
+    std::string toHex() const;
+
+    /**
+     * Compute the fingerprint of a byte sequence
+     */
+    static SchemaFingerprint of(std::string_view data);
+
+    template <typename H>
+    friend H AbslHashValue(H h, const SchemaFingerprint &f) {
+        return H::combine(std::move(h), f.hi, f.lo);
+    }
+};
+
+/**
+ * Memoized fingerprint slot embedded in a model object
+ *
+ * Safe to read from several threads: concurrent computations of the same
+ * fingerprint store identical values. Copies carry the memoized value;
+ * owners call reset() whenever a field contributing to the fingerprint
+ * changes.
+ */
+class SchemaFingerprintMemo {
+  public:
+    SchemaFingerprintMemo() = default;
+
+    SchemaFingerprintMemo(const SchemaFingerprintMemo &other) {
+        copyFrom(other);
+    }
+
+    SchemaFingerprintMemo &operator=(const SchemaFingerprintMemo &other) {
+        if (this != &other) {
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * Get the memoized fingerprint, computing it with fn on first use
+     */
+    template <typename F>
+    SchemaFingerprint get(F &&fn) const {
+        if (ready_.load(std::memory_order_acquire)) {
+            return {hi_.load(std::memory_order_relaxed),
+                    lo_.load(std::memory_order_relaxed)};
+        }
+        SchemaFingerprint fingerprint = fn();
+        hi_.store(fingerprint.hi, std::memory_order_relaxed);
+        lo_.store(fingerprint.lo, std::memory_order_relaxed);
+        ready_.store(true, std::memory_order_release);
+        return fingerprint;
+    }
+
+    /**
+     * Drop the memoized fingerprint (not thread-safe, like the model setters)
+     */
+    void reset() { ready_.store(false, std::memory_order_relaxed); }
+
+  private:
+    void copyFrom(const SchemaFingerprintMemo &other) {
+        bool ready = other.ready_.load(std::memory_order_acquire);
+        hi_.store(other.hi_.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+        lo_.store(other.lo_.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+        ready_.store(ready, std::memory_order_relaxed);
+    }
+
+    mutable std::atomic<bool> ready_{false};
+    mutable std::atomic<uint64_t> hi_{0};
+    mutable std::atomic<uint64_t> lo_{0};
+};
+
+}  // namespace schemaregistry::rest::model
@@ -4,15 +4,18 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "proto/tink.pb.h"
 #include "schemaregistry/rest/ClientConfiguration.h"
 #include "schemaregistry/rest/DekRegistryClient.h"
 #include "schemaregistry/rest/DekRegistryTypes.h"
 #include "schemaregistry/rest/IDekRegistryClient.h"
+#include "schemaregistry/rest/TtlLruCache.h"
 #include "schemaregistry/rest/model/CreateDekRequest.h"
 #include "schemaregistry/rest/model/CreateKekRequest.h"
 #include "schemaregistry/rest/model/Dek.h"
@@ -34,6 +37,9 @@ namespace schemaregistry::rules::encryption {
 using namespace schemaregistry::serdes;
 using namespace schemaregistry::rest;
 
+// Forward declarations
+class EncryptionExecutorTransform;
+
 // Constants
 constexpr const char *ENCRYPT_KEK_NAME = "encrypt.kek.name";
 constexpr const char *ENCRYPT_KMS_KEY_ID = "encrypt.kms.key.id";
@@ -100,9 +106,6 @@ class Cryptor {
         const std::vector<uint8_t> &associated_data) const;
 };
 
-// Forward declarations
-class EncryptionExecutorTransform;
-
 /**
  * Main encryption executor for message-level encryption
  * Based on EncryptionExecutor from encrypt_executor.rs
@@ -114,6 +117,9 @@ class EncryptionExecutor : public RuleExecutor {
     std::unordered_map<std::string, std::string> config_;
     mutable std::shared_mutex config_mutex_;
     std::shared_ptr<Clock> clock_;
+    mutable schemaregistry::rest::TtlLruCache<
+        std::string, std::shared_ptr<EncryptionExecutorTransform>>
+        transforms_;
 
   public:
     explicit EncryptionExecutor(
@@ -137,6 +143,14 @@ class EncryptionExecutor : public RuleExecutor {
     std::unique_ptr<EncryptionExecutorTransform> newTransform(
         RuleContext &ctx) const;
 
+    /**
+     * Get the transform of a rule for a subject and rule mode, created on
+     * first use and shared by all later messages, so that the rule
+     * parameters are parsed and the KEK is resolved once
+     */
+    std::shared_ptr<EncryptionExecutorTransform> getTransform(
+        RuleContext &ctx) const;
+
     // Static registration
     static void registerExecutor();
 
@@ -157,9 +171,13 @@ class EncryptionExecutorTransform {
     const EncryptionExecutor *executor_;
     Cryptor cryptor_;
     std::string kek_name_;
-    mutable std::optional<schemaregistry::rest::model::Kek> kek_;
-    mutable std::mutex kek_mutex_;
+    std::shared_ptr<const schemaregistry::rest::model::Kek> kek_;
+    std::mutex kek_mutex_;
     int64_t dek_expiry_days_;
+    // DEKs with key material by requested version, until they expire
+    schemaregistry::rest::TtlLruCache<
+        int32_t, std::shared_ptr<const schemaregistry::rest::model::Dek>>
+        deks_;
 
   public:
     EncryptionExecutorTransform(const EncryptionExecutor *executor,
@@ -172,7 +190,8 @@ class EncryptionExecutorTransform {
 
   private:
     bool isDekRotated() const;
-    schemaregistry::rest::model::Kek getKek(RuleContext &ctx);
+    std::shared_ptr<const schemaregistry::rest::model::Kek> getKek(
+        RuleContext &ctx);
     schemaregistry::rest::model::Kek getOrCreateKek(RuleContext &ctx);
     std::optional<schemaregistry::rest::model::Kek> retrieveKekFromRegistry(
         const KekId &kek_id);
@@ -180,6 +199,8 @@ class EncryptionExecutorTransform {
         const KekId &kek_id, const std::string &kms_type,
         const std::string &kms_key_id, bool shared);
 
+    std::shared_ptr<const schemaregistry::rest::model::Dek> getDek(
+        RuleContext &ctx, std::optional<int32_t> version);
     schemaregistry::rest::model::Dek getOrCreateDek(
         RuleContext &ctx, std::optional<int32_t> version);
     schemaregistry::rest::model::Dek createDek(
@@ -201,9 +222,8 @@ class EncryptionExecutorTransform {
         const DekId &dek_id,
         const std::optional<std::vector<uint8_t>> &encrypted_dek);
 
-    bool isExpired(
-        RuleContext &ctx,
-        const std::optional<schemaregistry::rest::model::Dek> &dek) const;
+    bool isExpired(RuleContext &ctx,
+                   const schemaregistry::rest::model::Dek &dek) const;
     std::vector<uint8_t> prefixVersion(
         int32_t version, const std::vector<uint8_t> &ciphertext) const;
     std::pair<std::optional<int32_t>, std::vector<uint8_t>> extractVersion(
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 
 #include "nlohmann/json.hpp"
+#include "schemaregistry/rest/TtlLruCache.h"
 #include "schemaregistry/serdes/Serde.h"
 #include "schemaregistry/serdes/SerdeError.h"
 
@@ -14,7 +18,26 @@ using namespace schemaregistry::serdes;
 
 class JsonataExecutor : public RuleExecutor {
   public:
-    JsonataExecutor();
+    /**
+     * Statistics of the compiled expression cache
+     */
+    struct CacheStats {
+        size_t hits = 0;       // Lookups of an expression already compiled
+        size_t misses = 0;     // Lookups that compiled the expression
+        size_t evictions = 0;  // Expressions dropped when the cache was full
+        size_t size = 0;       // Expressions currently cached
+    };
+
+    /**
+     * Constructor
+     * @param max_cached_expressions Maximum number of expressions cached,
+     * greater than 0
+     */
+    explicit JsonataExecutor(size_t max_cached_expressions = 1000);
+    ~JsonataExecutor();
+
+    JsonataExecutor(const JsonataExecutor &) = delete;
+    JsonataExecutor &operator=(const JsonataExecutor &) = delete;
 
     std::unique_ptr<SerdeValue> transform(
         schemaregistry::serdes::RuleContext &ctx,
@@ -22,7 +45,26 @@ class JsonataExecutor : public RuleExecutor {
 
     std::string getType() const override;
 
+    /**
+     * Get statistics of the compiled expression cache
+     */
+    CacheStats getCacheStats() const;
+
     static void registerExecutor();
+
+  private:
+    class CompiledExpression;
+
+    std::shared_ptr<CompiledExpression> getOrCompileExpression(
+        const std::string &expr);
+
+    // Compiled expressions, least recently used evicted first
+    schemaregistry::rest::TtlLruCache<std::string,
+                                      std::shared_ptr<CompiledExpression>>
+        expression_cache_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    std::atomic<size_t> evictions_{0};
 };
 
-}  // namespace schemaregistry::rules::jsonata
\ No newline at end of file
+}  // namespace schemaregistry::rules::jsonata
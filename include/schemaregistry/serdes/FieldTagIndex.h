@@ -0,0 +1,137 @@
+/**
+ * FieldTagIndex
+ * Per-schema index of the tags applying to each field
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "schemaregistry/rest/TtlLruCache.h"
+#include "schemaregistry/rest/model/Metadata.h"
+#include "schemaregistry/rest/model/Schema.h"
+#include "schemaregistry/serdes/WildcardMatcher.h"
+
+namespace schemaregistry::serdes {
+
+/**
+ * Fields of a schema a field rule has to visit
+ *
+ * Records (Avro records, Protobuf messages) are identified by full name and
+ * their fields by index. A field is visited if the rule applies to it or to
+ * any field nested in it, through arrays, maps and unions. Fields of records
+ * missing from the plan are all visited.
+ */
+class FieldVisitPlan {
+  public:
+    using Records = absl::flat_hash_map<std::string, std::vector<bool>>;
+
+    explicit FieldVisitPlan(Records records) : records_(std::move(records)) {}
+
+    /**
+     * Whether a field of a record has to be visited
+     * @param record Full name of the record
+     * @param field Index of the field in the record
+     */
+    bool visits(const std::string &record, size_t field) const {
+        auto it = records_.find(record);
+        return it == records_.end() || field >= it->second.size() ||
+               it->second[field];
+    }
+
+  private:
+    Records records_;
+};
+
+/**
+ * Index from full field names to the tags of a schema that apply to them
+ *
+ * Tags come from two places: tags declared inline in the schema, which the
+ * format collects when it parses the schema, and the tags of the schema
+ * metadata, which are keyed by wildcard patterns over full field names. The
+ * index is built once per schema and shared read-only by all rule contexts.
+ * The patterns are matched against a field name on its first lookup, and
+ * the result is memoized, so later lookups cost one hash lookup.
+ */
+class FieldTagIndex {
+  public:
+    using TagSet = std::unordered_set<std::string>;
+
+    /**
+     * Constructor
+     * @param inline_tags Inline tags by full field name
+     * @param metadata Schema metadata holding tags by field name pattern
+     */
+    FieldTagIndex(
+        std::unordered_map<std::string, TagSet> inline_tags,
+        const std::optional<schemaregistry::rest::model::Metadata> &metadata);
+
+    FieldTagIndex(const FieldTagIndex &) = delete;
+    FieldTagIndex &operator=(const FieldTagIndex &) = delete;
+
+    /**
+     * Get the index of the metadata tags of schema, for formats without
+     * inline tags. Indexes are cached by schema content.
+     * @param schema The schema rules are executed against
+     */
+    static std::shared_ptr<const FieldTagIndex> forSchema(
+        const schemaregistry::rest::model::Schema &schema);
+
+    /**
+     * Get the inline tags of a field, or nullptr if it has none
+     */
+    const TagSet *getInlineTags(const std::string &full_name) const;
+
+    /**
+     * Get the metadata tags whose pattern matches a field
+     */
+    std::shared_ptr<const TagSet> getMetadataTags(
+        const std::string &full_name) const;
+
+    /**
+     * Get all tags of a field, its inline tags merged with its metadata tags
+     */
+    std::shared_ptr<const TagSet> getTags(const std::string &full_name) const;
+
+    /**
+     * Get the visit plan of a rule over the schema, building it on first use
+     * @param root Full name of the record the plan starts from
+     * @param rule_tags Tags the rule applies to, not empty
+     * @param build Builds the plan if it is not cached yet
+     */
+    std::shared_ptr<const FieldVisitPlan> getVisitPlan(
+        const std::string &root, const TagSet &rule_tags,
+        const std::function<FieldVisitPlan()> &build) const;
+
+  private:
+    struct Pattern {
+        std::shared_ptr<const WildcardMatcher> matcher;
+        std::vector<std::string> tags;
+    };
+
+    struct FieldTags {
+        std::shared_ptr<const TagSet> metadata;
+        std::shared_ptr<const TagSet> all;
+    };
+
+    std::unordered_map<std::string, TagSet> inline_tags_;
+    std::vector<Pattern> patterns_;
+
+    mutable std::shared_mutex mutex_;
+    mutable absl::flat_hash_map<std::string, FieldTags> fields_;
+    mutable schemaregistry::rest::TtlLruCache<
+        std::string, std::shared_ptr<const FieldVisitPlan>>
+        plans_;
+
+    FieldTags lookup(const std::string &full_name) const;
+};
+
+}  // namespace schemaregistry::serdes
@@ -4,14 +4,19 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/hash/hash.h"
 #include "schemaregistry/rest/TtlLruCache.h"
 
 #include "schemaregistry/rest/ISchemaRegistryClient.h"
+#include "schemaregistry/serdes/FieldTagIndex.h"
 #include "schemaregistry/serdes/RuleRegistry.h"
 #include "schemaregistry/serdes/SerdeConfig.h"
 #include "schemaregistry/serdes/SerdeError.h"
@@ -64,6 +69,7 @@ class SchemaId {
 
     // Serialization methods (synchronous versions)
     size_t readFromBytes(const std::vector<uint8_t> &bytes);
+    size_t readFromBytes(const uint8_t *bytes, size_t size);
     std::vector<uint8_t> idToBytes() const;
     std::vector<uint8_t> guidToBytes() const;
 
@@ -75,7 +81,7 @@ class SchemaId {
 
   private:
     std::pair<std::vector<int32_t>, size_t> readIndexArrayAndData(
-        const std::vector<uint8_t> &buf) const;
+        const uint8_t *buf, size_t size) const;
     std::optional<std::vector<uint8_t>> toEncodedIndexArray() const;
 };
 
@@ -161,13 +167,17 @@ class FieldContext {
     std::string name_;
     mutable std::mutex field_type_mutex_;
     FieldType field_type_;
-    std::unordered_set<std::string> tags_;
+    std::shared_ptr<const std::unordered_set<std::string>> tags_;
 
   public:
     FieldContext(const SerdeValue &containing_message,
                  const std::string &full_name, const std::string &name,
                  FieldType field_type,
                  const std::unordered_set<std::string> &tags);
+    FieldContext(const SerdeValue &containing_message,
+                 const std::string &full_name, const std::string &name,
+                 FieldType field_type,
+                 std::shared_ptr<const std::unordered_set<std::string>> tags);
 
     // Accessors
     const SerdeValue &getContainingMessage() const {
@@ -177,7 +187,11 @@ class FieldContext {
     const std::string &getName() const { return name_; }
     FieldType getFieldType() const;
     void setFieldType(FieldType field_type);
-    const std::unordered_set<std::string> &getTags() const { return tags_; }
+    const std::unordered_set<std::string> &getTags() const { return *tags_; }
+    std::shared_ptr<const std::unordered_set<std::string>> getTagsHandle()
+        const {
+        return tags_;
+    }
 
     // Utility methods
     bool isPrimitive() const;
@@ -193,20 +207,25 @@ class FieldContext {
 /**
  * Rule execution context
  * Based on RuleContext from serde.rs
+ *
+ * The schemas, rule and rule list are borrowed and must outlive the context.
+ * Contexts are created for, and only valid during, the execution of a rule:
+ * executors must not keep the context, its schemas or its rules beyond the
+ * call they were passed to, and copy what they need to keep instead.
  */
 class RuleContext {
   private:
     std::optional<std::string> enabled_env_;
     SerializationContext ser_ctx_;
-    std::optional<Schema> source_;
-    std::optional<Schema> target_;
+    const Schema *source_;
+    const Schema *target_;
     std::string subject_;
     Mode rule_mode_;
-    Rule rule_;
+    const Rule *rule_;
     size_t index_;
-    std::vector<Rule> rules_;
-    std::unordered_map<std::string, std::unordered_set<std::string>>
-        inline_tags_;
+    const std::vector<Rule> *rules_;
+    std::unordered_set<std::string> rule_tags_;
+    std::shared_ptr<const FieldTagIndex> tag_index_;
     std::vector<std::unique_ptr<FieldContext>> field_contexts_;
     std::shared_ptr<FieldTransformer> field_transformer_;
     std::shared_ptr<RuleRegistry> rule_registry_;
@@ -214,11 +233,10 @@ class RuleContext {
   public:
     RuleContext(std::optional<std::string> enabled_env,
                 const SerializationContext &ser_ctx,
-                std::optional<Schema> source, std::optional<Schema> target,
+                const Schema *source, const Schema *target,
                 const std::string &subject, Mode rule_mode, const Rule &rule,
                 size_t index, const std::vector<Rule> &rules,
-                std::unordered_map<std::string, std::unordered_set<std::string>>
-                    inline_tags,
+                std::shared_ptr<const FieldTagIndex> tag_index,
                 std::shared_ptr<FieldTransformer> field_transformer = nullptr,
                 std::shared_ptr<RuleRegistry> rule_registry = nullptr);
 
@@ -229,19 +247,22 @@ class RuleContext {
     const SerializationContext &getSerializationContext() const {
         return ser_ctx_;
     }
-    const std::optional<Schema> &getSource() const { return source_; }
-    const std::optional<Schema> &getTarget() const { return target_; }
+    const Schema *getSource() const { return source_; }
+    const Schema *getTarget() const { return target_; }
     const std::string &getSubject() const { return subject_; }
     Mode getRuleMode() const { return rule_mode_; }
-    const Rule &getRule() const { return rule_; }
+    const Rule &getRule() const { return *rule_; }
     size_t getIndex() const { return index_; }
-    const std::vector<Rule> &getRules() const { return rules_; }
+    const std::vector<Rule> &getRules() const { return *rules_; }
     std::shared_ptr<FieldTransformer> getFieldTransformer() const {
         return field_transformer_;
     }
     std::shared_ptr<RuleRegistry> getRuleRegistry() const {
         return rule_registry_;
     }
+    const std::shared_ptr<const FieldTagIndex> &getTagIndex() const {
+        return tag_index_;
+    }
 
     // Parameter handling
     std::optional<std::string> getParameter(const std::string &name) const;
@@ -260,6 +281,28 @@ class RuleContext {
     // Tag handling
     std::unordered_set<std::string> getTags(const std::string &full_name) const;
 
+    /**
+     * Tags of the rule, empty if the rule applies to all fields
+     */
+    const std::unordered_set<std::string> &getRuleTags() const {
+        return rule_tags_;
+    }
+
+    /**
+     * Whether the rule applies to a field with the given tags
+     */
+    bool appliesTo(const std::unordered_set<std::string> &field_tags) const;
+
+    /**
+     * Get the fields of the schema the rule has to visit
+     * @param root Full name of the record the plan starts from
+     * @param build Builds the plan if the schema has none cached yet
+     * @return The plan, or nullptr if the rule has to visit all fields
+     */
+    std::shared_ptr<const FieldVisitPlan> getVisitPlan(
+        const std::string &root,
+        const std::function<FieldVisitPlan()> &build) const;
+
     // Copy/move constructors and assignment operators are deleted due to
     // unique_ptr
     RuleContext(const RuleContext &) = delete;
@@ -274,8 +317,16 @@ class RuleContext {
  */
 class Serde {
   private:
+    /**
+     * Migration plans by subject, writer schema and reader schema
+     */
+    using MigrationPlans = schemaregistry::rest::TtlLruCache<
+        std::string, std::shared_ptr<const std::vector<Migration>>>;
+
     std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client_;
     std::shared_ptr<RuleRegistry> rule_registry_;
+    // Shared by copies, which use the same client
+    std::shared_ptr<MigrationPlans> migration_plans_;
 
   public:
     Serde(std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client,
@@ -289,22 +340,30 @@ class Serde {
     // Rule execution (synchronous versions)
     std::unique_ptr<SerdeValue> executeRules(
         const SerializationContext &ser_ctx, const std::string &subject,
-        Mode rule_mode, std::optional<Schema> source,
-        std::optional<Schema> target, const SerdeValue &msg,
-        std::unordered_map<std::string, std::unordered_set<std::string>>
-            inline_tags,
+        Mode rule_mode, const Schema *source, const Schema *target,
+        const SerdeValue &msg,
+        std::shared_ptr<const FieldTagIndex> tag_index,
         std::shared_ptr<FieldTransformer> field_transformer = nullptr) const;
 
     std::unique_ptr<SerdeValue> executeRulesWithPhase(
         const SerializationContext &ser_ctx, const std::string &subject,
-        Phase rule_phase, Mode rule_mode, std::optional<Schema> source,
-        std::optional<Schema> target, const SerdeValue &msg,
-        std::unordered_map<std::string, std::unordered_set<std::string>>
-            inline_tags,
+        Phase rule_phase, Mode rule_mode, const Schema *source,
+        const Schema *target, const SerdeValue &msg,
+        std::shared_ptr<const FieldTagIndex> tag_index,
         std::shared_ptr<FieldTransformer> field_transformer = nullptr) const;
 
     // Migration support (synchronous versions)
-    std::vector<Migration> getMigrations(
+
+    /**
+     * Get the migrations from the writer schema to the reader schema of a
+     * subject. They are planned on first use for a pair of schemas and
+     * cached, with their schemas and rules extracted.
+     * @param subject The subject both schemas are registered under
+     * @param source_info The writer schema
+     * @param target The reader schema
+     * @param format Format of the intermediate schemas to fetch
+     */
+    std::shared_ptr<const std::vector<Migration>> getMigrations(
         const std::string &subject, const Schema &source_info,
         const RegisteredSchema &target,
         std::optional<std::string> format = std::nullopt) const;
@@ -328,10 +387,25 @@ class Serde {
     }
 
   private:
+    std::vector<Migration> planMigrations(
+        const std::string &subject, const Schema &source_info,
+        const RegisteredSchema &target,
+        std::optional<std::string> format) const;
+
+    void prepareMigration(Migration &migration) const;
+
+    std::unique_ptr<SerdeValue> executeRuleList(
+        const SerializationContext &ser_ctx, const std::string &subject,
+        Mode rule_mode, const std::optional<std::string> &enabled_env,
+        const std::vector<Rule> &rules, const Schema *source,
+        const Schema *target, const SerdeValue &msg,
+        std::shared_ptr<const FieldTagIndex> tag_index,
+        std::shared_ptr<FieldTransformer> field_transformer) const;
+
     // Helper methods for rule processing (synchronous versions)
-    std::vector<Rule> getMigrationRules(std::optional<Schema> schema) const;
-    std::vector<Rule> getDomainRules(std::optional<Schema> schema) const;
-    std::vector<Rule> getEncodingRules(std::optional<Schema> schema) const;
+    std::vector<Rule> getMigrationRules(const Schema *schema) const;
+    std::vector<Rule> getDomainRules(const Schema *schema) const;
+    std::vector<Rule> getEncodingRules(const Schema *schema) const;
 
     std::optional<std::string> getOnSuccess(const Rule &rule) const;
     std::optional<std::string> getOnFailure(const Rule &rule) const;
@@ -377,6 +451,87 @@ class BaseSerializer {
     BaseSerializer &operator=(BaseSerializer &&) = delete;
 };
 
+/**
+ * Serialization state for one (topic, key/value) pair, compiled on first use.
+ *
+ * Holds everything a serializer derives from its subject and target schema,
+ * so that the per-message path reduces to executing rules (only when the
+ * schema has any), encoding and framing. A plan is immutable; it is replaced
+ * when the subject or the registered schema it was built from changes.
+ * Parsed is the format specific parsed form of the writer schema.
+ */
+template <typename Parsed>
+struct SerializerPlan {
+    std::string subject;
+    // Latest registered body the plan was built from, or nullptr when the
+    // serializer's own schema was registered or looked up
+    std::shared_ptr<const Schema> latest;
+    // Schema messages are written with, passed to rule execution
+    std::shared_ptr<const Schema> schema;
+    SchemaId schema_id;
+    // Bytes written in front of each payload, if the configured schema ID
+    // serializer only prepends them (see schemaIdPrefix)
+    std::optional<std::vector<uint8_t>> id_prefix;
+    Parsed parsed;
+    // Tags of the fields of schema, or nullptr to index its metadata only
+    std::shared_ptr<const FieldTagIndex> tag_index;
+    std::shared_ptr<FieldTransformer> field_transformer;
+    bool has_domain_rules = false;
+    bool has_encoding_rules = false;
+
+    /**
+     * Whether the plan still applies to subject and its current reader schema
+     */
+    bool isCurrent(const std::string &current_subject,
+                   const std::optional<RegisteredSchema> &reader) const {
+        if (subject != current_subject) {
+            return false;
+        }
+        if (!reader.has_value()) {
+            return latest == nullptr;
+        }
+        // Interned bodies compare by identity
+        return latest == reader->getSchemaHandle() &&
+               schema_id.getId() == reader->getId() &&
+               schema_id.getGuid() == reader->getGuid();
+    }
+};
+
+/**
+ * Thread-safe map of compiled serializer plans by topic and key/value,
+ * bounded per key/value with the least recently used evicted first
+ */
+template <typename Parsed>
+class SerializerPlanCache {
+  public:
+    using PlanPtr = std::shared_ptr<const SerializerPlan<Parsed>>;
+
+    PlanPtr get(const std::string &topic, SerdeType serde_type) const {
+        return plans(serde_type).get(topic).value_or(nullptr);
+    }
+
+    void put(const std::string &topic, SerdeType serde_type, PlanPtr plan) {
+        plans(serde_type).put(topic, plan);
+    }
+
+    void clear() {
+        key_plans_.clear();
+        value_plans_.clear();
+    }
+
+  private:
+    using Plans = schemaregistry::rest::TtlLruCache<std::string, PlanPtr>;
+
+    static constexpr size_t kMaxPlans = 1000;
+
+    Plans &plans(SerdeType serde_type) const {
+        return serde_type == SerdeType::Key ? key_plans_ : value_plans_;
+    }
+
+    mutable Plans key_plans_{kMaxPlans};
+    mutable Plans value_plans_{kMaxPlans};
+};
+
 /**
  * Base deserializer class
  * Based on BaseDeserializer from serde.rs
@@ -395,6 +550,12 @@ class BaseDeserializer {
         std::optional<std::string> subject = std::nullopt,
         std::optional<std::string> format = std::nullopt) const;
 
+    // Shared writer schema, without copying the client's cached instance
+    std::shared_ptr<const Schema> getWriterSchemaHandle(
+        const SchemaId &schema_id,
+        std::optional<std::string> subject = std::nullopt,
+        std::optional<std::string> format = std::nullopt) const;
+
     // Accessors
     const Serde &getSerde() const { return serde_; }
     const DeserializerConfig &getConfig() const { return config_; }
@@ -475,12 +636,12 @@ class AssociatedNameStrategy {
      */
     std::optional<std::string> getSubject(const std::string &topic,
                                           SerdeType serde_type,
-                                          const std::optional<Schema> &schema) const;
+                                          const Schema *schema) const;
 
   private:
     std::optional<std::string> loadAssociatedSubjectName(
-        const std::string &topic, bool is_key,
-        const std::optional<Schema> &schema, SerdeType serde_type) const;
+        const std::string &topic, bool is_key, const Schema *schema,
+        SerdeType serde_type) const;
 };
 
 }  // namespace schemaregistry::serdes
\ No newline at end of file
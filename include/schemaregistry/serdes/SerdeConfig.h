@@ -87,8 +87,7 @@ struct DeserializerConfig {
  * Maps to topic_name_strategy from serde.rs
  */
 std::optional<std::string> topicNameStrategy(
-    const std::string &topic, SerdeType serde_type,
-    const std::optional<Schema> &schema);
+    const std::string &topic, SerdeType serde_type, const Schema *schema);
 
 /**
  * StrategyFunc returns the SubjectNameStrategyFunc for the given strategy type.
@@ -163,4 +162,23 @@ size_t prefixSchemaIdDeserializer(const std::vector<uint8_t> &payload,
                                   const SerializationContext &ser_ctx,
                                   SchemaId &schema_id);
 
+/**
+ * Read the schema ID of a payload with the given deserializer, without
+ * copying the payload when it is one of the built-in deserializers. Custom
+ * deserializers are called with a copy of the payload.
+ * @return Number of payload bytes taken by the schema ID
+ */
+size_t readSchemaId(const SchemaIdDeserializer &deserializer,
+                    const uint8_t *payload, size_t size,
+                    const SerializationContext &ser_ctx, SchemaId &schema_id);
+
+/**
+ * Bytes the given serializer prepends to every payload written with
+ * schema_id, if it is the prefix serializer. Lets serializers encode the
+ * payload straight after the prefix in a single buffer; returns nullopt for
+ * any other serializer, whose output must be produced by calling it.
+ */
+std::optional<std::vector<uint8_t>> schemaIdPrefix(
+    const SchemaIdSerializer &serializer, const SchemaId &schema_id);
+
 }  // namespace schemaregistry::serdes
\ No newline at end of file
@@ -28,6 +28,8 @@ class ClientConfiguration;
 
 namespace schemaregistry::serdes {
 
+class FieldTagIndex;
+
 /**
  * Serialization format types
  */
@@ -215,6 +217,16 @@ struct Migration {
     std::optional<RegisteredSchema> source;
     std::optional<RegisteredSchema> target;
 
+    // Extracted once when Serde::getMigrations plans the migration, so that
+    // executing it does not convert the schemas or copy the rules again.
+    // Migrations built otherwise are extracted on every execution.
+    bool prepared = false;
+    std::optional<Schema> source_schema;
+    std::optional<Schema> target_schema;
+    std::optional<std::string> enabled_env;
+    std::vector<Rule> rules;
+    std::shared_ptr<const FieldTagIndex> tag_index;
+
     Migration(Mode mode, std::optional<RegisteredSchema> src = std::nullopt,
               std::optional<RegisteredSchema> tgt = std::nullopt);
 };
@@ -248,17 +260,16 @@ SubjectNameStrategyType parseSubjectNameStrategyType(const std::string &s);
  * SubjectNameStrategyFunc is a function that determines the subject for the
  * given parameters. This is used for strategies that need to capture state
  * (like RecordNameStrategy). Based on SubjectNameStrategyFunc from serde.rs
+ * The schema is null when it is not known yet.
  */
 using SubjectNameStrategyFunc = std::function<std::optional<std::string>(
-    const std::string &topic, SerdeType serde_type,
-    const std::optional<Schema> &schema)>;
+    const std::string &topic, SerdeType serde_type, const Schema *schema)>;
 
 /**
  * RecordNameFunc extracts the record name from a schema.
  * Based on RecordNameFunc from serde.rs
  */
-using RecordNameFunc =
-    std::function<std::string(const std::optional<Schema> &schema)>;
+using RecordNameFunc = std::function<std::string(const Schema *schema)>;
 
 using SchemaIdSerializer = std::function<std::vector<uint8_t>(
     const std::vector<uint8_t> &payload,
@@ -278,16 +289,14 @@ using FieldTransformer = std::function<std::unique_ptr<SerdeValue>(
 template <typename T>
 class ParsedSchemaCache {
   private:
-    absl::flat_hash_map<std::string, T> cache_;
+    absl::flat_hash_map<schemaregistry::rest::model::SchemaFingerprint, T>
+        cache_;
     mutable std::mutex mutex_;
 
   public:
     void set(const Schema &schema, const T &parsed_schema);
     std::optional<T> get(const Schema &schema) const;
     void clear();
-
-  private:
-    std::string getSchemaKey(const Schema &schema) const;
 };
 
 /**
@@ -5,9 +5,12 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
 #include <regex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace schemaregistry::serdes {
 
@@ -19,12 +22,61 @@ namespace schemaregistry::serdes {
  * - '**' matches any sequence of characters including separator
  * - '?' matches any single character except separator
  *
+ * Patterns are compiled once and cached, see WildcardMatcher::compile.
+ *
  * @param text The text to match against
  * @param matcher The wildcard pattern to match
  * @return true if the text matches the pattern exactly
  */
 bool wildcardMatch(const std::string &text, const std::string &matcher);
 
+/**
+ * Wildcard pattern compiled for repeated matching
+ *
+ * The pattern is compiled to a sequence of literal characters and wildcards,
+ * matched by simulating all positions in the pattern at once, so that
+ * matching takes O(text * pattern) time and never backtracks. Patterns that
+ * rely on regex syntax passed through by wildcardToRegexp, such as bracket
+ * expressions, are matched with a std::regex compiled once instead.
+ */
+class WildcardMatcher {
+  public:
+    /**
+     * Compile a wildcard pattern with '.' as separator
+     * @param pattern The wildcard pattern
+     */
+    explicit WildcardMatcher(const std::string &pattern);
+
+    /**
+     * Get the compiled matcher for pattern from a process-wide cache
+     * @param pattern The wildcard pattern
+     */
+    static std::shared_ptr<const WildcardMatcher> compile(
+        const std::string &pattern);
+
+    /**
+     * Whether text matches the whole pattern
+     */
+    bool matches(const std::string &text) const;
+
+  private:
+    enum class Op { Char, AnyChar, AnySegment, AnyPath };
+
+    struct Token {
+        Op op;
+        char c;
+    };
+
+    // Pattern without wildcards, compared as a whole
+    std::optional<std::string> literal_;
+    std::vector<Token> tokens_;
+    // Set for patterns only the regex translation can match
+    std::optional<std::regex> regex_;
+    bool invalid_ = false;
+
+    bool matchRegex(const std::string &text) const;
+};
+
 /**
  * Convert a wildcard pattern to a regular expression
  *
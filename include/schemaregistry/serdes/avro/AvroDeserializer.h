@@ -69,6 +69,18 @@ class AvroDeserializer {
     NamedValue deserialize(const SerializationContext &ctx,
                            const std::vector<uint8_t> &data);
 
+    /**
+     * Deserialize a borrowed buffer to a named Avro value
+     * The buffer, e.g. a Kafka message payload, is only read during the call
+     * and is not copied unless encoding rules have to rewrite it.
+     * @param ctx Serialization context (topic, serde type, etc.)
+     * @param data Serialized bytes with schema ID header
+     * @param size Number of serialized bytes
+     * @return NamedValue containing the deserialized Avro datum
+     */
+    NamedValue deserialize(const SerializationContext &ctx, const uint8_t *data,
+                           size_t size);
+
     /**
      * Deserialize bytes to JSON
      * Converts Avro datum to JSON after deserialization
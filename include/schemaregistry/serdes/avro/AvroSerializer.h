@@ -61,6 +61,20 @@ class AvroSerializer {
     std::vector<uint8_t> serialize(const SerializationContext &ctx,
                                    const ::avro::GenericDatum &datum);
 
+    /**
+     * Serialize a generic Avro datum into a caller-owned buffer
+     * The previous contents of out are replaced, but its capacity is reused,
+     * so a buffer kept across calls avoids allocating per message. With the
+     * default schema ID serializer and no encoding rules, the datum is
+     * encoded directly after the schema ID header.
+     * @param ctx Serialization context (topic, serde type, etc.)
+     * @param datum Avro generic datum to serialize
+     * @param out Buffer receiving the serialized bytes with schema ID header
+     */
+    void serialize(const SerializationContext &ctx,
+                   const ::avro::GenericDatum &datum,
+                   std::vector<uint8_t> &out);
+
     /**
      * Serialize a JSON value to Avro bytes
      * Uses the JSON to Avro conversion before serialization
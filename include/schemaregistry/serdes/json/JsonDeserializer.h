@@ -44,6 +44,18 @@ class JsonDeserializer {
     nlohmann::json deserialize(const SerializationContext &ctx,
                                const std::vector<uint8_t> &data);
 
+    /**
+     * Deserialize a borrowed buffer to JSON object
+     * The buffer, e.g. a Kafka message payload, is parsed in place and is not
+     * copied unless encoding rules have to rewrite it.
+     * @param ctx Serialization context (topic, serde type, etc.)
+     * @param data Serialized bytes with schema ID header
+     * @param size Number of serialized bytes
+     * @return Deserialized JSON object
+     */
+    nlohmann::json deserialize(const SerializationContext &ctx,
+                               const uint8_t *data, size_t size);
+
     /**
      * Close the deserializer and cleanup resources
      */
@@ -46,6 +46,17 @@ class JsonSerializer {
     std::vector<uint8_t> serialize(const SerializationContext &ctx,
                                    const nlohmann::json &value);
 
+    /**
+     * Serialize a JSON value into a caller-owned buffer
+     * The previous contents of out are replaced, but its capacity is reused
+     * across calls.
+     * @param ctx Serialization context (topic, serde type, etc.)
+     * @param value JSON value to serialize
+     * @param out Buffer receiving the serialized bytes with schema ID header
+     */
+    void serialize(const SerializationContext &ctx, const nlohmann::json &value,
+                   std::vector<uint8_t> &out);
+
     /**
      * Close the serializer and cleanup resources
      */
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/descriptor.pb.h>
 #include <google/protobuf/dynamic_message.h>
@@ -39,12 +40,28 @@ class ProtobufDeserializer {
     std::unique_ptr<T> deserialize(const SerializationContext &ctx,
                                    const std::vector<uint8_t> &data);
 
+    /**
+     * Deserialize a borrowed buffer, e.g. a Kafka message payload. The buffer
+     * is parsed in place and not copied unless encoding rules rewrite it.
+     */
+    std::unique_ptr<T> deserialize(const SerializationContext &ctx,
+                                   const uint8_t *data, size_t size);
+
+    /**
+     * Deserialize a borrowed buffer into a message created on an arena, which
+     * owns the message. Without an arena the caller owns the message.
+     */
+    T *deserialize(const SerializationContext &ctx, const uint8_t *data,
+                   size_t size, google::protobuf::Arena *arena);
+
     void close();
 
   private:
     std::shared_ptr<BaseDeserializer> base_;
     std::unique_ptr<ProtobufSerde> serde_;
     SubjectNameStrategyFunc subject_name_strategy_;
+    // Applies field rules to messages of T
+    std::shared_ptr<FieldTransformer> generated_field_transformer_;
 
     std::unique_ptr<google::protobuf::Message> createMessageFromDescriptor(
         const google::protobuf::Descriptor *descriptor);
@@ -53,7 +70,7 @@ class ProtobufDeserializer {
         const google::protobuf::Message &message);
 
     std::string getRecordName(
-        const std::optional<schemaregistry::rest::model::Schema> &schema);
+        const schemaregistry::rest::model::Schema *schema);
 
     std::unique_ptr<google::protobuf::Message> deserializeWithMessageDescriptor(
         const std::vector<uint8_t> &payload,
@@ -75,8 +92,8 @@ std::unique_ptr<schemaregistry::serdes::SerdeValue> transformFields(
 
 template <typename T>
 inline std::string ProtobufDeserializer<T>::getRecordName(
-    const std::optional<schemaregistry::rest::model::Schema> &schema) {
-    if (!schema.has_value()) return "";
+    const schemaregistry::rest::model::Schema *schema) {
+    if (!schema) return "";
     auto [file_desc, pool] =
         serde_->getParsedSchema(*schema, base_->getSerde().getClient());
     if (file_desc && file_desc->message_type_count() > 0) {
@@ -89,13 +106,8 @@ template <typename T>
 inline std::unique_ptr<google::protobuf::Message>
 ProtobufDeserializer<T>::createMessageFromDescriptor(
     const google::protobuf::Descriptor *descriptor) {
-    google::protobuf::DynamicMessageFactory factory;
-    const auto *prototype = factory.GetPrototype(descriptor);
-    if (!prototype) {
-        throw ProtobufError("Failed to get message prototype for descriptor: " +
-                            descriptor->full_name());
-    }
-    return std::unique_ptr<google::protobuf::Message>(prototype->New());
+    return std::unique_ptr<google::protobuf::Message>(
+        serde_->getPrototype(descriptor)->New());
 }
 
 template <typename T>
@@ -110,8 +122,13 @@ inline ProtobufDeserializer<T>::ProtobufDeserializer(
           config.subject_name_strategy_type,
           base_->getSerde().getClient(),
           config.subject_name_strategy_config,
-          [this](const std::optional<schemaregistry::rest::model::Schema> &s) {
+          [this](const schemaregistry::rest::model::Schema *s) {
               return getRecordName(s);
+          })),
+      generated_field_transformer_(std::make_shared<FieldTransformer>(
+          [](RuleContext &ctx, const std::string &rule_type,
+             const SerdeValue &value) {
+              return utils::transformFields(ctx, T::descriptor(), value);
           })) {
     std::vector<std::shared_ptr<RuleExecutor>> executors;
     if (rule_registry) {
@@ -133,6 +150,19 @@ inline ProtobufDeserializer<T>::ProtobufDeserializer(
 template <typename T>
 inline std::unique_ptr<T> ProtobufDeserializer<T>::deserialize(
     const SerializationContext &ctx, const std::vector<uint8_t> &data) {
+    return deserialize(ctx, data.data(), data.size());
+}
+
+template <typename T>
+inline std::unique_ptr<T> ProtobufDeserializer<T>::deserialize(
+    const SerializationContext &ctx, const uint8_t *data, size_t size) {
+    return std::unique_ptr<T>(deserialize(ctx, data, size, nullptr));
+}
+
+template <typename T>
+inline T *ProtobufDeserializer<T>::deserialize(
+    const SerializationContext &ctx, const uint8_t *data, size_t size,
+    google::protobuf::Arena *arena) {
     using namespace schemaregistry::serdes;
     using namespace schemaregistry::serdes::protobuf;
 
@@ -140,7 +170,7 @@ inline std::unique_ptr<T> ProtobufDeserializer<T>::deserialize(
     // Topic strategy works immediately; Record/TopicRecord will be recomputed
     // once we have the writer schema with the actual message name.
     auto initial_subject =
-        subject_name_strategy_(ctx.topic, ctx.serde_type, std::nullopt);
+        subject_name_strategy_(ctx.topic, ctx.serde_type, nullptr);
     std::optional<schemaregistry::rest::model::RegisteredSchema> latest_schema;
 
     if (initial_subject.has_value()) {
@@ -157,30 +187,22 @@ inline std::unique_ptr<T> ProtobufDeserializer<T>::deserialize(
     }
 
     SchemaId schema_id(SerdeFormat::Protobuf);
-    size_t bytes_read =
-        base_->getConfig().schema_id_deserializer(data, ctx, schema_id);
+    size_t bytes_read = readSchemaId(base_->getConfig().schema_id_deserializer,
+                                     data, size, ctx, schema_id);
     std::vector<int32_t> msg_index =
         schema_id.getMessageIndexes().value_or(std::vector<int32_t>{});
 
-    std::vector<uint8_t> remaining_data(data.begin() + bytes_read, data.end());
+    // The payload is parsed in place
+    const uint8_t *payload = data + bytes_read;
+    size_t payload_size = size - bytes_read;
 
-    auto writer_schema_raw =
-        base_->getWriterSchema(schema_id, initial_subject, "serialized");
-    auto [writer_schema, pool_ptr] = serde_->getParsedSchema(
-        writer_schema_raw, base_->getSerde().getClient());
-    if (!writer_schema) {
-        throw ProtobufError("Failed to parse writer schema");
-    }
-
-    const auto *writer_desc =
-        utils::getMessageDescriptorByIndex(pool_ptr, writer_schema, msg_index);
-    if (!writer_desc) {
-        throw ProtobufError("Failed to get writer message descriptor");
-    }
+    auto writer_schema_ptr =
+        base_->getWriterSchemaHandle(schema_id, initial_subject, "serialized");
+    const auto &writer_schema_raw = *writer_schema_ptr;
 
     // Recompute subject with writer schema for Record/TopicRecord strategies.
     auto subject_opt = subject_name_strategy_(
-        ctx.topic, ctx.serde_type, std::make_optional(writer_schema_raw));
+        ctx.topic, ctx.serde_type, &writer_schema_raw);
     if (!subject_opt.has_value()) {
         throw SerializationError("Subject name could not be determined");
     }
@@ -199,135 +221,149 @@ inline std::unique_ptr<T> ProtobufDeserializer<T>::deserialize(
         }
     }
 
-    std::vector<uint8_t> processed_data = remaining_data;
-
     // Handle encoding rules on the writer schema
+    std::vector<uint8_t> processed_data;
     if (auto rule_set_opt = writer_schema_raw.getRuleSet();
         rule_set_opt && rule_set_opt->getEncodingRules()) {
-        auto bytes_val =
-            SerdeValue::newBytes(SerdeFormat::Protobuf, processed_data);
+        auto bytes_val = SerdeValue::newBytes(
+            SerdeFormat::Protobuf,
+            std::vector<uint8_t>(payload, payload + payload_size));
         auto res_val = base_->getSerde().executeRulesWithPhase(
-            ctx, subject, Phase::Encoding, Mode::Read, std::nullopt,
-            std::make_optional(writer_schema_raw), *bytes_val, {});
+            ctx, subject, Phase::Encoding, Mode::Read, nullptr,
+            &writer_schema_raw, *bytes_val, {});
         processed_data = res_val->asBytes();
+        payload = processed_data.data();
+        payload_size = processed_data.size();
     }
 
     // Determine reader schema and possible migrations
-    std::vector<Migration> migrations;
-    schemaregistry::rest::model::Schema reader_schema_raw;
-    const google::protobuf::FileDescriptor *reader_schema_fd;
-
+    std::shared_ptr<const std::vector<Migration>> migrations;
+    std::shared_ptr<const schemaregistry::rest::model::Schema>
+        reader_schema_ptr;
     if (latest_schema) {
         migrations = base_->getSerde().getMigrations(
             subject, writer_schema_raw, *latest_schema, std::nullopt);
-        reader_schema_raw = latest_schema->toSchema();
-        std::tie(reader_schema_fd, std::ignore) = serde_->getParsedSchema(
-            reader_schema_raw, base_->getSerde().getClient());
+        reader_schema_ptr = latest_schema->getSchemaHandle();
     } else {
-        reader_schema_raw = writer_schema_raw;
-        reader_schema_fd = writer_schema;
+        reader_schema_ptr = writer_schema_ptr;
     }
+    const auto &reader_schema_raw = *reader_schema_ptr;
 
-    // Determine reader descriptor
-    const google::protobuf::Descriptor *reader_desc =
-        utils::getMessageDescriptorByIndex(pool_ptr, reader_schema_fd, {0});
-    if (const auto *same_name =
-            pool_ptr->FindMessageTypeByName(writer_desc->full_name());
-        same_name) {
-        reader_desc = same_name;
-    }
+    // Descriptors and prototypes are resolved once per writer schema,
+    // message indexes and reader schema
+    auto plan = serde_->getDecodePlan(writer_schema_raw, msg_index,
+                                      reader_schema_raw,
+                                      base_->getSerde().getClient());
 
-    google::protobuf::DynamicMessageFactory factory(pool_ptr);
-    std::unique_ptr<google::protobuf::Message> msg;
+    const auto &rule_set = reader_schema_raw.getRuleSet();
+    bool has_domain_rules = rule_set.has_value() &&
+                            rule_set->getDomainRules().has_value() &&
+                            !rule_set->getDomainRules()->empty();
+    bool has_migrations = migrations && !migrations->empty();
 
-    if (!migrations.empty()) {
+    std::unique_ptr<google::protobuf::Message> msg;
+    auto field_transformer = plan->field_transformer;
+
+    if (!has_migrations &&
+        serde_->isWireCompatible(plan->reader_descriptor, T::descriptor())) {
+        // The reader schema is that of T, so the payload is parsed into T
+        // directly and field rules run on it
+        if (!has_domain_rules) {
+            T *out_msg = google::protobuf::Arena::Create<T>(arena);
+            std::unique_ptr<T> owned(arena ? nullptr : out_msg);
+            if (!out_msg->ParseFromArray(payload,
+                                         static_cast<int>(payload_size))) {
+                throw ProtobufError(
+                    "Failed to parse protobuf message from binary data");
+            }
+            owned.release();
+            return out_msg;
+        }
+        msg = std::make_unique<T>();
+        if (!msg->ParseFromArray(payload, static_cast<int>(payload_size))) {
+            throw ProtobufError(
+                "Failed to parse protobuf message from binary data");
+        }
+        field_transformer = generated_field_transformer_;
+    } else if (has_migrations) {
         // Parse writer message first
-        const auto *writer_prototype = factory.GetPrototype(writer_desc);
-        msg =
-            std::unique_ptr<google::protobuf::Message>(writer_prototype->New());
-        if (!msg->ParseFromArray(processed_data.data(),
-                                 static_cast<int>(processed_data.size()))) {
+        msg = std::unique_ptr<google::protobuf::Message>(
+            plan->writer_prototype->New());
+        if (!msg->ParseFromArray(payload, static_cast<int>(payload_size))) {
             throw ProtobufError(
                 "Failed to parse protobuf message from binary data");
         }
 
         // Convert to JSON for migration
-        std::string json_str;
-        if (!google::protobuf::util::MessageToJsonString(*msg, &json_str)
-                 .ok()) {
-            throw ProtobufError(
-                "Failed to convert message to JSON during migration");
-        }
-        auto json_val = nlohmann::json::parse(json_str);
-        auto serde_json = SerdeValue::newJson(SerdeFormat::Json, json_val);
+        auto serde_json =
+            SerdeValue::newJson(SerdeFormat::Json, utils::messageToJson(*msg));
         auto migrated_val = base_->getSerde().executeMigrations(
-            ctx, subject, migrations, *serde_json);
+            ctx, subject, *migrations, *serde_json);
 
         if (migrated_val->getFormat() != SerdeFormat::Json) {
             throw ProtobufError("Expected JSON value after migrations");
         }
-        std::string migrated_json = migrated_val->asJson().dump();
-
-        // Parse back to reader message type
-        const auto *reader_prototype = factory.GetPrototype(reader_desc);
-        msg =
-            std::unique_ptr<google::protobuf::Message>(reader_prototype->New());
-        google::protobuf::util::JsonParseOptions opts;
-        if (!google::protobuf::util::JsonStringToMessage(migrated_json,
-                                                         msg.get(), opts)
-                 .ok()) {
-            throw ProtobufError(
-                "Failed to convert migrated JSON back to protobuf");
-        }
+
+        // Convert back to reader message type
+        msg = std::unique_ptr<google::protobuf::Message>(
+            plan->reader_prototype->New());
+        utils::jsonToMessage(migrated_val->asJson(), msg.get());
     } else {
-        const auto *reader_proto = factory.GetPrototype(reader_desc);
-        msg = std::unique_ptr<google::protobuf::Message>(reader_proto->New());
-        if (!msg->ParseFromArray(processed_data.data(),
-                                 static_cast<int>(processed_data.size()))) {
+        msg = std::unique_ptr<google::protobuf::Message>(
+            plan->reader_prototype->New());
+        if (!msg->ParseFromArray(payload, static_cast<int>(payload_size))) {
             throw ProtobufError(
                 "Failed to parse protobuf message from binary data");
         }
     }
 
     // Execute field-level rules
-    auto field_tf = [reader_desc](RuleContext &rctx,
-                                  const std::string &rule_type,
-                                  const SerdeValue &val) {
-        return utils::transformFields(rctx, reader_desc, val);
-    };
-
-    auto msg_copy = std::unique_ptr<google::protobuf::Message>(msg->New());
-    msg_copy->CopyFrom(*msg);
-    auto protobuf_val = makeProtobufValue(ProtobufVariant(std::move(msg_copy)));
-
-    auto result_val = base_->getSerde().executeRules(
-        ctx, subject, Mode::Read, std::nullopt,
-        std::make_optional(reader_schema_raw), *protobuf_val, {},
-        std::make_shared<FieldTransformer>(field_tf));
-
-    if (result_val->getFormat() != SerdeFormat::Protobuf) {
-        throw ProtobufError("Expected protobuf value after rule execution");
+    if (has_domain_rules) {
+        auto protobuf_val = makeProtobufValue(ProtobufVariant(std::move(msg)));
+        auto result_val = base_->getSerde().executeRules(
+            ctx, subject, Mode::Read, nullptr, &reader_schema_raw,
+            *protobuf_val, {}, field_transformer);
+
+        if (result_val->getFormat() != SerdeFormat::Protobuf) {
+            throw ProtobufError(
+                "Expected protobuf value after rule execution");
+        }
+        auto &proto_variant = asProtobuf(*result_val);
+        if (proto_variant.type != ProtobufVariant::ValueType::Message) {
+            throw ProtobufError(
+                "Expected message variant but got different type");
+        }
+        msg = std::move(
+            proto_variant
+                .template get<std::unique_ptr<google::protobuf::Message>>());
     }
 
-    // Copy final message into a newly created T instance
-    auto &proto_variant = asProtobuf(*result_val);
-    if (proto_variant.type != ProtobufVariant::ValueType::Message) {
-        throw ProtobufError("Expected message variant but got different type");
+    // Messages parsed into T above are handed over as they are
+    if (auto *typed_msg =
+            google::protobuf::DynamicCastToGenerated<T>(msg.get())) {
+        if (!arena) {
+            msg.release();
+            return typed_msg;
+        }
+        T *out_msg = google::protobuf::Arena::Create<T>(arena);
+        out_msg->CopyFrom(*typed_msg);
+        return out_msg;
     }
-    google::protobuf::Message &final_msg =
-        *proto_variant
-             .template get<std::unique_ptr<google::protobuf::Message>>();
-    auto out_msg = std::make_unique<T>();
+
+    // Copy final message into a newly created T instance
+    T *out_msg = google::protobuf::Arena::Create<T>(arena);
+    std::unique_ptr<T> owned(arena ? nullptr : out_msg);
 
     // Don't use CopyFrom, as the descriptors are from different pools
     std::string serialized_data;
-    if (final_msg.SerializeToString(&serialized_data)) {
+    if (msg->SerializeToString(&serialized_data)) {
         // Deserialize into the specific message type
         if (!out_msg->ParseFromString(serialized_data)) {
             throw ProtobufError("Failed to parse protobuf message");
         }
     }
 
+    owned.release();
     return out_msg;
 }
 
@@ -17,11 +17,14 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "schemaregistry/rest/RestException.h"
+#include "schemaregistry/rest/SchemaInterner.h"
 #include "schemaregistry/serdes/Serde.h"
 #include "schemaregistry/serdes/SerdeConfig.h"
 #include "schemaregistry/serdes/SerdeError.h"
@@ -77,6 +80,14 @@ class ProtobufSerializer {
     std::vector<uint8_t> serialize(const SerializationContext &ctx,
                                    const T &message);
 
+    /**
+     * Serialize a protobuf message into a caller-owned buffer, replacing its
+     * contents but reusing its capacity. Without encoding rules, the message
+     * is encoded directly after the schema ID header.
+     */
+    void serialize(const SerializationContext &ctx, const T &message,
+                   std::vector<uint8_t> &out);
+
     /**
      * Serialize with file descriptor set
      */
@@ -92,14 +103,56 @@ class ProtobufSerializer {
         const SerializationContext &ctx, const T &message,
         const google::protobuf::Descriptor *descriptor);
 
+    /**
+     * Close the serializer and cleanup resources
+     */
+    void close();
+
   private:
+    // Bound on the schemas kept for generated message types, least recently
+    // used evicted first
+    static constexpr size_t kMaxDescriptorSchemas = 1000;
+
+    // Plans are built for the descriptor of the messages written
+    using ProtobufPlan = SerializerPlan<const google::protobuf::Descriptor *>;
+
+    // Schema rendered from a generated message type, with its references
+    // registered, and the ids it was registered or looked up with
+    struct DescriptorSchema {
+        std::shared_ptr<const schemaregistry::rest::model::Schema> schema;
+        // Ids by subject, message indexes included
+        absl::flat_hash_map<std::string, SchemaId> ids;
+    };
+
     std::optional<schemaregistry::rest::model::Schema> schema_;
     std::shared_ptr<BaseSerializer> base_;
     std::unique_ptr<ProtobufSerde> serde_;
     ReferenceSubjectNameStrategy reference_subject_name_strategy_;
     SubjectNameStrategyFunc subject_name_strategy_;
+    // Associated subjects may change over time, other strategies only
+    // depend on the topic and the serializer's own schema
+    bool cache_subject_;
+    SerializerPlanCache<const google::protobuf::Descriptor *> plans_;
+    // Generated message types outlive the serializer, so their schemas are
+    // kept across plan rebuilds, by descriptor and serde type. Entries are
+    // copied on update, the mutex serializing updates.
+    std::mutex descriptor_schemas_mutex_;
+    schemaregistry::rest::TtlLruCache<
+        std::pair<const google::protobuf::Descriptor *, SerdeType>,
+        std::shared_ptr<const DescriptorSchema>>
+        descriptor_schemas_{kMaxDescriptorSchemas};
 
     // Helper methods
+    void serializeInto(const SerializationContext &ctx, const T &message,
+                       const google::protobuf::Descriptor *descriptor,
+                       std::vector<uint8_t> &out);
+
+    std::shared_ptr<const ProtobufPlan> compilePlan(
+        const SerializationContext &ctx, const std::string &subject,
+        const std::optional<schemaregistry::rest::model::RegisteredSchema>
+            &latest_schema,
+        const google::protobuf::Descriptor *descriptor);
+
     std::vector<int32_t> toIndexArray(
         const google::protobuf::Descriptor *descriptor);
 
@@ -110,7 +163,7 @@ class ProtobufSerializer {
     void validateSchema(const schemaregistry::rest::model::Schema &schema);
 
     std::string getRecordName(
-        const std::optional<schemaregistry::rest::model::Schema> &schema);
+        const schemaregistry::rest::model::Schema *schema);
 };
 
 }  // namespace schemaregistry::serdes::protobuf
@@ -142,9 +195,11 @@ inline ProtobufSerializer<T>::ProtobufSerializer(
           config.subject_name_strategy_type,
           base_->getSerde().getClient(),
           config.subject_name_strategy_config,
-          [this](const std::optional<schemaregistry::rest::model::Schema> &s) {
+          [this](const schemaregistry::rest::model::Schema *s) {
               return getRecordName(s);
-          })) {
+          })),
+      cache_subject_(config.subject_name_strategy_type !=
+                     SubjectNameStrategyType::Associated) {
     std::vector<std::shared_ptr<RuleExecutor>> executors;
     if (rule_registry) {
         executors = rule_registry->getExecutors();
@@ -177,9 +232,11 @@ inline ProtobufSerializer<T>::ProtobufSerializer(
           config.subject_name_strategy_type,
           base_->getSerde().getClient(),
           config.subject_name_strategy_config,
-          [this](const std::optional<schemaregistry::rest::model::Schema> &s) {
+          [this](const schemaregistry::rest::model::Schema *s) {
               return getRecordName(s);
-          })) {
+          })),
+      cache_subject_(config.subject_name_strategy_type !=
+                     SubjectNameStrategyType::Associated) {
     std::vector<std::shared_ptr<RuleExecutor>> executors;
     if (rule_registry) {
         executors = rule_registry->getExecutors();
@@ -204,6 +261,13 @@ inline std::vector<uint8_t> ProtobufSerializer<T>::serialize(
                                           message.GetDescriptor());
 }
 
+template <typename T>
+inline void ProtobufSerializer<T>::serialize(const SerializationContext &ctx,
+                                             const T &message,
+                                             std::vector<uint8_t> &out) {
+    serializeInto(ctx, message, message.GetDescriptor(), out);
+}
+
 template <typename T>
 inline std::vector<uint8_t>
 ProtobufSerializer<T>::serializeWithFileDescriptorSet(
@@ -228,8 +292,8 @@ ProtobufSerializer<T>::serializeWithFileDescriptorSet(
 
 template <typename T>
 inline std::string ProtobufSerializer<T>::getRecordName(
-    const std::optional<schemaregistry::rest::model::Schema> &schema) {
-    if (!schema.has_value()) return "";
+    const schemaregistry::rest::model::Schema *schema) {
+    if (!schema) return "";
     auto [file_desc, pool] =
         serde_->getParsedSchema(*schema, base_->getSerde().getClient());
     if (file_desc && file_desc->message_type_count() > 0) {
@@ -238,6 +302,13 @@ inline std::string ProtobufSerializer<T>::getRecordName(
     throw ProtobufError("Could not determine record name from schema");
 }
 
+template <typename T>
+inline void ProtobufSerializer<T>::close() {
+    plans_.clear();
+    descriptor_schemas_.clear();
+    serde_->clear();
+}
+
 // Forward declaration for transformFields helper that lives in
 // ProtobufUtils.cpp
 namespace utils {
@@ -252,23 +323,45 @@ inline std::vector<uint8_t>
 ProtobufSerializer<T>::serializeWithMessageDescriptor(
     const SerializationContext &ctx, const T &message,
     const google::protobuf::Descriptor *descriptor) {
+    std::vector<uint8_t> out;
+    serializeInto(ctx, message, descriptor, out);
+    return out;
+}
+
+template <typename T>
+inline void ProtobufSerializer<T>::serializeInto(
+    const SerializationContext &ctx, const T &message,
+    const google::protobuf::Descriptor *descriptor,
+    std::vector<uint8_t> &out) {
     using namespace schemaregistry::serdes;
     using namespace schemaregistry::serdes::protobuf;
     using schemaregistry::rest::model::RegisteredSchema;
 
-    // Resolve the subject name using the configured strategy.
-    auto subject_opt =
-        subject_name_strategy_(ctx.topic, ctx.serde_type, schema_);
-    if (!subject_opt.has_value()) {
-        throw SerializationError("Could not determine subject for serialization");
+    // Only descriptors of generated types are known to outlive the plan;
+    // others, e.g. built from a file descriptor set, get a plan per call.
+    bool cacheable = descriptor->file()->pool() ==
+                     google::protobuf::DescriptorPool::generated_pool();
+    auto plan = cacheable ? plans_.get(ctx.topic, ctx.serde_type) : nullptr;
+
+    // Resolve the subject name using the configured strategy, unless the
+    // plan already resolved it with a strategy that cannot change.
+    std::optional<std::string> resolved_subject;
+    if (!plan || !cache_subject_) {
+        resolved_subject =
+            subject_name_strategy_(ctx.topic, ctx.serde_type,
+                                   schema_ ? &*schema_ : nullptr);
+        if (!resolved_subject.has_value()) {
+            throw SerializationError(
+                "Could not determine subject for serialization");
+        }
     }
-    const std::string &subject = subject_opt.value();
+    // Copied, as a stale plan is released once its replacement is cached
+    std::string subject = resolved_subject.has_value()
+                              ? std::move(*resolved_subject)
+                              : plan->subject;
 
-    // Retrieve (or register) the schema in the registry.
-    SchemaId schema_id(SerdeFormat::Protobuf);
+    // Retrieve the schema to use from the registry, if configured.
     std::optional<RegisteredSchema> latest_schema;
-    std::vector<uint8_t> encoded_bytes;
-
     try {
         latest_schema = base_->getSerde().getReaderSchema(
             subject, "serialized", base_->getConfig().use_schema);
@@ -276,39 +369,43 @@ ProtobufSerializer<T>::serializeWithMessageDescriptor(
         if (e.getStatus() != 404) {
             throw;
         }
-        // Not found – handled below.
+        // Not found – handled when compiling the plan.
     }
 
-    if (latest_schema) {
-        // Path when writer schema is known already to the registry.
-        schema_id = SchemaId(SerdeFormat::Protobuf, latest_schema->getId(),
-                             latest_schema->getGuid(), std::nullopt);
-
-        auto schema = latest_schema->toSchema();
-        auto [fd, pool] =
-            serde_->getParsedSchema(schema, base_->getSerde().getClient());
-
-        auto field_tf = [descriptor](RuleContext &rctx,
-                                     const std::string &rule_type,
-                                     const SerdeValue &val) {
-            return utils::transformFields(rctx, descriptor, val);
-        };
+    // Rebuild the plan if the message type or the latest schema changed.
+    if (!plan || plan->parsed != descriptor ||
+        !plan->isCurrent(subject, latest_schema)) {
+        plan = compilePlan(ctx, subject, latest_schema, descriptor);
+        if (cacheable) {
+            plans_.put(ctx.topic, ctx.serde_type, plan);
+        }
+    }
 
-        google::protobuf::DynamicMessageFactory msg_factory;
-        auto *dynamic_proto = msg_factory.GetPrototype(descriptor);
+    // Message to encode, rewritten by domain rules if there are any. Other
+    // descriptors than generated ones get a factory of their own, which
+    // outlives the messages it creates.
+    const google::protobuf::Message *encoded_msg = &message;
+    std::unique_ptr<google::protobuf::DynamicMessageFactory> msg_factory;
+    std::unique_ptr<SerdeValue> serde_value;
+    if (plan->has_domain_rules) {
+        // Run the rules on a dynamic copy of the message.
+        const google::protobuf::Message *dynamic_proto;
+        if (cacheable) {
+            dynamic_proto = serde_->getPrototype(descriptor);
+        } else {
+            msg_factory =
+                std::make_unique<google::protobuf::DynamicMessageFactory>();
+            dynamic_proto = msg_factory->GetPrototype(descriptor);
+        }
         auto dynamic_msg =
             std::unique_ptr<google::protobuf::Message>(dynamic_proto->New());
         dynamic_msg->CopyFrom(message);
-
-        auto dynamic_msg_copy =
-            std::unique_ptr<google::protobuf::Message>(dynamic_msg->New());
-        dynamic_msg_copy->CopyFrom(*dynamic_msg);
         auto protobuf_value = protobuf::makeProtobufValue(
-            ProtobufVariant(std::move(dynamic_msg_copy)));
+            ProtobufVariant(std::move(dynamic_msg)));
 
-        auto serde_value = base_->getSerde().executeRules(
-            ctx, subject, Mode::Write, std::nullopt, std::make_optional(schema),
-            *protobuf_value, {}, std::make_shared<FieldTransformer>(field_tf));
+        serde_value = base_->getSerde().executeRules(
+            ctx, subject, Mode::Write, nullptr, plan->schema.get(),
+            *protobuf_value, {}, plan->field_transformer);
 
         if (serde_value->getFormat() != SerdeFormat::Protobuf) {
             throw ProtobufError(
@@ -317,65 +414,149 @@ ProtobufSerializer<T>::serializeWithMessageDescriptor(
 
         // Convert the serde_value to a Protobuf message
         auto &proto_variant = asProtobuf(*serde_value);
-        auto &transformed_msg =
-            *proto_variant
-                 .template get<std::unique_ptr<google::protobuf::Message>>();
-        encoded_bytes.resize(
-            static_cast<size_t>(transformed_msg.ByteSizeLong()));
-        if (!transformed_msg.SerializeToArray(
-                encoded_bytes.data(), static_cast<int>(encoded_bytes.size()))) {
-            throw ProtobufError("Failed to serialize protobuf message");
-        }
-    } else {
-        // Schema not present in registry – create & register or look it up.
-        auto refs = resolveDependencies(ctx, descriptor->file());
+        encoded_msg =
+            proto_variant
+                .template get<std::unique_ptr<google::protobuf::Message>>()
+                .get();
+    }
 
-        schemaregistry::rest::model::Schema schema;
-        schema.setSchemaType("PROTOBUF");
-        schema.setReferences(refs);
-        schema.setSchema(utils::schemaToString(descriptor->file()));
+    // Encode right after the schema ID prefix, unless encoding rules rewrite
+    // the payload.
+    bool prefixed = plan->id_prefix.has_value() && !plan->has_encoding_rules;
+    std::vector<uint8_t> encoded_bytes;
+    auto &buffer = prefixed ? out : encoded_bytes;
+    if (prefixed) {
+        buffer.assign(plan->id_prefix->begin(), plan->id_prefix->end());
+    }
+    size_t offset = buffer.size();
+    size_t size = static_cast<size_t>(encoded_msg->ByteSizeLong());
+    buffer.resize(offset + size);
+    if (!encoded_msg->SerializeToArray(buffer.data() + offset,
+                                       static_cast<int>(size))) {
+        throw ProtobufError("Failed to serialize protobuf message");
+    }
+    if (prefixed) {
+        return;
+    }
 
-        if (base_->getConfig().auto_register_schemas) {
-            auto reg = base_->getSerde().getClient()->registerSchema(
-                subject, schema, base_->getConfig().normalize_schemas);
-            schema_id = SchemaId(SerdeFormat::Protobuf, reg.getId(),
-                                 reg.getGuid(), std::nullopt);
-        } else {
-            auto reg = base_->getSerde().getClient()->getBySchema(
-                subject, schema, base_->getConfig().normalize_schemas, false);
-            schema_id = SchemaId(SerdeFormat::Protobuf, reg.getId(),
-                                 reg.getGuid(), std::nullopt);
+    // Apply encoding-phase rules if they exist.
+    if (plan->has_encoding_rules) {
+        auto bytes_value =
+            SerdeValue::newBytes(SerdeFormat::Protobuf, encoded_bytes);
+        auto result = base_->getSerde().executeRulesWithPhase(
+            ctx, subject, Phase::Encoding, Mode::Write, nullptr,
+            plan->schema.get(), *bytes_value, {});
+        encoded_bytes = result->asBytes();
+    }
+
+    // Final framing (schema id serialization).
+    const auto &id_serializer = base_->getConfig().schema_id_serializer;
+    out = id_serializer(encoded_bytes, ctx, plan->schema_id);
+}
+
+template <typename T>
+inline std::shared_ptr<const typename ProtobufSerializer<T>::ProtobufPlan>
+ProtobufSerializer<T>::compilePlan(
+    const SerializationContext &ctx, const std::string &subject,
+    const std::optional<schemaregistry::rest::model::RegisteredSchema>
+        &latest_schema,
+    const google::protobuf::Descriptor *descriptor) {
+    auto plan = std::make_shared<ProtobufPlan>();
+    plan->subject = subject;
+    plan->parsed = descriptor;
+
+    if (latest_schema) {
+        // Path when writer schema is known already to the registry.
+        plan->latest = latest_schema->getSchemaHandle();
+        plan->schema = plan->latest;
+        plan->schema_id =
+            SchemaId(SerdeFormat::Protobuf, latest_schema->getId(),
+                     latest_schema->getGuid(), std::nullopt);
+
+        // Parse once, so that an invalid schema fails here as before.
+        serde_->getParsedSchema(*plan->schema, base_->getSerde().getClient());
+
+        plan->field_transformer = std::make_shared<FieldTransformer>(
+            [descriptor](RuleContext &rctx, const std::string &rule_type,
+                         const SerdeValue &val) {
+                return utils::transformFields(rctx, descriptor, val);
+            });
+
+        const auto &rule_set = plan->schema->getRuleSet();
+        plan->has_domain_rules = rule_set.has_value() &&
+                                 rule_set->getDomainRules().has_value() &&
+                                 !rule_set->getDomainRules()->empty();
+        plan->has_encoding_rules =
+            rule_set.has_value() && rule_set->getEncodingRules().has_value();
+
+        // Store message index information (for nested msgs).
+        plan->schema_id.setMessageIndexes(toIndexArray(descriptor));
+    } else {
+        // Schema not present in registry – create & register or look it up,
+        // once per subject for generated message types.
+        bool cacheable = descriptor->file()->pool() ==
+                         google::protobuf::DescriptorPool::generated_pool();
+        auto key = std::make_pair(descriptor, ctx.serde_type);
+        bool registered = false;
+        if (cacheable) {
+            if (auto cached = descriptor_schemas_.get(key);
+                cached.has_value()) {
+                const auto &entry = **cached;
+                plan->schema = entry.schema;
+                auto id_it = entry.ids.find(subject);
+                if (id_it != entry.ids.end()) {
+                    plan->schema_id = id_it->second;
+                    registered = true;
+                }
+            }
         }
 
-        encoded_bytes.resize(static_cast<size_t>(message.ByteSizeLong()));
-        if (!message.SerializeToArray(encoded_bytes.data(),
-                                      static_cast<int>(encoded_bytes.size()))) {
-            throw ProtobufError("Failed to serialize protobuf message");
+        if (!plan->schema) {
+            // Render the schema, registering its references
+            auto refs = resolveDependencies(ctx, descriptor->file());
+
+            schemaregistry::rest::model::Schema schema;
+            schema.setSchemaType("PROTOBUF");
+            schema.setReferences(refs);
+            schema.setSchema(utils::schemaToString(descriptor->file()));
+            plan->schema =
+                schemaregistry::rest::SchemaInterner::global().intern(schema);
         }
-    }
 
-    // Apply encoding-phase rules if they exist.
-    if (latest_schema) {
-        auto schema = latest_schema->toSchema();
-        if (schema.getRuleSet().has_value()) {
-            auto rule_set = schema.getRuleSet().value();
-            if (rule_set.getEncodingRules().has_value()) {
-                auto bytes_value =
-                    SerdeValue::newBytes(SerdeFormat::Protobuf, encoded_bytes);
-                auto result = base_->getSerde().executeRulesWithPhase(
-                    ctx, subject, Phase::Encoding, Mode::Write, std::nullopt,
-                    std::make_optional(schema), *bytes_value, {});
-                encoded_bytes = result->asBytes();
+        if (!registered) {
+            schemaregistry::rest::model::RegisteredSchema reg;
+            if (base_->getConfig().auto_register_schemas) {
+                reg = base_->getSerde().getClient()->registerSchema(
+                    subject, *plan->schema,
+                    base_->getConfig().normalize_schemas);
+            } else {
+                reg = base_->getSerde().getClient()->getBySchema(
+                    subject, *plan->schema,
+                    base_->getConfig().normalize_schemas, false);
+            }
+            plan->schema_id = SchemaId(SerdeFormat::Protobuf, reg.getId(),
+                                       reg.getGuid(), std::nullopt);
+
+            // Store message index information (for nested msgs).
+            plan->schema_id.setMessageIndexes(toIndexArray(descriptor));
+
+            if (cacheable) {
+                std::lock_guard<std::mutex> lock(descriptor_schemas_mutex_);
+                auto entry = std::make_shared<DescriptorSchema>();
+                if (auto cached = descriptor_schemas_.get(key);
+                    cached.has_value()) {
+                    *entry = **cached;
+                }
+                entry->schema = plan->schema;
+                entry->ids.insert_or_assign(subject, plan->schema_id);
+                descriptor_schemas_.put(key, entry);
             }
         }
     }
 
-    // Store message index information (for nested msgs).
-    schema_id.setMessageIndexes(toIndexArray(descriptor));
-
-    // Final framing (schema id serialization).
-    auto id_serializer = base_->getConfig().schema_id_serializer;
-    return id_serializer(encoded_bytes, ctx, schema_id);
+    plan->id_prefix = schemaIdPrefix(base_->getConfig().schema_id_serializer,
+                                     plan->schema_id);
+    return plan;
 }
 
 template <typename T>
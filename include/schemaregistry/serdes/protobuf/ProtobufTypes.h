@@ -1,6 +1,7 @@
 #pragma once
 
 #include <google/protobuf/descriptor.h>
+#include <google/protobuf/dynamic_message.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/util/json_util.h>
 
@@ -8,20 +9,38 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_set>
 #include <variant>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "schemaregistry/rest/ISchemaRegistryClient.h"
+#include "schemaregistry/rest/TtlLruCache.h"
 #include "schemaregistry/serdes/SerdeError.h"
 #include "schemaregistry/serdes/SerdeTypes.h"
 
 namespace schemaregistry::serdes::protobuf {
 
+/**
+ * How messages written with one schema and message index are read with a
+ * reader schema, resolved once and shared by all such messages
+ */
+struct ProtobufDecodePlan {
+    const google::protobuf::Descriptor *writer_descriptor = nullptr;
+    const google::protobuf::Descriptor *reader_descriptor = nullptr;
+    // Prototypes of the dynamic messages of both descriptors
+    const google::protobuf::Message *writer_prototype = nullptr;
+    const google::protobuf::Message *reader_prototype = nullptr;
+    // Applies field rules to messages of the reader descriptor
+    std::shared_ptr<FieldTransformer> field_transformer;
+};
+
 /**
  * Protobuf schema caching and parsing class
  * Based on ProtobufSerde struct from protobuf.rs (converted to synchronous)
@@ -38,32 +57,89 @@ class ProtobufSerde {
         const schemaregistry::rest::model::Schema &schema,
         std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client);
 
+    /**
+     * Get cached decode plan or resolve and cache it
+     * @param writer Schema the message is written with
+     * @param msg_index Message indexes of the message type in writer
+     * @param reader Schema the message is read with, writer if not evolving
+     * @param client Client for resolving references
+     * @return Descriptors and prototypes to read the message with
+     */
+    std::shared_ptr<const ProtobufDecodePlan> getDecodePlan(
+        const schemaregistry::rest::model::Schema &writer,
+        const std::vector<int32_t> &msg_index,
+        const schemaregistry::rest::model::Schema &reader,
+        std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client);
+
+    /**
+     * Get the prototype of the dynamic messages of a descriptor
+     * @param descriptor Descriptor of a generated type or of a parsed schema,
+     * either of which outlives the prototype until clear()
+     */
+    const google::protobuf::Message *getPrototype(
+        const google::protobuf::Descriptor *descriptor);
+
+    /**
+     * Check if messages of a parsed schema can be parsed directly into a
+     * generated type, memoized until clear()
+     * @param descriptor Descriptor of a parsed schema
+     * @param generated Descriptor of the generated type
+     */
+    bool isWireCompatible(const google::protobuf::Descriptor *descriptor,
+                          const google::protobuf::Descriptor *generated);
+
     // Clear cache
     void clear();
 
   private:
-    // Cache for parsed schemas: Schema -> (FileDescriptor*, DescriptorPool)
-    std::unordered_map<
-        std::string,
-        std::pair<const google::protobuf::FileDescriptor *,
-                  std::unique_ptr<google::protobuf::DescriptorPool>>>
+    // Referenced files of a schema as (name, schema string), in the order
+    // they are built
+    using DependencyFiles = std::vector<std::pair<std::string, std::string>>;
+
+    struct ParsedSchema {
+        const google::protobuf::FileDescriptor *file = nullptr;
+        // Pool of the referenced files, shared by all schemas with the
+        // same referenced files
+        std::shared_ptr<const google::protobuf::DescriptorPool> dependencies;
+        std::unique_ptr<google::protobuf::DescriptorPool> pool;
+    };
+
+    // Cache for parsed schemas by content
+    absl::flat_hash_map<schemaregistry::rest::model::SchemaFingerprint,
+                        ParsedSchema>
         parsed_schemas_cache_;
 
+    // Prototypes refer to the descriptors of the pools above, so the
+    // factory is declared after them to be destroyed first
+    std::unique_ptr<google::protobuf::DynamicMessageFactory> message_factory_;
+
+    // Decode plans by writer schema, message indexes and reader schema
+    schemaregistry::rest::TtlLruCache<
+        std::tuple<schemaregistry::rest::model::SchemaFingerprint,
+                   std::vector<int32_t>,
+                   schemaregistry::rest::model::SchemaFingerprint>,
+        std::shared_ptr<const ProtobufDecodePlan>>
+        decode_plans_;
+
+    // Wire compatibility by parsed and generated descriptor
+    schemaregistry::rest::TtlLruCache<
+        std::pair<const google::protobuf::Descriptor *,
+                  const google::protobuf::Descriptor *>,
+        bool>
+        wire_compatible_;
+
     mutable std::mutex cache_mutex_;
 
     // Helper methods
     void resolveNamedSchema(
         const schemaregistry::rest::model::Schema &schema,
         std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client,
-        google::protobuf::DescriptorPool *pool,
-        std::unordered_set<std::string> &visited);
-
-    // Initialize descriptor pool with well-known types
-    void initPool(google::protobuf::DescriptorPool *pool);
+        DependencyFiles &files, std::unordered_set<std::string> &visited);
 
-    // Add file descriptor to pool
-    void addFileToPool(google::protobuf::DescriptorPool *pool,
-                       const google::protobuf::FileDescriptor *file_descriptor);
+    // Get the process-wide pool of referenced files, built on the pool of
+    // well-known types, or null without any
+    static std::shared_ptr<const google::protobuf::DescriptorPool>
+    getDependencyPool(const DependencyFiles &files);
 };
 
 // C++ variant representing protobuf values - type alias for map keys
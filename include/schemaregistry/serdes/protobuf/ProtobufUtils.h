@@ -54,6 +54,16 @@ std::optional<ProtobufVariant> transformFieldWithContext(
     const google::protobuf::Descriptor *desc,
     const google::protobuf::Message *message);
 
+/**
+ * Transform field with rule context, given the containing message seen by
+ * field rules, so that the fields of one message share a single copy of it
+ */
+std::optional<ProtobufVariant> transformFieldWithContext(
+    RuleContext &ctx, const google::protobuf::FieldDescriptor *fd,
+    const google::protobuf::Descriptor *desc,
+    const google::protobuf::Message *message,
+    const SerdeValue &containing_message);
+
 /**
  * Extract field value from protobuf message
  */
@@ -104,16 +114,27 @@ std::unordered_set<std::string> getInlineTags(
     const google::protobuf::FieldDescriptor *field_desc);
 
 /**
- * Protobuf Message to JSON conversion
+ * Check if messages of two descriptors, e.g. of a registered schema and of a
+ * generated type, have the same fields in the same declaration order, nested
+ * types and inline tags, so that either can be parsed from and transformed
+ * like the other
+ */
+bool isWireCompatible(const google::protobuf::Descriptor *descriptor,
+                      const google::protobuf::Descriptor *other);
+
+/**
+ * Convert a Protobuf message to JSON through reflection, following the
+ * proto3 JSON mapping: JSON field names, 64-bit integers as strings, enums
+ * by name, bytes as base64 and the JSON forms of well-known types
  */
 nlohmann::json messageToJson(const google::protobuf::Message &message);
 
 /**
- * JSON to Protobuf Message conversion
+ * Set the fields of a Protobuf message from JSON through reflection,
+ * accepting the proto3 JSON mapping produced by messageToJson
  */
-std::unique_ptr<google::protobuf::Message> jsonToMessage(
-    const nlohmann::json &json, const google::protobuf::Descriptor *descriptor,
-    const google::protobuf::DescriptorPool *pool);
+void jsonToMessage(const nlohmann::json &json,
+                   google::protobuf::Message *message);
 
 /**
  * Copy compatible fields between protobuf messages
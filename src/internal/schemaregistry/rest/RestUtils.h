@@ -0,0 +1,37 @@
+/**
+ * RestUtils
+ * Request helpers shared by the synchronous and asynchronous clients
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace schemaregistry::rest::utils {
+
+/**
+ * Percent-encode a string for use in a URL path or query
+ */
+std::string urlEncode(const std::string &str);
+
+/**
+ * Cache key for a latest-with-metadata lookup, independent of the order
+ * of the metadata entries
+ */
+std::string createMetadataKey(
+    const std::string &subject,
+    const std::unordered_map<std::string, std::string> &metadata);
+
+/**
+ * Key identifying a request, so that identical requests in flight at the
+ * same time can share a single round trip
+ */
+std::string createRequestKey(
+    const std::string &path, const std::string &method,
+    const std::vector<std::pair<std::string, std::string>> &query,
+    const std::string &body = "");
+
+}  // namespace schemaregistry::rest::utils
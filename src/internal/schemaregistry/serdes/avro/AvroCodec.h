@@ -0,0 +1,109 @@
+/**
+ * AvroCodec
+ * Avro binary encoding compiled from a schema into a flat program
+ */
+
+#pragma once
+
+#include <avro/Generic.hh>
+#include <avro/ValidSchema.hh>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+
+namespace schemaregistry::serdes::avro {
+
+/**
+ * Avro binary codec compiled from a schema
+ *
+ * The schema is flattened once into a program with one instruction per
+ * schema node. Records, arrays, maps and unions refer to the instructions
+ * of their children, and recursive types refer back to the instruction of
+ * their definition. Encoding and decoding interpret the program against a
+ * GenericDatum, appending to or reading from raw buffers directly, so that
+ * no encoder, decoder or stream is set up per call. A codec is immutable
+ * once compiled and may be shared by threads.
+ */
+class AvroCodec {
+  public:
+    /**
+     * Compile the codec of a schema
+     * @param schema Schema of the datums to encode and decode
+     */
+    explicit AvroCodec(const ::avro::ValidSchema &schema);
+
+    AvroCodec(const AvroCodec &) = delete;
+    AvroCodec &operator=(const AvroCodec &) = delete;
+
+    /**
+     * Get the schema the codec was compiled from
+     */
+    const ::avro::ValidSchema &getSchema() const { return schema_; }
+
+    /**
+     * Append the binary encoding of a datum to a buffer
+     * @param datum Datum of the codec's schema
+     * @param out Buffer to append to
+     */
+    void encode(const ::avro::GenericDatum &datum,
+                std::vector<uint8_t> &out) const;
+
+    /**
+     * Decode a datum of the codec's schema from a buffer
+     * @param data Serialized bytes
+     * @param size Number of serialized bytes
+     */
+    ::avro::GenericDatum decode(const uint8_t *data, size_t size) const;
+
+  private:
+    enum class Op : uint8_t {
+        Null,
+        Bool,
+        Int,
+        Long,
+        Float,
+        Double,
+        Bytes,
+        String,
+        Fixed,
+        Enum,
+        Record,
+        Array,
+        Map,
+        Union,
+    };
+
+    struct Instruction {
+        Op op;
+        // Fields of a record, branches of a union, size of a fixed or
+        // symbols of an enum
+        uint32_t count = 0;
+        // First child in children_ for records and unions, or the child
+        // instruction for arrays and maps
+        uint32_t operand = 0;
+    };
+
+    class Reader;
+
+    using NamedInstructions =
+        absl::flat_hash_map<const ::avro::Node *, uint32_t>;
+
+    static ::avro::Type typeOf(Op op);
+
+    uint32_t compile(const ::avro::NodePtr &node, NamedInstructions &named);
+    void encode(uint32_t pc, const ::avro::GenericDatum &datum,
+                std::vector<uint8_t> &out) const;
+    void decode(uint32_t pc, Reader &reader,
+                ::avro::GenericDatum &datum) const;
+
+    ::avro::ValidSchema schema_;
+    std::vector<Instruction> program_;
+    std::vector<uint32_t> children_;
+    // Schema node of each instruction, to create datums of array items and
+    // map values while decoding
+    std::vector<::avro::NodePtr> nodes_;
+};
+
+}  // namespace schemaregistry::serdes::avro
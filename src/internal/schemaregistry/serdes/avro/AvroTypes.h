@@ -13,13 +13,54 @@
 #include <nlohmann/json.hpp>
 #include <shared_mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "schemaregistry/rest/SchemaRegistryClient.h"
+#include "schemaregistry/serdes/FieldTagIndex.h"
 #include "schemaregistry/serdes/SerdeError.h"
 #include "schemaregistry/serdes/SerdeTypes.h"
+#include "schemaregistry/serdes/avro/AvroCodec.h"
 
 namespace schemaregistry::serdes::avro {
 
+/**
+ * Decoders of data written with one schema into datums of another schema
+ *
+ * Creating a resolving decoder builds the resolution grammar of the writer
+ * schema against the reader schema, so decoders are kept for reuse. A
+ * decoder holds parsing state and is used by one thread at a time:
+ * concurrent reads borrow distinct decoders, and a decoder is only created
+ * when all pooled ones are in use.
+ */
+class ResolvingDecoderPool {
+  public:
+    /**
+     * Constructor
+     * @param writer_schema Schema the data is written with
+     * @param reader_schema Schema of the datums to decode
+     */
+    ResolvingDecoderPool(::avro::ValidSchema writer_schema,
+                         ::avro::ValidSchema reader_schema);
+
+    /**
+     * Decode data written with the writer schema into a reader datum
+     * @param data Serialized bytes
+     * @param size Number of serialized bytes
+     */
+    ::avro::GenericDatum decode(const uint8_t *data, size_t size);
+
+  private:
+    ::avro::ResolvingDecoderPtr acquire();
+    void release(::avro::ResolvingDecoderPtr decoder);
+
+    const ::avro::ValidSchema writer_schema_;
+    const ::avro::ValidSchema reader_schema_;
+    std::mutex mutex_;
+    std::vector<::avro::ResolvingDecoderPtr> idle_;
+};
+
 /**
  * Shared cache for parsed Avro schemas
  * Thread-safe storage of compiled schemas
@@ -40,6 +81,38 @@ class AvroSerde {
         const schemaregistry::rest::model::Schema &schema,
         std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client);
 
+    /**
+     * Get cached tag index of schema or build and cache it
+     * @param schema Schema whose inline and metadata tags are indexed
+     * @return Index of the tags of each field of schema
+     */
+    std::shared_ptr<const FieldTagIndex> getTagIndex(
+        const schemaregistry::rest::model::Schema &schema);
+
+    /**
+     * Get cached resolving decoders of a pair of schemas or create them
+     * @param writer Schema the data is written with
+     * @param writer_schema Parsed writer schema
+     * @param reader Schema the data is read with
+     * @param reader_schema Parsed reader schema
+     * @return Decoders resolving writer data into reader datums
+     */
+    std::shared_ptr<ResolvingDecoderPool> getResolvingDecoders(
+        const schemaregistry::rest::model::Schema &writer,
+        const ::avro::ValidSchema &writer_schema,
+        const schemaregistry::rest::model::Schema &reader,
+        const ::avro::ValidSchema &reader_schema);
+
+    /**
+     * Get cached codec of schema or compile and cache it
+     * @param schema Schema the codec encodes and decodes
+     * @param parsed_schema Parsed schema
+     * @return Codec compiled from parsed_schema
+     */
+    std::shared_ptr<const AvroCodec> getCodec(
+        const schemaregistry::rest::model::Schema &schema,
+        const ::avro::ValidSchema &parsed_schema);
+
     /**
      * Clear all cached schemas
      */
@@ -47,9 +120,21 @@ class AvroSerde {
 
   private:
     mutable std::shared_mutex mutex_;
-    std::unordered_map<std::string, std::pair<::avro::ValidSchema,
-                                              std::vector<::avro::ValidSchema>>>
+    absl::flat_hash_map<schemaregistry::rest::model::SchemaFingerprint,
+                        std::pair<::avro::ValidSchema,
+                                  std::vector<::avro::ValidSchema>>>
         parsed_schemas_;
+    absl::flat_hash_map<schemaregistry::rest::model::SchemaFingerprint,
+                        std::shared_ptr<const FieldTagIndex>>
+        tag_indexes_;
+    absl::flat_hash_map<
+        std::pair<schemaregistry::rest::model::SchemaFingerprint,
+                  schemaregistry::rest::model::SchemaFingerprint>,
+        std::shared_ptr<ResolvingDecoderPool>>
+        resolving_decoders_;
+    absl::flat_hash_map<schemaregistry::rest::model::SchemaFingerprint,
+                        std::shared_ptr<const AvroCodec>>
+        codecs_;
 
     /**
      * Resolve schema references recursively
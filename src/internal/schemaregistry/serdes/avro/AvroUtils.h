@@ -41,6 +41,17 @@ namespace utils {
                                      const ::avro::ValidSchema &schema,
                                      const ::avro::GenericDatum &datum);
 
+/**
+ * Apply field transformation rules to datum in place
+ * Only the fields the rule's visit plan marks as possibly tagged are walked
+ * @param ctx Rule context
+ * @param schema Schema for the datum
+ * @param datum Avro datum to transform
+ */
+void transformFieldsInPlace(RuleContext &ctx,
+                            const ::avro::ValidSchema &schema,
+                            ::avro::GenericDatum &datum);
+
 /**
  * Transform individual field with context handling
  * @param ctx Rule context
@@ -105,6 +116,29 @@ std::vector<uint8_t> serializeAvroData(
     const ::avro::GenericDatum &datum, const ::avro::ValidSchema &writer_schema,
     const std::vector<::avro::ValidSchema> &named_schemas = {});
 
+/**
+ * Serialize Avro datum, appending the bytes to out
+ * Encodes straight into the buffer, so callers can reuse it across calls and
+ * write a header in front of the datum without copying
+ * @param datum Avro datum to serialize
+ * @param writer_schema Schema to use for writing
+ * @param named_schemas Additional named schemas for resolution
+ * @param out Buffer the serialized bytes are appended to
+ */
+void serializeAvroData(const ::avro::GenericDatum &datum,
+                       const ::avro::ValidSchema &writer_schema,
+                       const std::vector<::avro::ValidSchema> &named_schemas,
+                       std::vector<uint8_t> &out);
+
+/**
+ * Serialize Avro datum with a compiled codec, appending the bytes to out
+ * @param datum Avro datum to serialize
+ * @param codec Codec of the schema to use for writing
+ * @param out Buffer the serialized bytes are appended to
+ */
+void serializeAvroData(const ::avro::GenericDatum &datum,
+                       const AvroCodec &codec, std::vector<uint8_t> &out);
+
 /**
  * Deserialize byte array to Avro datum
  * @param data Serialized bytes
@@ -118,6 +152,30 @@ std::vector<uint8_t> serializeAvroData(
     const ::avro::ValidSchema *reader_schema = nullptr,
     const std::vector<::avro::ValidSchema> &named_schemas = {});
 
+/**
+ * Deserialize Avro datum from a borrowed buffer, without copying it
+ * @param data Serialized bytes
+ * @param size Number of serialized bytes
+ * @param writer_schema Schema used for writing
+ * @param reader_schema Optional reader schema for schema evolution
+ * @param named_schemas Additional named schemas for resolution
+ * @return Deserialized Avro datum
+ */
+::avro::GenericDatum deserializeAvroData(
+    const uint8_t *data, size_t size, const ::avro::ValidSchema &writer_schema,
+    const ::avro::ValidSchema *reader_schema = nullptr,
+    const std::vector<::avro::ValidSchema> &named_schemas = {});
+
+/**
+ * Deserialize Avro datum with a compiled codec, without copying the buffer
+ * @param data Serialized bytes
+ * @param size Number of serialized bytes
+ * @param codec Codec of the schema used for writing
+ * @return Deserialized Avro datum
+ */
+::avro::GenericDatum deserializeAvroData(const uint8_t *data, size_t size,
+                                         const AvroCodec &codec);
+
 /**
  * Parse Avro schema string with named schema support
  * @param schema_str Main schema string
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "JsonValue.h"
+#include "absl/container/flat_hash_map.h"
 #include "schemaregistry/rest/ISchemaRegistryClient.h"
 #include "schemaregistry/serdes/SerdeError.h"
 #include "schemaregistry/serdes/SerdeTypes.h"
@@ -36,8 +37,8 @@ class JsonSerde {
 
   private:
     // Cache for parsed schemas: Schema -> json_schema
-    std::unordered_map<
-        std::string,
+    absl::flat_hash_map<
+        schemaregistry::rest::model::SchemaFingerprint,
         std::shared_ptr<jsoncons::jsonschema::json_schema<jsoncons::ojson>>>
         parsed_schemas_cache_;
 
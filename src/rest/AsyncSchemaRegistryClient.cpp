@@ -0,0 +1,482 @@
+/**
+ * Confluent Schema Registry Async Client
+ * Asynchronous C++ client implementation for interacting with Confluent
+ * Schema Registry
+ */
+
+#include "schemaregistry/rest/AsyncSchemaRegistryClient.h"
+
+#include <map>
+#include <nlohmann/json.hpp>
+
+#include "schemaregistry/rest/MockAsyncSchemaRegistryClient.h"
+#include "schemaregistry/rest/RestUtils.h"
+#include "schemaregistry/rest/SchemaInterner.h"
+
+using json = nlohmann::json;
+
+namespace schemaregistry::rest {
+
+namespace {
+
+template <typename T>
+T parseFromJson(const std::string &jsonStr, const std::string &what) {
+    try {
+        json j = json::parse(jsonStr);
+        return j.get<T>();
+    } catch (const std::exception &e) {
+        throw schemaregistry::rest::RestException(
+            "Failed to parse " + what + " from JSON: " +
+            std::string(e.what()));
+    }
+}
+
+schemaregistry::rest::model::RegisteredSchema parseRegisteredSchemaFromJson(
+    const std::string &jsonStr) {
+    try {
+        json j = json::parse(jsonStr);
+        schemaregistry::rest::model::RegisteredSchema response;
+        from_json(j, response);
+        // Share the body with every other cache holding the same schema
+        response.setSchemaHandle(
+            SchemaInterner::global().intern(response.getSchemaHandle()));
+        return response;
+    } catch (const std::exception &e) {
+        throw schemaregistry::rest::RestException(
+            "Failed to parse registered schema from JSON: " +
+            std::string(e.what()));
+    }
+}
+
+template <typename V>
+std::shared_future<V> makeReadyFuture(V value) {
+    std::promise<V> promise;
+    promise.set_value(std::move(value));
+    return promise.get_future().share();
+}
+
+/**
+ * Build a response callback that completes the given call with the result of
+ * handler applied to the response body, or with the error raised
+ */
+template <typename Completion, typename Handler>
+std::function<void(const cpr::Response &)> completeWith(
+    std::shared_ptr<Completion> completion, Handler handler) {
+    return [completion, handler](const cpr::Response &result) {
+        try {
+            if (result.status_code >= 400) {
+                std::string errorMsg = "HTTP Error " +
+                                       std::to_string(result.status_code) +
+                                       ": " + result.text;
+                throw schemaregistry::rest::RestException(errorMsg,
+                                                          result.status_code);
+            }
+            completion->setValue(handler(result.text));
+        } catch (...) {
+            completion->setException(std::current_exception());
+        }
+    };
+}
+
+}  // namespace
+
+AsyncSchemaRegistryClient::AsyncSchemaRegistryClient(
+    std::shared_ptr<const schemaregistry::rest::ClientConfiguration> config)
+    : AsyncSchemaRegistryClient(
+          std::make_shared<schemaregistry::rest::RestClient>(config)) {}
+
+AsyncSchemaRegistryClient::AsyncSchemaRegistryClient(
+    std::shared_ptr<schemaregistry::rest::RestClient> rest_client)
+    : restClient(std::move(rest_client)),
+      store(std::make_shared<SchemaStore>()),
+      latestVersionCache(
+          restClient->getConfiguration()->getCacheCapacity(),
+          std::chrono::seconds(
+              restClient->getConfiguration()->getCacheLatestTtlSec()),
+          std::chrono::seconds(
+              restClient->getConfiguration()->getCacheLatestStaleTtlSec())),
+      latestWithMetadataCache(
+          restClient->getConfiguration()->getCacheCapacity(),
+          std::chrono::seconds(
+              restClient->getConfiguration()->getCacheLatestTtlSec()),
+          std::chrono::seconds(
+              restClient->getConfiguration()->getCacheLatestStaleTtlSec())) {
+    if (restClient->getConfiguration()->getBaseUrls().empty()) {
+        throw schemaregistry::rest::RestException("Base URL is required");
+    }
+}
+
+AsyncSchemaRegistryClient::~AsyncSchemaRegistryClient() {
+    close();
+    // Stop the event loop before the caches and flights it refers to are
+    // destroyed; requests still in flight complete with a broken promise
+    restClient.reset();
+}
+
+std::shared_ptr<IAsyncSchemaRegistryClient>
+AsyncSchemaRegistryClient::newClient(
+    std::shared_ptr<const schemaregistry::rest::ClientConfiguration> config) {
+    if (config->getBaseUrls().empty()) {
+        throw schemaregistry::rest::RestException("Base URL is required");
+    }
+
+    const std::string url = config->getBaseUrls()[0];
+    if (url.substr(0, 7) == "mock://") {
+        return std::make_shared<MockAsyncSchemaRegistryClient>(config);
+    }
+    return std::make_shared<AsyncSchemaRegistryClient>(config);
+}
+
+std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+AsyncSchemaRegistryClient::getConfiguration() const {
+    return restClient->getConfiguration();
+}
+
+void AsyncSchemaRegistryClient::sendHttpRequestAsync(
+    const std::string &path, const std::string &method,
+    const std::vector<std::pair<std::string, std::string>> &query,
+    const std::string &body,
+    std::function<void(const cpr::Response &)> callback) const {
+    std::map<std::string, std::string> headers;
+    headers.insert(std::make_pair("Content-Type", "application/json"));
+
+    restClient->sendRequestUrlsAsync(path, method, query, headers, body,
+                                     std::move(callback));
+}
+
+void AsyncSchemaRegistryClient::clearLatestCaches() {
+    latestVersionCache.clear();
+    latestWithMetadataCache.clear();
+}
+
+void AsyncSchemaRegistryClient::clearCaches() {
+    clearLatestCaches();
+    store->clear();
+}
+
+void AsyncSchemaRegistryClient::close() { clearCaches(); }
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+AsyncSchemaRegistryClient::registerSchema(
+    const std::string &subject,
+    const schemaregistry::rest::model::Schema &schema, bool normalize) {
+    // Check cache first
+    auto registered = store->getRegisteredBySchema(subject, schema);
+    if (registered.has_value()) {
+        return makeReadyFuture(registered.value());
+    }
+
+    // Prepare request
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/versions";
+    std::vector<std::pair<std::string, std::string>> query;
+    query.emplace_back("normalize", normalize ? "true" : "false");
+
+    // Serialize schema to JSON
+    json j;
+    to_json(j, schema);
+    std::string body = j.dump();
+
+    return registeredSchemaFlights.runAsync(
+        utils::createRequestKey(path, "POST", query, body),
+        [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "POST", query, body,
+                completeWith(completion, [this, subject,
+                                          schema](const std::string &text) {
+                    auto response = parseRegisteredSchemaFromJson(text);
+
+                    // Update cache
+                    schemaregistry::rest::model::Schema schemaKey;
+                    if (response.getSchema().has_value()) {
+                        schemaKey = response.toSchema();
+                    } else {
+                        schemaKey = schema;  // Use the input schema if no
+                                             // schema in response
+                    }
+                    store->setSchema(std::make_optional(subject),
+                                     response.getId(), response.getGuid(),
+                                     schemaKey);
+                    return response;
+                }));
+        });
+}
+
+std::shared_future<schemaregistry::rest::model::Schema>
+AsyncSchemaRegistryClient::getBySubjectAndId(
+    const std::optional<std::string> &subject, int32_t id,
+    const std::optional<std::string> &format) {
+    // Check cache first
+    auto result = store->getSchemaById(subject.value_or(""), id);
+    if (result.has_value()) {
+        return makeReadyFuture(result.value().second);
+    }
+
+    // Prepare request
+    std::string path = "/schemas/ids/" + std::to_string(id);
+    std::vector<std::pair<std::string, std::string>> query;
+    if (subject.has_value()) {
+        query.emplace_back("subject", subject.value());
+    }
+    if (format.has_value()) {
+        query.emplace_back("format", format.value());
+    }
+
+    return schemaFlights.runAsync(
+        utils::createRequestKey(path, "GET", query), [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "GET", query, "",
+                completeWith(completion,
+                             [this, subject, id](const std::string &text) {
+                                 auto response =
+                                     parseRegisteredSchemaFromJson(text);
+                                 auto schema = response.toSchema();
+
+                                 // Update cache
+                                 store->setSchema(subject,
+                                                  std::make_optional(id),
+                                                  response.getGuid(), schema);
+                                 return schema;
+                             }));
+        });
+}
+
+std::shared_future<schemaregistry::rest::model::Schema>
+AsyncSchemaRegistryClient::getByGuid(const std::string &guid,
+                                     const std::optional<std::string> &format) {
+    // Check cache first
+    auto result = store->getSchemaByGuid(guid);
+    if (result.has_value()) {
+        return makeReadyFuture(result.value());
+    }
+
+    // Prepare request
+    std::string path = "/schemas/guids/" + utils::urlEncode(guid);
+    std::vector<std::pair<std::string, std::string>> query;
+    if (format.has_value()) {
+        query.emplace_back("format", format.value());
+    }
+
+    return schemaFlights.runAsync(
+        utils::createRequestKey(path, "GET", query), [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "GET", query, "",
+                completeWith(completion, [this, guid](const std::string &text) {
+                    auto response = parseRegisteredSchemaFromJson(text);
+                    auto schema = response.toSchema();
+
+                    // Update cache
+                    store->setSchema(std::nullopt, response.getId(),
+                                     std::make_optional(guid), schema);
+                    return schema;
+                }));
+        });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+AsyncSchemaRegistryClient::getBySchema(
+    const std::string &subject,
+    const schemaregistry::rest::model::Schema &schema, bool normalize,
+    bool deleted) {
+    // Check cache first
+    auto result = store->getRegisteredBySchema(subject, schema);
+    if (result.has_value()) {
+        return makeReadyFuture(result.value());
+    }
+
+    // Prepare request
+    std::string path = "/subjects/" + utils::urlEncode(subject);
+    std::vector<std::pair<std::string, std::string>> query;
+    query.emplace_back("normalize", normalize ? "true" : "false");
+    query.emplace_back("deleted", deleted ? "true" : "false");
+
+    // Serialize schema to JSON
+    json j;
+    to_json(j, schema);
+    std::string body = j.dump();
+
+    return registeredSchemaFlights.runAsync(
+        utils::createRequestKey(path, "POST", query, body),
+        [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "POST", query, body,
+                completeWith(completion, [this,
+                                          schema](const std::string &text) {
+                    auto response = parseRegisteredSchemaFromJson(text);
+
+                    // Update cache
+                    // Ensure the schema matches the input
+                    schemaregistry::rest::model::RegisteredSchema rs(
+                        response.getId(), response.getGuid(),
+                        response.getSubject(), response.getVersion(), schema);
+                    store->setRegisteredSchema(schema, rs);
+                    return response;
+                }));
+        });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+AsyncSchemaRegistryClient::getVersion(
+    const std::string &subject, int32_t version, bool deleted,
+    const std::optional<std::string> &format) {
+    // Check cache first
+    auto result = store->getRegisteredByVersion(subject, version);
+    if (result.has_value()) {
+        return makeReadyFuture(result.value());
+    }
+
+    // Prepare request
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/versions/" +
+                       std::to_string(version);
+    std::vector<std::pair<std::string, std::string>> query;
+    query.emplace_back("deleted", deleted ? "true" : "false");
+    if (format.has_value()) {
+        query.emplace_back("format", format.value());
+    }
+
+    return registeredSchemaFlights.runAsync(
+        utils::createRequestKey(path, "GET", query), [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "GET", query, "",
+                completeWith(completion, [this](const std::string &text) {
+                    auto response = parseRegisteredSchemaFromJson(text);
+
+                    // Update cache
+                    store->setRegisteredSchema(response.toSchema(), response);
+                    return response;
+                }));
+        });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+AsyncSchemaRegistryClient::getLatestVersion(
+    const std::string &subject, const std::optional<std::string> &format) {
+    // Check cache first, a stale value is served while it is refreshed
+    auto cached = latestVersionCache.get(subject);
+    if (cached.value.has_value()) {
+        if (cached.refresh) {
+            fetchLatestVersion(subject, format);
+        }
+        return makeReadyFuture(std::move(*cached.value));
+    }
+
+    return fetchLatestVersion(subject, format);
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+AsyncSchemaRegistryClient::fetchLatestVersion(
+    const std::string &subject, const std::optional<std::string> &format) {
+    // Prepare request
+    std::string path =
+        "/subjects/" + utils::urlEncode(subject) + "/versions/latest";
+    std::vector<std::pair<std::string, std::string>> query;
+    if (format.has_value()) {
+        query.emplace_back("format", format.value());
+    }
+
+    return registeredSchemaFlights.runAsync(
+        utils::createRequestKey(path, "GET", query), [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "GET", query, "",
+                completeWith(completion,
+                             [this, subject](const std::string &text) {
+                                 auto response =
+                                     parseRegisteredSchemaFromJson(text);
+
+                                 // Update cache
+                                 latestVersionCache.put(subject, response);
+                                 return response;
+                             }));
+        });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+AsyncSchemaRegistryClient::getLatestWithMetadata(
+    const std::string &subject,
+    const std::unordered_map<std::string, std::string> &metadata, bool deleted,
+    const std::optional<std::string> &format) {
+    // Check cache first, a stale value is served while it is refreshed
+    auto cached = latestWithMetadataCache.get(
+        utils::createMetadataKey(subject, metadata));
+    if (cached.value.has_value()) {
+        if (cached.refresh) {
+            fetchLatestWithMetadata(subject, metadata, deleted, format);
+        }
+        return makeReadyFuture(std::move(*cached.value));
+    }
+
+    return fetchLatestWithMetadata(subject, metadata, deleted, format);
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+AsyncSchemaRegistryClient::fetchLatestWithMetadata(
+    const std::string &subject,
+    const std::unordered_map<std::string, std::string> &metadata, bool deleted,
+    const std::optional<std::string> &format) {
+    std::string cacheKey = utils::createMetadataKey(subject, metadata);
+
+    // Prepare request
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/metadata";
+    std::vector<std::pair<std::string, std::string>> query;
+    query.emplace_back("deleted", deleted ? "true" : "false");
+    if (format.has_value()) {
+        query.emplace_back("format", format.value());
+    }
+
+    // Add metadata to query
+    for (const auto &pair : metadata) {
+        query.emplace_back("key", pair.first);
+        query.emplace_back("value", pair.second);
+    }
+
+    return registeredSchemaFlights.runAsync(
+        utils::createRequestKey(path, "GET", query), [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "GET", query, "",
+                completeWith(completion,
+                             [this, cacheKey](const std::string &text) {
+                                 auto response =
+                                     parseRegisteredSchemaFromJson(text);
+
+                                 // Update cache
+                                 latestWithMetadataCache.put(cacheKey,
+                                                             response);
+                                 return response;
+                             }));
+        });
+}
+
+std::shared_future<std::vector<int32_t>>
+AsyncSchemaRegistryClient::getAllVersions(const std::string &subject) {
+    // Prepare request
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/versions";
+
+    return versionsFlights.runAsync(
+        utils::createRequestKey(path, "GET", {}), [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "GET", {}, "",
+                completeWith(completion, [](const std::string &text) {
+                    return parseFromJson<std::vector<int32_t>>(text,
+                                                               "int array");
+                }));
+        });
+}
+
+std::shared_future<std::vector<std::string>>
+AsyncSchemaRegistryClient::getAllSubjects(bool deleted) {
+    // Prepare request
+    std::string path = "/subjects";
+    std::vector<std::pair<std::string, std::string>> query;
+    query.emplace_back("deleted", deleted ? "true" : "false");
+
+    return subjectsFlights.runAsync(
+        utils::createRequestKey(path, "GET", query), [&](auto completion) {
+            sendHttpRequestAsync(
+                path, "GET", query, "",
+                completeWith(completion, [](const std::string &text) {
+                    return parseFromJson<std::vector<std::string>>(
+                        text, "string array");
+                }));
+        });
+}
+
+}  // namespace schemaregistry::rest
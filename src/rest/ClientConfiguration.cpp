@@ -23,9 +23,13 @@ ClientConfiguration::ClientConfiguration(
       bearer_access_token_(std::nullopt),
       cache_capacity_(1000),
       cache_latest_ttl_sec_(3600),
+      cache_latest_stale_ttl_sec_(0),
+      cache_not_found_ttl_sec_(30),
       max_retries_(3),
       retries_wait_ms_(1000),
-      retries_max_wait_ms_(5000) {}
+      retries_max_wait_ms_(5000),
+      connection_pool_size_(8),
+      connection_idle_timeout_sec_(60) {}
 
 ClientConfiguration::~ClientConfiguration() {}
 
@@ -97,6 +101,24 @@ void ClientConfiguration::setCacheLatestTtlSec(
     cache_latest_ttl_sec_ = cache_latest_ttl_sec;
 }
 
+std::uint64_t ClientConfiguration::getCacheLatestStaleTtlSec() const {
+    return cache_latest_stale_ttl_sec_;
+}
+
+void ClientConfiguration::setCacheLatestStaleTtlSec(
+    std::uint64_t cache_latest_stale_ttl_sec) {
+    cache_latest_stale_ttl_sec_ = cache_latest_stale_ttl_sec;
+}
+
+std::uint64_t ClientConfiguration::getCacheNotFoundTtlSec() const {
+    return cache_not_found_ttl_sec_;
+}
+
+void ClientConfiguration::setCacheNotFoundTtlSec(
+    std::uint64_t cache_not_found_ttl_sec) {
+    cache_not_found_ttl_sec_ = cache_not_found_ttl_sec;
+}
+
 // Retry configuration
 std::uint32_t ClientConfiguration::getMaxRetries() const {
     return max_retries_;
@@ -123,6 +145,25 @@ void ClientConfiguration::setRetriesMaxWaitMs(
     retries_max_wait_ms_ = retries_max_wait_ms;
 }
 
+// Connection pool configuration
+std::uint32_t ClientConfiguration::getConnectionPoolSize() const {
+    return connection_pool_size_;
+}
+
+void ClientConfiguration::setConnectionPoolSize(
+    std::uint32_t connection_pool_size) {
+    connection_pool_size_ = connection_pool_size;
+}
+
+std::uint64_t ClientConfiguration::getConnectionIdleTimeoutSec() const {
+    return connection_idle_timeout_sec_;
+}
+
+void ClientConfiguration::setConnectionIdleTimeoutSec(
+    std::uint64_t connection_idle_timeout_sec) {
+    connection_idle_timeout_sec_ = connection_idle_timeout_sec;
+}
+
 std::shared_ptr<cpr::Session> ClientConfiguration::getSession() const {
     return session_;
 }
@@ -136,9 +177,13 @@ bool ClientConfiguration::operator==(const ClientConfiguration &other) const {
            bearer_access_token_ == other.bearer_access_token_ &&
            cache_capacity_ == other.cache_capacity_ &&
            cache_latest_ttl_sec_ == other.cache_latest_ttl_sec_ &&
+           cache_latest_stale_ttl_sec_ == other.cache_latest_stale_ttl_sec_ &&
+           cache_not_found_ttl_sec_ == other.cache_not_found_ttl_sec_ &&
            max_retries_ == other.max_retries_ &&
            retries_wait_ms_ == other.retries_wait_ms_ &&
-           retries_max_wait_ms_ == other.retries_max_wait_ms_;
+           retries_max_wait_ms_ == other.retries_max_wait_ms_ &&
+           connection_pool_size_ == other.connection_pool_size_ &&
+           connection_idle_timeout_sec_ == other.connection_idle_timeout_sec_;
 }
 
 bool ClientConfiguration::operator!=(const ClientConfiguration &other) const {
@@ -62,12 +62,34 @@ void DekStore::clear() {
     deks.clear();
 }
 
+namespace {
+
+// Scope of cached DEK lookup misses, invalidated when the DEK is registered
+std::string dekScope(const std::string &kek_name, const std::string &subject) {
+    return kek_name + "\n" + subject;
+}
+
+// Identity of a GET request, used as key of cached lookup misses
+std::string requestKey(const std::string &path,
+                       const std::map<std::string, std::string> &query) {
+    std::string key = path + "?";
+    for (const auto &pair : query) {
+        key += pair.first + "=" + pair.second + "&";
+    }
+    return key;
+}
+
+}  // namespace
+
 // DekRegistryClient implementation
 DekRegistryClient::DekRegistryClient(
     std::shared_ptr<const schemaregistry::rest::ClientConfiguration> config)
     : restClient(std::make_shared<schemaregistry::rest::RestClient>(config)),
       store(std::make_shared<DekStore>()),
-      storeMutex(std::make_shared<std::mutex>()) {
+      storeMutex(std::make_shared<std::mutex>()),
+      notFoundCache(std::make_shared<NotFoundCache>(
+          config->getCacheCapacity(),
+          std::chrono::seconds(config->getCacheNotFoundTtlSec()))) {
     if (config->getBaseUrls().empty()) {
         throw schemaregistry::rest::RestException("Base URL is required");
     }
@@ -206,6 +228,7 @@ schemaregistry::rest::model::Kek DekRegistryClient::registerKek(
         std::lock_guard<std::mutex> lock(*storeMutex);
         store->setKek(cacheKey, kek);
     }
+    notFoundCache->invalidate(request.getName());
 
     return kek;
 }
@@ -249,6 +272,7 @@ schemaregistry::rest::model::Dek DekRegistryClient::registerDek(
             std::lock_guard<std::mutex> lock(*storeMutex);
             store->setDek(cacheKey, dek);
         }
+        notFoundCache->invalidate(dekScope(kek_name, request.getSubject()));
 
         return dek;
     } catch (const schemaregistry::rest::RestException &e) {
@@ -267,6 +291,8 @@ schemaregistry::rest::model::Dek DekRegistryClient::registerDek(
                 std::lock_guard<std::mutex> lock(*storeMutex);
                 store->setDek(cacheKey, dek);
             }
+            notFoundCache->invalidate(
+                dekScope(kek_name, request.getSubject()));
 
             return dek;
         } else {
@@ -294,8 +320,11 @@ schemaregistry::rest::model::Kek DekRegistryClient::getKek(
     std::map<std::string, std::string> query;
     query.insert(std::make_pair("deleted", deleted ? "true" : "false"));
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "GET", query);
+    // Send request, unless known to be missing
+    std::string responseBody =
+        notFoundCache->run(name, requestKey(path, query), [&]() {
+            return sendHttpRequest(path, "GET", query);
+        });
 
     // Parse response
     schemaregistry::rest::model::Kek kek = parseKekFromJson(responseBody);
@@ -337,8 +366,10 @@ schemaregistry::rest::model::Dek DekRegistryClient::getDek(
     query.insert(std::make_pair("algorithm", algorithmToString(alg)));
     query.insert(std::make_pair("deleted", deleted ? "true" : "false"));
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "GET", query);
+    // Send request, unless known to be missing
+    std::string responseBody = notFoundCache->run(
+        dekScope(kek_name, subject), requestKey(path, query),
+        [&]() { return sendHttpRequest(path, "GET", query); });
 
     // Parse response
     schemaregistry::rest::model::Dek dek = parseDekFromJson(responseBody);
@@ -386,6 +417,7 @@ schemaregistry::rest::model::Dek DekRegistryClient::setDekKeyMaterial(
 void DekRegistryClient::clearCaches() {
     std::lock_guard<std::mutex> lock(*storeMutex);
     store->clear();
+    notFoundCache->clear();
 }
 
 void DekRegistryClient::close() { clearCaches(); }
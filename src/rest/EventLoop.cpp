@@ -0,0 +1,126 @@
+/**
+ * Event Loop Implementation
+ * Timer-driven task executor backing asynchronous requests
+ */
+
+#include "schemaregistry/rest/EventLoop.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace schemaregistry::rest {
+
+EventLoop::EventLoop(size_t workers) : next_seq_(0), stopped_(false) {
+    if (workers == 0) {
+        throw std::invalid_argument(
+            "Event loop must have at least one worker");
+    }
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this]() { runWorker(); });
+    }
+    timer_thread_ = std::thread([this]() { runTimers(); });
+}
+
+EventLoop::~EventLoop() { stop(); }
+
+void EventLoop::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    tasks_available_.notify_one();
+}
+
+void EventLoop::schedule(std::chrono::milliseconds delay, Task task) {
+    if (delay <= std::chrono::milliseconds::zero()) {
+        post(std::move(task));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return;
+        }
+        timers_.push(Timer{std::chrono::steady_clock::now() + delay,
+                           next_seq_++, std::move(task)});
+    }
+    timers_changed_.notify_one();
+}
+
+void EventLoop::stop() {
+    std::deque<Task> dropped_tasks;
+    std::priority_queue<Timer> dropped_timers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        dropped_tasks.swap(tasks_);
+        dropped_timers.swap(timers_);
+    }
+    tasks_available_.notify_all();
+    timers_changed_.notify_all();
+
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
+    // Dropped tasks are destroyed here, outside the lock, as destroying a
+    // task may release resources (e.g. break a pending promise)
+}
+
+void EventLoop::runWorker() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            tasks_available_.wait(lock,
+                                  [this]() { return stopped_ || !tasks_.empty(); });
+            if (stopped_) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void EventLoop::runTimers() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+        if (timers_.empty()) {
+            timers_changed_.wait(lock);
+            continue;
+        }
+
+        auto due = timers_.top().due;
+        if (std::chrono::steady_clock::now() < due) {
+            timers_changed_.wait_until(lock, due);
+            continue;
+        }
+
+        // Hand expired timers over to the workers
+        bool fired = false;
+        auto now = std::chrono::steady_clock::now();
+        while (!timers_.empty() && timers_.top().due <= now) {
+            tasks_.push_back(std::move(const_cast<Timer &>(timers_.top()).task));
+            timers_.pop();
+            fired = true;
+        }
+        if (fired) {
+            tasks_available_.notify_all();
+        }
+    }
+}
+
+}  // namespace schemaregistry::rest
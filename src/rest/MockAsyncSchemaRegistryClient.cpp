@@ -0,0 +1,122 @@
+/**
+ * Mock Async Schema Registry Client
+ * Asynchronous facade over MockSchemaRegistryClient for testing
+ */
+
+#include "schemaregistry/rest/MockAsyncSchemaRegistryClient.h"
+
+namespace schemaregistry::rest {
+
+namespace {
+
+// Run fn now and return a ready future holding its result or exception
+template <typename F>
+auto makeReadyFuture(F &&fn) -> std::shared_future<decltype(fn())> {
+    using V = decltype(fn());
+    std::promise<V> promise;
+    try {
+        promise.set_value(fn());
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+    return promise.get_future().share();
+}
+
+}  // namespace
+
+MockAsyncSchemaRegistryClient::MockAsyncSchemaRegistryClient(
+    std::shared_ptr<const schemaregistry::rest::ClientConfiguration> config)
+    : client(std::make_shared<MockSchemaRegistryClient>(config)) {}
+
+MockAsyncSchemaRegistryClient::MockAsyncSchemaRegistryClient(
+    std::shared_ptr<MockSchemaRegistryClient> client)
+    : client(std::move(client)) {}
+
+std::shared_ptr<MockSchemaRegistryClient>
+MockAsyncSchemaRegistryClient::getClient() const {
+    return client;
+}
+
+std::shared_ptr<const schemaregistry::rest::ClientConfiguration>
+MockAsyncSchemaRegistryClient::getConfiguration() const {
+    return client->getConfiguration();
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+MockAsyncSchemaRegistryClient::registerSchema(
+    const std::string &subject,
+    const schemaregistry::rest::model::Schema &schema, bool normalize) {
+    return makeReadyFuture(
+        [&]() { return client->registerSchema(subject, schema, normalize); });
+}
+
+std::shared_future<schemaregistry::rest::model::Schema>
+MockAsyncSchemaRegistryClient::getBySubjectAndId(
+    const std::optional<std::string> &subject, int32_t id,
+    const std::optional<std::string> &format) {
+    return makeReadyFuture(
+        [&]() { return client->getBySubjectAndId(subject, id, format); });
+}
+
+std::shared_future<schemaregistry::rest::model::Schema>
+MockAsyncSchemaRegistryClient::getByGuid(
+    const std::string &guid, const std::optional<std::string> &format) {
+    return makeReadyFuture([&]() { return client->getByGuid(guid, format); });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+MockAsyncSchemaRegistryClient::getBySchema(
+    const std::string &subject,
+    const schemaregistry::rest::model::Schema &schema, bool normalize,
+    bool deleted) {
+    return makeReadyFuture([&]() {
+        return client->getBySchema(subject, schema, normalize, deleted);
+    });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+MockAsyncSchemaRegistryClient::getVersion(
+    const std::string &subject, int32_t version, bool deleted,
+    const std::optional<std::string> &format) {
+    return makeReadyFuture([&]() {
+        return client->getVersion(subject, version, deleted, format);
+    });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+MockAsyncSchemaRegistryClient::getLatestVersion(
+    const std::string &subject, const std::optional<std::string> &format) {
+    return makeReadyFuture(
+        [&]() { return client->getLatestVersion(subject, format); });
+}
+
+std::shared_future<schemaregistry::rest::model::RegisteredSchema>
+MockAsyncSchemaRegistryClient::getLatestWithMetadata(
+    const std::string &subject,
+    const std::unordered_map<std::string, std::string> &metadata, bool deleted,
+    const std::optional<std::string> &format) {
+    return makeReadyFuture([&]() {
+        return client->getLatestWithMetadata(subject, metadata, deleted,
+                                             format);
+    });
+}
+
+std::shared_future<std::vector<int32_t>>
+MockAsyncSchemaRegistryClient::getAllVersions(const std::string &subject) {
+    return makeReadyFuture([&]() { return client->getAllVersions(subject); });
+}
+
+std::shared_future<std::vector<std::string>>
+MockAsyncSchemaRegistryClient::getAllSubjects(bool deleted) {
+    return makeReadyFuture([&]() { return client->getAllSubjects(deleted); });
+}
+
+void MockAsyncSchemaRegistryClient::clearLatestCaches() {
+    client->clearLatestCaches();
+}
+
+void MockAsyncSchemaRegistryClient::clearCaches() { client->clearCaches(); }
+
+void MockAsyncSchemaRegistryClient::close() { client->close(); }
+
+}  // namespace schemaregistry::rest
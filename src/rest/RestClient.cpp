@@ -24,9 +24,30 @@
 
 namespace schemaregistry::rest {
 
+namespace {
+
+// Session pool sized by the configuration, or by the configuration defaults
+// when there is none
+std::shared_ptr<SessionPool> makeSessionPool(
+    const std::shared_ptr<const ClientConfiguration> &configuration) {
+    const ClientConfiguration defaults(std::vector<std::string>{});
+    const auto &config = configuration ? *configuration : defaults;
+    return std::make_shared<SessionPool>(
+        config.getConnectionPoolSize(),
+        std::chrono::seconds(config.getConnectionIdleTimeoutSec()));
+}
+
+}  // namespace
+
 RestClient::RestClient(std::shared_ptr<const ClientConfiguration> configuration)
-    : configuration_(configuration) {}
-RestClient::~RestClient() {}
+    : configuration_(configuration),
+      session_pool_(makeSessionPool(configuration)) {}
+RestClient::~RestClient() {
+    std::lock_guard<std::mutex> lock(event_loop_mutex_);
+    if (event_loop_) {
+        event_loop_->stop();
+    }
+}
 
 std::shared_ptr<const ClientConfiguration> RestClient::getConfiguration()
     const {
@@ -75,6 +96,102 @@ cpr::Response RestClient::sendRequestUrls(
     return last_response;
 }
 
+struct RestClient::AsyncRequest {
+    std::string path;
+    std::string method;
+    std::vector<std::pair<std::string, std::string>> query;
+    std::map<std::string, std::string> headers;
+    std::string body;
+    std::function<void(const cpr::Response &)> callback;
+    size_t url_index = 0;
+    std::uint32_t retries = 0;
+    cpr::Response last_response;  // default constructed (status_code = 0)
+};
+
+void RestClient::sendRequestUrlsAsync(
+    const std::string &path, const std::string &method,
+    const std::vector<std::pair<std::string, std::string>> &query,
+    const std::map<std::string, std::string> &headers,
+    const std::string &body,
+    std::function<void(const cpr::Response &)> callback) const {
+    if (configuration_->getBaseUrls().empty()) {
+        callback(cpr::Response{});
+        return;
+    }
+
+    auto request = std::make_shared<AsyncRequest>();
+    request->path = path;
+    request->method = method;
+    request->query = query;
+    request->headers = headers;
+    request->body = body;
+    request->callback = std::move(callback);
+
+    getEventLoop()->post([this, request]() { attemptAsync(request); });
+}
+
+void RestClient::attemptAsync(std::shared_ptr<AsyncRequest> request) const {
+    const auto &base_urls = configuration_->getBaseUrls();
+    const bool last_url = request->url_index + 1 >= base_urls.size();
+
+    cpr::Response result;
+    try {
+        result = sendRequest(base_urls[request->url_index], request->path,
+                             request->method, request->query,
+                             request->headers, request->body);
+    } catch (const std::exception &) {
+        // Try next URL for exceptions
+        if (last_url) {
+            request->callback(request->last_response);
+            return;
+        }
+        request->url_index++;
+        request->retries = 0;
+        getEventLoop()->post([this, request]() { attemptAsync(request); });
+        return;
+    }
+    request->last_response = result;
+
+    bool retriable = false;
+    if (result.status_code == 0) {
+        // Network error - always retriable
+        retriable = true;
+    } else if (result.status_code >= 400) {
+        retriable = utils::isRetriable(static_cast<int>(result.status_code));
+    }
+
+    // Retry against the same URL once the backoff timer fires
+    if (retriable && request->retries < configuration_->getMaxRetries()) {
+        auto backoff = utils::calculateExponentialBackoff(
+            configuration_->getRetriesWaitMs(), request->retries,
+            std::chrono::milliseconds(configuration_->getRetriesMaxWaitMs()));
+        request->retries++;
+        getEventLoop()->schedule(
+            backoff, [this, request]() { attemptAsync(request); });
+        return;
+    }
+
+    // Retries exhausted, try next URL if available
+    if (retriable && !last_url) {
+        request->url_index++;
+        request->retries = 0;
+        getEventLoop()->post([this, request]() { attemptAsync(request); });
+        return;
+    }
+
+    request->callback(result);
+}
+
+std::shared_ptr<EventLoop> RestClient::getEventLoop() const {
+    std::lock_guard<std::mutex> lock(event_loop_mutex_);
+    if (!event_loop_) {
+        // Each worker holds at most one pooled session at a time
+        event_loop_ =
+            std::make_shared<EventLoop>(configuration_->getConnectionPoolSize());
+    }
+    return event_loop_;
+}
+
 cpr::Response RestClient::tryRequest(
     const std::string &base_url, const std::string &path,
     const std::string &method,
@@ -91,7 +208,7 @@ cpr::Response RestClient::tryRequest(
         // Use the new sendRequest method that handles authentication and
         // headers
         cpr::Response result =
-            sendRequest(base_url + path, method, query, headers, body);
+            sendRequest(base_url, path, method, query, headers, body);
 
         // Check if we should retry
         bool should_retry = false;
@@ -115,23 +232,28 @@ cpr::Response RestClient::tryRequest(
 }
 
 cpr::Response RestClient::sendRequest(
-    const std::string &url, const std::string &method,
+    const std::string &base_url, const std::string &path,
+    const std::string &method,
     const std::vector<std::pair<std::string, std::string>> &query,
     const std::map<std::string, std::string> &headers,
     const std::string &body) const {
     std::unique_lock<std::mutex> lock(session_mutex_, std::defer_lock);
 
+    // A user-provided session is shared by all requests; otherwise a session
+    // is checked out of the pool for the duration of this request
+    SessionPool::Lease lease;
     auto session = configuration_->getSession();
     if (!session) {
-        session = std::make_shared<cpr::Session>();
+        lease = session_pool_->acquire(base_url);
+        session = lease.get();
     } else {
         lock.lock();
     }
 
-    // Configure the shared Session for this request
+    // Configure the Session for this request
     // Ensure no stale body/payload leaks into requests like GET
     session->RemoveContent();
-    session->SetUrl(cpr::Url{url});
+    session->SetUrl(cpr::Url{base_url + path});
 
     // Set default headers including content type
     cpr::Header cpr_headers;
@@ -182,14 +304,13 @@ cpr::Response RestClient::sendRequest(
 
     session->SetHeader(cpr_headers);
 
-    // Set query parameters (supporting repeated keys)
-    if (!query.empty()) {
-        cpr::Parameters params{};
-        for (const auto &p : query) {
-            params.Add(cpr::Parameter{p.first, p.second});
-        }
-        session->SetParameters(params);
+    // Set query parameters (supporting repeated keys). Always set them, so
+    // that parameters of a previous request on a reused session do not leak
+    cpr::Parameters params{};
+    for (const auto &p : query) {
+        params.Add(cpr::Parameter{p.first, p.second});
     }
+    session->SetParameters(params);
 
     // Set body when applicable
     if (!body.empty() && (method == "POST" || method == "PUT" ||
@@ -198,20 +319,28 @@ cpr::Response RestClient::sendRequest(
     }
 
     // Dispatch based on method
+    cpr::Response response;
     if (method == "GET") {
-        return session->Get();
+        response = session->Get();
     } else if (method == "POST") {
-        return session->Post();
+        response = session->Post();
     } else if (method == "PUT") {
-        return session->Put();
+        response = session->Put();
     } else if (method == "PATCH") {
-        return session->Patch();
+        response = session->Patch();
     } else if (method == "DELETE") {
-        return session->Delete();
+        response = session->Delete();
     } else {
         // Unsupported method; set an error-like response
         return cpr::Response{};
     }
+
+    // Don't return a session to the pool after a network error, as the state
+    // of its connection is unknown
+    if (response.status_code == 0) {
+        lease.discard();
+    }
+    return response;
 }
 
 }  // namespace schemaregistry::rest
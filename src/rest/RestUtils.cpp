@@ -0,0 +1,63 @@
+/**
+ * RestUtils
+ * Request helpers shared by the synchronous and asynchronous clients
+ */
+
+#include "schemaregistry/rest/RestUtils.h"
+
+#include <cctype>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace schemaregistry::rest::utils {
+
+std::string urlEncode(const std::string &str) {
+    std::ostringstream escaped;
+    escaped.fill('0');
+    escaped << std::hex;
+
+    for (char c : str) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            escaped << c;
+        } else {
+            escaped << std::uppercase;
+            escaped << '%' << std::setw(2) << int((unsigned char)c);
+            escaped << std::nouppercase;
+        }
+    }
+
+    return escaped.str();
+}
+
+std::string createMetadataKey(
+    const std::string &subject,
+    const std::unordered_map<std::string, std::string> &metadata) {
+    std::ostringstream key;
+    key << subject << "|";
+
+    // Sort metadata for consistent key
+    std::map<std::string, std::string> sortedMetadata(metadata.begin(),
+                                                      metadata.end());
+    for (const auto &pair : sortedMetadata) {
+        key << pair.first << "=" << pair.second << "&";
+    }
+
+    return key.str();
+}
+
+std::string createRequestKey(
+    const std::string &path, const std::string &method,
+    const std::vector<std::pair<std::string, std::string>> &query,
+    const std::string &body) {
+    std::ostringstream key;
+    key << method << " " << path << "?";
+    for (const auto &pair : query) {
+        key << urlEncode(pair.first) << "=" << urlEncode(pair.second) << "&";
+    }
+    key << "\n" << body;
+
+    return key.str();
+}
+
+}  // namespace schemaregistry::rest::utils
@@ -0,0 +1,84 @@
+/**
+ * Schema Interner Implementation
+ * Process-wide table of shared, immutable schema bodies
+ */
+
+#include "schemaregistry/rest/SchemaInterner.h"
+
+#include <algorithm>
+
+namespace schemaregistry::rest {
+
+SchemaInterner &SchemaInterner::global() {
+    static SchemaInterner instance;
+    return instance;
+}
+
+SchemaInterner::SchemaPtr SchemaInterner::intern(
+    const schemaregistry::rest::model::Schema &schema) {
+    auto fingerprint = schema.getFingerprint();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto existing = find_unsafe(fingerprint, schema)) {
+            return existing;
+        }
+    }
+
+    // Copy outside the lock; the copy carries the memoized fingerprint
+    auto copy = std::make_shared<const schemaregistry::rest::model::Schema>(
+        schema);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto existing = find_unsafe(fingerprint, schema)) {
+        return existing;
+    }
+    insert_unsafe(fingerprint, copy);
+    return copy;
+}
+
+SchemaInterner::SchemaPtr SchemaInterner::intern(SchemaPtr schema) {
+    if (!schema) {
+        return schema;
+    }
+    auto fingerprint = schema->getFingerprint();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto existing = find_unsafe(fingerprint, *schema)) {
+        return existing;
+    }
+    insert_unsafe(fingerprint, schema);
+    return schema;
+}
+
+size_t SchemaInterner::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+SchemaInterner::SchemaPtr SchemaInterner::find_unsafe(
+    const schemaregistry::rest::model::SchemaFingerprint &fingerprint,
+    const schemaregistry::rest::model::Schema &schema) const {
+    auto it = entries_.find(fingerprint);
+    if (it == entries_.end()) {
+        return nullptr;
+    }
+    auto existing = it->second.lock();
+    // Guard against fingerprint collisions; only runs when filling caches
+    if (existing && (existing.get() == &schema || *existing == schema)) {
+        return existing;
+    }
+    return nullptr;
+}
+
+void SchemaInterner::insert_unsafe(
+    const schemaregistry::rest::model::SchemaFingerprint &fingerprint,
+    const SchemaPtr &schema) {
+    if (entries_.size() >= purge_threshold_) {
+        absl::erase_if(entries_,
+                       [](const auto &entry) { return entry.second.expired(); });
+        purge_threshold_ = std::max<size_t>(64, entries_.size() * 2);
+    }
+    entries_[fingerprint] = schema;
+}
+
+}  // namespace schemaregistry::rest
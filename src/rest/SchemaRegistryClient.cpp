@@ -7,12 +7,12 @@
 #include "schemaregistry/rest/SchemaRegistryClient.h"
 
 #include <algorithm>
-#include <iomanip>
 #include <iostream>
 #include <nlohmann/json.hpp>
-#include <sstream>
 
 #include "schemaregistry/rest/MockSchemaRegistryClient.h"
+#include "schemaregistry/rest/RestUtils.h"
+#include "schemaregistry/rest/SchemaInterner.h"
 #include "schemaregistry/rest/model/Association.h"
 
 using json = nlohmann::json;
@@ -23,18 +23,31 @@ SchemaRegistryClient::SchemaRegistryClient(
     std::shared_ptr<const schemaregistry::rest::ClientConfiguration> config)
     : restClient(std::make_shared<schemaregistry::rest::RestClient>(config)),
       store(std::make_shared<SchemaStore>()),
-      storeMutex(std::make_shared<std::mutex>()),
-      latestVersionCache(config->getCacheCapacity(),
-                         std::chrono::seconds(config->getCacheLatestTtlSec())),
+      latestVersionCache(
+          config->getCacheCapacity(),
+          std::chrono::seconds(config->getCacheLatestTtlSec()),
+          std::chrono::seconds(config->getCacheLatestStaleTtlSec())),
       latestWithMetadataCache(
           config->getCacheCapacity(),
-          std::chrono::seconds(config->getCacheLatestTtlSec())) {
+          std::chrono::seconds(config->getCacheLatestTtlSec()),
+          std::chrono::seconds(config->getCacheLatestStaleTtlSec())),
+      notFoundCache(config->getCacheCapacity(),
+                    std::chrono::seconds(config->getCacheNotFoundTtlSec())) {
     if (config->getBaseUrls().empty()) {
         throw schemaregistry::rest::RestException("Base URL is required");
     }
+    if (latestVersionCache.revalidating()) {
+        refresher = std::make_unique<EventLoop>(1);
+    }
 }
 
-SchemaRegistryClient::~SchemaRegistryClient() { close(); }
+SchemaRegistryClient::~SchemaRegistryClient() {
+    // Stop refreshes before the caches they update are destroyed
+    if (refresher) {
+        refresher->stop();
+    }
+    close();
+}
 
 std::shared_ptr<ISchemaRegistryClient> SchemaRegistryClient::newClient(
     std::shared_ptr<const schemaregistry::rest::ClientConfiguration> config) {
@@ -54,40 +67,6 @@ SchemaRegistryClient::getConfiguration() const {
     return restClient->getConfiguration();
 }
 
-std::string SchemaRegistryClient::urlEncode(const std::string &str) const {
-    std::ostringstream escaped;
-    escaped.fill('0');
-    escaped << std::hex;
-
-    for (char c : str) {
-        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped << c;
-        } else {
-            escaped << std::uppercase;
-            escaped << '%' << std::setw(2) << int((unsigned char)c);
-            escaped << std::nouppercase;
-        }
-    }
-
-    return escaped.str();
-}
-
-std::string SchemaRegistryClient::createMetadataKey(
-    const std::string &subject,
-    const std::unordered_map<std::string, std::string> &metadata) const {
-    std::ostringstream key;
-    key << subject << "|";
-
-    // Sort metadata for consistent key
-    std::map<std::string, std::string> sortedMetadata(metadata.begin(),
-                                                      metadata.end());
-    for (const auto &pair : sortedMetadata) {
-        key << pair.first << "=" << pair.second << "&";
-    }
-
-    return key.str();
-}
-
 std::string SchemaRegistryClient::sendHttpRequest(
     const std::string &path, const std::string &method,
     const std::vector<std::pair<std::string, std::string>> &query,
@@ -115,6 +94,9 @@ SchemaRegistryClient::parseRegisteredSchemaFromJson(
         json j = json::parse(jsonStr);
         schemaregistry::rest::model::RegisteredSchema response;
         from_json(j, response);
+        // Share the body with every other cache holding the same schema
+        response.setSchemaHandle(
+            SchemaInterner::global().intern(response.getSchemaHandle()));
         return response;
     } catch (const std::exception &e) {
         throw schemaregistry::rest::RestException(
@@ -175,10 +157,8 @@ void SchemaRegistryClient::clearLatestCaches() {
 
 void SchemaRegistryClient::clearCaches() {
     clearLatestCaches();
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        store->clear();
-    }
+    notFoundCache.clear();
+    store->clear();
 }
 
 void SchemaRegistryClient::close() { clearCaches(); }
@@ -188,16 +168,13 @@ SchemaRegistryClient::registerSchema(
     const std::string &subject,
     const schemaregistry::rest::model::Schema &schema, bool normalize) {
     // Check cache first
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        auto registered = store->getRegisteredBySchema(subject, schema);
-        if (registered.has_value()) {
-            return registered.value();
-        }
+    auto registered = store->getRegisteredBySchema(subject, schema);
+    if (registered.has_value()) {
+        return registered.value();
     }
 
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject) + "/versions";
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/versions";
     std::vector<std::pair<std::string, std::string>> query;
     query.emplace_back("normalize", normalize ? "true" : "false");
 
@@ -206,40 +183,47 @@ SchemaRegistryClient::registerSchema(
     to_json(j, schema);
     std::string body = j.dump();
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "POST", query, body);
+    return registeredSchemaFlights.run(
+        utils::createRequestKey(path, "POST", query, body), [&]() {
+            // Check cache again, a previous call may have just populated it
+            auto registered = store->getRegisteredBySchema(subject, schema);
+            if (registered.has_value()) {
+                return registered.value();
+            }
 
-    // Parse response
-    schemaregistry::rest::model::RegisteredSchema response =
-        parseRegisteredSchemaFromJson(responseBody);
+            // Send request
+            std::string responseBody =
+                sendHttpRequest(path, "POST", query, body);
 
-    // Update cache
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        schemaregistry::rest::model::Schema schemaKey;
-        if (response.getSchema().has_value()) {
-            schemaKey = response.toSchema();
-        } else {
-            schemaKey =
-                schema;  // Use the input schema if no schema in response
-        }
-        store->setSchema(std::make_optional(subject), response.getId(),
-                         response.getGuid(), schemaKey);
-    }
+            // Parse response
+            schemaregistry::rest::model::RegisteredSchema response =
+                parseRegisteredSchemaFromJson(responseBody);
 
-    return response;
+            // Update cache
+            schemaregistry::rest::model::Schema schemaKey;
+            if (response.getSchema().has_value()) {
+                schemaKey = response.toSchema();
+            } else {
+                schemaKey = schema;  // Use the input schema if no schema
+                                     // in response
+            }
+            store->setSchema(std::make_optional(subject), response.getId(),
+                             response.getGuid(), schemaKey);
+
+            // Lookups that missed before may now succeed
+            notFoundCache.invalidate(subject);
+
+            return response;
+        });
 }
 
 schemaregistry::rest::model::Schema SchemaRegistryClient::getBySubjectAndId(
     const std::optional<std::string> &subject, int32_t id,
     const std::optional<std::string> &format) {
     // Check cache first
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        auto result = store->getSchemaById(subject.value_or(""), id);
-        if (result.has_value()) {
-            return result.value().second;
-        }
+    auto result = store->getSchemaById(subject.value_or(""), id);
+    if (result.has_value()) {
+        return result.value().second;
     }
 
     // Prepare request
@@ -252,37 +236,42 @@ schemaregistry::rest::model::Schema SchemaRegistryClient::getBySubjectAndId(
         query.emplace_back("format", format.value());
     }
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "GET", query);
+    // A 404 is not cached: IDs and GUIDs come from messages already written
+    // with them, so a miss only lasts until the registry catches up
+    auto requestKey = utils::createRequestKey(path, "GET", query);
+    return schemaFlights.run(requestKey, [&]() {
+        // Check cache again, a previous call may have just populated it
+        auto result = store->getSchemaById(subject.value_or(""), id);
+        if (result.has_value()) {
+            return result.value().second;
+        }
 
-    // Parse response
-    schemaregistry::rest::model::RegisteredSchema response =
-        parseRegisteredSchemaFromJson(responseBody);
-    schemaregistry::rest::model::Schema schema = response.toSchema();
+        // Send request
+        std::string responseBody = sendHttpRequest(path, "GET", query);
 
-    // Update cache
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
+        // Parse response
+        schemaregistry::rest::model::RegisteredSchema response =
+            parseRegisteredSchemaFromJson(responseBody);
+        schemaregistry::rest::model::Schema schema = response.toSchema();
+
+        // Update cache
         store->setSchema(subject, std::make_optional(id), response.getGuid(),
                          schema);
-    }
 
-    return schema;
+        return schema;
+    });
 }
 
 schemaregistry::rest::model::Schema SchemaRegistryClient::getByGuid(
     const std::string &guid, const std::optional<std::string> &format) {
     // Check cache first
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        auto result = store->getSchemaByGuid(guid);
-        if (result.has_value()) {
-            return result.value();
-        }
+    auto result = store->getSchemaByGuid(guid);
+    if (result.has_value()) {
+        return result.value();
     }
 
     // Prepare request
-    std::string path = "/schemas/guids/" + urlEncode(guid);
+    std::string path = "/schemas/guids/" + utils::urlEncode(guid);
     std::vector<std::pair<std::string, std::string>> query;
     if (format.has_value()) {
         query.emplace_back("format", format.value());
@@ -297,30 +286,61 @@ schemaregistry::rest::model::Schema SchemaRegistryClient::getByGuid(
     schemaregistry::rest::model::Schema schema = response.toSchema();
 
     // Update cache
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        store->setSchema(std::nullopt, response.getId(),
-                         std::make_optional(guid), schema);
-    }
+    store->setSchema(std::nullopt, response.getId(),
+                     std::make_optional(guid), schema);
 
     return schema;
 }
 
+std::shared_ptr<const schemaregistry::rest::model::Schema>
+SchemaRegistryClient::getSchemaHandleBySubjectAndId(
+    const std::optional<std::string> &subject, int32_t id,
+    const std::optional<std::string> &format) {
+    auto result = store->getSchemaHandleById(subject.value_or(""), id);
+    if (result.has_value()) {
+        return result.value().second;
+    }
+
+    // Fetch and cache, then hand out the cached instance
+    auto schema = getBySubjectAndId(subject, id, format);
+    result = store->getSchemaHandleById(subject.value_or(""), id);
+    if (result.has_value()) {
+        return result.value().second;
+    }
+    return std::make_shared<const schemaregistry::rest::model::Schema>(
+        std::move(schema));
+}
+
+std::shared_ptr<const schemaregistry::rest::model::Schema>
+SchemaRegistryClient::getSchemaHandleByGuid(
+    const std::string &guid, const std::optional<std::string> &format) {
+    auto result = store->getSchemaHandleByGuid(guid);
+    if (result) {
+        return result;
+    }
+
+    // Fetch and cache, then hand out the cached instance
+    auto schema = getByGuid(guid, format);
+    result = store->getSchemaHandleByGuid(guid);
+    if (result) {
+        return result;
+    }
+    return std::make_shared<const schemaregistry::rest::model::Schema>(
+        std::move(schema));
+}
+
 schemaregistry::rest::model::RegisteredSchema SchemaRegistryClient::getBySchema(
     const std::string &subject,
     const schemaregistry::rest::model::Schema &schema, bool normalize,
     bool deleted) {
     // Check cache first
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        auto result = store->getRegisteredBySchema(subject, schema);
-        if (result.has_value()) {
-            return result.value();
-        }
+    auto result = store->getRegisteredBySchema(subject, schema);
+    if (result.has_value()) {
+        return result.value();
     }
 
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject);
+    std::string path = "/subjects/" + utils::urlEncode(subject);
     std::vector<std::pair<std::string, std::string>> query;
     query.emplace_back("normalize", normalize ? "true" : "false");
     query.emplace_back("deleted", deleted ? "true" : "false");
@@ -330,40 +350,48 @@ schemaregistry::rest::model::RegisteredSchema SchemaRegistryClient::getBySchema(
     to_json(j, schema);
     std::string body = j.dump();
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "POST", query, body);
+    auto requestKey = utils::createRequestKey(path, "POST", query, body);
+    notFoundCache.check(subject, requestKey);
 
-    // Parse response
-    schemaregistry::rest::model::RegisteredSchema response =
-        parseRegisteredSchemaFromJson(responseBody);
+    return registeredSchemaFlights.run(requestKey, [&]() {
+        // Check cache again, a previous call may have just populated it
+        auto result = store->getRegisteredBySchema(subject, schema);
+        if (result.has_value()) {
+            return result.value();
+        }
 
-    // Update cache
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
+        // Send request, remembering a 404
+        std::string responseBody =
+            notFoundCache.run(subject, requestKey, [&]() {
+                return sendHttpRequest(path, "POST", query, body);
+            });
+
+        // Parse response
+        schemaregistry::rest::model::RegisteredSchema response =
+            parseRegisteredSchemaFromJson(responseBody);
+
+        // Update cache
         // Ensure the schema matches the input
         schemaregistry::rest::model::RegisteredSchema rs(
             response.getId(), response.getGuid(), response.getSubject(),
             response.getVersion(), schema);
         store->setRegisteredSchema(schema, rs);
-    }
 
-    return response;
+        return response;
+    });
 }
 
 schemaregistry::rest::model::RegisteredSchema SchemaRegistryClient::getVersion(
     const std::string &subject, int32_t version, bool deleted,
     const std::optional<std::string> &format) {
     // Check cache first
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
-        auto result = store->getRegisteredByVersion(subject, version);
-        if (result.has_value()) {
-            return result.value();
-        }
+    auto result = store->getRegisteredByVersion(subject, version);
+    if (result.has_value()) {
+        return result.value();
     }
 
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject) + "/versions/" +
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/versions/" +
                        std::to_string(version);
     std::vector<std::pair<std::string, std::string>> query;
     query.emplace_back("deleted", deleted ? "true" : "false");
@@ -371,50 +399,94 @@ schemaregistry::rest::model::RegisteredSchema SchemaRegistryClient::getVersion(
         query.emplace_back("format", format.value());
     }
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "GET", query);
+    // A 404 is not cached, as for IDs
+    auto requestKey = utils::createRequestKey(path, "GET", query);
+    return registeredSchemaFlights.run(requestKey, [&]() {
+        // Check cache again, a previous call may have just populated it
+        auto result = store->getRegisteredByVersion(subject, version);
+        if (result.has_value()) {
+            return result.value();
+        }
 
-    // Parse response
-    schemaregistry::rest::model::RegisteredSchema response =
-        parseRegisteredSchemaFromJson(responseBody);
+        // Send request
+        std::string responseBody = sendHttpRequest(path, "GET", query);
 
-    // Update cache
-    {
-        std::lock_guard<std::mutex> lock(*storeMutex);
+        // Parse response
+        schemaregistry::rest::model::RegisteredSchema response =
+            parseRegisteredSchemaFromJson(responseBody);
+
+        // Update cache
         schemaregistry::rest::model::Schema schema = response.toSchema();
         store->setRegisteredSchema(schema, response);
-    }
 
-    return response;
+        return response;
+    });
+}
+
+void SchemaRegistryClient::refreshInBackground(std::function<void()> refresh) {
+    refresher->post([refresh = std::move(refresh)]() {
+        try {
+            refresh();
+        } catch (const std::exception &) {
+            // The stale value is served until it expires, or until a later
+            // refresh succeeds
+        }
+    });
 }
 
 schemaregistry::rest::model::RegisteredSchema
 SchemaRegistryClient::getLatestVersion(
     const std::string &subject, const std::optional<std::string> &format) {
-    // Check cache first
+    // Check cache first, a stale value is served while it is refreshed
     auto cached = latestVersionCache.get(subject);
-    if (cached.has_value()) {
-        return cached.value();
+    if (cached.value.has_value()) {
+        if (cached.refresh) {
+            refreshInBackground([this, subject, format]() {
+                fetchLatestVersion(subject, format);
+            });
+        }
+        return std::move(*cached.value);
     }
 
+    return fetchLatestVersion(subject, format);
+}
+
+schemaregistry::rest::model::RegisteredSchema
+SchemaRegistryClient::fetchLatestVersion(
+    const std::string &subject, const std::optional<std::string> &format) {
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject) + "/versions/latest";
+    std::string path =
+        "/subjects/" + utils::urlEncode(subject) + "/versions/latest";
     std::vector<std::pair<std::string, std::string>> query;
     if (format.has_value()) {
         query.emplace_back("format", format.value());
     }
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "GET", query);
+    auto requestKey = utils::createRequestKey(path, "GET", query);
+    notFoundCache.check(subject, requestKey);
 
-    // Parse response
-    schemaregistry::rest::model::RegisteredSchema response =
-        parseRegisteredSchemaFromJson(responseBody);
+    return registeredSchemaFlights.run(requestKey, [&]() {
+        // Check cache again, a previous call may have just refreshed it
+        auto cached = latestVersionCache.get(subject);
+        if (cached.value.has_value() && !cached.stale) {
+            return std::move(*cached.value);
+        }
 
-    // Update cache
-    latestVersionCache.put(subject, response);
+        // Send request, remembering a 404
+        std::string responseBody =
+            notFoundCache.run(subject, requestKey, [&]() {
+                return sendHttpRequest(path, "GET", query);
+            });
 
-    return response;
+        // Parse response
+        schemaregistry::rest::model::RegisteredSchema response =
+            parseRegisteredSchemaFromJson(responseBody);
+
+        // Update cache
+        latestVersionCache.put(subject, response);
+
+        return response;
+    });
 }
 
 schemaregistry::rest::model::RegisteredSchema
@@ -422,15 +494,28 @@ SchemaRegistryClient::getLatestWithMetadata(
     const std::string &subject,
     const std::unordered_map<std::string, std::string> &metadata, bool deleted,
     const std::optional<std::string> &format) {
-    // Check cache first
-    std::string cacheKey = createMetadataKey(subject, metadata);
-    auto cached = latestWithMetadataCache.get(cacheKey);
-    if (cached.has_value()) {
-        return cached.value();
+    // Check cache first, a stale value is served while it is refreshed
+    auto cached = latestWithMetadataCache.get(
+        utils::createMetadataKey(subject, metadata));
+    if (cached.value.has_value()) {
+        if (cached.refresh) {
+            refreshInBackground([this, subject, metadata, deleted, format]() {
+                fetchLatestWithMetadata(subject, metadata, deleted, format);
+            });
+        }
+        return std::move(*cached.value);
     }
 
+    return fetchLatestWithMetadata(subject, metadata, deleted, format);
+}
+
+schemaregistry::rest::model::RegisteredSchema
+SchemaRegistryClient::fetchLatestWithMetadata(
+    const std::string &subject,
+    const std::unordered_map<std::string, std::string> &metadata, bool deleted,
+    const std::optional<std::string> &format) {
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject) + "/metadata";
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/metadata";
     std::vector<std::pair<std::string, std::string>> query;
     query.emplace_back("deleted", deleted ? "true" : "false");
     if (format.has_value()) {
@@ -443,15 +528,18 @@ SchemaRegistryClient::getLatestWithMetadata(
         query.emplace_back("value", pair.second);
     }
 
-    // Send request
-    std::string responseBody = sendHttpRequest(path, "GET", query);
+    // Send request, unless known to be missing
+    std::string responseBody = notFoundCache.run(
+        subject, utils::createRequestKey(path, "GET", query),
+        [&]() { return sendHttpRequest(path, "GET", query); });
 
     // Parse response
     schemaregistry::rest::model::RegisteredSchema response =
         parseRegisteredSchemaFromJson(responseBody);
 
     // Update cache
-    latestWithMetadataCache.put(cacheKey, response);
+    latestWithMetadataCache.put(utils::createMetadataKey(subject, metadata),
+                                response);
 
     return response;
 }
@@ -459,7 +547,7 @@ SchemaRegistryClient::getLatestWithMetadata(
 std::vector<int32_t> SchemaRegistryClient::getAllVersions(
     const std::string &subject) {
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject) + "/versions";
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/versions";
 
     // Send request
     std::string responseBody = sendHttpRequest(path, "GET");
@@ -484,7 +572,7 @@ std::vector<std::string> SchemaRegistryClient::getAllSubjects(bool deleted) {
 std::vector<int32_t> SchemaRegistryClient::deleteSubject(
     const std::string &subject, bool permanent) {
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject);
+    std::string path = "/subjects/" + utils::urlEncode(subject);
     std::vector<std::pair<std::string, std::string>> query;
     query.emplace_back("permanent", permanent ? "true" : "false");
 
@@ -499,7 +587,7 @@ int32_t SchemaRegistryClient::deleteSubjectVersion(const std::string &subject,
                                                    int32_t version,
                                                    bool permanent) {
     // Prepare request
-    std::string path = "/subjects/" + urlEncode(subject) + "/versions/" +
+    std::string path = "/subjects/" + utils::urlEncode(subject) + "/versions/" +
                        std::to_string(version);
     std::vector<std::pair<std::string, std::string>> query;
     query.emplace_back("permanent", permanent ? "true" : "false");
@@ -522,7 +610,8 @@ bool SchemaRegistryClient::testSubjectCompatibility(
     const schemaregistry::rest::model::Schema &schema) {
     // Prepare request
     std::string path =
-        "/compatibility/subjects/" + urlEncode(subject) + "/versions/latest";
+        "/compatibility/subjects/" + utils::urlEncode(subject) +
+        "/versions/latest";
 
     // Serialize schema to JSON
     json j;
@@ -547,7 +636,7 @@ bool SchemaRegistryClient::testCompatibility(
     const std::string &subject, int32_t version,
     const schemaregistry::rest::model::Schema &schema) {
     // Prepare request
-    std::string path = "/compatibility/subjects/" + urlEncode(subject) +
+    std::string path = "/compatibility/subjects/" + utils::urlEncode(subject) +
                        "/versions/" + std::to_string(version);
 
     // Serialize schema to JSON
@@ -572,7 +661,7 @@ bool SchemaRegistryClient::testCompatibility(
 schemaregistry::rest::model::ServerConfig SchemaRegistryClient::getConfig(
     const std::string &subject) {
     // Prepare request
-    std::string path = "/config/" + urlEncode(subject);
+    std::string path = "/config/" + utils::urlEncode(subject);
 
     // Send request
     std::string responseBody = sendHttpRequest(path, "GET");
@@ -585,7 +674,7 @@ schemaregistry::rest::model::ServerConfig SchemaRegistryClient::updateConfig(
     const std::string &subject,
     const schemaregistry::rest::model::ServerConfig &config) {
     // Prepare request
-    std::string path = "/config/" + urlEncode(subject);
+    std::string path = "/config/" + utils::urlEncode(subject);
 
     // Serialize config to JSON
     json j;
@@ -700,7 +789,8 @@ void SchemaRegistryClient::deleteAssociations(
     const std::optional<std::vector<std::string>> &association_types,
     bool cascade_lifecycle) {
     // Prepare request
-    std::string path = "/associations/resources/" + urlEncode(resource_id);
+    std::string path =
+        "/associations/resources/" + utils::urlEncode(resource_id);
     std::vector<std::pair<std::string, std::string>> query;
 
     if (resource_type.has_value()) {
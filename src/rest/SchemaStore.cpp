@@ -6,32 +6,125 @@
 
 #include "schemaregistry/rest/SchemaStore.h"
 
+#include "schemaregistry/rest/SchemaInterner.h"
+
+#include <array>
 #include <functional>
 #include <sstream>
+#include <type_traits>
 
 namespace schemaregistry::rest {
 
-SchemaStore::SchemaStore() {}
+namespace {
+
+// Set index[subject][key] = value, copying only the inner map of subject
+template <typename Index, typename K, typename V>
+void setIndexEntry(Index &index, const std::string &subject, const K &key,
+                   V value) {
+    using InnerMap =
+        std::remove_const_t<typename Index::mapped_type::element_type>;
+    auto it = index.find(subject);
+    auto inner = it != index.end() ? std::make_shared<InnerMap>(*it->second)
+                                   : std::make_shared<InnerMap>();
+    (*inner)[key] = std::move(value);
+    index[subject] = std::move(inner);
+}
+
+// Find index[subject][key], or nullptr if absent
+template <typename Index, typename K>
+const typename Index::mapped_type::element_type::mapped_type *findIndexEntry(
+    const Index &index, const std::string &subject, const K &key) {
+    auto subjectIt = index.find(subject);
+    if (subjectIt != index.end()) {
+        auto it = subjectIt->second->find(key);
+        if (it != subjectIt->second->end()) {
+            return &it->second;
+        }
+    }
+    return nullptr;
+}
+
+// Stores whose snapshots each thread caches before they evict each other
+constexpr size_t kCachedStores = 8;
+
+std::atomic<uint64_t> nextStoreId{1};
+
+}  // namespace
+
+SchemaStore::SchemaStore()
+    : snapshot(std::make_shared<const Snapshot>()),
+      storeId(nextStoreId.fetch_add(1, std::memory_order_relaxed)) {}
+
+const SchemaStore::Snapshot &SchemaStore::loadSnapshot() const {
+    // Loading the shared snapshot takes a lock, and its reference count is
+    // shared by all readers, so it is only loaded after a write
+    struct CachedSnapshot {
+        uint64_t storeId = 0;
+        uint64_t generation = 0;
+        std::shared_ptr<const Snapshot> snapshot;
+    };
+    thread_local std::array<CachedSnapshot, kCachedStores> cache;
+
+    // Acquiring the generation makes the snapshot published before it
+    // visible, a newer one may be loaded and is then loaded again
+    uint64_t current = generation.load(std::memory_order_acquire);
+    auto &cached = cache[storeId % kCachedStores];
+    if (cached.storeId != storeId || cached.generation != current) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        cached.snapshot = snapshot.load(std::memory_order_acquire);
+#else
+        cached.snapshot =
+            std::atomic_load_explicit(&snapshot, std::memory_order_acquire);
+#endif
+        cached.storeId = storeId;
+        cached.generation = current;
+    }
+    return *cached.snapshot;
+}
+
+void SchemaStore::storeSnapshot(std::shared_ptr<const Snapshot> next) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    snapshot.store(std::move(next), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&snapshot, std::move(next),
+                               std::memory_order_release);
+#endif
+    generation.fetch_add(1, std::memory_order_release);
+}
 
 void SchemaStore::setSchema(const std::optional<std::string> &subject,
                             const std::optional<int32_t> &schemaId,
                             const std::optional<std::string> &schemaGuid,
                             const schemaregistry::rest::model::Schema &schema) {
+    auto schemaPtr = SchemaInterner::global().intern(schema);
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto next = std::make_shared<Snapshot>(loadSnapshot());
+    setSchemaInSnapshot(*next, subject, schemaId, schemaGuid, schemaPtr);
+    storeSnapshot(std::move(next));
+}
+
+void SchemaStore::setSchemaInSnapshot(
+    Snapshot &next, const std::optional<std::string> &subject,
+    const std::optional<int32_t> &schemaId,
+    const std::optional<std::string> &schemaGuid,
+    const SchemaPtr &schema) const {
     std::string subjectStr = subject.value_or("");
 
     if (schemaId.has_value()) {
         // Update schema id index
-        schemaIdIndex[subjectStr][schemaId.value()] =
-            std::make_pair(schemaGuid, schema);
+        setIndexEntry(next.schemaIdIndex, subjectStr, schemaId.value(),
+                      std::make_pair(schemaGuid, schema));
 
         // Update schema index
-        std::string schemaHash = createSchemaHash(schema);
-        schemaIndex[subjectStr][schemaHash] = schemaId.value();
+        auto fingerprint = schema->getFingerprint();
+        setIndexEntry(next.schemaIndex, subjectStr, fingerprint,
+                      schemaId.value());
     }
 
     if (schemaGuid.has_value()) {
         // Update schema guid index
-        schemaGuidIndex[schemaGuid.value()] = schema;
+        next.schemaGuidIndex[schemaGuid.value()] = schema;
     }
 }
 
@@ -43,20 +136,33 @@ void SchemaStore::setRegisteredSchema(
         subjectStr = rs.getSubject().value();
     }
 
-    std::string schemaHash = createSchemaHash(schema);
+    // Share one body between the schema and registered schema indexes, and
+    // with any other subject or cache holding the same schema
+    auto &interner = SchemaInterner::global();
+    auto schemaPtr = interner.intern(schema);
+    auto fingerprint = schemaPtr->getFingerprint();
+    auto interned = rs;
+    interned.setSchemaHandle(interner.intern(rs.getSchemaHandle()));
+    auto rsPtr =
+        std::make_shared<const schemaregistry::rest::model::RegisteredSchema>(
+            std::move(interned));
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    auto next = std::make_shared<Snapshot>(loadSnapshot());
 
     // Update registered schema by ID index
     if (rs.getId().has_value()) {
-        rsIdIndex[subjectStr][rs.getId().value()] = rs;
+        setIndexEntry(next->rsIdIndex, subjectStr, rs.getId().value(), rsPtr);
     }
 
     // Update registered schema by version index
     if (rs.getVersion().has_value()) {
-        rsVersionIndex[subjectStr][rs.getVersion().value()] = rs;
+        setIndexEntry(next->rsVersionIndex, subjectStr,
+                      rs.getVersion().value(), rsPtr);
     }
 
     // Update registered schema by schema index
-    rsSchemaIndex[subjectStr][schemaHash] = rs;
+    setIndexEntry(next->rsSchemaIndex, subjectStr, fingerprint, rsPtr);
 
     // Also update the schema store
     std::optional<std::string> guid;
@@ -69,41 +175,61 @@ void SchemaStore::setRegisteredSchema(
         subjectOpt = subjectStr;
     }
 
-    setSchema(subjectOpt, rs.getId(), guid, schema);
+    setSchemaInSnapshot(*next, subjectOpt, rs.getId(), guid, schemaPtr);
+    storeSnapshot(std::move(next));
 }
 
 std::optional<
     std::pair<std::optional<std::string>, schemaregistry::rest::model::Schema>>
 SchemaStore::getSchemaById(const std::string &subject, int32_t schemaId) const {
-    auto subjectIt = schemaIdIndex.find(subject);
-    if (subjectIt != schemaIdIndex.end()) {
-        auto schemaIt = subjectIt->second.find(schemaId);
-        if (schemaIt != subjectIt->second.end()) {
-            return schemaIt->second;
-        }
+    auto entry = getSchemaHandleById(subject, schemaId);
+    if (entry) {
+        return std::make_pair(entry->first, *entry->second);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::pair<std::optional<std::string>, SchemaStore::SchemaPtr>>
+SchemaStore::getSchemaHandleById(const std::string &subject,
+                                 int32_t schemaId) const {
+    const auto &current = loadSnapshot();
+    auto entry = findIndexEntry(current.schemaIdIndex, subject, schemaId);
+    if (entry) {
+        return *entry;
     }
     return std::nullopt;
 }
 
 std::optional<schemaregistry::rest::model::Schema> SchemaStore::getSchemaByGuid(
     const std::string &guid) const {
-    auto it = schemaGuidIndex.find(guid);
-    if (it != schemaGuidIndex.end()) {
-        return it->second;
+    auto schema = getSchemaHandleByGuid(guid);
+    if (schema) {
+        return *schema;
     }
     return std::nullopt;
 }
 
+SchemaStore::SchemaPtr SchemaStore::getSchemaHandleByGuid(
+    const std::string &guid) const {
+    const auto &current = loadSnapshot();
+    auto it = current.schemaGuidIndex.find(guid);
+    if (it != current.schemaGuidIndex.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
 std::optional<int32_t> SchemaStore::getIdBySchema(
     const std::string &subject,
     const schemaregistry::rest::model::Schema &schema) const {
-    auto subjectIt = schemaIndex.find(subject);
-    if (subjectIt != schemaIndex.end()) {
-        std::string schemaHash = createSchemaHash(schema);
-        auto schemaIt = subjectIt->second.find(schemaHash);
-        if (schemaIt != subjectIt->second.end()) {
-            return schemaIt->second;
-        }
+    const auto &current = loadSnapshot();
+    if (!current.schemaIndex.contains(subject)) {
+        return std::nullopt;
+    }
+    auto entry = findIndexEntry(current.schemaIndex, subject,
+                                schema.getFingerprint());
+    if (entry) {
+        return *entry;
     }
     return std::nullopt;
 }
@@ -112,13 +238,14 @@ std::optional<schemaregistry::rest::model::RegisteredSchema>
 SchemaStore::getRegisteredBySchema(
     const std::string &subject,
     const schemaregistry::rest::model::Schema &schema) const {
-    auto subjectIt = rsSchemaIndex.find(subject);
-    if (subjectIt != rsSchemaIndex.end()) {
-        std::string schemaHash = createSchemaHash(schema);
-        auto schemaIt = subjectIt->second.find(schemaHash);
-        if (schemaIt != subjectIt->second.end()) {
-            return schemaIt->second;
-        }
+    const auto &current = loadSnapshot();
+    if (!current.rsSchemaIndex.contains(subject)) {
+        return std::nullopt;
+    }
+    auto entry = findIndexEntry(current.rsSchemaIndex, subject,
+                                schema.getFingerprint());
+    if (entry) {
+        return **entry;
     }
     return std::nullopt;
 }
@@ -126,12 +253,10 @@ SchemaStore::getRegisteredBySchema(
 std::optional<schemaregistry::rest::model::RegisteredSchema>
 SchemaStore::getRegisteredByVersion(const std::string &subject,
                                     int32_t version) const {
-    auto subjectIt = rsVersionIndex.find(subject);
-    if (subjectIt != rsVersionIndex.end()) {
-        auto versionIt = subjectIt->second.find(version);
-        if (versionIt != subjectIt->second.end()) {
-            return versionIt->second;
-        }
+    const auto &current = loadSnapshot();
+    auto entry = findIndexEntry(current.rsVersionIndex, subject, version);
+    if (entry) {
+        return **entry;
     }
     return std::nullopt;
 }
@@ -139,31 +264,17 @@ SchemaStore::getRegisteredByVersion(const std::string &subject,
 std::optional<schemaregistry::rest::model::RegisteredSchema>
 SchemaStore::getRegisteredById(const std::string &subject,
                                int32_t schemaId) const {
-    auto subjectIt = rsIdIndex.find(subject);
-    if (subjectIt != rsIdIndex.end()) {
-        auto idIt = subjectIt->second.find(schemaId);
-        if (idIt != subjectIt->second.end()) {
-            return idIt->second;
-        }
+    const auto &current = loadSnapshot();
+    auto entry = findIndexEntry(current.rsIdIndex, subject, schemaId);
+    if (entry) {
+        return **entry;
     }
     return std::nullopt;
 }
 
 void SchemaStore::clear() {
-    schemaIdIndex.clear();
-    schemaGuidIndex.clear();
-    schemaIndex.clear();
-    rsIdIndex.clear();
-    rsVersionIndex.clear();
-    rsSchemaIndex.clear();
-}
-
-std::string SchemaStore::createSchemaHash(
-    const schemaregistry::rest::model::Schema &schema) const {
-    // Us the JSON representation of the schema to create a hash
-    nlohmann::json j;
-    to_json(j, schema);
-    return j.dump();
+    std::lock_guard<std::mutex> lock(writeMutex);
+    storeSnapshot(std::make_shared<const Snapshot>());
 }
 
 }  // namespace schemaregistry::rest
\ No newline at end of file
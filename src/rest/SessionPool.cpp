@@ -0,0 +1,185 @@
+/**
+ * Session Pool Implementation
+ * Thread-safe, bounded pool of keep-alive HTTP sessions
+ */
+
+#include "schemaregistry/rest/SessionPool.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace schemaregistry::rest {
+
+// Lease implementation
+
+SessionPool::Lease::Lease(SessionPool *pool, std::string base_url,
+                          std::shared_ptr<cpr::Session> session)
+    : pool_(pool),
+      base_url_(std::move(base_url)),
+      session_(std::move(session)) {}
+
+SessionPool::Lease::~Lease() { release(); }
+
+SessionPool::Lease::Lease(Lease &&other) noexcept
+    : pool_(other.pool_),
+      base_url_(std::move(other.base_url_)),
+      session_(std::move(other.session_)) {
+    other.pool_ = nullptr;
+}
+
+SessionPool::Lease &SessionPool::Lease::operator=(Lease &&other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = other.pool_;
+        base_url_ = std::move(other.base_url_);
+        session_ = std::move(other.session_);
+        other.pool_ = nullptr;
+    }
+    return *this;
+}
+
+void SessionPool::Lease::discard() {
+    if (pool_ && session_) {
+        session_.reset();
+        pool_->discard();
+    }
+    pool_ = nullptr;
+}
+
+void SessionPool::Lease::release() {
+    if (pool_ && session_) {
+        pool_->release(base_url_, std::move(session_));
+    }
+    pool_ = nullptr;
+}
+
+// SessionPool implementation
+
+SessionPool::SessionPool(size_t max_sessions, std::chrono::seconds idle_timeout)
+    : idle_count_(0),
+      live_count_(0),
+      max_sessions_(max_sessions),
+      idle_timeout_(idle_timeout) {
+    if (max_sessions == 0) {
+        throw std::invalid_argument(
+            "Session pool size must be greater than 0");
+    }
+}
+
+SessionPool::Lease SessionPool::acquire(const std::string &base_url) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        evict_expired_unsafe(std::chrono::steady_clock::now());
+
+        // Prefer the most recently used session for this base url, as it is
+        // the most likely to still hold an open connection
+        auto it = idle_.find(base_url);
+        if (it != idle_.end() && !it->second.empty()) {
+            auto session = std::move(it->second.back().session);
+            it->second.pop_back();
+            if (it->second.empty()) {
+                idle_.erase(it);
+            }
+            idle_count_--;
+            return Lease(this, base_url, std::move(session));
+        }
+
+        // Make room by dropping an idle session bound to another base url
+        if (live_count_ >= max_sessions_) {
+            evict_lru_unsafe();
+        }
+
+        if (live_count_ < max_sessions_) {
+            live_count_++;
+            lock.unlock();
+            try {
+                return Lease(this, base_url, std::make_shared<cpr::Session>());
+            } catch (...) {
+                discard();
+                throw;
+            }
+        }
+
+        available_.wait(lock);
+    }
+}
+
+size_t SessionPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_count_;
+}
+
+size_t SessionPool::idleCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_count_;
+}
+
+void SessionPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    live_count_ -= idle_count_;
+    idle_count_ = 0;
+    idle_.clear();
+    available_.notify_all();
+}
+
+void SessionPool::release(const std::string &base_url,
+                          std::shared_ptr<cpr::Session> session) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+        idle_[base_url].push_back(IdleSession{std::move(session), now});
+        idle_count_++;
+        evict_expired_unsafe(now);
+    }
+    available_.notify_one();
+}
+
+void SessionPool::discard() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        live_count_--;
+    }
+    available_.notify_one();
+}
+
+void SessionPool::evict_expired_unsafe(
+    std::chrono::steady_clock::time_point now) {
+    for (auto it = idle_.begin(); it != idle_.end();) {
+        auto &sessions = it->second;
+        while (!sessions.empty() &&
+               now - sessions.front().last_used > idle_timeout_) {
+            sessions.pop_front();
+            idle_count_--;
+            live_count_--;
+        }
+        if (sessions.empty()) {
+            idle_.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool SessionPool::evict_lru_unsafe() {
+    auto lru = idle_.end();
+    for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+        if (lru == idle_.end() || it->second.front().last_used <
+                                      lru->second.front().last_used) {
+            lru = it;
+        }
+    }
+    if (lru == idle_.end()) {
+        return false;
+    }
+
+    lru->second.pop_front();
+    if (lru->second.empty()) {
+        idle_.erase(lru);
+    }
+    idle_count_--;
+    live_count_--;
+    return true;
+}
+
+}  // namespace schemaregistry::rest
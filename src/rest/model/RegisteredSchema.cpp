@@ -17,7 +17,17 @@
 
 namespace schemaregistry::rest::model {
 
-RegisteredSchema::RegisteredSchema() {
+namespace {
+
+// Shared body of schemas constructed without one
+const std::shared_ptr<const Schema> &emptyBody() {
+    static const auto empty = std::make_shared<const Schema>();
+    return empty;
+}
+
+}  // namespace
+
+RegisteredSchema::RegisteredSchema() : body_(emptyBody()) {
     // Optional members are initialized to std::nullopt by default
 }
 
@@ -30,17 +40,23 @@ RegisteredSchema::RegisteredSchema(const std::optional<int32_t> &id,
       guid_(guid),
       subject_(subject),
       version_(version),
-      schemaType_(schema.getSchemaType()),
-      references_(schema.getReferences()),
-      metadata_(schema.getMetadata()),
-      ruleSet_(schema.getRuleSet()),
-      schema_(schema.getSchema()) {}
+      body_(std::make_shared<const Schema>(schema)) {}
+
+RegisteredSchema::RegisteredSchema(const std::optional<int32_t> &id,
+                                   const std::optional<std::string> &guid,
+                                   const std::optional<std::string> &subject,
+                                   const std::optional<int32_t> &version,
+                                   std::shared_ptr<const Schema> schema)
+    : id_(id),
+      guid_(guid),
+      subject_(subject),
+      version_(version),
+      body_(schema ? std::move(schema) : emptyBody()) {}
 
 bool RegisteredSchema::operator==(const RegisteredSchema &rhs) const {
     return id_ == rhs.id_ && guid_ == rhs.guid_ && subject_ == rhs.subject_ &&
-           version_ == rhs.version_ && schemaType_ == rhs.schemaType_ &&
-           references_ == rhs.references_ && metadata_ == rhs.metadata_ &&
-           ruleSet_ == rhs.ruleSet_ && schema_ == rhs.schema_;
+           version_ == rhs.version_ &&
+           (body_ == rhs.body_ || *body_ == *rhs.body_);
 }
 
 bool RegisteredSchema::operator!=(const RegisteredSchema &rhs) const {
@@ -53,11 +69,9 @@ void to_json(nlohmann::json &j, const RegisteredSchema &o) {
     if (o.guid_.has_value()) j["guid"] = o.guid_.value();
     if (o.subject_.has_value()) j["subject"] = o.subject_.value();
     if (o.version_.has_value()) j["version"] = o.version_.value();
-    if (o.schemaType_.has_value()) j["schemaType"] = o.schemaType_.value();
-    if (o.references_.has_value()) j["references"] = o.references_.value();
-    if (o.metadata_.has_value()) j["metadata"] = o.metadata_.value();
-    if (o.ruleSet_.has_value()) j["ruleSet"] = o.ruleSet_.value();
-    if (o.schema_.has_value()) j["schema"] = o.schema_.value();
+    nlohmann::json body;
+    to_json(body, *o.body_);
+    j.update(body);
 }
 
 void from_json(const nlohmann::json &j, RegisteredSchema &o) {
@@ -81,31 +95,9 @@ void from_json(const nlohmann::json &j, RegisteredSchema &o) {
         j.at("version").get_to(temp);
         o.version_ = temp;
     }
-    if (j.find("schemaType") != j.end()) {
-        std::string temp;
-        j.at("schemaType").get_to(temp);
-        o.schemaType_ = temp;
-    }
-    if (j.find("references") != j.end()) {
-        std::vector<schemaregistry::rest::model::SchemaReference> temp;
-        j.at("references").get_to(temp);
-        o.references_ = temp;
-    }
-    if (j.find("metadata") != j.end()) {
-        schemaregistry::rest::model::Metadata temp;
-        j.at("metadata").get_to(temp);
-        o.metadata_ = temp;
-    }
-    if (j.find("ruleSet") != j.end()) {
-        schemaregistry::rest::model::RuleSet temp;
-        j.at("ruleSet").get_to(temp);
-        o.ruleSet_ = temp;
-    }
-    if (j.find("schema") != j.end()) {
-        std::string temp;
-        j.at("schema").get_to(temp);
-        o.schema_ = temp;
-    }
+    auto body = std::make_shared<Schema>(*o.body_);
+    from_json(j, *body);
+    o.body_ = std::move(body);
 }
 
 std::optional<int32_t> RegisteredSchema::getId() const { return id_; }
@@ -135,60 +127,67 @@ void RegisteredSchema::setVersion(const std::optional<int32_t> &value) {
 }
 
 std::optional<std::string> RegisteredSchema::getSchemaType() const {
-    return schemaType_;
+    return body_->getSchemaType();
 }
 
 void RegisteredSchema::setSchemaType(const std::optional<std::string> &value) {
-    schemaType_ = value;
+    mutableBody().setSchemaType(value);
 }
 
 std::optional<std::vector<schemaregistry::rest::model::SchemaReference>>
 RegisteredSchema::getReferences() const {
-    return references_;
+    return body_->getReferences();
 }
 
 void RegisteredSchema::setReferences(
     const std::optional<
         std::vector<schemaregistry::rest::model::SchemaReference>> &value) {
-    references_ = value;
+    mutableBody().setReferences(value);
 }
 
 std::optional<schemaregistry::rest::model::Metadata>
 RegisteredSchema::getMetadata() const {
-    return metadata_;
+    return body_->getMetadata();
 }
 
 void RegisteredSchema::setMetadata(
     const std::optional<schemaregistry::rest::model::Metadata> &value) {
-    metadata_ = value;
+    mutableBody().setMetadata(value);
 }
 
 std::optional<schemaregistry::rest::model::RuleSet>
 RegisteredSchema::getRuleSet() const {
-    return ruleSet_;
+    return body_->getRuleSet();
 }
 
 void RegisteredSchema::setRuleSet(
     const std::optional<schemaregistry::rest::model::RuleSet> &value) {
-    ruleSet_ = value;
+    mutableBody().setRuleSet(value);
 }
 
 std::optional<std::string> RegisteredSchema::getSchema() const {
-    return schema_;
+    return body_->getSchema();
 }
 
 void RegisteredSchema::setSchema(const std::optional<std::string> &value) {
-    schema_ = value;
+    mutableBody().setSchema(value);
+}
+
+Schema RegisteredSchema::toSchema() const { return *body_; }
+
+std::shared_ptr<const Schema> RegisteredSchema::getSchemaHandle() const {
+    return body_;
+}
+
+void RegisteredSchema::setSchemaHandle(std::shared_ptr<const Schema> value) {
+    body_ = value ? std::move(value) : emptyBody();
 }
 
-Schema RegisteredSchema::toSchema() const {
-    Schema schema;
-    schema.setSchemaType(schemaType_);
-    schema.setReferences(references_);
-    schema.setMetadata(metadata_);
-    schema.setRuleSet(ruleSet_);
-    schema.setSchema(schema_);
-    return schema;
+Schema &RegisteredSchema::mutableBody() {
+    // Never modify a body that other copies or caches may share
+    auto body = std::make_shared<Schema>(*body_);
+    body_ = body;
+    return *body;
 }
 
 }  // namespace schemaregistry::rest::model
@@ -39,6 +39,7 @@ void to_json(nlohmann::json &j, const Schema &o) {
 }
 
 void from_json(const nlohmann::json &j, Schema &o) {
+    o.fingerprint_.reset();
     if (j.find("schemaType") != j.end()) {
         std::string temp;
         j.at("schemaType").get_to(temp);
@@ -70,6 +71,7 @@ std::optional<std::string> Schema::getSchemaType() const { return schemaType_; }
 
 void Schema::setSchemaType(const std::optional<std::string> &value) {
     schemaType_ = value;
+    fingerprint_.reset();
 }
 
 std::optional<std::vector<schemaregistry::rest::model::SchemaReference>>
@@ -81,6 +83,7 @@ void Schema::setReferences(
     const std::optional<
         std::vector<schemaregistry::rest::model::SchemaReference>> &value) {
     references_ = value;
+    fingerprint_.reset();
 }
 
 std::optional<schemaregistry::rest::model::Metadata> Schema::getMetadata()
@@ -91,6 +94,7 @@ std::optional<schemaregistry::rest::model::Metadata> Schema::getMetadata()
 void Schema::setMetadata(
     const std::optional<schemaregistry::rest::model::Metadata> &value) {
     metadata_ = value;
+    fingerprint_.reset();
 }
 
 std::optional<schemaregistry::rest::model::RuleSet> Schema::getRuleSet() const {
@@ -100,12 +104,53 @@ std::optional<schemaregistry::rest::model::RuleSet> Schema::getRuleSet() const {
 void Schema::setRuleSet(
     const std::optional<schemaregistry::rest::model::RuleSet> &value) {
     ruleSet_ = value;
+    fingerprint_.reset();
 }
 
 std::optional<std::string> Schema::getSchema() const { return schema_; }
 
 void Schema::setSchema(const std::optional<std::string> &value) {
     schema_ = value;
+    fingerprint_.reset();
+}
+
+namespace {
+
+// Append a length-prefixed field, so adjacent fields cannot run together
+void appendField(std::string &out, const std::optional<std::string> &field) {
+    if (!field.has_value()) {
+        out.push_back('\0');
+        return;
+    }
+    out.push_back('\1');
+    uint64_t size = field->size();
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>(size >> (i * 8)));
+    }
+    out.append(*field);
+}
+
+template <typename T>
+std::optional<std::string> dumpField(const std::optional<T> &field) {
+    if (!field.has_value()) {
+        return std::nullopt;
+    }
+    return nlohmann::json(field.value()).dump();
+}
+
+}  // namespace
+
+SchemaFingerprint Schema::getFingerprint() const {
+    return fingerprint_.get([this]() {
+        std::string data;
+        data.reserve(schema_.value_or("").size() + 64);
+        appendField(data, schemaType_);
+        appendField(data, schema_);
+        appendField(data, dumpField(references_));
+        appendField(data, dumpField(metadata_));
+        appendField(data, dumpField(ruleSet_));
+        return SchemaFingerprint::of(data);
+    });
 }
 
 }  // namespace schemaregistry::rest::model
@@ -0,0 +1,113 @@
+/**
+ * Confluent Schema Registry Client
+ * 128-bit content fingerprint used to key schema caches
+ */
+
+#include "schemaregistry/rest/model/SchemaFingerprint.h"
+
+namespace schemaregistry::rest::model {
+
+namespace {
+
+constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+inline uint64_t loadLittleEndian64(const unsigned char *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+}  // namespace
+
+SchemaFingerprint SchemaFingerprint::of(std::string_view data) {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(data.data());
+    const size_t len = data.size();
+    const size_t nblocks = len / 16;
+
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+
+    // Body
+    for (size_t i = 0; i < nblocks; ++i) {
+        uint64_t k1 = loadLittleEndian64(bytes + i * 16);
+        uint64_t k2 = loadLittleEndian64(bytes + i * 16 + 8);
+
+        k1 *= kC1;
+        k1 = rotl64(k1, 31);
+        k1 *= kC2;
+        h1 ^= k1;
+        h1 = rotl64(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= kC2;
+        k2 = rotl64(k2, 33);
+        k2 *= kC1;
+        h2 ^= k2;
+        h2 = rotl64(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // Tail
+    const unsigned char *tail = bytes + nblocks * 16;
+    const size_t rest = len & 15;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t i = rest; i > 8; --i) {
+        k2 = (k2 << 8) | tail[i - 1];
+    }
+    for (size_t i = rest < 8 ? rest : 8; i > 0; --i) {
+        k1 = (k1 << 8) | tail[i - 1];
+    }
+    if (rest > 8) {
+        k2 *= kC2;
+        k2 = rotl64(k2, 33);
+        k2 *= kC1;
+        h2 ^= k2;
+    }
+    if (rest > 0) {
+        k1 *= kC1;
+        k1 = rotl64(k1, 31);
+        k1 *= kC2;
+        h1 ^= k1;
+    }
+
+    // Finalization
+    h1 ^= static_cast<uint64_t>(len);
+    h2 ^= static_cast<uint64_t>(len);
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    return {h1, h2};
+}
+
+std::string SchemaFingerprint::toHex() const {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string out(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        out[15 - i] = kDigits[(hi >> (i * 4)) & 0xf];
+        out[31 - i] = kDigits[(lo >> (i * 4)) & 0xf];
+    }
+    return out;
+}
+
+}  // namespace schemaregistry::rest::model
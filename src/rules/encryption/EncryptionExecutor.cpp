@@ -1,9 +1,13 @@
 #include "schemaregistry/rules/encryption/EncryptionExecutor.h"
 
+#include <openssl/crypto.h>
+#include <openssl/sha.h>
+
 #include <algorithm>
 #include <cstring>
 #include <ctime>
 #include <random>
+#include <shared_mutex>
 
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_format.h"
@@ -62,20 +66,103 @@ void FakeClock::setTime(int64_t time) {
 }
 
 // Cryptor implementation
-Cryptor::Cryptor(schemaregistry::rest::model::Algorithm dek_format)
-    : dek_format_(dek_format) {
-    // Initialize Tink
-    auto status = crypto::tink::AeadConfig::Register();
-    if (!status.ok()) {
-        throw SerdeError("Failed to register AEAD config: " +
-                         std::string(status.message()));
+namespace {
+
+// Primitives cached per type, least recently used evicted first
+constexpr size_t kMaxCachedPrimitives = 1024;
+
+// Transforms cached per executor, least recently used evicted first
+constexpr size_t kMaxCachedTransforms = 1000;
+
+// DEK versions cached per transform, least recently used evicted first
+constexpr size_t kMaxCachedDeks = 100;
+
+/**
+ * Register the Tink primitives used by cryptors, once per process
+ */
+void registerTinkConfigs() {
+    static const std::string error = []() -> std::string {
+        auto status = crypto::tink::AeadConfig::Register();
+        if (!status.ok()) {
+            return "Failed to register AEAD config: " +
+                   std::string(status.message());
+        }
+        status = crypto::tink::DeterministicAeadConfig::Register();
+        if (!status.ok()) {
+            return "Failed to register Deterministic AEAD config: " +
+                   std::string(status.message());
+        }
+        return "";
+    }();
+    if (!error.empty()) {
+        throw SerdeError(error);
+    }
+}
+
+/**
+ * Primitives by key type and digest of the key material
+ *
+ * Primitives are thread-safe and only hold the key schedule, in Tink's own
+ * buffers that are zeroed when the last user of an evicted primitive drops
+ * it. The cache itself never stores key material.
+ */
+template <typename P>
+using PrimitiveCache =
+    schemaregistry::rest::TtlLruCache<std::string, std::shared_ptr<const P>>;
+
+template <typename P>
+PrimitiveCache<P> &primitiveCache() {
+    static PrimitiveCache<P> cache(kMaxCachedPrimitives);
+    return cache;
+}
+
+std::string primitiveKey(const std::string &type_url,
+                         const std::vector<uint8_t> &dek) {
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256(dek.data(), dek.size(), digest);
+    std::string key = type_url;
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char *>(digest), sizeof(digest));
+    return key;
+}
+
+template <typename P>
+std::shared_ptr<const P> getPrimitive(const std::string &type_url,
+                                      const std::vector<uint8_t> &dek,
+                                      const std::string &primitive_name) {
+    auto key = primitiveKey(type_url, dek);
+    auto &cache = primitiveCache<P>();
+    if (auto cached = cache.get(key); cached.has_value()) {
+        return std::move(*cached);
     }
 
-    status = crypto::tink::DeterministicAeadConfig::Register();
-    if (!status.ok()) {
-        throw SerdeError("Failed to register Deterministic AEAD config: " +
-                         std::string(status.message()));
+    google::crypto::tink::KeyData key_data;
+    key_data.set_type_url(type_url);
+    key_data.set_key_material_type(
+        google::crypto::tink::KeyData_KeyMaterialType_SYMMETRIC);
+    key_data.set_value(std::string(dek.begin(), dek.end()));
+    auto primitive_result = crypto::tink::Registry::GetPrimitive<P>(key_data);
+    std::string *key_value = key_data.mutable_value();
+    OPENSSL_cleanse(&(*key_value)[0], key_value->size());
+    if (!primitive_result.ok()) {
+        throw SerdeError("could not get " + primitive_name + " primitive: " +
+                         std::string(primitive_result.status().message()));
     }
+    std::shared_ptr<const P> primitive(std::move(primitive_result.value()));
+    cache.put(key, primitive);
+    return primitive;
+}
+
+absl::string_view asStringView(const std::vector<uint8_t> &bytes) {
+    return absl::string_view(reinterpret_cast<const char *>(bytes.data()),
+                             bytes.size());
+}
+
+}  // namespace
+
+Cryptor::Cryptor(schemaregistry::rest::model::Algorithm dek_format)
+    : dek_format_(dek_format) {
+    registerTinkConfigs();
 
     // Create key template based on algorithm
     switch (dek_format) {
@@ -115,122 +202,57 @@ std::vector<uint8_t> Cryptor::generateKey() const {
 std::vector<uint8_t> Cryptor::encrypt(
     const std::vector<uint8_t> &dek, const std::vector<uint8_t> &plaintext,
     const std::vector<uint8_t> &associated_data) const {
-    google::crypto::tink::KeyData key_data;
-    key_data.set_type_url(key_template_.type_url());
-    key_data.set_key_material_type(
-        google::crypto::tink::KeyData_KeyMaterialType_SYMMETRIC);
-    key_data.set_value(std::string(dek.begin(), dek.end()));
-
+    crypto::tink::util::StatusOr<std::string> ciphertext_result;
     if (isDeterministic()) {
-        auto primitive_result = crypto::tink::Registry::GetPrimitive<
-            crypto::tink::DeterministicAead>(key_data);
-        if (!primitive_result.ok()) {
-            throw SerdeError("could not get deterministic aead primitive: " +
-                             std::string(primitive_result.status().message()));
-        }
-
-        auto primitive = std::move(primitive_result.value());
-        auto ciphertext_result = primitive->EncryptDeterministically(
-            absl::string_view(reinterpret_cast<const char *>(plaintext.data()),
-                              plaintext.size()),
-            absl::string_view(
-                reinterpret_cast<const char *>(associated_data.data()),
-                associated_data.size()));
-
-        if (!ciphertext_result.ok()) {
-            throw SerdeError("encryption failed: " +
-                             std::string(ciphertext_result.status().message()));
-        }
-
-        const std::string &result = ciphertext_result.value();
-        return std::vector<uint8_t>(result.begin(), result.end());
+        auto primitive = getPrimitive<crypto::tink::DeterministicAead>(
+            key_template_.type_url(), dek, "deterministic aead");
+        ciphertext_result = primitive->EncryptDeterministically(
+            asStringView(plaintext), asStringView(associated_data));
     } else {
-        auto primitive_result =
-            crypto::tink::Registry::GetPrimitive<crypto::tink::Aead>(key_data);
-        if (!primitive_result.ok()) {
-            throw SerdeError("could not get aead primitive: " +
-                             std::string(primitive_result.status().message()));
-        }
-
-        auto primitive = std::move(primitive_result.value());
-        auto ciphertext_result = primitive->Encrypt(
-            absl::string_view(reinterpret_cast<const char *>(plaintext.data()),
-                              plaintext.size()),
-            absl::string_view(
-                reinterpret_cast<const char *>(associated_data.data()),
-                associated_data.size()));
-
-        if (!ciphertext_result.ok()) {
-            throw SerdeError("encryption failed: " +
-                             std::string(ciphertext_result.status().message()));
-        }
+        auto primitive = getPrimitive<crypto::tink::Aead>(
+            key_template_.type_url(), dek, "aead");
+        ciphertext_result = primitive->Encrypt(asStringView(plaintext),
+                                               asStringView(associated_data));
+    }
 
-        const std::string &result = ciphertext_result.value();
-        return std::vector<uint8_t>(result.begin(), result.end());
+    if (!ciphertext_result.ok()) {
+        throw SerdeError("encryption failed: " +
+                         std::string(ciphertext_result.status().message()));
     }
+
+    const std::string &result = ciphertext_result.value();
+    return std::vector<uint8_t>(result.begin(), result.end());
 }
 
 std::vector<uint8_t> Cryptor::decrypt(
     const std::vector<uint8_t> &dek, const std::vector<uint8_t> &ciphertext,
     const std::vector<uint8_t> &associated_data) const {
-    google::crypto::tink::KeyData key_data;
-    key_data.set_type_url(key_template_.type_url());
-    key_data.set_key_material_type(
-        google::crypto::tink::KeyData_KeyMaterialType_SYMMETRIC);
-    key_data.set_value(std::string(dek.begin(), dek.end()));
-
+    crypto::tink::util::StatusOr<std::string> plaintext_result;
     if (isDeterministic()) {
-        auto primitive_result = crypto::tink::Registry::GetPrimitive<
-            crypto::tink::DeterministicAead>(key_data);
-        if (!primitive_result.ok()) {
-            throw SerdeError("could not get deterministic aead primitive: " +
-                             std::string(primitive_result.status().message()));
-        }
-
-        auto primitive = std::move(primitive_result.value());
-        auto plaintext_result = primitive->DecryptDeterministically(
-            absl::string_view(reinterpret_cast<const char *>(ciphertext.data()),
-                              ciphertext.size()),
-            absl::string_view(
-                reinterpret_cast<const char *>(associated_data.data()),
-                associated_data.size()));
-
-        if (!plaintext_result.ok()) {
-            throw SerdeError("decryption failed: " +
-                             std::string(plaintext_result.status().message()));
-        }
-
-        const std::string &result = plaintext_result.value();
-        return std::vector<uint8_t>(result.begin(), result.end());
+        auto primitive = getPrimitive<crypto::tink::DeterministicAead>(
+            key_template_.type_url(), dek, "deterministic aead");
+        plaintext_result = primitive->DecryptDeterministically(
+            asStringView(ciphertext), asStringView(associated_data));
     } else {
-        auto primitive_result =
-            crypto::tink::Registry::GetPrimitive<crypto::tink::Aead>(key_data);
-        if (!primitive_result.ok()) {
-            throw SerdeError("could not get aead primitive: " +
-                             std::string(primitive_result.status().message()));
-        }
-
-        auto primitive = std::move(primitive_result.value());
-        auto plaintext_result = primitive->Decrypt(
-            absl::string_view(reinterpret_cast<const char *>(ciphertext.data()),
-                              ciphertext.size()),
-            absl::string_view(
-                reinterpret_cast<const char *>(associated_data.data()),
-                associated_data.size()));
-
-        if (!plaintext_result.ok()) {
-            throw SerdeError("decryption failed: " +
-                             std::string(plaintext_result.status().message()));
-        }
+        auto primitive = getPrimitive<crypto::tink::Aead>(
+            key_template_.type_url(), dek, "aead");
+        plaintext_result = primitive->Decrypt(asStringView(ciphertext),
+                                              asStringView(associated_data));
+    }
 
-        const std::string &result = plaintext_result.value();
-        return std::vector<uint8_t>(result.begin(), result.end());
+    if (!plaintext_result.ok()) {
+        throw SerdeError("decryption failed: " +
+                         std::string(plaintext_result.status().message()));
     }
+
+    const std::string &result = plaintext_result.value();
+    return std::vector<uint8_t>(result.begin(), result.end());
 }
 
 // EncryptionExecutor implementation
 EncryptionExecutor::EncryptionExecutor(std::shared_ptr<Clock> clock)
-    : clock_(clock ? clock : std::make_shared<SystemClock>()) {}
+    : clock_(clock ? clock : std::make_shared<SystemClock>()),
+      transforms_(kMaxCachedTransforms) {}
 
 void EncryptionExecutor::configure(
     std::shared_ptr<const ClientConfiguration> client_config,
@@ -258,13 +280,14 @@ void EncryptionExecutor::configure(
 std::string EncryptionExecutor::getType() const { return "ENCRYPT_PAYLOAD"; }
 
 void EncryptionExecutor::close() {
+    transforms_.clear();
     std::lock_guard<std::mutex> client_lock(client_mutex_);
     client_.reset();
 }
 
 std::unique_ptr<SerdeValue> EncryptionExecutor::transform(
     RuleContext &ctx, const SerdeValue &msg) {
-    auto transform = newTransform(ctx);
+    auto transform = getTransform(ctx);
     return transform->transform(ctx, FieldType::Bytes, msg);
 }
 
@@ -335,6 +358,38 @@ std::unique_ptr<EncryptionExecutorTransform> EncryptionExecutor::newTransform(
         this, std::move(cryptor), kek_name, dek_expiry_days);
 }
 
+std::shared_ptr<EncryptionExecutorTransform> EncryptionExecutor::getTransform(
+    RuleContext &ctx) const {
+    // The key covers everything the parameters of the rule are read from:
+    // the rule itself and the metadata of the target schema
+    const auto &rule = ctx.getRule();
+    std::string key = ctx.getSubject();
+    key.push_back('\0');
+    key.append(std::to_string(static_cast<int>(ctx.getRuleMode())));
+    key.push_back('\0');
+    key.append(rule.getName().value_or(""));
+    if (auto params = rule.getParams(); params.has_value()) {
+        for (const auto &[name, value] : params.value()) {
+            key.push_back('\0');
+            key.append(name);
+            key.push_back('=');
+            key.append(value);
+        }
+    }
+    if (ctx.getTarget()) {
+        key.push_back('\0');
+        key.append(ctx.getTarget()->getFingerprint().toHex());
+    }
+
+    if (auto cached = transforms_.get(key); cached.has_value()) {
+        return std::move(*cached);
+    }
+
+    std::shared_ptr<EncryptionExecutorTransform> transform = newTransform(ctx);
+    transforms_.put(key, transform);
+    return transform;
+}
+
 // EncryptionExecutorTransform implementation
 EncryptionExecutorTransform::EncryptionExecutorTransform(
     const EncryptionExecutor *executor, Cryptor cryptor,
@@ -342,7 +397,8 @@ EncryptionExecutorTransform::EncryptionExecutorTransform(
     : executor_(executor),
       cryptor_(std::move(cryptor)),
       kek_name_(kek_name),
-      dek_expiry_days_(dek_expiry_days) {}
+      dek_expiry_days_(dek_expiry_days),
+      deks_(kMaxCachedDeks) {}
 
 std::unique_ptr<SerdeValue> EncryptionExecutorTransform::transform(
     RuleContext &ctx, FieldType field_type, const SerdeValue &field_value) {
@@ -360,8 +416,8 @@ std::unique_ptr<SerdeValue> EncryptionExecutorTransform::transform(
                 version = -1;
             }
 
-            auto dek = getOrCreateDek(ctx, version);
-            auto key_material_bytes = dek.getKeyMaterialBytes();
+            auto dek = getDek(ctx, version);
+            auto key_material_bytes = dek->getKeyMaterialBytes();
             if (!key_material_bytes) {
                 throw SerdeError("no key material found");
             }
@@ -371,7 +427,7 @@ std::unique_ptr<SerdeValue> EncryptionExecutorTransform::transform(
                 cryptor_.encrypt(*key_material_bytes, *plaintext, empty_aad);
 
             if (isDekRotated()) {
-                ciphertext = prefixVersion(dek.getVersion(), ciphertext);
+                ciphertext = prefixVersion(dek->getVersion(), ciphertext);
             }
 
             if (field_type == FieldType::String) {
@@ -417,8 +473,8 @@ std::unique_ptr<SerdeValue> EncryptionExecutorTransform::transform(
                 ciphertext = std::move(c);
             }
 
-            auto dek = getOrCreateDek(ctx, version);
-            auto key_material_bytes = dek.getKeyMaterialBytes();
+            auto dek = getDek(ctx, version);
+            auto key_material_bytes = dek->getKeyMaterialBytes();
 
             std::vector<uint8_t> empty_aad;
             auto plaintext =
@@ -437,17 +493,15 @@ bool EncryptionExecutorTransform::isDekRotated() const {
     return dek_expiry_days_ > 0;
 }
 
-schemaregistry::rest::model::Kek EncryptionExecutorTransform::getKek(
-    RuleContext &ctx) {
+std::shared_ptr<const schemaregistry::rest::model::Kek>
+EncryptionExecutorTransform::getKek(RuleContext &ctx) {
     std::lock_guard<std::mutex> lock(kek_mutex_);
 
-    if (kek_) {
-        return *kek_;
+    if (!kek_) {
+        kek_ = std::make_shared<const schemaregistry::rest::model::Kek>(
+            getOrCreateKek(ctx));
     }
-
-    auto kek = getOrCreateKek(ctx);
-    kek_ = kek;
-    return kek;
+    return kek_;
 }
 
 schemaregistry::rest::model::Kek EncryptionExecutorTransform::getOrCreateKek(
@@ -552,9 +606,28 @@ EncryptionExecutorTransform::storeKekToRegistry(const KekId &kek_id,
     }
 }
 
+std::shared_ptr<const schemaregistry::rest::model::Dek>
+EncryptionExecutorTransform::getDek(RuleContext &ctx,
+                                    std::optional<int32_t> version) {
+    int32_t requested_version = version.value_or(1);
+    if (auto cached = deks_.get(requested_version);
+        cached.has_value() && !isExpired(ctx, **cached)) {
+        return std::move(*cached);
+    }
+
+    auto dek = getOrCreateDek(ctx, version);
+    // Decode the key material now, the shared DEK is not modified after
+    dek.populateKeyMaterialBytes();
+    auto shared_dek = std::make_shared<const schemaregistry::rest::model::Dek>(
+        std::move(dek));
+    deks_.put(requested_version, shared_dek);
+    return shared_dek;
+}
+
 schemaregistry::rest::model::Dek EncryptionExecutorTransform::getOrCreateDek(
     RuleContext &ctx, std::optional<int32_t> version) {
-    auto kek = getKek(ctx);
+    auto kek_handle = getKek(ctx);
+    const auto &kek = *kek_handle;
     bool is_read = ctx.getRuleMode() == Mode::Read;
 
     int32_t actual_version = version.value_or(1);
@@ -572,7 +645,7 @@ schemaregistry::rest::model::Dek EncryptionExecutorTransform::getOrCreateDek(
     dek_id.deleted = is_read;
 
     auto dek = retrieveDekFromRegistry(dek_id);
-    bool is_expired = isExpired(ctx, dek);
+    bool is_expired = dek.has_value() && isExpired(ctx, *dek);
 
     if (!dek || is_expired) {
         if (is_read) {
@@ -753,12 +826,12 @@ EncryptionExecutorTransform::storeDekToRegistry(
 }
 
 bool EncryptionExecutorTransform::isExpired(
-    RuleContext &ctx,
-    const std::optional<schemaregistry::rest::model::Dek> &dek) const {
+    RuleContext &ctx, const schemaregistry::rest::model::Dek &dek) const {
+    if (ctx.getRuleMode() == Mode::Read || dek_expiry_days_ <= 0) {
+        return false;
+    }
     int64_t now = executor_->clock_->now();
-    return ctx.getRuleMode() != Mode::Read && dek_expiry_days_ > 0 &&
-           dek.has_value() &&
-           ((now - dek->getTs()) / MILLIS_IN_DAY) > dek_expiry_days_;
+    return ((now - dek.getTs()) / MILLIS_IN_DAY) > dek_expiry_days_;
 }
 
 std::vector<uint8_t> EncryptionExecutorTransform::prefixVersion(
@@ -22,7 +22,7 @@ void FieldEncryptionExecutor::close() { executor_.close(); }
 
 std::unique_ptr<SerdeValue> FieldEncryptionExecutor::transformField(
     RuleContext &ctx, const SerdeValue &field_value) {
-    auto transform = executor_.newTransform(ctx);
+    auto transform = executor_.getTransform(ctx);
     auto field_ctx = ctx.currentField();
     if (!field_ctx) {
         throw SerdeError("no field context");
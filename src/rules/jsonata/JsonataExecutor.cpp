@@ -1,6 +1,8 @@
 #include "schemaregistry/rules/jsonata/JsonataExecutor.h"
 
 #include <regex>
+#include <utility>
+#include <vector>
 
 #include "jsonata/Jsonata.h"
 #include "schemaregistry/serdes/RuleRegistry.h"
@@ -10,7 +12,66 @@ namespace schemaregistry::rules::jsonata {
 
 using namespace schemaregistry::serdes;
 
-JsonataExecutor::JsonataExecutor() {}
+namespace {
+
+// Parsed instances kept per expression for reuse, beyond what a single
+// thread needs so that concurrent evaluations rarely parse again
+constexpr size_t kMaxIdleInstances = 16;
+
+}  // namespace
+
+/**
+ * Compiled JSONata expression
+ *
+ * A parsed expression keeps evaluation state, such as the bindings of its
+ * environment, so an instance is never evaluated by two threads at once.
+ * Instead each evaluation borrows a parsed instance from a pool and returns
+ * it afterwards; the expression is parsed again only when all instances
+ * are in use by concurrent evaluations.
+ */
+class JsonataExecutor::CompiledExpression {
+  public:
+    explicit CompiledExpression(std::string expr) : expr_(std::move(expr)) {
+        // Parse eagerly, so that invalid expressions are not cached
+        idle_.push_back(std::make_unique<::jsonata::Jsonata>(expr_));
+    }
+
+    auto evaluate(nlohmann::json &value) {
+        auto instance = acquire();
+        auto result = instance->evaluate(value);
+        release(std::move(instance));
+        return result;
+    }
+
+  private:
+    std::unique_ptr<::jsonata::Jsonata> acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_.empty()) {
+                auto instance = std::move(idle_.back());
+                idle_.pop_back();
+                return instance;
+            }
+        }
+        return std::make_unique<::jsonata::Jsonata>(expr_);
+    }
+
+    void release(std::unique_ptr<::jsonata::Jsonata> instance) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() < kMaxIdleInstances) {
+            idle_.push_back(std::move(instance));
+        }
+    }
+
+    const std::string expr_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<::jsonata::Jsonata>> idle_;
+};
+
+JsonataExecutor::JsonataExecutor(size_t max_cached_expressions)
+    : expression_cache_(max_cached_expressions) {}
+
+JsonataExecutor::~JsonataExecutor() = default;
 
 // Implement the required getType method
 std::string JsonataExecutor::getType() const { return "JSONATA"; }
@@ -21,12 +82,34 @@ std::unique_ptr<SerdeValue> JsonataExecutor::transform(
     if (!expr) {
         throw SerdeError("Rule does not contain an expression");
     }
-    auto jsonata = ::jsonata::Jsonata(expr.value());
+    auto jsonata = getOrCompileExpression(expr.value());
     auto value = msg.asJson();
-    auto result = jsonata.evaluate(value);
+    auto result = jsonata->evaluate(value);
     return SerdeValue::newJson(msg.getFormat(), result);
 }
 
+JsonataExecutor::CacheStats JsonataExecutor::getCacheStats() const {
+    CacheStats stats;
+    stats.hits = hits_.load();
+    stats.misses = misses_.load();
+    stats.evictions = evictions_.load();
+    stats.size = expression_cache_.size();
+    return stats;
+}
+
+std::shared_ptr<JsonataExecutor::CompiledExpression>
+JsonataExecutor::getOrCompileExpression(const std::string &expr) {
+    if (auto cached = expression_cache_.get(expr); cached.has_value()) {
+        hits_++;
+        return std::move(*cached);
+    }
+
+    misses_++;
+    auto compiled = std::make_shared<CompiledExpression>(expr);
+    evictions_ += expression_cache_.put(expr, compiled);
+    return compiled;
+}
+
 void JsonataExecutor::registerExecutor() {
     // Register this executor with the global rule registry
     // This matches the Rust version:
@@ -34,4 +117,4 @@ void JsonataExecutor::registerExecutor() {
     global_registry::registerRuleExecutor(std::make_shared<JsonataExecutor>());
 }
 
-}  // namespace schemaregistry::rules::jsonata
\ No newline at end of file
+}  // namespace schemaregistry::rules::jsonata
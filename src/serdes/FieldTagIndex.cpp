@@ -0,0 +1,153 @@
+/**
+ * FieldTagIndex
+ * Per-schema index of the tags applying to each field
+ */
+
+#include "schemaregistry/serdes/FieldTagIndex.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace schemaregistry::serdes {
+
+namespace {
+
+// Field names memoized per index. Names of array elements or map entries
+// may be unbounded, those past the limit are matched on every lookup.
+constexpr size_t kMaxIndexedFields = 10000;
+
+// Visit plans memoized per index, one per root and set of rule tags
+constexpr size_t kMaxVisitPlans = 256;
+
+// Indexes of metadata tags by schema content, least recently used evicted
+// first
+constexpr size_t kMaxCachedIndexes = 1024;
+
+using IndexCache = schemaregistry::rest::TtlLruCache<
+    schemaregistry::rest::model::SchemaFingerprint,
+    std::shared_ptr<const FieldTagIndex>>;
+
+IndexCache &indexCache() {
+    static IndexCache cache(kMaxCachedIndexes);
+    return cache;
+}
+
+const std::shared_ptr<const FieldTagIndex::TagSet> &noTags() {
+    static const auto empty = std::make_shared<const FieldTagIndex::TagSet>();
+    return empty;
+}
+
+}  // namespace
+
+FieldTagIndex::FieldTagIndex(
+    std::unordered_map<std::string, TagSet> inline_tags,
+    const std::optional<schemaregistry::rest::model::Metadata> &metadata)
+    : inline_tags_(std::move(inline_tags)), plans_(kMaxVisitPlans) {
+    if (!metadata.has_value()) {
+        return;
+    }
+    auto tags = metadata->getTags();
+    if (!tags.has_value()) {
+        return;
+    }
+    for (const auto &[pattern, pattern_tags] : tags.value()) {
+        patterns_.push_back({WildcardMatcher::compile(pattern), pattern_tags});
+    }
+}
+
+std::shared_ptr<const FieldTagIndex> FieldTagIndex::forSchema(
+    const schemaregistry::rest::model::Schema &schema) {
+    auto fingerprint = schema.getFingerprint();
+    auto &cache = indexCache();
+    if (auto cached = cache.get(fingerprint); cached.has_value()) {
+        return std::move(*cached);
+    }
+
+    auto index = std::make_shared<const FieldTagIndex>(
+        std::unordered_map<std::string, TagSet>{}, schema.getMetadata());
+    cache.put(fingerprint, index);
+    return index;
+}
+
+const FieldTagIndex::TagSet *FieldTagIndex::getInlineTags(
+    const std::string &full_name) const {
+    auto it = inline_tags_.find(full_name);
+    return it != inline_tags_.end() ? &it->second : nullptr;
+}
+
+std::shared_ptr<const FieldTagIndex::TagSet> FieldTagIndex::getMetadataTags(
+    const std::string &full_name) const {
+    return lookup(full_name).metadata;
+}
+
+std::shared_ptr<const FieldTagIndex::TagSet> FieldTagIndex::getTags(
+    const std::string &full_name) const {
+    return lookup(full_name).all;
+}
+
+std::shared_ptr<const FieldVisitPlan> FieldTagIndex::getVisitPlan(
+    const std::string &root, const TagSet &rule_tags,
+    const std::function<FieldVisitPlan()> &build) const {
+    std::vector<std::string> sorted_tags(rule_tags.begin(), rule_tags.end());
+    std::sort(sorted_tags.begin(), sorted_tags.end());
+    std::string key = root;
+    for (const auto &tag : sorted_tags) {
+        key.push_back('\0');
+        key.append(tag);
+    }
+
+    if (auto cached = plans_.get(key); cached.has_value()) {
+        return std::move(*cached);
+    }
+
+    auto plan = std::make_shared<const FieldVisitPlan>(build());
+    plans_.put(key, plan);
+    return plan;
+}
+
+FieldTagIndex::FieldTags FieldTagIndex::lookup(
+    const std::string &full_name) const {
+    const auto *inline_tags = getInlineTags(full_name);
+    if (patterns_.empty() && inline_tags == nullptr) {
+        return {noTags(), noTags()};
+    }
+    {
+        std::shared_lock lock(mutex_);
+        auto it = fields_.find(full_name);
+        if (it != fields_.end()) {
+            return it->second;
+        }
+    }
+
+    TagSet metadata_tags;
+    for (const auto &pattern : patterns_) {
+        if (pattern.matcher->matches(full_name)) {
+            metadata_tags.insert(pattern.tags.begin(), pattern.tags.end());
+        }
+    }
+
+    FieldTags field_tags;
+    if (metadata_tags.empty()) {
+        field_tags.metadata = noTags();
+    } else {
+        field_tags.metadata =
+            std::make_shared<const TagSet>(std::move(metadata_tags));
+    }
+    if (inline_tags == nullptr) {
+        field_tags.all = field_tags.metadata;
+    } else {
+        TagSet all_tags = *inline_tags;
+        all_tags.insert(field_tags.metadata->begin(),
+                        field_tags.metadata->end());
+        field_tags.all = std::make_shared<const TagSet>(std::move(all_tags));
+    }
+
+    std::unique_lock lock(mutex_);
+    if (fields_.size() < kMaxIndexedFields) {
+        return fields_.try_emplace(full_name, field_tags).first->second;
+    }
+    return field_tags;
+}
+
+}  // namespace schemaregistry::serdes
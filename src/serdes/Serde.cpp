@@ -15,6 +15,13 @@
 
 namespace schemaregistry::serdes {
 
+namespace {
+
+// Migration plans cached per Serde, least recently used evicted first
+constexpr size_t kMaxCachedMigrationPlans = 1000;
+
+}  // namespace
+
 // SchemaId implementation
 
 SchemaId::SchemaId(SerdeFormat serde_format, std::optional<int32_t> id,
@@ -27,7 +34,11 @@ SchemaId::SchemaId(SerdeFormat serde_format, std::optional<int32_t> id,
 }
 
 size_t SchemaId::readFromBytes(const std::vector<uint8_t> &bytes) {
-    if (bytes.empty()) {
+    return readFromBytes(bytes.data(), bytes.size());
+}
+
+size_t SchemaId::readFromBytes(const uint8_t *bytes, size_t size) {
+    if (size == 0) {
         throw SerdeError("Empty byte array");
     }
 
@@ -35,7 +46,7 @@ size_t SchemaId::readFromBytes(const std::vector<uint8_t> &bytes) {
     uint8_t magic = bytes[0];
 
     if (magic == MAGIC_BYTE_V0) {
-        if (bytes.size() < 5) {
+        if (size < 5) {
             throw SerdeError("Insufficient bytes for schema ID");
         }
 
@@ -45,7 +56,7 @@ size_t SchemaId::readFromBytes(const std::vector<uint8_t> &bytes) {
         id_ = id;
         total_bytes_read = 5;
     } else if (magic == MAGIC_BYTE_V1) {
-        if (bytes.size() < 17) {
+        if (size < 17) {
             throw SerdeError("Insufficient bytes for schema GUID");
         }
 
@@ -68,10 +79,9 @@ size_t SchemaId::readFromBytes(const std::vector<uint8_t> &bytes) {
     }
 
     if (serde_format_ == SerdeFormat::Protobuf &&
-        total_bytes_read < bytes.size()) {
-        auto [msg_indexes, bytes_read] =
-            readIndexArrayAndData(std::vector<uint8_t>(
-                bytes.begin() + total_bytes_read, bytes.end()));
+        total_bytes_read < size) {
+        auto [msg_indexes, bytes_read] = readIndexArrayAndData(
+            bytes + total_bytes_read, size - total_bytes_read);
         message_indexes_ = msg_indexes;
         total_bytes_read += bytes_read;
     }
@@ -80,8 +90,8 @@ size_t SchemaId::readFromBytes(const std::vector<uint8_t> &bytes) {
 }
 
 std::pair<std::vector<int32_t>, size_t> SchemaId::readIndexArrayAndData(
-    const std::vector<uint8_t> &buf) const {
-    if (buf.empty() || buf[0] == 0) {
+    const uint8_t *buf, size_t size) const {
+    if (size == 0 || buf[0] == 0) {
         return {std::vector<int32_t>{0}, 1};
     }
 
@@ -91,7 +101,7 @@ std::pair<std::vector<int32_t>, size_t> SchemaId::readIndexArrayAndData(
     // Read variable-length encoded array length
     int32_t len = 0;
     int shift = 0;
-    while (pos < buf.size()) {
+    while (pos < size) {
         uint8_t byte = buf[pos++];
         len |= (byte & 0x7F) << shift;
         if ((byte & 0x80) == 0) break;
@@ -99,10 +109,10 @@ std::pair<std::vector<int32_t>, size_t> SchemaId::readIndexArrayAndData(
     }
 
     // Read variable-length encoded values
-    for (int i = 0; i < len && pos < buf.size(); ++i) {
+    for (int i = 0; i < len && pos < size; ++i) {
         int32_t value = 0;
         shift = 0;
-        while (pos < buf.size()) {
+        while (pos < size) {
             uint8_t byte = buf[pos++];
             value |= (byte & 0x7F) << shift;
             if ((byte & 0x80) == 0) break;
@@ -279,7 +289,17 @@ FieldContext::FieldContext(const SerdeValue &containing_message,
       full_name_(full_name),
       name_(name),
       field_type_(field_type),
-      tags_(tags) {}
+      tags_(std::make_shared<const std::unordered_set<std::string>>(tags)) {}
+
+FieldContext::FieldContext(
+    const SerdeValue &containing_message, const std::string &full_name,
+    const std::string &name, FieldType field_type,
+    std::shared_ptr<const std::unordered_set<std::string>> tags)
+    : containing_message_(containing_message),
+      full_name_(full_name),
+      name_(name),
+      field_type_(field_type),
+      tags_(std::move(tags)) {}
 
 FieldType FieldContext::getFieldType() const {
     std::lock_guard<std::mutex> lock(field_type_mutex_);
@@ -339,11 +359,10 @@ std::string FieldContext::typeName() const {
 
 RuleContext::RuleContext(
     std::optional<std::string> enabled_env,
-    const SerializationContext &ser_ctx, std::optional<Schema> source,
-    std::optional<Schema> target, const std::string &subject, Mode rule_mode,
+    const SerializationContext &ser_ctx, const Schema *source,
+    const Schema *target, const std::string &subject, Mode rule_mode,
     const Rule &rule, size_t index, const std::vector<Rule> &rules,
-    std::unordered_map<std::string, std::unordered_set<std::string>>
-        inline_tags,
+    std::shared_ptr<const FieldTagIndex> tag_index,
     std::shared_ptr<FieldTransformer> field_transformer,
     std::shared_ptr<RuleRegistry> rule_registry)
     : enabled_env_(enabled_env),
@@ -352,18 +371,23 @@ RuleContext::RuleContext(
       target_(target),
       subject_(subject),
       rule_mode_(rule_mode),
-      rule_(rule),
+      rule_(&rule),
       index_(index),
-      rules_(rules),
-      inline_tags_(inline_tags),
+      rules_(&rules),
+      tag_index_(std::move(tag_index)),
       field_transformer_(field_transformer),
-      rule_registry_(rule_registry) {}
+      rule_registry_(rule_registry) {
+    auto rule_tags = rule_->getTags();
+    if (rule_tags.has_value()) {
+        rule_tags_.insert(rule_tags->begin(), rule_tags->end());
+    }
+}
 
 std::optional<std::string> RuleContext::getParameter(
     const std::string &name) const {
     // First check rule parameters
-    if (rule_.getParams().has_value()) {
-        auto params = rule_.getParams()
+    if (rule_->getParams().has_value()) {
+        auto params = rule_->getParams()
                           .value();  // Store copy to avoid dangling reference
         auto it = params.find(name);
         if (it != params.end()) {
@@ -372,7 +396,7 @@ std::optional<std::string> RuleContext::getParameter(
     }
 
     // Then check target schema metadata properties
-    if (target_.has_value() && target_->getMetadata().has_value()) {
+    if (target_ && target_->getMetadata().has_value()) {
         auto metadata = target_->getMetadata()
                             .value();  // Store copy to avoid dangling reference
         if (metadata.getProperties().has_value()) {
@@ -391,9 +415,11 @@ std::optional<std::string> RuleContext::getParameter(
 
 std::optional<std::unordered_set<std::string>> RuleContext::getInlineTags(
     const std::string &name) const {
-    auto it = inline_tags_.find(name);
-    if (it != inline_tags_.end()) {
-        return it->second;
+    if (tag_index_) {
+        const auto *tags = tag_index_->getInlineTags(name);
+        if (tags != nullptr) {
+            return *tags;
+        }
     }
     return std::nullopt;
 }
@@ -407,26 +433,30 @@ std::optional<FieldContext> RuleContext::currentField() const {
     const auto &back = *field_contexts_.back();
     return std::make_optional<FieldContext>(
         back.getContainingMessage(), back.getFullName(), back.getName(),
-        back.getFieldType(), back.getTags());
+        back.getFieldType(), back.getTagsHandle());
 }
 
 void RuleContext::enterField(const SerdeValue &containing_message,
                              const std::string &full_name,
                              const std::string &name, FieldType field_type,
                              const std::unordered_set<std::string> &tags) {
-    std::unordered_set<std::string> all_tags = tags;
-    if (all_tags.empty()) {
-        auto inline_tags = getInlineTags(full_name);
-        if (inline_tags.has_value()) {
-            all_tags = inline_tags.value();
+    std::shared_ptr<const std::unordered_set<std::string>> all_tags;
+    if (tags.empty() && tag_index_) {
+        // Inline and metadata tags, merged once per field by the index
+        all_tags = tag_index_->getTags(full_name);
+    } else {
+        auto merged = tags;
+        if (tag_index_) {
+            auto schema_tags = tag_index_->getMetadataTags(full_name);
+            merged.insert(schema_tags->begin(), schema_tags->end());
         }
+        all_tags = std::make_shared<const std::unordered_set<std::string>>(
+            std::move(merged));
     }
-    auto schema_tags = getTags(full_name);
-    all_tags.insert(schema_tags.begin(), schema_tags.end());
 
     // Use unique_ptr to avoid copy/move issues with FieldContext
     field_contexts_.push_back(std::make_unique<FieldContext>(
-        containing_message, full_name, name, field_type, all_tags));
+        containing_message, full_name, name, field_type, std::move(all_tags)));
 }
 
 void RuleContext::exitField() {
@@ -437,24 +467,32 @@ void RuleContext::exitField() {
 
 std::unordered_set<std::string> RuleContext::getTags(
     const std::string &full_name) const {
-    std::unordered_set<std::string> result;
+    if (!tag_index_) {
+        return {};
+    }
+    return *tag_index_->getMetadataTags(full_name);
+}
 
-    if (target_.has_value() && target_->getMetadata().has_value()) {
-        auto metadata = target_->getMetadata()
-                            .value();  // Store copy to avoid dangling reference
-        if (metadata.getTags().has_value()) {
-            auto tags_map =
-                metadata.getTags()
-                    .value();  // Store copy to avoid dangling reference
-            for (const auto &[pattern, tag] : tags_map) {
-                if (wildcardMatch(full_name, pattern)) {  // Fixed function name
-                    result.insert(pattern);
-                }
-            }
+bool RuleContext::appliesTo(
+    const std::unordered_set<std::string> &field_tags) const {
+    if (rule_tags_.empty()) {
+        return true;
+    }
+    for (const auto &tag : field_tags) {
+        if (rule_tags_.find(tag) != rule_tags_.end()) {
+            return true;
         }
     }
+    return false;
+}
 
-    return result;
+std::shared_ptr<const FieldVisitPlan> RuleContext::getVisitPlan(
+    const std::string &root,
+    const std::function<FieldVisitPlan()> &build) const {
+    if (rule_tags_.empty() || !tag_index_) {
+        return nullptr;
+    }
+    return tag_index_->getVisitPlan(root, rule_tags_, build);
 }
 
 // Serde implementation
@@ -462,7 +500,10 @@ std::unordered_set<std::string> RuleContext::getTags(
 Serde::Serde(
     std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client,
     std::shared_ptr<RuleRegistry> rule_registry)
-    : client_(client), rule_registry_(rule_registry) {}
+    : client_(client),
+      rule_registry_(rule_registry),
+      migration_plans_(
+          std::make_shared<MigrationPlans>(kMaxCachedMigrationPlans)) {}
 
 std::optional<RegisteredSchema> Serde::getReaderSchema(
     const std::string &subject, std::optional<std::string> format,
@@ -500,42 +541,39 @@ std::optional<RegisteredSchema> Serde::getReaderSchema(
 
 std::unique_ptr<SerdeValue> Serde::executeRules(
     const SerializationContext &ser_ctx, const std::string &subject,
-    Mode rule_mode, std::optional<Schema> source, std::optional<Schema> target,
-    const SerdeValue &msg,
-    std::unordered_map<std::string, std::unordered_set<std::string>>
-        inline_tags,
+    Mode rule_mode, const Schema *source, const Schema *target,
+    const SerdeValue &msg, std::shared_ptr<const FieldTagIndex> tag_index,
     std::shared_ptr<FieldTransformer> field_transformer) const {
     return executeRulesWithPhase(ser_ctx, subject, Phase::Domain, rule_mode,
-                                 source, target, msg, inline_tags,
+                                 source, target, msg, std::move(tag_index),
                                  field_transformer);
 }
 
 std::unique_ptr<SerdeValue> Serde::executeRulesWithPhase(
     const SerializationContext &ser_ctx, const std::string &subject,
-    Phase rule_phase, Mode rule_mode, std::optional<Schema> source,
-    std::optional<Schema> target, const SerdeValue &msg,
-    std::unordered_map<std::string, std::unordered_set<std::string>>
-        inline_tags,
+    Phase rule_phase, Mode rule_mode, const Schema *source,
+    const Schema *target, const SerdeValue &msg,
+    std::shared_ptr<const FieldTagIndex> tag_index,
     std::shared_ptr<FieldTransformer> field_transformer) const {
     std::optional<std::string> enabled_env;
     std::vector<Rule> rules;
 
     switch (rule_mode) {
         case Mode::Upgrade:
-            if (target.has_value() && target->getRuleSet().has_value()) {
+            if (target && target->getRuleSet().has_value()) {
                 enabled_env = target->getRuleSet()->getEnableAt();
             }
             rules = getMigrationRules(target);
             break;
         case Mode::Downgrade:
-            if (source.has_value() && source->getRuleSet().has_value()) {
+            if (source && source->getRuleSet().has_value()) {
                 enabled_env = source->getRuleSet()->getEnableAt();
             }
             rules = getMigrationRules(source);
             std::reverse(rules.begin(), rules.end());
             break;
         default:
-            if (target.has_value() && target->getRuleSet().has_value()) {
+            if (target && target->getRuleSet().has_value()) {
                 enabled_env = target->getRuleSet()->getEnableAt();
             }
             if (rule_phase == Phase::Encoding) {
@@ -549,9 +587,24 @@ std::unique_ptr<SerdeValue> Serde::executeRulesWithPhase(
             break;
     }
 
+    return executeRuleList(ser_ctx, subject, rule_mode, enabled_env, rules,
+                           source, target, msg, std::move(tag_index),
+                           std::move(field_transformer));
+}
+
+std::unique_ptr<SerdeValue> Serde::executeRuleList(
+    const SerializationContext &ser_ctx, const std::string &subject,
+    Mode rule_mode, const std::optional<std::string> &enabled_env,
+    const std::vector<Rule> &rules, const Schema *source,
+    const Schema *target, const SerdeValue &msg,
+    std::shared_ptr<const FieldTagIndex> tag_index,
+    std::shared_ptr<FieldTransformer> field_transformer) const {
     if (rules.empty()) {
         return msg.clone();
     }
+    if (!tag_index && target) {
+        tag_index = FieldTagIndex::forSchema(*target);
+    }
 
     // Create a local variable to track the current message state
     auto current_msg = msg.clone();
@@ -560,7 +613,7 @@ std::unique_ptr<SerdeValue> Serde::executeRulesWithPhase(
         const auto &rule = rules[index];
 
         RuleContext ctx(enabled_env, ser_ctx, source, target, subject,
-                        rule_mode, rule, index, rules, inline_tags,
+                        rule_mode, rule, index, rules, tag_index,
                         field_transformer, rule_registry_);
 
         if (isDisabled(ctx, rule)) {
@@ -642,7 +695,34 @@ std::unique_ptr<SerdeValue> Serde::executeRulesWithPhase(
     return std::move(current_msg);
 }
 
-std::vector<Migration> Serde::getMigrations(
+std::shared_ptr<const std::vector<Migration>> Serde::getMigrations(
+    const std::string &subject, const Schema &source_info,
+    const RegisteredSchema &target, std::optional<std::string> format) const {
+    // The writer schema is looked up by content, so its fingerprint stands
+    // for its ID; the reader schema is identified by version and content
+    auto source_fingerprint = source_info.getFingerprint();
+    auto target_fingerprint = target.getSchemaHandle()->getFingerprint();
+    std::string key = subject;
+    key.push_back('\0');
+    key.append(format.value_or(""));
+    key.push_back('\0');
+    key.append(source_fingerprint.toHex());
+    key.push_back('\0');
+    key.append(std::to_string(target.getVersion().value_or(0)));
+    key.push_back('\0');
+    key.append(target_fingerprint.toHex());
+
+    if (auto cached = migration_plans_->get(key); cached.has_value()) {
+        return std::move(*cached);
+    }
+
+    auto migrations = std::make_shared<const std::vector<Migration>>(
+        planMigrations(subject, source_info, target, format));
+    migration_plans_->put(key, migrations);
+    return migrations;
+}
+
+std::vector<Migration> Serde::planMigrations(
     const std::string &subject, const Schema &source_info,
     const RegisteredSchema &target, std::optional<std::string> format) const {
     auto source = client_->getBySchema(subject, source_info, false, true);
@@ -687,7 +767,8 @@ std::vector<Migration> Serde::getMigrations(
                 migration.source = version;
                 migration.target = *previous;
             }
-            migrations.push_back(migration);
+            prepareMigration(migration);
+            migrations.push_back(std::move(migration));
         }
 
         previous = &version;
@@ -700,6 +781,33 @@ std::vector<Migration> Serde::getMigrations(
     return migrations;
 }
 
+void Serde::prepareMigration(Migration &migration) const {
+    if (migration.source.has_value()) {
+        migration.source_schema = migration.source->toSchema();
+    }
+    if (migration.target.has_value()) {
+        migration.target_schema = migration.target->toSchema();
+    }
+
+    // Same rules as executeRulesWithPhase selects for the migration phase
+    const auto &rule_schema = migration.rule_mode == Mode::Upgrade
+                                  ? migration.target_schema
+                                  : migration.source_schema;
+    if (rule_schema.has_value() && rule_schema->getRuleSet().has_value()) {
+        migration.enabled_env = rule_schema->getRuleSet()->getEnableAt();
+    }
+    migration.rules =
+        getMigrationRules(rule_schema.has_value() ? &*rule_schema : nullptr);
+    if (migration.rule_mode == Mode::Downgrade) {
+        std::reverse(migration.rules.begin(), migration.rules.end());
+    }
+    if (!migration.rules.empty() && migration.target_schema.has_value()) {
+        migration.tag_index =
+            FieldTagIndex::forSchema(*migration.target_schema);
+    }
+    migration.prepared = true;
+}
+
 std::vector<RegisteredSchema> Serde::getSchemasBetween(
     const std::string &subject, const RegisteredSchema &first,
     const RegisteredSchema &last, std::optional<std::string> format) const {
@@ -726,6 +834,16 @@ std::unique_ptr<SerdeValue> Serde::executeMigrations(
     const std::vector<Migration> &migrations, const SerdeValue &msg) const {
     auto current_msg = msg.clone();
     for (const auto &migration : migrations) {
+        if (migration.prepared) {
+            current_msg = executeRuleList(
+                ser_ctx, subject, migration.rule_mode, migration.enabled_env,
+                migration.rules,
+                migration.source_schema ? &*migration.source_schema : nullptr,
+                migration.target_schema ? &*migration.target_schema : nullptr,
+                *current_msg, migration.tag_index, nullptr);
+            continue;
+        }
+
         std::optional<Schema> source =
             migration.source.has_value()
                 ? std::make_optional(migration.source->toSchema())
@@ -735,9 +853,10 @@ std::unique_ptr<SerdeValue> Serde::executeMigrations(
                 ? std::make_optional(migration.target->toSchema())
                 : std::nullopt;
 
-        current_msg = executeRulesWithPhase(ser_ctx, subject, Phase::Migration,
-                                            migration.rule_mode, source, target,
-                                            *current_msg, {});
+        current_msg = executeRulesWithPhase(
+            ser_ctx, subject, Phase::Migration, migration.rule_mode,
+            source ? &*source : nullptr, target ? &*target : nullptr,
+            *current_msg, {});
     }
 
     return current_msg;
@@ -745,43 +864,43 @@ std::unique_ptr<SerdeValue> Serde::executeMigrations(
 
 // Helper methods
 
-std::vector<Rule> Serde::getMigrationRules(std::optional<Schema> schema) const {
-    if (!schema.has_value() || !schema->getRuleSet().has_value()) {
+std::vector<Rule> Serde::getMigrationRules(const Schema *schema) const {
+    if (!schema || !schema->getRuleSet().has_value()) {
         return {};
     }
 
-    auto rule_set = schema->getRuleSet().value();
-    if (!rule_set.getMigrationRules().has_value()) {
+    auto rules = schema->getRuleSet()->getMigrationRules();
+    if (!rules.has_value()) {
         return {};
     }
 
-    return rule_set.getMigrationRules().value();
+    return std::move(rules.value());
 }
 
-std::vector<Rule> Serde::getDomainRules(std::optional<Schema> schema) const {
-    if (!schema.has_value() || !schema->getRuleSet().has_value()) {
+std::vector<Rule> Serde::getDomainRules(const Schema *schema) const {
+    if (!schema || !schema->getRuleSet().has_value()) {
         return {};
     }
 
-    auto rule_set = schema->getRuleSet().value();
-    if (!rule_set.getDomainRules().has_value()) {
+    auto rules = schema->getRuleSet()->getDomainRules();
+    if (!rules.has_value()) {
         return {};
     }
 
-    return rule_set.getDomainRules().value();
+    return std::move(rules.value());
 }
 
-std::vector<Rule> Serde::getEncodingRules(std::optional<Schema> schema) const {
-    if (!schema.has_value() || !schema->getRuleSet().has_value()) {
+std::vector<Rule> Serde::getEncodingRules(const Schema *schema) const {
+    if (!schema || !schema->getRuleSet().has_value()) {
         return {};
     }
 
-    auto rule_set = schema->getRuleSet().value();
-    if (!rule_set.getEncodingRules().has_value()) {
+    auto rules = schema->getRuleSet()->getEncodingRules();
+    if (!rules.has_value()) {
         return {};
     }
 
-    return rule_set.getEncodingRules().value();
+    return std::move(rules.value());
 }
 
 std::optional<std::string> Serde::getOnSuccess(const Rule &rule) const {
@@ -983,14 +1102,21 @@ BaseDeserializer::BaseDeserializer(Serde serde,
     : serde_(std::move(serde)), config_(config) {}
 
 Schema BaseDeserializer::getWriterSchema(
+    const SchemaId &schema_id, std::optional<std::string> subject,
+    std::optional<std::string> format) const {
+    return *getWriterSchemaHandle(schema_id, std::move(subject),
+                                  std::move(format));
+}
+
+std::shared_ptr<const Schema> BaseDeserializer::getWriterSchemaHandle(
     const SchemaId &schema_id, std::optional<std::string> subject,
     std::optional<std::string> format) const {
     if (schema_id.getId().has_value()) {
-        return serde_.getClient()->getBySubjectAndId(
+        return serde_.getClient()->getSchemaHandleBySubjectAndId(
             subject.value_or(""), schema_id.getId().value(), format);
     } else if (schema_id.getGuid().has_value()) {
-        return serde_.getClient()->getByGuid(schema_id.getGuid().value(),
-                                             format);
+        return serde_.getClient()->getSchemaHandleByGuid(
+            schema_id.getGuid().value(), format);
     } else {
         throw SerdeError("Schema ID or GUID are not set");
     }
@@ -1024,14 +1150,13 @@ AssociatedNameStrategy::AssociatedNameStrategy(
 
 std::optional<std::string> AssociatedNameStrategy::getSubject(
     const std::string &topic, SerdeType serde_type,
-    const std::optional<Schema> &schema) const {
+    const Schema *schema) const {
     if (topic.empty()) {
         return std::nullopt;
     }
 
     bool is_key = (serde_type == SerdeType::Key);
-    std::string schema_str =
-        schema.has_value() ? schema->getSchema().value_or("") : "";
+    std::string schema_str = schema ? schema->getSchema().value_or("") : "";
 
     SubjectCacheKey cache_key{topic, is_key, schema_str};
 
@@ -1051,7 +1176,7 @@ std::optional<std::string> AssociatedNameStrategy::getSubject(
 }
 
 std::optional<std::string> AssociatedNameStrategy::loadAssociatedSubjectName(
-    const std::string &topic, bool is_key, const std::optional<Schema> &schema,
+    const std::string &topic, bool is_key, const Schema *schema,
     SerdeType serde_type) const {
     std::string association_type = is_key ? "key" : "value";
 
@@ -61,8 +61,7 @@ DeserializerConfig DeserializerConfig::createDefault() {
 // Default strategy functions implementation
 
 std::optional<std::string> topicNameStrategy(
-    const std::string &topic, SerdeType serde_type,
-    const std::optional<Schema> &schema) {
+    const std::string &topic, SerdeType serde_type, const Schema *schema) {
     switch (serde_type) {
         case SerdeType::Key:
             return topic + "-key";
@@ -78,8 +77,7 @@ std::optional<SubjectNameStrategyFunc> strategyFunc(
     switch (strategy_type) {
         case SubjectNameStrategyType::Topic:
             return [](const std::string &topic, SerdeType serde_type,
-                      const std::optional<Schema> &schema)
-                       -> std::optional<std::string> {
+                      const Schema *schema) -> std::optional<std::string> {
                 return topicNameStrategy(topic, serde_type, schema);
             };
         case SubjectNameStrategyType::Record:
@@ -100,8 +98,7 @@ std::optional<SubjectNameStrategyFunc> strategyFunc(
             return std::nullopt;
         default:
             return [](const std::string &topic, SerdeType serde_type,
-                      const std::optional<Schema> &schema)
-                       -> std::optional<std::string> {
+                      const Schema *schema) -> std::optional<std::string> {
                 return topicNameStrategy(topic, serde_type, schema);
             };
     }
@@ -109,9 +106,9 @@ std::optional<SubjectNameStrategyFunc> strategyFunc(
 
 SubjectNameStrategyFunc recordNameStrategy(RecordNameFunc get_record_name) {
     return [get_record_name](const std::string &topic, SerdeType serde_type,
-                             const std::optional<Schema> &schema)
+                             const Schema *schema)
                -> std::optional<std::string> {
-        if (!schema.has_value()) {
+        if (!schema) {
             return std::nullopt;
         }
         return get_record_name(schema);
@@ -120,9 +117,9 @@ SubjectNameStrategyFunc recordNameStrategy(RecordNameFunc get_record_name) {
 
 SubjectNameStrategyFunc topicRecordNameStrategy(RecordNameFunc get_record_name) {
     return [get_record_name](const std::string &topic, SerdeType serde_type,
-                             const std::optional<Schema> &schema)
+                             const Schema *schema)
                -> std::optional<std::string> {
-        if (!schema.has_value()) {
+        if (!schema) {
             return std::nullopt;
         }
         return topic + "-" + get_record_name(schema);
@@ -142,8 +139,7 @@ SubjectNameStrategyFunc configureSubjectNameStrategy(
         auto assoc = std::make_shared<AssociatedNameStrategy>(
             std::move(client), strategy_config, get_record_name);
         return [assoc](const std::string &topic, SerdeType serde_type,
-                       const std::optional<Schema> &schema)
-                   -> std::optional<std::string> {
+                       const Schema *schema) -> std::optional<std::string> {
             return assoc->getSubject(topic, serde_type, schema);
         };
     }
@@ -206,9 +202,18 @@ std::vector<uint8_t> headerSchemaIdSerializer(
     }
 }
 
-size_t dualSchemaIdDeserializer(const std::vector<uint8_t> &payload,
-                                const SerializationContext &ser_ctx,
-                                SchemaId &schema_id) {
+namespace {
+
+using SchemaIdDeserializerFn = size_t (*)(const std::vector<uint8_t> &,
+                                          const SerializationContext &,
+                                          SchemaId &);
+using SchemaIdSerializerFn = std::vector<uint8_t> (*)(
+    const std::vector<uint8_t> &, const SerializationContext &,
+    const SchemaId &);
+
+size_t readDualSchemaId(const uint8_t *payload, size_t size,
+                        const SerializationContext &ser_ctx,
+                        SchemaId &schema_id) {
     try {
         // First try to get schema ID from headers
         if (ser_ctx.headers.has_value()) {
@@ -236,18 +241,17 @@ size_t dualSchemaIdDeserializer(const std::vector<uint8_t> &payload,
         }
 
         // Fall back to reading from payload prefix
-        return schema_id.readFromBytes(payload);
+        return schema_id.readFromBytes(payload, size);
     } catch (const std::exception &e) {
         throw SerializationError("Failed to deserialize schema ID: " +
                                  std::string(e.what()));
     }
 }
 
-size_t prefixSchemaIdDeserializer(const std::vector<uint8_t> &payload,
-                                  const SerializationContext &ser_ctx,
-                                  SchemaId &schema_id) {
+size_t readPrefixSchemaId(const uint8_t *payload, size_t size,
+                          SchemaId &schema_id) {
     try {
-        return schema_id.readFromBytes(payload);
+        return schema_id.readFromBytes(payload, size);
     } catch (const std::exception &e) {
         throw SerializationError(
             "Failed to deserialize schema ID from prefix: " +
@@ -255,4 +259,45 @@ size_t prefixSchemaIdDeserializer(const std::vector<uint8_t> &payload,
     }
 }
 
+}  // namespace
+
+size_t dualSchemaIdDeserializer(const std::vector<uint8_t> &payload,
+                                const SerializationContext &ser_ctx,
+                                SchemaId &schema_id) {
+    return readDualSchemaId(payload.data(), payload.size(), ser_ctx,
+                            schema_id);
+}
+
+size_t prefixSchemaIdDeserializer(const std::vector<uint8_t> &payload,
+                                  const SerializationContext &ser_ctx,
+                                  SchemaId &schema_id) {
+    return readPrefixSchemaId(payload.data(), payload.size(), schema_id);
+}
+
+size_t readSchemaId(const SchemaIdDeserializer &deserializer,
+                    const uint8_t *payload, size_t size,
+                    const SerializationContext &ser_ctx, SchemaId &schema_id) {
+    if (const auto *fn = deserializer.target<SchemaIdDeserializerFn>()) {
+        if (*fn == dualSchemaIdDeserializer) {
+            return readDualSchemaId(payload, size, ser_ctx, schema_id);
+        }
+        if (*fn == prefixSchemaIdDeserializer) {
+            return readPrefixSchemaId(payload, size, schema_id);
+        }
+    }
+    // Custom deserializers only take vectors
+    return deserializer(std::vector<uint8_t>(payload, payload + size), ser_ctx,
+                        schema_id);
+}
+
+std::optional<std::vector<uint8_t>> schemaIdPrefix(
+    const SchemaIdSerializer &serializer, const SchemaId &schema_id) {
+    const auto *fn = serializer.target<SchemaIdSerializerFn>();
+    if (fn == nullptr || *fn != prefixSchemaIdSerializer ||
+        !schema_id.getId().has_value()) {
+        return std::nullopt;
+    }
+    return schema_id.idToBytes();
+}
+
 }  // namespace schemaregistry::serdes
\ No newline at end of file
@@ -110,15 +110,13 @@ SubjectNameStrategyType parseSubjectNameStrategyType(const std::string &s) {
 template <typename T>
 void ParsedSchemaCache<T>::set(const Schema &schema, const T &parsed_schema) {
     std::lock_guard<std::mutex> lock(mutex_);
-    std::string key = getSchemaKey(schema);
-    cache_[key] = parsed_schema;
+    cache_[schema.getFingerprint()] = parsed_schema;
 }
 
 template <typename T>
 std::optional<T> ParsedSchemaCache<T>::get(const Schema &schema) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    std::string key = getSchemaKey(schema);
-    auto it = cache_.find(key);
+    auto it = cache_.find(schema.getFingerprint());
     if (it != cache_.end()) {
         return it->second;
     }
@@ -131,14 +129,6 @@ void ParsedSchemaCache<T>::clear() {
     cache_.clear();
 }
 
-template <typename T>
-std::string ParsedSchemaCache<T>::getSchemaKey(const Schema &schema) const {
-    // Us the JSON representation of the schema to create a hash
-    nlohmann::json j;
-    to_json(j, schema);
-    return j.dump();
-}
-
 // Explicit template instantiations for common types
 template class ParsedSchemaCache<std::string>;
 template class ParsedSchemaCache<int>;
@@ -5,8 +5,11 @@
 
 #include "schemaregistry/serdes/WildcardMatcher.h"
 
+#include <algorithm>
 #include <stdexcept>
 
+#include "schemaregistry/rest/TtlLruCache.h"
+
 namespace schemaregistry::serdes {
 
 namespace {
@@ -46,22 +49,40 @@ std::pair<std::string, size_t> doubleSlashes(const std::string &dst,
     return std::make_pair(result, i);
 }
 
-}  // anonymous namespace
-
-std::string wildcardToRegexp(const std::string &pattern,
-                             const std::string &separator) {
-    std::string dst;
-
-    // Replace **<separator>* with ** to handle the special case
+// Replace all occurrences of **<separator>* with **
+std::string collapseDoubleStars(const std::string &pattern,
+                                const std::string &separator) {
     std::string pat = "**" + separator + "*";
     std::string src = pattern;
-
-    // Replace all occurrences of **<separator>* with **
     size_t pos = 0;
     while ((pos = src.find(pat, pos)) != std::string::npos) {
         src.replace(pos, pat.length(), "**");
         pos += 2;  // Length of "**"
     }
+    return src;
+}
+
+// Compiled matchers by pattern. Patterns come from schema metadata, so
+// there are few of them; the least recently used is evicted first.
+constexpr size_t kMaxCachedMatchers = 1024;
+
+using MatcherCache =
+    schemaregistry::rest::TtlLruCache<std::string,
+                                      std::shared_ptr<const WildcardMatcher>>;
+
+MatcherCache &matcherCache() {
+    static MatcherCache cache(kMaxCachedMatchers);
+    return cache;
+}
+
+}  // anonymous namespace
+
+std::string wildcardToRegexp(const std::string &pattern,
+                             const std::string &separator) {
+    std::string dst;
+
+    // Replace **<separator>* with ** to handle the special case
+    std::string src = collapseDoubleStars(pattern, separator);
 
     size_t i = 0;
     size_t size = src.length();
@@ -98,21 +119,155 @@ std::string wildcardToRegexp(const std::string &pattern,
 }
 
 bool wildcardMatch(const std::string &text, const std::string &matcher) {
-    try {
-        std::string regexPattern = wildcardToRegexp(matcher, ".");
-        std::regex pattern(regexPattern);
-        std::smatch match;
-
-        if (std::regex_search(text, match, pattern)) {
-            // Check if the match covers the entire string
-            return match.position() == 0 && match.length() == text.length();
+    return WildcardMatcher::compile(matcher)->matches(text);
+}
+
+WildcardMatcher::WildcardMatcher(const std::string &pattern) {
+    std::string src = collapseDoubleStars(pattern, ".");
+
+    // Tokenize the same way wildcardToRegexp translates the pattern
+    bool wildcards = false;
+    bool needs_regex = false;
+    size_t i = 0;
+    while (i < src.length() && !needs_regex) {
+        char c = src[i];
+        i++;
+
+        if (c == '*') {
+            // One char lookahead for **
+            if (i < src.length() && src[i] == '*') {
+                tokens_.push_back({Op::AnyPath, c});
+                i++;
+            } else {
+                tokens_.push_back({Op::AnySegment, c});
+            }
+            wildcards = true;
+        } else if (c == '?') {
+            tokens_.push_back({Op::AnyChar, c});
+            wildcards = true;
+        } else if (c == '\\') {
+            if (i < src.length()) {
+                char next = src[i];
+                i++;
+                // An escaped backslash or bracket keeps its regex meaning
+                needs_regex = next == '\\' || next == '[' || next == ']';
+                tokens_.push_back({Op::Char, next});
+            } else {
+                // A backslash at the very end is a literal backslash
+                tokens_.push_back({Op::Char, c});
+            }
+        } else {
+            // Bracket expressions are passed through to the regex
+            needs_regex = c == '[' || c == ']';
+            tokens_.push_back({Op::Char, c});
         }
+    }
 
+    if (needs_regex) {
+        tokens_.clear();
+        try {
+            regex_.emplace(wildcardToRegexp(pattern, "."));
+        } catch (const std::regex_error &e) {
+            // Patterns that fail to compile match nothing
+            invalid_ = true;
+        }
+    } else if (!wildcards) {
+        literal_.emplace();
+        for (const auto &token : tokens_) {
+            literal_->push_back(token.c);
+        }
+    }
+}
+
+std::shared_ptr<const WildcardMatcher> WildcardMatcher::compile(
+    const std::string &pattern) {
+    auto &cache = matcherCache();
+    if (auto cached = cache.get(pattern); cached.has_value()) {
+        return std::move(*cached);
+    }
+
+    auto matcher = std::make_shared<const WildcardMatcher>(pattern);
+    cache.put(pattern, matcher);
+    return matcher;
+}
+
+bool WildcardMatcher::matches(const std::string &text) const {
+    if (invalid_) {
         return false;
-    } catch (const std::regex_error &e) {
-        // If regex compilation fails, return false
-        return false;
     }
+    if (regex_.has_value()) {
+        return matchRegex(text);
+    }
+    if (literal_.has_value()) {
+        return text == *literal_;
+    }
+
+    // Track every pattern position reachable after the text read so far.
+    // Position n means the whole pattern was matched.
+    size_t n = tokens_.size();
+    std::vector<char> current(n + 1, 0);
+    std::vector<char> next(n + 1, 0);
+
+    // Activate pos, and the positions after any wildcards matching nothing
+    auto activate = [&](std::vector<char> &states, size_t pos) {
+        while (!states[pos]) {
+            states[pos] = 1;
+            if (pos == n || (tokens_[pos].op != Op::AnySegment &&
+                             tokens_[pos].op != Op::AnyPath)) {
+                break;
+            }
+            pos++;
+        }
+    };
+
+    activate(current, 0);
+    for (char c : text) {
+        std::fill(next.begin(), next.end(), 0);
+        for (size_t pos = 0; pos < n; ++pos) {
+            if (!current[pos]) {
+                continue;
+            }
+            const auto &token = tokens_[pos];
+            switch (token.op) {
+                case Op::Char:
+                    if (c == token.c) {
+                        activate(next, pos + 1);
+                    }
+                    break;
+                case Op::AnyChar:
+                    if (c != '.') {
+                        activate(next, pos + 1);
+                    }
+                    break;
+                case Op::AnySegment:
+                    if (c != '.') {
+                        activate(next, pos);
+                    }
+                    break;
+                case Op::AnyPath:
+                    // As the regex '.', which does not match line breaks
+                    if (c != '\n' && c != '\r') {
+                        activate(next, pos);
+                    }
+                    break;
+            }
+        }
+        current.swap(next);
+        if (std::find(current.begin(), current.end(), 1) == current.end()) {
+            return false;
+        }
+    }
+    return current[n];
+}
+
+bool WildcardMatcher::matchRegex(const std::string &text) const {
+    std::smatch match;
+    if (std::regex_search(text, match, *regex_)) {
+        // Check if the match covers the entire string
+        return match.position() == 0 &&
+               static_cast<size_t>(match.length()) == text.length();
+    }
+    return false;
 }
 
 }  // namespace schemaregistry::serdes
\ No newline at end of file
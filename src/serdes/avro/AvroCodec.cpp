@@ -0,0 +1,494 @@
+/**
+ * AvroCodec
+ * Avro binary encoding compiled from a schema into a flat program
+ */
+
+#include "schemaregistry/serdes/avro/AvroCodec.h"
+
+#include <avro/NodeImpl.hh>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "schemaregistry/serdes/avro/AvroTypes.h"
+
+namespace schemaregistry::serdes::avro {
+
+namespace {
+
+// Floats and doubles are written as their IEEE 754 bits
+static_assert(std::numeric_limits<float>::is_iec559 &&
+                  std::numeric_limits<double>::is_iec559,
+              "Avro floats and doubles require IEEE 754 types");
+
+void writeLong(int64_t value, std::vector<uint8_t> &out) {
+    // Zig-zag encoding, then groups of 7 bits, least significant first
+    uint64_t n = (static_cast<uint64_t>(value) << 1) ^
+                 static_cast<uint64_t>(value >> 63);
+    while (n & ~uint64_t{0x7f}) {
+        out.push_back(static_cast<uint8_t>((n & 0x7f) | 0x80));
+        n >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(n));
+}
+
+void writeRaw(const void *data, size_t size, std::vector<uint8_t> &out) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+void writeBytes(const void *data, size_t size, std::vector<uint8_t> &out) {
+    writeLong(static_cast<int64_t>(size), out);
+    writeRaw(data, size, out);
+}
+
+// Write the bits of a float or double little-endian, whatever the host's
+// byte order
+template <typename Bits, typename Value>
+void writeLittleEndian(Value value, std::vector<uint8_t> &out) {
+    static_assert(sizeof(Bits) == sizeof(Value));
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+        out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+    }
+}
+
+}  // namespace
+
+/**
+ * Bounds-checked cursor over the buffer being decoded
+ */
+class AvroCodec::Reader {
+  public:
+    Reader(const uint8_t *data, size_t size) : pos_(data), end_(data + size) {}
+
+    int64_t readLong() {
+        uint64_t n = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = readByte();
+            n |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return static_cast<int64_t>(n >> 1) ^
+                       -static_cast<int64_t>(n & 1);
+            }
+        }
+        throw AvroError("Invalid Avro varint");
+    }
+
+    int32_t readInt() {
+        int64_t value = readLong();
+        if (value < INT32_MIN || value > INT32_MAX) {
+            throw AvroError("Value out of range for Avro int: " +
+                            std::to_string(value));
+        }
+        return static_cast<int32_t>(value);
+    }
+
+    size_t readSize() {
+        int64_t size = readLong();
+        if (size < 0) {
+            throw AvroError("Negative Avro length: " + std::to_string(size));
+        }
+        return static_cast<size_t>(size);
+    }
+
+    uint8_t readByte() {
+        if (pos_ == end_) {
+            throw AvroError("Unexpected end of Avro data");
+        }
+        return *pos_++;
+    }
+
+    const uint8_t *readRaw(size_t size) {
+        if (static_cast<size_t>(end_ - pos_) < size) {
+            throw AvroError("Unexpected end of Avro data");
+        }
+        const uint8_t *data = pos_;
+        pos_ += size;
+        return data;
+    }
+
+    /**
+     * Read the little-endian bits of a float or double
+     */
+    template <typename Bits, typename Value>
+    Value readLittleEndian() {
+        static_assert(sizeof(Bits) == sizeof(Value));
+        const uint8_t *bytes = readRaw(sizeof(Bits));
+        Bits bits = 0;
+        for (size_t i = 0; i < sizeof(bits); ++i) {
+            bits |= static_cast<Bits>(bytes[i]) << (8 * i);
+        }
+        Value value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /**
+     * Read the item count of the next block of an array or map, 0 at the end
+     */
+    size_t readBlockCount() {
+        int64_t count = readLong();
+        if (count == INT64_MIN) {
+            throw AvroError("Invalid Avro block count: " +
+                            std::to_string(count));
+        }
+        if (count < 0) {
+            // Negative counts are followed by the byte size of the block
+            readLong();
+            return static_cast<size_t>(-count);
+        }
+        return static_cast<size_t>(count);
+    }
+
+  private:
+    const uint8_t *pos_;
+    const uint8_t *end_;
+};
+
+AvroCodec::AvroCodec(const ::avro::ValidSchema &schema) : schema_(schema) {
+    NamedInstructions named;
+    compile(schema_.root(), named);
+}
+
+::avro::Type AvroCodec::typeOf(Op op) {
+    switch (op) {
+        case Op::Null:
+            return ::avro::AVRO_NULL;
+        case Op::Bool:
+            return ::avro::AVRO_BOOL;
+        case Op::Int:
+            return ::avro::AVRO_INT;
+        case Op::Long:
+            return ::avro::AVRO_LONG;
+        case Op::Float:
+            return ::avro::AVRO_FLOAT;
+        case Op::Double:
+            return ::avro::AVRO_DOUBLE;
+        case Op::Bytes:
+            return ::avro::AVRO_BYTES;
+        case Op::String:
+            return ::avro::AVRO_STRING;
+        case Op::Fixed:
+            return ::avro::AVRO_FIXED;
+        case Op::Enum:
+            return ::avro::AVRO_ENUM;
+        case Op::Record:
+            return ::avro::AVRO_RECORD;
+        case Op::Array:
+            return ::avro::AVRO_ARRAY;
+        case Op::Map:
+            return ::avro::AVRO_MAP;
+        case Op::Union:
+            return ::avro::AVRO_UNION;
+    }
+    return ::avro::AVRO_UNKNOWN;
+}
+
+uint32_t AvroCodec::compile(const ::avro::NodePtr &node,
+                            NamedInstructions &named) {
+    if (node->type() == ::avro::AVRO_SYMBOLIC) {
+        auto resolved = ::avro::resolveSymbol(node);
+        auto it = named.find(resolved.get());
+        return it != named.end() ? it->second : compile(resolved, named);
+    }
+
+    auto pc = static_cast<uint32_t>(program_.size());
+    program_.push_back({});
+    nodes_.push_back(node);
+    if (node->hasName()) {
+        named.emplace(node.get(), pc);
+    }
+
+    Instruction instruction;
+    switch (node->type()) {
+        case ::avro::AVRO_NULL:
+            instruction.op = Op::Null;
+            break;
+        case ::avro::AVRO_BOOL:
+            instruction.op = Op::Bool;
+            break;
+        case ::avro::AVRO_INT:
+            instruction.op = Op::Int;
+            break;
+        case ::avro::AVRO_LONG:
+            instruction.op = Op::Long;
+            break;
+        case ::avro::AVRO_FLOAT:
+            instruction.op = Op::Float;
+            break;
+        case ::avro::AVRO_DOUBLE:
+            instruction.op = Op::Double;
+            break;
+        case ::avro::AVRO_BYTES:
+            instruction.op = Op::Bytes;
+            break;
+        case ::avro::AVRO_STRING:
+            instruction.op = Op::String;
+            break;
+        case ::avro::AVRO_FIXED:
+            instruction.op = Op::Fixed;
+            instruction.count = static_cast<uint32_t>(node->fixedSize());
+            break;
+        case ::avro::AVRO_ENUM:
+            instruction.op = Op::Enum;
+            instruction.count = static_cast<uint32_t>(node->names());
+            break;
+        case ::avro::AVRO_ARRAY:
+        case ::avro::AVRO_MAP: {
+            instruction.op =
+                node->type() == ::avro::AVRO_ARRAY ? Op::Array : Op::Map;
+            // Map nodes hold the key type at 0 and the value type at 1
+            size_t leaf = node->type() == ::avro::AVRO_ARRAY ? 0 : 1;
+            instruction.operand = compile(node->leafAt(leaf), named);
+            break;
+        }
+        case ::avro::AVRO_RECORD:
+        case ::avro::AVRO_UNION: {
+            instruction.op =
+                node->type() == ::avro::AVRO_RECORD ? Op::Record : Op::Union;
+            instruction.count = static_cast<uint32_t>(node->leaves());
+            // Children are compiled first, since they append to children_
+            std::vector<uint32_t> children;
+            children.reserve(node->leaves());
+            for (size_t i = 0; i < node->leaves(); ++i) {
+                children.push_back(compile(node->leafAt(i), named));
+            }
+            instruction.operand = static_cast<uint32_t>(children_.size());
+            children_.insert(children_.end(), children.begin(),
+                             children.end());
+            break;
+        }
+        default:
+            throw AvroError("Unsupported Avro type in schema: " +
+                            ::avro::toString(node->type()));
+    }
+    program_[pc] = instruction;
+    return pc;
+}
+
+void AvroCodec::encode(const ::avro::GenericDatum &datum,
+                       std::vector<uint8_t> &out) const {
+    encode(0, datum, out);
+}
+
+void AvroCodec::encode(uint32_t pc, const ::avro::GenericDatum &datum,
+                       std::vector<uint8_t> &out) const {
+    const Instruction &instruction = program_[pc];
+    // GenericDatum::value does not check the type of the datum
+    bool matches = instruction.op == Op::Union
+                       ? datum.isUnion()
+                       : datum.type() == typeOf(instruction.op);
+    if (!matches) {
+        throw AvroError("Datum of type " + ::avro::toString(datum.type()) +
+                        " does not match schema type " +
+                        ::avro::toString(typeOf(instruction.op)));
+    }
+
+    switch (instruction.op) {
+        case Op::Null:
+            break;
+        case Op::Bool:
+            out.push_back(datum.value<bool>() ? 1 : 0);
+            break;
+        case Op::Int:
+            writeLong(datum.value<int32_t>(), out);
+            break;
+        case Op::Long:
+            writeLong(datum.value<int64_t>(), out);
+            break;
+        case Op::Float:
+            writeLittleEndian<uint32_t>(datum.value<float>(), out);
+            break;
+        case Op::Double:
+            writeLittleEndian<uint64_t>(datum.value<double>(), out);
+            break;
+        case Op::Bytes: {
+            const auto &bytes = datum.value<std::vector<uint8_t>>();
+            writeBytes(bytes.data(), bytes.size(), out);
+            break;
+        }
+        case Op::String: {
+            const auto &str = datum.value<std::string>();
+            writeBytes(str.data(), str.size(), out);
+            break;
+        }
+        case Op::Fixed: {
+            const auto &bytes = datum.value<::avro::GenericFixed>().value();
+            if (bytes.size() != instruction.count) {
+                throw AvroError("Fixed value of size " +
+                                std::to_string(bytes.size()) +
+                                " does not match schema size " +
+                                std::to_string(instruction.count));
+            }
+            writeRaw(bytes.data(), bytes.size(), out);
+            break;
+        }
+        case Op::Enum:
+            writeLong(static_cast<int64_t>(
+                          datum.value<::avro::GenericEnum>().value()),
+                      out);
+            break;
+        case Op::Record: {
+            const auto &record = datum.value<::avro::GenericRecord>();
+            if (record.fieldCount() != instruction.count) {
+                throw AvroError("Record with " +
+                                std::to_string(record.fieldCount()) +
+                                " fields does not match schema with " +
+                                std::to_string(instruction.count));
+            }
+            for (uint32_t i = 0; i < instruction.count; ++i) {
+                encode(children_[instruction.operand + i], record.fieldAt(i),
+                       out);
+            }
+            break;
+        }
+        case Op::Array: {
+            const auto &items = datum.value<::avro::GenericArray>().value();
+            if (!items.empty()) {
+                writeLong(static_cast<int64_t>(items.size()), out);
+                for (const auto &item : items) {
+                    encode(instruction.operand, item, out);
+                }
+            }
+            out.push_back(0);
+            break;
+        }
+        case Op::Map: {
+            const auto &entries = datum.value<::avro::GenericMap>().value();
+            if (!entries.empty()) {
+                writeLong(static_cast<int64_t>(entries.size()), out);
+                for (const auto &[key, value] : entries) {
+                    writeBytes(key.data(), key.size(), out);
+                    encode(instruction.operand, value, out);
+                }
+            }
+            out.push_back(0);
+            break;
+        }
+        case Op::Union: {
+            size_t branch = datum.unionBranch();
+            if (branch >= instruction.count) {
+                throw AvroError("Union branch out of range: " +
+                                std::to_string(branch));
+            }
+            writeLong(static_cast<int64_t>(branch), out);
+            // The datum forwards to the value of its selected branch
+            encode(children_[instruction.operand + branch], datum, out);
+            break;
+        }
+    }
+}
+
+::avro::GenericDatum AvroCodec::decode(const uint8_t *data,
+                                       size_t size) const {
+    Reader reader(data, size);
+    ::avro::GenericDatum datum(schema_);
+    decode(0, reader, datum);
+    return datum;
+}
+
+void AvroCodec::decode(uint32_t pc, Reader &reader,
+                       ::avro::GenericDatum &datum) const {
+    const Instruction &instruction = program_[pc];
+    switch (instruction.op) {
+        case Op::Null:
+            break;
+        case Op::Bool:
+            datum.value<bool>() = reader.readByte() != 0;
+            break;
+        case Op::Int:
+            datum.value<int32_t>() = reader.readInt();
+            break;
+        case Op::Long:
+            datum.value<int64_t>() = reader.readLong();
+            break;
+        case Op::Float:
+            datum.value<float>() = reader.readLittleEndian<uint32_t, float>();
+            break;
+        case Op::Double:
+            datum.value<double>() =
+                reader.readLittleEndian<uint64_t, double>();
+            break;
+        case Op::Bytes: {
+            size_t size = reader.readSize();
+            const uint8_t *bytes = reader.readRaw(size);
+            datum.value<std::vector<uint8_t>>().assign(bytes, bytes + size);
+            break;
+        }
+        case Op::String: {
+            size_t size = reader.readSize();
+            const auto *chars =
+                reinterpret_cast<const char *>(reader.readRaw(size));
+            datum.value<std::string>().assign(chars, size);
+            break;
+        }
+        case Op::Fixed: {
+            const uint8_t *bytes = reader.readRaw(instruction.count);
+            datum.value<::avro::GenericFixed>().value().assign(
+                bytes, bytes + instruction.count);
+            break;
+        }
+        case Op::Enum: {
+            int64_t index = reader.readLong();
+            if (index < 0 || index >= instruction.count) {
+                throw AvroError("Enum index out of range: " +
+                                std::to_string(index));
+            }
+            datum.value<::avro::GenericEnum>().set(static_cast<size_t>(index));
+            break;
+        }
+        case Op::Record: {
+            auto &record = datum.value<::avro::GenericRecord>();
+            for (uint32_t i = 0; i < instruction.count; ++i) {
+                decode(children_[instruction.operand + i], reader,
+                       record.fieldAt(i));
+            }
+            break;
+        }
+        case Op::Array: {
+            auto &items = datum.value<::avro::GenericArray>().value();
+            items.clear();
+            const auto &item_node = nodes_[instruction.operand];
+            for (size_t count = reader.readBlockCount(); count != 0;
+                 count = reader.readBlockCount()) {
+                for (size_t i = 0; i < count; ++i) {
+                    items.emplace_back(item_node);
+                    decode(instruction.operand, reader, items.back());
+                }
+            }
+            break;
+        }
+        case Op::Map: {
+            auto &entries = datum.value<::avro::GenericMap>().value();
+            entries.clear();
+            const auto &value_node = nodes_[instruction.operand];
+            for (size_t count = reader.readBlockCount(); count != 0;
+                 count = reader.readBlockCount()) {
+                for (size_t i = 0; i < count; ++i) {
+                    size_t size = reader.readSize();
+                    const auto *key =
+                        reinterpret_cast<const char *>(reader.readRaw(size));
+                    entries.emplace_back(std::string(key, size),
+                                         ::avro::GenericDatum(value_node));
+                    decode(instruction.operand, reader, entries.back().second);
+                }
+            }
+            break;
+        }
+        case Op::Union: {
+            int64_t branch = reader.readLong();
+            if (branch < 0 || branch >= instruction.count) {
+                throw AvroError("Union branch out of range: " +
+                                std::to_string(branch));
+            }
+            datum.selectBranch(static_cast<size_t>(branch));
+            decode(children_[instruction.operand + branch], reader, datum);
+            break;
+        }
+    }
+}
+
+}  // namespace schemaregistry::serdes::avro
@@ -22,7 +22,7 @@ class AvroDeserializer::Impl {
               config.subject_name_strategy_type,
               base_->getSerde().getClient(),
               config.subject_name_strategy_config,
-              [this](const std::optional<Schema> &s) { return getRecordName(s); })) {
+              [this](const Schema *s) { return getRecordName(s); })) {
         std::vector<std::shared_ptr<RuleExecutor>> executors;
         if (rule_registry) {
             executors = rule_registry->getExecutors();
@@ -40,11 +40,11 @@ class AvroDeserializer::Impl {
         }
     }
 
-    NamedValue deserialize(const SerializationContext &ctx,
-                           const std::vector<uint8_t> &data) {
+    NamedValue deserialize(const SerializationContext &ctx, const uint8_t *data,
+                           size_t size) {
         // Get initial subject using configured subject name strategy (without schema)
         auto initial_subject =
-            subject_name_strategy_(ctx.topic, ctx.serde_type, std::nullopt);
+            subject_name_strategy_(ctx.topic, ctx.serde_type, nullptr);
         std::optional<schemaregistry::rest::model::RegisteredSchema>
             latest_schema;
 
@@ -62,22 +62,24 @@ class AvroDeserializer::Impl {
             }
         }
 
-        // Extract schema ID from data
+        // Extract schema ID from data, the payload is read in place
         SchemaId schema_id(SerdeFormat::Avro);
-        auto id_deserializer = base_->getConfig().schema_id_deserializer;
-        size_t bytes_read = id_deserializer(data, ctx, schema_id);
-        std::vector<uint8_t> payload_data(data.begin() + bytes_read,
-                                          data.end());
+        size_t bytes_read =
+            readSchemaId(base_->getConfig().schema_id_deserializer, data,
+                         size, ctx, schema_id);
+        const uint8_t *payload = data + bytes_read;
+        size_t payload_size = size - bytes_read;
 
         // Get writer schema (pass nullopt when initial subject is unknown)
-        auto writer_schema_raw =
-            base_->getWriterSchema(schema_id, initial_subject, std::nullopt);
+        auto writer_schema_ptr = base_->getWriterSchemaHandle(
+            schema_id, initial_subject, std::nullopt);
+        const auto &writer_schema_raw = *writer_schema_ptr;
         auto writer_parsed = serde_->getParsedSchema(
             writer_schema_raw, base_->getSerde().getClient());
 
         // Recompute subject with writer schema (needed for Record/TopicRecord strategies)
         auto subject_opt = subject_name_strategy_(
-            ctx.topic, ctx.serde_type, std::make_optional(writer_schema_raw));
+            ctx.topic, ctx.serde_type, &writer_schema_raw);
         if (!subject_opt.has_value()) {
             throw SerializationError("Could not determine subject for deserialization");
         }
@@ -98,21 +100,26 @@ class AvroDeserializer::Impl {
         }
 
         // Apply encoding rules if present (pre-decode)
+        std::vector<uint8_t> decoded_data;
         if (writer_schema_raw.getRuleSet().has_value()) {
             auto rule_set = writer_schema_raw.getRuleSet().value();
             if (rule_set.getEncodingRules().has_value()) {
-                auto bytes_value =
-                    SerdeValue::newBytes(SerdeFormat::Avro, payload_data);
+                auto bytes_value = SerdeValue::newBytes(
+                    SerdeFormat::Avro,
+                    std::vector<uint8_t>(payload, payload + payload_size));
                 auto result = base_->getSerde().executeRulesWithPhase(
-                    ctx, subject, Phase::Encoding, Mode::Read, std::nullopt,
-                    std::make_optional(writer_schema_raw), *bytes_value, {});
-                payload_data = result->asBytes();
+                    ctx, subject, Phase::Encoding, Mode::Read, nullptr,
+                    &writer_schema_raw, *bytes_value, {});
+                decoded_data = result->asBytes();
+                payload = decoded_data.data();
+                payload_size = decoded_data.size();
             }
         }
 
         // Migrations processing
-        std::vector<Migration> migrations;
-        schemaregistry::rest::model::Schema reader_schema_raw;
+        std::shared_ptr<const std::vector<Migration>> migrations;
+        std::shared_ptr<const schemaregistry::rest::model::Schema>
+            reader_schema_ptr;
         std::pair<::avro::ValidSchema, std::vector<::avro::ValidSchema>>
             reader_parsed;
 
@@ -121,23 +128,28 @@ class AvroDeserializer::Impl {
             migrations = base_->getSerde().getMigrations(
                 subject, writer_schema_raw, latest_schema.value(),
                 std::nullopt);
-            reader_schema_raw = latest_schema->toSchema();
+            reader_schema_ptr = latest_schema->getSchemaHandle();
             reader_parsed = serde_->getParsedSchema(
-                reader_schema_raw, base_->getSerde().getClient());
+                *reader_schema_ptr, base_->getSerde().getClient());
         } else {
             // No evolution - writer and reader schemas are the same
-            reader_schema_raw = writer_schema_raw;
+            reader_schema_ptr = writer_schema_ptr;
             reader_parsed = writer_parsed;
         }
+        const auto &reader_schema_raw = *reader_schema_ptr;
 
-        // Deserialize Avro data
+        // Deserialize Avro data. Schema evolution without migration rules is
+        // resolved by the decoder, without going through JSON.
+        bool resolve =
+            latest_schema.has_value() && migrations->empty() &&
+            writer_parsed.first.root()->type() != ::avro::AVRO_BYTES;
         ::avro::GenericDatum value;
-        if (latest_schema.has_value()) {
+        if (latest_schema.has_value() && !resolve) {
             // Two-step process for schema evolution
             // 1. Deserialize with writer schema
-            auto intermediate =
-                utils::deserializeAvroData(payload_data, writer_parsed.first,
-                                           nullptr, writer_parsed.second);
+            auto intermediate = utils::deserializeAvroData(
+                payload, payload_size,
+                *serde_->getCodec(writer_schema_raw, writer_parsed.first));
 
             // 2. Convert to JSON for migration
             auto json_value = utils::avroToJson(intermediate);
@@ -146,7 +158,7 @@ class AvroDeserializer::Impl {
 
             // 3. Apply migrations
             auto migrated = base_->getSerde().executeMigrations(
-                ctx, subject, migrations, *json_serde_value);
+                ctx, subject, *migrations, *json_serde_value);
 
             if (migrated->getFormat() != SerdeFormat::Json) {
                 throw AvroError("Expected JSON value after migrations");
@@ -155,15 +167,25 @@ class AvroDeserializer::Impl {
 
             // 4. Convert back to Avro with reader schema
             value = utils::jsonToAvro(migrated_json, reader_parsed.first);
+        } else if (resolve && writer_schema_raw.getFingerprint() !=
+                                  reader_schema_raw.getFingerprint()) {
+            value = serde_
+                        ->getResolvingDecoders(
+                            writer_schema_raw, writer_parsed.first,
+                            reader_schema_raw, reader_parsed.first)
+                        ->decode(payload, payload_size);
         } else {
-            // Direct deserialization without evolution
+            // Direct deserialization without evolution, the reader schema
+            // being the writer schema
             value = utils::deserializeAvroData(
-                payload_data, writer_parsed.first, &reader_parsed.first,
-                reader_parsed.second);
+                payload, payload_size,
+                *serde_->getCodec(writer_schema_raw, writer_parsed.first));
         }
 
-        // Apply transformation rules
-        auto parsed_schema = writer_parsed;
+        // Apply transformation rules. The datum is of the reader schema,
+        // whose tag index holds the field visit plans, so the transformer
+        // walks the reader schema as well.
+        const auto &parsed_schema = reader_parsed.first;
 
         // Create field transformer lambda
         auto field_transformer =
@@ -172,9 +194,9 @@ class AvroDeserializer::Impl {
                 const SerdeValue &msg) -> std::unique_ptr<SerdeValue> {
             if (msg.getFormat() == SerdeFormat::Avro) {
                 auto avro_datum = asAvro(msg);
-                auto transformed = utils::transformFields(
-                    ctx, parsed_schema.first, avro_datum);
-                return makeAvroValue(transformed);
+                utils::transformFieldsInPlace(ctx, parsed_schema,
+                                              avro_datum);
+                return makeAvroValue(std::move(avro_datum));
             }
             return msg.clone();
         };
@@ -182,10 +204,8 @@ class AvroDeserializer::Impl {
         auto serde_value = makeAvroValue(value);
 
         auto transformed = base_->getSerde().executeRules(
-            ctx, subject, Mode::Read, std::nullopt,
-            std::make_optional(reader_schema_raw), *serde_value,
-            utils::getInlineTags(
-                nlohmann::json::parse(reader_schema_raw.getSchema().value())),
+            ctx, subject, Mode::Read, nullptr, &reader_schema_raw, *serde_value,
+            serde_->getTagIndex(reader_schema_raw),
             std::make_shared<FieldTransformer>(field_transformer));
         if (transformed->getFormat() == SerdeFormat::Avro) {
             value = asAvro(*transformed);
@@ -196,7 +216,7 @@ class AvroDeserializer::Impl {
 
     nlohmann::json deserializeToJson(const SerializationContext &ctx,
                                      const std::vector<uint8_t> &data) {
-        auto named_value = deserialize(ctx, data);
+        auto named_value = deserialize(ctx, data.data(), data.size());
         return utils::avroToJson(named_value.value);
     }
 
@@ -216,8 +236,8 @@ class AvroDeserializer::Impl {
         return serde_->getParsedSchema(schema, base_->getSerde().getClient());
     }
 
-    std::string getRecordName(const std::optional<Schema> &schema) {
-        if (!schema.has_value()) return "";
+    std::string getRecordName(const Schema *schema) {
+        if (!schema) return "";
         auto [valid_schema, refs] = getParsedSchema(*schema);
         auto name = utils::getSchemaName(valid_schema);
         if (!name.has_value()) {
@@ -253,7 +273,12 @@ AvroDeserializer::~AvroDeserializer() = default;
 
 NamedValue AvroDeserializer::deserialize(const SerializationContext &ctx,
                                          const std::vector<uint8_t> &data) {
-    return impl_->deserialize(ctx, data);
+    return impl_->deserialize(ctx, data.data(), data.size());
+}
+
+NamedValue AvroDeserializer::deserialize(const SerializationContext &ctx,
+                                         const uint8_t *data, size_t size) {
+    return impl_->deserialize(ctx, data, size);
 }
 
 nlohmann::json AvroDeserializer::deserializeToJson(
@@ -1,23 +1,80 @@
 #include "schemaregistry/serdes/avro/AvroSerializer.h"
 
 #include <algorithm>
+#include <avro/Stream.hh>
 #include <sstream>
 
 #include "schemaregistry/rest/RestException.h"
+#include "schemaregistry/rest/SchemaInterner.h"
 #include "schemaregistry/serdes/avro/AvroUtils.h"
 
 namespace schemaregistry::serdes::avro {
 
+namespace {
+
+// Decoders kept per pair of schemas, beyond what a single thread needs so
+// that concurrent reads rarely build the resolution grammar again
+constexpr size_t kMaxIdleDecoders = 16;
+
+}  // namespace
+
+// ResolvingDecoderPool implementation
+
+ResolvingDecoderPool::ResolvingDecoderPool(::avro::ValidSchema writer_schema,
+                                           ::avro::ValidSchema reader_schema)
+    : writer_schema_(std::move(writer_schema)),
+      reader_schema_(std::move(reader_schema)) {
+    // Build one decoder eagerly, so that incompatible schemas fail here
+    release(acquire());
+}
+
+::avro::GenericDatum ResolvingDecoderPool::decode(const uint8_t *data,
+                                                  size_t size) {
+    auto decoder = acquire();
+    try {
+        auto input_stream = ::avro::memoryInputStream(data, size);
+        decoder->init(*input_stream);
+        ::avro::GenericDatum datum(reader_schema_);
+        ::avro::decode(*decoder, datum);
+        release(std::move(decoder));
+        return datum;
+    } catch (const ::avro::Exception &e) {
+        throw AvroError(e);
+    }
+}
+
+::avro::ResolvingDecoderPtr ResolvingDecoderPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_.empty()) {
+            auto decoder = std::move(idle_.back());
+            idle_.pop_back();
+            return decoder;
+        }
+    }
+    try {
+        return ::avro::resolvingDecoder(writer_schema_, reader_schema_,
+                                        ::avro::binaryDecoder());
+    } catch (const ::avro::Exception &e) {
+        throw AvroError(e);
+    }
+}
+
+void ResolvingDecoderPool::release(::avro::ResolvingDecoderPtr decoder) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.size() < kMaxIdleDecoders) {
+        idle_.push_back(std::move(decoder));
+    }
+}
+
 // AvroSerde implementation
 
 std::pair<::avro::ValidSchema, std::vector<::avro::ValidSchema>>
 AvroSerde::getParsedSchema(
     const schemaregistry::rest::model::Schema &schema,
     std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client) {
-    // Generate cache key (reuse the updated SerdeTypes cache key generation)
-    nlohmann::json j;
-    to_json(j, schema);
-    std::string cache_key = j.dump();
+    // Key on the schema's memoized content fingerprint
+    auto cache_key = schema.getFingerprint();
 
     // Check cache first
     {
@@ -50,6 +107,50 @@ AvroSerde::getParsedSchema(
     return parsed;
 }
 
+std::shared_ptr<const FieldTagIndex> AvroSerde::getTagIndex(
+    const schemaregistry::rest::model::Schema &schema) {
+    auto cache_key = schema.getFingerprint();
+    {
+        std::shared_lock lock(mutex_);
+        auto it = tag_indexes_.find(cache_key);
+        if (it != tag_indexes_.end()) {
+            return it->second;
+        }
+    }
+
+    if (!schema.getSchema().has_value()) {
+        throw AvroError("Schema string is not available");
+    }
+    auto index = std::make_shared<const FieldTagIndex>(
+        utils::getInlineTags(nlohmann::json::parse(schema.getSchema().value())),
+        schema.getMetadata());
+
+    std::unique_lock lock(mutex_);
+    return tag_indexes_.try_emplace(cache_key, std::move(index)).first->second;
+}
+
+std::shared_ptr<ResolvingDecoderPool> AvroSerde::getResolvingDecoders(
+    const schemaregistry::rest::model::Schema &writer,
+    const ::avro::ValidSchema &writer_schema,
+    const schemaregistry::rest::model::Schema &reader,
+    const ::avro::ValidSchema &reader_schema) {
+    auto cache_key =
+        std::make_pair(writer.getFingerprint(), reader.getFingerprint());
+    {
+        std::shared_lock lock(mutex_);
+        auto it = resolving_decoders_.find(cache_key);
+        if (it != resolving_decoders_.end()) {
+            return it->second;
+        }
+    }
+
+    auto decoders =
+        std::make_shared<ResolvingDecoderPool>(writer_schema, reader_schema);
+    std::unique_lock lock(mutex_);
+    return resolving_decoders_.try_emplace(cache_key, std::move(decoders))
+        .first->second;
+}
+
 void AvroSerde::resolveNamedSchema(
     const schemaregistry::rest::model::Schema &schema,
     std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client,
@@ -91,14 +192,42 @@ void AvroSerde::resolveNamedSchema(
     }
 }
 
+std::shared_ptr<const AvroCodec> AvroSerde::getCodec(
+    const schemaregistry::rest::model::Schema &schema,
+    const ::avro::ValidSchema &parsed_schema) {
+    auto cache_key = schema.getFingerprint();
+    {
+        std::shared_lock lock(mutex_);
+        auto it = codecs_.find(cache_key);
+        if (it != codecs_.end()) {
+            return it->second;
+        }
+    }
+
+    auto codec = std::make_shared<const AvroCodec>(parsed_schema);
+    std::unique_lock lock(mutex_);
+    return codecs_.try_emplace(cache_key, std::move(codec)).first->second;
+}
+
 void AvroSerde::clear() {
     std::unique_lock lock(mutex_);
     parsed_schemas_.clear();
+    tag_indexes_.clear();
+    resolving_decoders_.clear();
+    codecs_.clear();
 }
 
 // AvroSerializer implementation (PIMPL)
 
 class AvroSerializer::Impl {
+    // Parsed schema messages are written with, and its compiled codec
+    struct ParsedAvroSchema {
+        std::pair<::avro::ValidSchema, std::vector<::avro::ValidSchema>>
+            schemas;
+        std::shared_ptr<const AvroCodec> codec;
+    };
+    using AvroPlan = SerializerPlan<ParsedAvroSchema>;
+
   public:
     Impl(std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client,
          std::optional<schemaregistry::rest::model::Schema> schema,
@@ -112,7 +241,9 @@ class AvroSerializer::Impl {
               config.subject_name_strategy_type,
               base_->getSerde().getClient(),
               config.subject_name_strategy_config,
-              [this](const std::optional<Schema> &s) { return getRecordName(s); })) {
+              [this](const Schema *s) { return getRecordName(s); })),
+          cache_subject_(config.subject_name_strategy_type !=
+                         SubjectNameStrategyType::Associated) {
         std::vector<std::shared_ptr<RuleExecutor>> executors;
         if (rule_registry) {
             executors = rule_registry->getExecutors();
@@ -130,25 +261,29 @@ class AvroSerializer::Impl {
         }
     }
 
-    std::vector<uint8_t> serialize(const SerializationContext &ctx,
-                                   const ::avro::GenericDatum &datum) {
-        auto value = datum;  // Copy for potential transformation
-
-        // Get subject using configured subject name strategy
-        auto subject_opt = subject_name_strategy_(
-            ctx.topic, ctx.serde_type,
-            schema_.has_value() ? std::make_optional(schema_.value())
-                                : std::nullopt);
-        if (!subject_opt.has_value()) {
-            throw SerializationError("Could not determine subject for serialization");
+    void serialize(const SerializationContext &ctx,
+                   const ::avro::GenericDatum &datum,
+                   std::vector<uint8_t> &out) {
+        auto plan = plans_.get(ctx.topic, ctx.serde_type);
+
+        // Get subject using configured subject name strategy, unless the
+        // plan already resolved it with a strategy that cannot change
+        std::optional<std::string> resolved_subject;
+        if (!plan || !cache_subject_) {
+            resolved_subject = subject_name_strategy_(
+                ctx.topic, ctx.serde_type, schema_ ? &*schema_ : nullptr);
+            if (!resolved_subject.has_value()) {
+                throw SerializationError(
+                    "Could not determine subject for serialization");
+            }
         }
-        const std::string &subject = subject_opt.value();
+        // Copied, as a stale plan is released once its replacement is cached
+        std::string subject = resolved_subject.has_value()
+                                  ? std::move(*resolved_subject)
+                                  : plan->subject;
 
-        // Get or register schema
-        SchemaId schema_id(SerdeFormat::Avro);
         std::optional<schemaregistry::rest::model::RegisteredSchema>
             latest_schema;
-
         try {
             latest_schema = base_->getSerde().getReaderSchema(
                 subject, std::nullopt, base_->getConfig().use_schema);
@@ -159,100 +294,141 @@ class AvroSerializer::Impl {
             // Schema not found - will use provided schema
         }
 
-        if (latest_schema.has_value()) {
-            // Use latest schema from registry
-            schema_id = SchemaId(SerdeFormat::Avro, latest_schema->getId(),
-                                 latest_schema->getGuid(), std::nullopt);
-
-            auto schema = latest_schema->toSchema();
-            auto parsed_schema =
-                serde_->getParsedSchema(schema, base_->getSerde().getClient());
-
-            // Create field transformer lambda
-            auto field_transformer =
-                [this, &parsed_schema](
-                    RuleContext &ctx, const std::string &rule_type,
-                    const SerdeValue &msg) -> std::unique_ptr<SerdeValue> {
-                if (msg.getFormat() == SerdeFormat::Avro) {
-                    auto avro_datum = asAvro(msg);
-                    auto transformed = utils::transformFields(
-                        ctx, parsed_schema.first, avro_datum);
-                    return makeAvroValue(transformed);
-                }
-                return msg.clone();
-            };
-
-            auto avro_value = makeAvroValue(value);
-
-            // Execute rules on the serde value
+        // Rebuild the plan if the latest schema changed since it was built
+        if (!plan || !plan->isCurrent(subject, latest_schema)) {
+            plan = compilePlan(subject, latest_schema);
+            plans_.put(ctx.topic, ctx.serde_type, plan);
+        }
+
+        // Execute rules on a copy of the datum, if there are any
+        const ::avro::GenericDatum *value = &datum;
+        ::avro::GenericDatum transformed;
+        if (plan->has_domain_rules) {
+            auto avro_value = makeAvroValue(datum);
             auto transformed_value = base_->getSerde().executeRules(
-                ctx, subject, Mode::Write, std::nullopt,
-                std::make_optional(schema), *avro_value,
-                utils::getInlineTags(
-                    nlohmann::json::parse(schema.getSchema().value())),
-                std::make_shared<FieldTransformer>(field_transformer));
+                ctx, subject, Mode::Write, nullptr, plan->schema.get(),
+                *avro_value, plan->tag_index, plan->field_transformer);
 
             // Extract Avro value from result
-            if (transformed_value->getFormat() == SerdeFormat::Avro) {
-                value = asAvro(*transformed_value);
-            } else {
+            if (transformed_value->getFormat() != SerdeFormat::Avro) {
                 throw AvroError(
                     "Unexpected serde value type returned from rule execution");
             }
-        } else {
-            // Use provided schema and register/lookup
-            if (!schema_.has_value()) {
-                throw AvroError(
-                    "No schema provided and none found in registry");
-            }
-
-            schemaregistry::rest::model::RegisteredSchema registered_schema;
-            if (base_->getConfig().auto_register_schemas) {
-                registered_schema =
-                    base_->getSerde().getClient()->registerSchema(
-                        subject, schema_.value(),
-                        base_->getConfig().normalize_schemas);
-            } else {
-                registered_schema = base_->getSerde().getClient()->getBySchema(
-                    subject, schema_.value(),
-                    base_->getConfig().normalize_schemas, false);
-            }
-
-            schema_id = SchemaId(SerdeFormat::Avro, registered_schema.getId(),
-                                 registered_schema.getGuid(), std::nullopt);
+            transformed = asAvro(*transformed_value);
+            value = &transformed;
         }
 
-        // Parse schema for serialization
-        auto schema_to_use = latest_schema.has_value()
-                                 ? latest_schema->toSchema()
-                                 : schema_.value();
-        auto parsed_schema = serde_->getParsedSchema(
-            schema_to_use, base_->getSerde().getClient());
+        // Encode right after the schema ID prefix, unless encoding rules
+        // rewrite the payload
+        if (plan->id_prefix.has_value() && !plan->has_encoding_rules) {
+            out.assign(plan->id_prefix->begin(), plan->id_prefix->end());
+            utils::serializeAvroData(*value, *plan->parsed.codec, out);
+            return;
+        }
 
         // Serialize Avro data
-        auto avro_bytes = utils::serializeAvroData(value, parsed_schema.first,
-                                                   parsed_schema.second);
+        std::vector<uint8_t> avro_bytes;
+        utils::serializeAvroData(*value, *plan->parsed.codec, avro_bytes);
 
         // Apply encoding rules if present
-        if (latest_schema.has_value()) {
-            auto schema = latest_schema->toSchema();
-            if (schema.getRuleSet().has_value()) {
-                auto rule_set = schema.getRuleSet().value();
-                if (rule_set.getEncodingRules().has_value()) {
-                    auto bytes_value =
-                        SerdeValue::newBytes(SerdeFormat::Avro, avro_bytes);
-                    auto result = base_->getSerde().executeRulesWithPhase(
-                        ctx, subject, Phase::Encoding, Mode::Write,
-                        std::nullopt, std::make_optional(schema), *bytes_value,
-                        {});
-                    avro_bytes = result->asBytes();
-                }
-            }
+        if (plan->has_encoding_rules) {
+            auto bytes_value =
+                SerdeValue::newBytes(SerdeFormat::Avro, avro_bytes);
+            auto result = base_->getSerde().executeRulesWithPhase(
+                ctx, subject, Phase::Encoding, Mode::Write, nullptr,
+                plan->schema.get(), *bytes_value, {});
+            avro_bytes = result->asBytes();
         }
 
         // Add schema ID header
-        auto id_serializer = base_->getConfig().schema_id_serializer;
-        return id_serializer(avro_bytes, ctx, schema_id);
+        const auto &id_serializer = base_->getConfig().schema_id_serializer;
+        out = id_serializer(avro_bytes, ctx, plan->schema_id);
+    }
+
+    // Build the plan for subject, writing with the latest schema if the
+    // registry returned one, or else with the serializer's own schema
+    std::shared_ptr<const AvroPlan> compilePlan(
+        const std::string &subject,
+        const std::optional<schemaregistry::rest::model::RegisteredSchema>
+            &latest_schema) {
+        auto plan = std::make_shared<AvroPlan>();
+        plan->subject = subject;
+
+        if (latest_schema.has_value()) {
+            // Use latest schema from registry
+            plan->latest = latest_schema->getSchemaHandle();
+            plan->schema = plan->latest;
+            plan->schema_id =
+                SchemaId(SerdeFormat::Avro, latest_schema->getId(),
+                         latest_schema->getGuid(), std::nullopt);
+
+            const auto &schema = *plan->schema;
+            plan->parsed = parseSchema(schema);
+            plan->tag_index = serde_->getTagIndex(schema);
+
+            // The transformer is owned by the plan, so it can refer to the
+            // plan's parsed schema
+            const auto *parsed_schema = &plan->parsed.schemas.first;
+            plan->field_transformer = std::make_shared<FieldTransformer>(
+                [parsed_schema](RuleContext &ctx, const std::string &rule_type,
+                                const SerdeValue &msg)
+                    -> std::unique_ptr<SerdeValue> {
+                    if (msg.getFormat() == SerdeFormat::Avro) {
+                        auto avro_datum = asAvro(msg);
+                        utils::transformFieldsInPlace(ctx, *parsed_schema,
+                                                      avro_datum);
+                        return makeAvroValue(std::move(avro_datum));
+                    }
+                    return msg.clone();
+                });
+
+            const auto &rule_set = schema.getRuleSet();
+            plan->has_domain_rules =
+                rule_set.has_value() &&
+                rule_set->getDomainRules().has_value() &&
+                !rule_set->getDomainRules()->empty();
+            plan->has_encoding_rules =
+                rule_set.has_value() &&
+                rule_set->getEncodingRules().has_value();
+            plan->id_prefix = schemaIdPrefix(
+                base_->getConfig().schema_id_serializer, plan->schema_id);
+            return plan;
+        }
+
+        // Use provided schema and register/lookup
+        if (!schema_.has_value()) {
+            throw AvroError("No schema provided and none found in registry");
+        }
+
+        schemaregistry::rest::model::RegisteredSchema registered_schema;
+        if (base_->getConfig().auto_register_schemas) {
+            registered_schema = base_->getSerde().getClient()->registerSchema(
+                subject, schema_.value(), base_->getConfig().normalize_schemas);
+        } else {
+            registered_schema = base_->getSerde().getClient()->getBySchema(
+                subject, schema_.value(), base_->getConfig().normalize_schemas,
+                false);
+        }
+
+        plan->schema =
+            schemaregistry::rest::SchemaInterner::global().intern(*schema_);
+        plan->schema_id =
+            SchemaId(SerdeFormat::Avro, registered_schema.getId(),
+                     registered_schema.getGuid(), std::nullopt);
+        plan->id_prefix = schemaIdPrefix(
+            base_->getConfig().schema_id_serializer, plan->schema_id);
+        plan->parsed = parseSchema(*plan->schema);
+        return plan;
+    }
+
+    // Parse schema and compile its codec, both cached by the serde
+    ParsedAvroSchema parseSchema(
+        const schemaregistry::rest::model::Schema &schema) {
+        ParsedAvroSchema parsed;
+        parsed.schemas =
+            serde_->getParsedSchema(schema, base_->getSerde().getClient());
+        parsed.codec = serde_->getCodec(schema, parsed.schemas.first);
+        return parsed;
     }
 
     std::vector<uint8_t> serializeJson(const SerializationContext &ctx,
@@ -263,10 +439,13 @@ class AvroSerializer::Impl {
         auto parsed_schema = serde_->getParsedSchema(
             schema_.value(), base_->getSerde().getClient());
         auto datum = utils::jsonToAvro(json_value, parsed_schema.first);
-        return serialize(ctx, datum);
+        std::vector<uint8_t> out;
+        serialize(ctx, datum, out);
+        return out;
     }
 
     void close() {
+        plans_.clear();
         if (serde_) {
             serde_->clear();
         }
@@ -277,8 +456,8 @@ class AvroSerializer::Impl {
         return serde_->getParsedSchema(schema, base_->getSerde().getClient());
     }
 
-    std::string getRecordName(const std::optional<Schema> &schema) {
-        if (!schema.has_value()) return "";
+    std::string getRecordName(const Schema *schema) {
+        if (!schema) return "";
         auto [valid_schema, refs] = getParsedSchema(*schema);
         auto name = utils::getSchemaName(valid_schema);
         if (!name.has_value()) {
@@ -292,6 +471,10 @@ class AvroSerializer::Impl {
     std::shared_ptr<BaseSerializer> base_;
     std::shared_ptr<AvroSerde> serde_;
     SubjectNameStrategyFunc subject_name_strategy_;
+    // Associated subjects may change over time, other strategies only
+    // depend on the topic and the serializer's own schema
+    bool cache_subject_;
+    SerializerPlanCache<ParsedAvroSchema> plans_;
 };
 
 AvroSerializer::AvroSerializer(
@@ -305,7 +488,15 @@ AvroSerializer::~AvroSerializer() = default;
 
 std::vector<uint8_t> AvroSerializer::serialize(
     const SerializationContext &ctx, const ::avro::GenericDatum &datum) {
-    return impl_->serialize(ctx, datum);
+    std::vector<uint8_t> out;
+    impl_->serialize(ctx, datum, out);
+    return out;
+}
+
+void AvroSerializer::serialize(const SerializationContext &ctx,
+                               const ::avro::GenericDatum &datum,
+                               std::vector<uint8_t> &out) {
+    impl_->serialize(ctx, datum, out);
 }
 
 std::vector<uint8_t> AvroSerializer::serializeJson(
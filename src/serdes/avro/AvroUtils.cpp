@@ -1,5 +1,6 @@
 #include "schemaregistry/serdes/avro/AvroUtils.h"
 
+#include <algorithm>
 #include <avro/Exception.hh>
 #include <avro/Stream.hh>
 #include <iostream>
@@ -13,146 +14,318 @@ namespace schemaregistry::serdes::avro {
 
 namespace utils {
 
-::avro::GenericDatum transformFields(RuleContext &ctx,
-                                     const ::avro::ValidSchema &schema,
-                                     const ::avro::GenericDatum &datum) {
-    switch (schema.root()->type()) {
-        case ::avro::AVRO_RECORD: {
-            auto record = datum.value<::avro::GenericRecord>();
-            ::avro::GenericRecord result(schema.root());
+namespace {
 
-            for (size_t i = 0; i < record.fieldCount(); ++i) {
-                auto field_datum = record.fieldAt(i);
-                auto field_schema_node = schema.root()->leafAt(i);
-                ::avro::ValidSchema field_schema(field_schema_node);
-                const std::string &field_name = schema.root()->nameAt(i);
+/**
+ * Avro output stream appending to a caller-owned vector
+ */
+class VectorOutputStream : public ::avro::OutputStream {
+  public:
+    explicit VectorOutputStream(std::vector<uint8_t> &out)
+        : out_(out), start_(out.size()) {}
+
+    bool next(uint8_t **data, size_t *len) override {
+        size_t used = out_.size();
+        out_.resize(std::max(out_.capacity(), used + kMinChunkSize));
+        *data = out_.data() + used;
+        *len = out_.size() - used;
+        return true;
+    }
+
+    // The encoder hands back the unused tail of the last chunk on flush
+    void backup(size_t len) override { out_.resize(out_.size() - len); }
+
+    uint64_t byteCount() const override { return out_.size() - start_; }
+
+    void flush() override {}
+
+  private:
+    static constexpr size_t kMinChunkSize = 256;
+
+    std::vector<uint8_t> &out_;
+    size_t start_;
+};
+
+FieldType avroTypeToFieldType(::avro::Type type) {
+    switch (type) {
+        case ::avro::AVRO_NULL:
+            return FieldType::Null;
+        case ::avro::AVRO_BOOL:
+            return FieldType::Boolean;
+        case ::avro::AVRO_INT:
+            return FieldType::Int;
+        case ::avro::AVRO_LONG:
+            return FieldType::Long;
+        case ::avro::AVRO_FLOAT:
+            return FieldType::Float;
+        case ::avro::AVRO_DOUBLE:
+            return FieldType::Double;
+        case ::avro::AVRO_BYTES:
+            return FieldType::Bytes;
+        case ::avro::AVRO_STRING:
+            return FieldType::String;
+        case ::avro::AVRO_RECORD:
+            return FieldType::Record;
+        case ::avro::AVRO_ENUM:
+            return FieldType::Enum;
+        case ::avro::AVRO_ARRAY:
+            return FieldType::Array;
+        case ::avro::AVRO_MAP:
+            return FieldType::Map;
+        case ::avro::AVRO_UNION:
+            return FieldType::Combined;
+        case ::avro::AVRO_FIXED:
+            return FieldType::Fixed;
+        case ::avro::AVRO_SYMBOLIC:
+            return FieldType::Record;  // Assume symbolic references are records
+        default:
+            return FieldType::String;  // Default fallback
+    }
+}
 
-                auto transformed_field = transformFieldWithContext(
-                    ctx, schema, field_name, field_datum, field_schema);
-                result.setFieldAt(i, transformed_field);
+/**
+ * Record in records the fields to visit of the records reachable from node
+ * @param field_tags Tags of the innermost enclosing field, nullptr if none
+ * @return Whether a value of node holds a field the rule applies to
+ */
+bool collectVisits(const RuleContext &ctx, const FieldTagIndex &index,
+                   const ::avro::NodePtr &node,
+                   const FieldTagIndex::TagSet *field_tags,
+                   FieldVisitPlan::Records &records) {
+    switch (node->type()) {
+        case ::avro::AVRO_RECORD: {
+            std::string record_name = node->name().fullname();
+            auto it = records.find(record_name);
+            if (it != records.end()) {
+                return std::find(it->second.begin(), it->second.end(),
+                                 true) != it->second.end();
             }
 
-            // Create a new GenericDatum with the schema and set the record
-            // value
-            ::avro::GenericDatum result_datum(schema);
-            result_datum.value<::avro::GenericRecord>() = result;
-            return result_datum;
+            std::vector<bool> visits(node->leaves(), false);
+            bool any = false;
+            for (size_t i = 0; i < node->leaves(); ++i) {
+                auto tags = index.getTags(record_name + "." + node->nameAt(i));
+                visits[i] = collectVisits(ctx, index, node->leafAt(i),
+                                          tags.get(), records);
+                any = any || visits[i];
+            }
+            records.insert_or_assign(record_name, std::move(visits));
+            return any;
         }
+        case ::avro::AVRO_ARRAY:
+            return collectVisits(ctx, index, node->leafAt(0), field_tags,
+                                 records);
+        case ::avro::AVRO_MAP:
+            // Leaf 0 of a map is its key schema, leaf 1 its value schema
+            return collectVisits(ctx, index, node->leafAt(1), field_tags,
+                                 records);
+        case ::avro::AVRO_UNION: {
+            bool any = false;
+            for (size_t i = 0; i < node->leaves(); ++i) {
+                any = collectVisits(ctx, index, node->leafAt(i), field_tags,
+                                    records) ||
+                      any;
+            }
+            return any;
+        }
+        default:
+            return field_tags != nullptr && ctx.appliesTo(*field_tags);
+    }
+}
 
-        case ::avro::AVRO_ARRAY: {
-            auto array = datum.value<::avro::GenericArray>();
-            ::avro::GenericDatum result_datum(schema);
-            auto &result = result_datum.value<::avro::GenericArray>();
-            auto item_schema_node = schema.root()->leafAt(0);
-            ::avro::ValidSchema item_schema(item_schema_node);
+/**
+ * Replace the value of datum, keeping the branch of a union datum
+ */
+void replaceDatum(::avro::GenericDatum &datum,
+                  const ::avro::GenericDatum &value) {
+    if (!datum.isUnion() || datum.type() != value.type()) {
+        datum = value;
+        return;
+    }
+    switch (value.type()) {
+        case ::avro::AVRO_STRING:
+            datum.value<std::string>() = value.value<std::string>();
+            break;
+        case ::avro::AVRO_BYTES:
+            datum.value<std::vector<uint8_t>>() =
+                value.value<std::vector<uint8_t>>();
+            break;
+        case ::avro::AVRO_INT:
+            datum.value<int32_t>() = value.value<int32_t>();
+            break;
+        case ::avro::AVRO_LONG:
+            datum.value<int64_t>() = value.value<int64_t>();
+            break;
+        case ::avro::AVRO_FLOAT:
+            datum.value<float>() = value.value<float>();
+            break;
+        case ::avro::AVRO_DOUBLE:
+            datum.value<double>() = value.value<double>();
+            break;
+        case ::avro::AVRO_BOOL:
+            datum.value<bool>() = value.value<bool>();
+            break;
+        default:
+            datum = value;
+            break;
+    }
+}
 
-            for (size_t i = 0; i < array.value().size(); ++i) {
-                auto transformed =
-                    transformFields(ctx, item_schema, array.value()[i]);
-                result.value().push_back(transformed);
+void transformInPlace(RuleContext &ctx, const FieldVisitPlan *plan,
+                      const ::avro::NodePtr &node, ::avro::GenericDatum &datum);
+
+void transformFieldInPlace(RuleContext &ctx, const FieldVisitPlan *plan,
+                           const ::avro::NodePtr &record_node,
+                           const std::string &record_name, size_t field,
+                           ::avro::GenericDatum &field_datum) {
+    const auto &field_node = record_node->leafAt(field);
+    const std::string &field_name = record_node->nameAt(field);
+    auto message_value = makeAvroValue(field_datum);
+    ctx.enterField(*message_value, record_name + "." + field_name, field_name,
+                   avroTypeToFieldType(field_node->type()), {});
+
+    try {
+        transformInPlace(ctx, plan, field_node, field_datum);
+
+        // Check for condition rules
+        auto rule_kind = ctx.getRule().getKind();
+        if (rule_kind.has_value() && rule_kind.value() == Kind::Condition) {
+            if (field_datum.type() == ::avro::AVRO_BOOL &&
+                !field_datum.value<bool>()) {
+                throw AvroError("Rule condition failed for field: " +
+                                field_name);
             }
+        }
 
-            return result_datum;
+        ctx.exitField();
+    } catch (const std::exception &e) {
+        ctx.exitField();
+        throw;
+    }
+}
+
+void transformInPlace(RuleContext &ctx, const FieldVisitPlan *plan,
+                      const ::avro::NodePtr &node,
+                      ::avro::GenericDatum &datum) {
+    switch (node->type()) {
+        case ::avro::AVRO_RECORD: {
+            auto &record = datum.value<::avro::GenericRecord>();
+            std::string record_name = node->name().fullname();
+            for (size_t i = 0; i < record.fieldCount(); ++i) {
+                if (plan != nullptr && !plan->visits(record_name, i)) {
+                    continue;
+                }
+                transformFieldInPlace(ctx, plan, node, record_name, i,
+                                      record.fieldAt(i));
+            }
+            return;
+        }
+
+        case ::avro::AVRO_ARRAY: {
+            for (auto &item : datum.value<::avro::GenericArray>().value()) {
+                transformInPlace(ctx, plan, node->leafAt(0), item);
+            }
+            return;
         }
 
         case ::avro::AVRO_MAP: {
-            auto map = datum.value<::avro::GenericMap>();
-            ::avro::GenericDatum result_datum(schema);
-            auto &result = result_datum.value<::avro::GenericMap>();
-            for (const auto &[key, value] : map.value()) {
-                auto value_schema_node = schema.root()->leafAt(0);
-                ::avro::ValidSchema value_schema(value_schema_node);
-                auto transformed = transformFields(ctx, value_schema, value);
-                result.value().emplace_back(key, transformed);
-            }
-            return result_datum;
+            for (auto &entry : datum.value<::avro::GenericMap>().value()) {
+                transformInPlace(ctx, plan, node->leafAt(1), entry.second);
+            }
+            return;
         }
 
         case ::avro::AVRO_UNION: {
-            auto union_val = datum.value<::avro::GenericUnion>();
-            auto [branch_idx, branch_schema] = resolveUnion(schema, datum);
-            auto transformed =
-                transformFields(ctx, branch_schema, union_val.datum());
-
-            ::avro::GenericDatum result_datum(schema);
-            auto &result = result_datum.value<::avro::GenericUnion>();
-            result.selectBranch(branch_idx);
-            result.datum() = transformed;
-
-            return result_datum;
+            // A union datum forwards value access to its selected branch
+            size_t branch = node->leaves();
+            if (datum.isUnion()) {
+                branch = datum.unionBranch();
+            } else {
+                for (size_t i = 0; i < node->leaves(); ++i) {
+                    if (node->leafAt(i)->type() == datum.type()) {
+                        branch = i;
+                        break;
+                    }
+                }
+            }
+            if (branch >= node->leaves()) {
+                throw AvroError(
+                    "No matching union branch found for datum type");
+            }
+            transformInPlace(ctx, plan, node->leafAt(branch), datum);
+            return;
         }
 
         default: {
             // Field-level transformation logic
             auto field_ctx = ctx.currentField();
-            if (field_ctx.has_value()) {
-                field_ctx->setFieldType(avroSchemaToFieldType(schema));
-
-                auto rule_tags = ctx.getRule().getTags();
-                std::unordered_set<std::string> rule_tags_set;
-                if (rule_tags.has_value()) {
-                    rule_tags_set = std::unordered_set<std::string>(
-                        rule_tags->begin(), rule_tags->end());
-                }
-
-                // Check if rule tags overlap with field context tags (empty
-                // rule_tags means apply to all)
-                bool should_apply =
-                    !rule_tags.has_value() || rule_tags_set.empty();
-                if (!should_apply) {
-                    const auto &field_tags = field_ctx->getTags();
-                    for (const auto &field_tag : field_tags) {
-                        if (rule_tags_set.find(field_tag) !=
-                            rule_tags_set.end()) {
-                            should_apply = true;
-                            break;
-                        }
-                    }
-                }
+            if (!field_ctx.has_value()) {
+                return;
+            }
+            field_ctx->setFieldType(avroTypeToFieldType(node->type()));
+            if (!ctx.appliesTo(field_ctx->getTags())) {
+                return;
+            }
 
-                if (should_apply) {
-                    auto message_value = makeAvroValue(datum);
+            auto message_value = makeAvroValue(datum);
 
-                    // Get field executor type from the rule
-                    auto field_executor_type =
-                        ctx.getRule().getType().value_or("");
+            // Get field executor type from the rule
+            auto field_executor_type = ctx.getRule().getType().value_or("");
 
-                    // Try to get executor from context's rule registry first,
-                    // then global
-                    std::shared_ptr<RuleExecutor> executor;
-                    if (ctx.getRuleRegistry()) {
-                        executor = ctx.getRuleRegistry()->getExecutor(
-                            field_executor_type);
-                    }
-                    if (!executor) {
-                        executor = global_registry::getRuleExecutor(
-                            field_executor_type);
-                    }
-
-                    if (executor) {
-                        auto field_executor =
-                            std::dynamic_pointer_cast<FieldRuleExecutor>(
-                                executor);
-                        if (!field_executor) {
-                            throw AvroError("executor " + field_executor_type +
-                                            " is not a field rule executor");
-                        }
+            // Try to get executor from context's rule registry first, then
+            // global
+            std::shared_ptr<RuleExecutor> executor;
+            if (ctx.getRuleRegistry()) {
+                executor =
+                    ctx.getRuleRegistry()->getExecutor(field_executor_type);
+            }
+            if (!executor) {
+                executor =
+                    global_registry::getRuleExecutor(field_executor_type);
+            }
+            if (!executor) {
+                return;
+            }
 
-                        auto new_value =
-                            field_executor->transformField(ctx, *message_value);
-                        if (new_value &&
-                            new_value->getFormat() == SerdeFormat::Avro) {
-                            return asAvro(*new_value);
-                        }
-                    }
-                }
+            auto field_executor =
+                std::dynamic_pointer_cast<FieldRuleExecutor>(executor);
+            if (!field_executor) {
+                throw AvroError("executor " + field_executor_type +
+                                " is not a field rule executor");
             }
 
-            return datum;
+            auto new_value =
+                field_executor->transformField(ctx, *message_value);
+            if (new_value && new_value->getFormat() == SerdeFormat::Avro) {
+                replaceDatum(datum, asAvro(*new_value));
+            }
+            return;
         }
     }
 }
 
+}  // namespace
+
+::avro::GenericDatum transformFields(RuleContext &ctx,
+                                     const ::avro::ValidSchema &schema,
+                                     const ::avro::GenericDatum &datum) {
+    ::avro::GenericDatum result = datum;
+    transformFieldsInPlace(ctx, schema, result);
+    return result;
+}
+
+void transformFieldsInPlace(RuleContext &ctx,
+                            const ::avro::ValidSchema &schema,
+                            ::avro::GenericDatum &datum) {
+    const auto &root = schema.root();
+    auto plan = ctx.getVisitPlan(getSchemaName(schema).value_or(""), [&]() {
+        FieldVisitPlan::Records records;
+        collectVisits(ctx, *ctx.getTagIndex(), root, nullptr, records);
+        return FieldVisitPlan(std::move(records));
+    });
+    transformInPlace(ctx, plan.get(), root, datum);
+}
+
 // Transform individual field with context handling
 ::avro::GenericDatum transformFieldWithContext(
     RuleContext &ctx, const ::avro::ValidSchema &record_schema,
@@ -198,40 +371,7 @@ namespace utils {
 }
 
 FieldType avroSchemaToFieldType(const ::avro::ValidSchema &schema) {
-    switch (schema.root()->type()) {
-        case ::avro::AVRO_NULL:
-            return FieldType::Null;
-        case ::avro::AVRO_BOOL:
-            return FieldType::Boolean;
-        case ::avro::AVRO_INT:
-            return FieldType::Int;
-        case ::avro::AVRO_LONG:
-            return FieldType::Long;
-        case ::avro::AVRO_FLOAT:
-            return FieldType::Float;
-        case ::avro::AVRO_DOUBLE:
-            return FieldType::Double;
-        case ::avro::AVRO_BYTES:
-            return FieldType::Bytes;
-        case ::avro::AVRO_STRING:
-            return FieldType::String;
-        case ::avro::AVRO_RECORD:
-            return FieldType::Record;
-        case ::avro::AVRO_ENUM:
-            return FieldType::Enum;
-        case ::avro::AVRO_ARRAY:
-            return FieldType::Array;
-        case ::avro::AVRO_MAP:
-            return FieldType::Map;
-        case ::avro::AVRO_UNION:
-            return FieldType::Combined;
-        case ::avro::AVRO_FIXED:
-            return FieldType::Fixed;
-        case ::avro::AVRO_SYMBOLIC:
-            return FieldType::Record;  // Assume symbolic references are records
-        default:
-            return FieldType::String;  // Default fallback
-    }
+    return avroTypeToFieldType(schema.root()->type());
 }
 
 nlohmann::json avroToJson(const ::avro::GenericDatum &datum) {
@@ -470,45 +610,66 @@ std::optional<std::string> getSchemaName(const ::avro::ValidSchema &schema) {
 std::vector<uint8_t> serializeAvroData(
     const ::avro::GenericDatum &datum, const ::avro::ValidSchema &writer_schema,
     const std::vector<::avro::ValidSchema> &named_schemas) {
+    std::vector<uint8_t> out;
+    serializeAvroData(datum, writer_schema, named_schemas, out);
+    return out;
+}
+
+void serializeAvroData(const ::avro::GenericDatum &datum,
+                       const ::avro::ValidSchema &writer_schema,
+                       const std::vector<::avro::ValidSchema> &named_schemas,
+                       std::vector<uint8_t> &out) {
     try {
-        // If the writer schema is AVRO_BYTES, just return the raw bytes directly
+        // If the writer schema is AVRO_BYTES, just append the raw bytes
         if (writer_schema.root()->type() == ::avro::AVRO_BYTES) {
-            return datum.value<std::vector<uint8_t>>();
+            const auto &bytes = datum.value<std::vector<uint8_t>>();
+            out.insert(out.end(), bytes.begin(), bytes.end());
+            return;
         }
 
-        auto output_stream = ::avro::memoryOutputStream();
+        VectorOutputStream output_stream(out);
         auto encoder = ::avro::binaryEncoder();
-        encoder->init(*output_stream);
+        encoder->init(output_stream);
 
         ::avro::encode(*encoder, datum);
         encoder->flush();
-
-        // Get the data from the output stream
-        auto input_stream = ::avro::memoryInputStream(*output_stream);
-        const uint8_t *data = nullptr;
-        size_t size = 0;
-        if (input_stream->next(&data, &size)) {
-            return std::vector<uint8_t>(data, data + size);
-        }
-        return {};
     } catch (const ::avro::Exception &e) {
         throw AvroError(e);
     }
 }
 
+void serializeAvroData(const ::avro::GenericDatum &datum,
+                       const AvroCodec &codec, std::vector<uint8_t> &out) {
+    // If the writer schema is AVRO_BYTES, just append the raw bytes
+    if (codec.getSchema().root()->type() == ::avro::AVRO_BYTES) {
+        const auto &bytes = datum.value<std::vector<uint8_t>>();
+        out.insert(out.end(), bytes.begin(), bytes.end());
+        return;
+    }
+    codec.encode(datum, out);
+}
+
 ::avro::GenericDatum deserializeAvroData(
     const std::vector<uint8_t> &data, const ::avro::ValidSchema &writer_schema,
     const ::avro::ValidSchema *reader_schema,
     const std::vector<::avro::ValidSchema> &named_schemas) {
+    return deserializeAvroData(data.data(), data.size(), writer_schema,
+                               reader_schema, named_schemas);
+}
+
+::avro::GenericDatum deserializeAvroData(
+    const uint8_t *data, size_t size, const ::avro::ValidSchema &writer_schema,
+    const ::avro::ValidSchema *reader_schema,
+    const std::vector<::avro::ValidSchema> &named_schemas) {
     try {
         // If the writer schema is AVRO_BYTES, just return the raw bytes directly
         if (writer_schema.root()->type() == ::avro::AVRO_BYTES) {
             ::avro::GenericDatum datum(writer_schema);
-            datum.value<std::vector<uint8_t>>() = data;
+            datum.value<std::vector<uint8_t>>().assign(data, data + size);
             return datum;
         }
 
-        auto input_stream = ::avro::memoryInputStream(data.data(), data.size());
+        auto input_stream = ::avro::memoryInputStream(data, size);
         auto decoder = ::avro::binaryDecoder();
         decoder->init(*input_stream);
 
@@ -522,6 +683,17 @@ std::vector<uint8_t> serializeAvroData(
     }
 }
 
+::avro::GenericDatum deserializeAvroData(const uint8_t *data, size_t size,
+                                         const AvroCodec &codec) {
+    // If the writer schema is AVRO_BYTES, just return the raw bytes directly
+    if (codec.getSchema().root()->type() == ::avro::AVRO_BYTES) {
+        ::avro::GenericDatum datum(codec.getSchema());
+        datum.value<std::vector<uint8_t>>().assign(data, data + size);
+        return datum;
+    }
+    return codec.decode(data, size);
+}
+
 std::pair<::avro::ValidSchema, std::vector<::avro::ValidSchema>>
 parseSchemaWithNamed(const std::string &schema_str,
                      const std::vector<std::string> &named_schemas) {
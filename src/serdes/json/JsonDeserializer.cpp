@@ -19,7 +19,7 @@ class JsonDeserializer::Impl {
               config.subject_name_strategy_type,
               base_->getSerde().getClient(),
               config.subject_name_strategy_config,
-              [this](const std::optional<Schema> &s) { return getRecordName(s); })) {
+              [this](const Schema *s) { return getRecordName(s); })) {
         std::vector<std::shared_ptr<RuleExecutor>> executors;
         if (rule_registry) {
             executors = rule_registry->getExecutors();
@@ -38,10 +38,10 @@ class JsonDeserializer::Impl {
     }
 
     nlohmann::json deserialize(const SerializationContext &ctx,
-                               const std::vector<uint8_t> &data) {
+                               const uint8_t *data, size_t size) {
         // Get initial subject using configured subject name strategy (without schema)
         auto initial_subject =
-            subject_name_strategy_(ctx.topic, ctx.serde_type, std::nullopt);
+            subject_name_strategy_(ctx.topic, ctx.serde_type, nullptr);
         std::optional<schemaregistry::rest::model::RegisteredSchema>
             latest_schema;
 
@@ -59,22 +59,24 @@ class JsonDeserializer::Impl {
             }
         }
 
-        // Parse schema ID from data
+        // Parse schema ID from data, the message is read in place
         SchemaId schema_id(SerdeFormat::Json);
-        auto id_deserializer = base_->getConfig().schema_id_deserializer;
-        size_t bytes_read = id_deserializer(data, ctx, schema_id);
+        size_t bytes_read =
+            readSchemaId(base_->getConfig().schema_id_deserializer, data,
+                         size, ctx, schema_id);
 
-        const uint8_t *message_data = data.data() + bytes_read;
-        size_t message_size = data.size() - bytes_read;
+        const uint8_t *message_data = data + bytes_read;
+        size_t message_size = size - bytes_read;
 
         // Get writer schema (pass nullopt when initial subject is unknown)
-        auto writer_schema_raw =
-            base_->getWriterSchema(schema_id, initial_subject, std::nullopt);
+        auto writer_schema_ptr = base_->getWriterSchemaHandle(
+            schema_id, initial_subject, std::nullopt);
+        const auto &writer_schema_raw = *writer_schema_ptr;
         auto writer_schema = getParsedSchema(writer_schema_raw);
 
         // Recompute subject with writer schema (needed for Record/TopicRecord strategies)
         auto subject_opt = subject_name_strategy_(
-            ctx.topic, ctx.serde_type, std::make_optional(writer_schema_raw));
+            ctx.topic, ctx.serde_type, &writer_schema_raw);
         if (!subject_opt.has_value()) {
             throw SerializationError("Could not determine subject name");
         }
@@ -97,23 +99,24 @@ class JsonDeserializer::Impl {
         // Handle encoding rules
         std::vector<uint8_t> decoded_data;
         if (writer_schema_raw.getRuleSet().has_value()) {
-            decoded_data.assign(message_data, message_data + message_size);
             auto rule_set = writer_schema_raw.getRuleSet().value();
             if (rule_set.getEncodingRules().has_value()) {
+                decoded_data.assign(message_data, message_data + message_size);
                 auto bytes_value =
                     SerdeValue::newBytes(SerdeFormat::Json, decoded_data);
                 auto result = base_->getSerde().executeRulesWithPhase(
-                    ctx, subject, Phase::Encoding, Mode::Read, std::nullopt,
-                    std::make_optional(writer_schema_raw), *bytes_value, {});
+                    ctx, subject, Phase::Encoding, Mode::Read, nullptr,
+                    &writer_schema_raw, *bytes_value, {});
                 decoded_data = result->asBytes();
+                message_data = decoded_data.data();
+                message_size = decoded_data.size();
             }
-            message_data = decoded_data.data();
-            message_size = decoded_data.size();
         }
 
         // Schema evolution handling
-        std::vector<Migration> migrations;
-        schemaregistry::rest::model::Schema reader_schema_raw;
+        std::shared_ptr<const std::vector<Migration>> migrations;
+        std::shared_ptr<const schemaregistry::rest::model::Schema>
+            reader_schema_ptr;
         std::shared_ptr<jsoncons::jsonschema::json_schema<jsoncons::ojson>>
             reader_schema;
 
@@ -122,28 +125,28 @@ class JsonDeserializer::Impl {
             migrations = base_->getSerde().getMigrations(
                 subject, writer_schema_raw, latest_schema.value(),
                 std::nullopt);
-            reader_schema_raw = latest_schema->toSchema();
-            reader_schema = getParsedSchema(reader_schema_raw);
+            reader_schema_ptr = latest_schema->getSchemaHandle();
+            reader_schema = getParsedSchema(*reader_schema_ptr);
         } else {
             // No evolution - writer and reader schemas are the same
-            migrations = {};
-            reader_schema_raw = writer_schema_raw;
+            migrations = nullptr;
+            reader_schema_ptr = writer_schema_ptr;
             reader_schema = writer_schema;
         }
+        const auto &reader_schema_raw = *reader_schema_ptr;
 
         // Parse JSON from bytes
-        std::string json_string(reinterpret_cast<const char *>(message_data),
-                                message_size);
         nlohmann::json value;
         try {
-            value = nlohmann::json::parse(json_string);
+            value = nlohmann::json::parse(message_data,
+                                          message_data + message_size);
         } catch (const nlohmann::json::parse_error &e) {
             throw JsonError("Failed to parse JSON: " + std::string(e.what()));
         }
 
         // Apply migrations if needed
-        if (!migrations.empty()) {
-            value = executeMigrations(ctx, subject, migrations, value);
+        if (migrations && !migrations->empty()) {
+            value = executeMigrations(ctx, subject, *migrations, value);
         }
 
         // Create field transformer lambda
@@ -164,7 +167,7 @@ class JsonDeserializer::Impl {
 
         // Execute rules on the serde value
         auto transformed_value = base_->getSerde().executeRules(
-            ctx, subject, Mode::Read, std::nullopt, reader_schema_raw,
+            ctx, subject, Mode::Read, nullptr, &reader_schema_raw,
             *json_value, {},
             std::make_shared<FieldTransformer>(field_transformer));
 
@@ -196,8 +199,8 @@ class JsonDeserializer::Impl {
         return serde_->getParsedSchema(schema, base_->getSerde().getClient());
     }
 
-    std::string getRecordName(const std::optional<Schema> &schema) {
-        if (!schema.has_value()) return "";
+    std::string getRecordName(const Schema *schema) {
+        if (!schema) return "";
         auto json = nlohmann::json::parse(schema->getSchema().value());
         if (json.is_object()) {
             if (json.contains("title") && json["title"].is_string()) {
@@ -234,7 +237,12 @@ JsonDeserializer::~JsonDeserializer() = default;
 
 nlohmann::json JsonDeserializer::deserialize(const SerializationContext &ctx,
                                              const std::vector<uint8_t> &data) {
-    return impl_->deserialize(ctx, data);
+    return impl_->deserialize(ctx, data.data(), data.size());
+}
+
+nlohmann::json JsonDeserializer::deserialize(const SerializationContext &ctx,
+                                             const uint8_t *data, size_t size) {
+    return impl_->deserialize(ctx, data, size);
 }
 
 void JsonDeserializer::close() { impl_->close(); }
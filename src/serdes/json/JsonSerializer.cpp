@@ -1,6 +1,7 @@
 #include "schemaregistry/serdes/json/JsonSerializer.h"
 
 #include "schemaregistry/rest/RestException.h"
+#include "schemaregistry/rest/SchemaInterner.h"
 #include "schemaregistry/serdes/json/JsonUtils.h"
 #include <cctype>
 #include <cstdio>
@@ -108,6 +109,33 @@ nlohmann::json flattenSchemaReferences(
     return flattened;
 }
 
+// Output adapter appending the characters written by nlohmann's serializer
+// to a byte buffer
+class ByteOutputAdapter
+    : public nlohmann::detail::output_adapter_protocol<char> {
+  public:
+    explicit ByteOutputAdapter(std::vector<uint8_t> &out) : out_(out) {}
+
+    void write_character(char c) override {
+        out_.push_back(static_cast<uint8_t>(c));
+    }
+
+    void write_characters(const char *s, std::size_t length) override {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(s);
+        out_.insert(out_.end(), bytes, bytes + length);
+    }
+
+  private:
+    std::vector<uint8_t> &out_;
+};
+
+// Append the compact JSON text of value to out, as dump() would render it
+void dumpInto(const nlohmann::json &value, std::vector<uint8_t> &out) {
+    nlohmann::detail::serializer<nlohmann::json> serializer(
+        std::make_shared<ByteOutputAdapter>(out), ' ');
+    serializer.dump(value, false, false, 0);
+}
+
 }  // anonymous namespace
 
 // JsonSerde implementation
@@ -119,9 +147,8 @@ JsonSerde::getParsedSchema(
     std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client) {
     std::lock_guard<std::mutex> lock(cache_mutex_);
 
-    // Create cache key from schema content
-    auto schema_str = schema.getSchema();
-    std::string cache_key = schema_str.value_or("");
+    // Key on the schema's memoized content fingerprint
+    auto cache_key = schema.getFingerprint();
 
     auto it = parsed_schemas_cache_.find(cache_key);
     if (it != parsed_schemas_cache_.end()) {
@@ -134,9 +161,10 @@ JsonSerde::getParsedSchema(
         schema_resolution::resolveNamedSchema(schema, client, visited);
 
     // Parse main schema
+    std::string schema_str = schema.getSchema().value_or("");
     nlohmann::json parsed_schema;
     try {
-        parsed_schema = nlohmann::json::parse(cache_key);
+        parsed_schema = nlohmann::json::parse(schema_str);
     } catch (const nlohmann::json::parse_error &e) {
         throw JsonError("Failed to parse JSON schema: " +
                         std::string(e.what()));
@@ -184,6 +212,10 @@ void JsonSerde::resolveNamedSchema(
 }
 
 class JsonSerializer::Impl {
+    using ParsedJsonSchema =
+        std::shared_ptr<jsoncons::jsonschema::json_schema<jsoncons::ojson>>;
+    using JsonPlan = SerializerPlan<ParsedJsonSchema>;
+
   public:
     Impl(std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client,
          std::optional<schemaregistry::rest::model::Schema> schema,
@@ -197,7 +229,9 @@ class JsonSerializer::Impl {
               config.subject_name_strategy_type,
               base_->getSerde().getClient(),
               config.subject_name_strategy_config,
-              [this](const std::optional<Schema> &s) { return getRecordName(s); })) {
+              [this](const Schema *s) { return getRecordName(s); })),
+          cache_subject_(config.subject_name_strategy_type !=
+                         SubjectNameStrategyType::Associated) {
         std::vector<std::shared_ptr<RuleExecutor>> executors;
         if (rule_registry) {
             executors = rule_registry->getExecutors();
@@ -215,23 +249,29 @@ class JsonSerializer::Impl {
         }
     }
 
-    std::vector<uint8_t> serialize(const SerializationContext &ctx,
-                                   const nlohmann::json &value) {
-        auto mutable_value = value;  // Copy for potential transformation
-
-        // Get subject using configured subject name strategy
-        auto subject_opt =
-            subject_name_strategy_(ctx.topic, ctx.serde_type, schema_);
-        if (!subject_opt.has_value()) {
-            throw SerializationError("Could not determine subject for serialization");
+    void serialize(const SerializationContext &ctx, const nlohmann::json &value,
+                   std::vector<uint8_t> &out) {
+        auto plan = plans_.get(ctx.topic, ctx.serde_type);
+
+        // Get subject using configured subject name strategy, unless the
+        // plan already resolved it with a strategy that cannot change
+        std::optional<std::string> resolved_subject;
+        if (!plan || !cache_subject_) {
+            resolved_subject =
+                subject_name_strategy_(ctx.topic, ctx.serde_type,
+                                       schema_ ? &*schema_ : nullptr);
+            if (!resolved_subject.has_value()) {
+                throw SerializationError(
+                    "Could not determine subject for serialization");
+            }
         }
-        const std::string &subject = subject_opt.value();
+        // Copied, as a stale plan is released once its replacement is cached
+        std::string subject = resolved_subject.has_value()
+                                  ? std::move(*resolved_subject)
+                                  : plan->subject;
 
-        // Get or register schema
-        SchemaId schema_id(SerdeFormat::Json);
         std::optional<schemaregistry::rest::model::RegisteredSchema>
             latest_schema;
-
         try {
             latest_schema = base_->getSerde().getReaderSchema(
                 subject, std::nullopt, base_->getConfig().use_schema);
@@ -242,134 +282,160 @@ class JsonSerializer::Impl {
             // Schema not found - will use provided schema
         }
 
-        schemaregistry::rest::model::Schema target_schema;
-        std::shared_ptr<jsoncons::jsonschema::json_schema<jsoncons::ojson>>
-            parsed_schema;
-
-        if (latest_schema.has_value()) {
-            target_schema = latest_schema->toSchema();
-            auto id_opt = latest_schema->getId();
-            if (id_opt.has_value()) {
-                schema_id.setId(id_opt.value());
-            }
-            auto guid_opt = latest_schema->getGuid();
-            if (guid_opt.has_value()) {
-                schema_id.setGuid(guid_opt.value());
-            }
+        // Rebuild the plan if the latest schema changed since it was built
+        if (!plan || !plan->isCurrent(subject, latest_schema)) {
+            plan = compilePlan(subject, latest_schema);
+            plans_.put(ctx.topic, ctx.serde_type, plan);
+        }
 
-            // Get parsed schema
-            parsed_schema = getParsedSchema(target_schema);
-
-            // Create field transformer lambda
-            auto field_transformer =
-                [this, &parsed_schema](
-                    RuleContext &ctx, const std::string &rule_type,
-                    const SerdeValue &msg) -> std::unique_ptr<SerdeValue> {
-                if (msg.getFormat() == SerdeFormat::Json) {
-                    auto json = asJson(msg);
-                    auto transformed = utils::value_transform::transformFields(
-                        ctx, parsed_schema, json);
-                    return makeJsonValue(transformed);
-                }
-                return msg.clone();
-            };
-
-            auto json_value = makeJsonValue(mutable_value);
-
-            // Execute rules on the serde value
+        // Execute rules on a copy of the value, if there are any
+        const nlohmann::json *target_value = &value;
+        nlohmann::json transformed;
+        if (plan->has_domain_rules) {
+            auto json_value = makeJsonValue(value);
             auto transformed_value = base_->getSerde().executeRules(
-                ctx, subject, Mode::Write, std::nullopt, target_schema,
-                *json_value, {},
-                std::make_shared<FieldTransformer>(field_transformer));
+                ctx, subject, Mode::Write, nullptr, plan->schema.get(),
+                *json_value, {}, plan->field_transformer);
 
             // Extract Json value from result
-            if (transformed_value->getFormat() == SerdeFormat::Json) {
-                mutable_value = asJson(*transformed_value);
-            } else {
+            if (transformed_value->getFormat() != SerdeFormat::Json) {
                 throw JsonError(
                     "Unexpected serde value type returned from rule execution");
             }
+            transformed = asJson(*transformed_value);
+            target_value = &transformed;
+        }
+
+        // Validate JSON against schema if validation is enabled
+        if (base_->getConfig().validate) {
+            try {
+                validation_utils::validateJson(plan->parsed, *target_value);
+            } catch (const std::exception &e) {
+                throw JsonValidationError("JSON validation failed: " +
+                                          std::string(e.what()));
+            }
+        }
+
+        // Serialize JSON to bytes, right after the schema ID prefix unless
+        // encoding rules rewrite the payload
+        if (plan->id_prefix.has_value() && !plan->has_encoding_rules) {
+            out.assign(plan->id_prefix->begin(), plan->id_prefix->end());
+            dumpInto(*target_value, out);
+            return;
+        }
+        std::vector<uint8_t> encoded_bytes;
+        dumpInto(*target_value, encoded_bytes);
+
+        // Apply encoding rules if present
+        if (plan->has_encoding_rules) {
+            auto bytes_value =
+                SerdeValue::newBytes(SerdeFormat::Json, encoded_bytes);
+            auto result = base_->getSerde().executeRulesWithPhase(
+                ctx, subject, Phase::Encoding, Mode::Write, nullptr,
+                plan->schema.get(), *bytes_value, {});
+            encoded_bytes = result->asBytes();
+        }
+
+        // Serialize schema ID with message
+        const auto &id_serializer = base_->getConfig().schema_id_serializer;
+        out = id_serializer(encoded_bytes, ctx, plan->schema_id);
+    }
+
+    // Build the plan for subject, writing with the latest schema if the
+    // registry returned one, or else with the serializer's own schema
+    std::shared_ptr<const JsonPlan> compilePlan(
+        const std::string &subject,
+        const std::optional<schemaregistry::rest::model::RegisteredSchema>
+            &latest_schema) {
+        auto plan = std::make_shared<JsonPlan>();
+        plan->subject = subject;
+        plan->schema_id = SchemaId(SerdeFormat::Json);
+
+        std::optional<schemaregistry::rest::model::RegisteredSchema>
+            registered_schema = latest_schema;
+        if (latest_schema.has_value()) {
+            plan->latest = latest_schema->getSchemaHandle();
+            plan->schema = plan->latest;
         } else {
             // Use provided schema
             if (!schema_.has_value()) {
-                throw JsonError("Schema needs to be set for auto-registration");
+                throw JsonError(
+                    "Schema needs to be set for auto-registration");
             }
-            target_schema = schema_.value();
+            plan->schema =
+                schemaregistry::rest::SchemaInterner::global().intern(
+                    *schema_);
 
             // Register or get schema
             if (base_->getConfig().auto_register_schemas) {
-                auto registered_schema =
+                registered_schema =
                     base_->getSerde().getClient()->registerSchema(
-                        subject, target_schema,
+                        subject, *plan->schema,
                         base_->getConfig().normalize_schemas);
-                auto id_opt = registered_schema.getId();
-                if (id_opt.has_value()) {
-                    schema_id.setId(id_opt.value());
-                }
-                auto guid_opt = registered_schema.getGuid();
-                if (guid_opt.has_value()) {
-                    schema_id.setGuid(guid_opt.value());
-                }
             } else {
-                auto registered_schema =
+                registered_schema =
                     base_->getSerde().getClient()->getBySchema(
-                        subject, target_schema,
+                        subject, *plan->schema,
                         base_->getConfig().normalize_schemas, false);
-                auto id_opt = registered_schema.getId();
-                if (id_opt.has_value()) {
-                    schema_id.setId(id_opt.value());
-                }
-                auto guid_opt = registered_schema.getGuid();
-                if (guid_opt.has_value()) {
-                    schema_id.setGuid(guid_opt.value());
-                }
             }
-
-            parsed_schema = getParsedSchema(target_schema);
         }
 
-        // Validate JSON against schema if validation is enabled
-        if (base_->getConfig().validate) {
-            try {
-                validation_utils::validateJson(parsed_schema, mutable_value);
-            } catch (const std::exception &e) {
-                throw JsonValidationError("JSON validation failed: " +
-                                          std::string(e.what()));
-            }
+        auto id_opt = registered_schema->getId();
+        if (id_opt.has_value()) {
+            plan->schema_id.setId(id_opt.value());
         }
-
-        // Serialize JSON to bytes
-        std::string json_string = mutable_value.dump();
-        std::vector<uint8_t> encoded_bytes(json_string.begin(),
-                                           json_string.end());
-
-        // Apply encoding rules if present
-        if (target_schema.getRuleSet().has_value()) {
-            auto rule_set = target_schema.getRuleSet().value();
-            if (rule_set.getEncodingRules().has_value()) {
-                auto bytes_value =
-                    SerdeValue::newBytes(SerdeFormat::Json, encoded_bytes);
-                auto result = base_->getSerde().executeRulesWithPhase(
-                    ctx, subject, Phase::Encoding, Mode::Write, std::nullopt,
-                    std::make_optional(target_schema), *bytes_value, {});
-                encoded_bytes = result->asBytes();
-            }
+        auto guid_opt = registered_schema->getGuid();
+        if (guid_opt.has_value()) {
+            plan->schema_id.setGuid(guid_opt.value());
+        }
+        plan->id_prefix = schemaIdPrefix(
+            base_->getConfig().schema_id_serializer, plan->schema_id);
+
+        plan->parsed = getParsedSchema(*plan->schema);
+
+        if (plan->latest) {
+            // The transformer is owned by the plan, so it can refer to the
+            // plan's parsed schema
+            const auto *parsed_schema = &plan->parsed;
+            plan->field_transformer = std::make_shared<FieldTransformer>(
+                [parsed_schema](RuleContext &ctx, const std::string &rule_type,
+                                const SerdeValue &msg)
+                    -> std::unique_ptr<SerdeValue> {
+                    if (msg.getFormat() == SerdeFormat::Json) {
+                        auto json = asJson(msg);
+                        auto transformed =
+                            utils::value_transform::transformFields(
+                                ctx, *parsed_schema, json);
+                        return makeJsonValue(transformed);
+                    }
+                    return msg.clone();
+                });
+
+            const auto &rule_set = plan->schema->getRuleSet();
+            plan->has_domain_rules =
+                rule_set.has_value() &&
+                rule_set->getDomainRules().has_value() &&
+                !rule_set->getDomainRules()->empty();
         }
 
-        // Serialize schema ID with message
-        auto id_serializer = base_->getConfig().schema_id_serializer;
-        return id_serializer(encoded_bytes, ctx, schema_id);
+        const auto &rule_set = plan->schema->getRuleSet();
+        plan->has_encoding_rules =
+            rule_set.has_value() && rule_set->getEncodingRules().has_value();
+        return plan;
     }
 
-    void close() { serde_->clear(); }
+    void close() {
+        plans_.clear();
+        serde_->clear();
+    }
 
     std::shared_ptr<jsoncons::jsonschema::json_schema<jsoncons::ojson>>
     getParsedSchema(const schemaregistry::rest::model::Schema &schema) {
         return serde_->getParsedSchema(schema, base_->getSerde().getClient());
     }
 
-    std::string getRecordName(const std::optional<Schema> &schema) {
-        if (!schema.has_value()) return "";
+    std::string getRecordName(const Schema *schema) {
+        if (!schema) return "";
         auto json = nlohmann::json::parse(schema->getSchema().value());
         if (json.is_object()) {
             if (json.contains("title") && json["title"].is_string()) {
@@ -384,6 +450,10 @@ class JsonSerializer::Impl {
     std::shared_ptr<BaseSerializer> base_;
     std::unique_ptr<JsonSerde> serde_;
     SubjectNameStrategyFunc subject_name_strategy_;
+    // Associated subjects may change over time, other strategies only
+    // depend on the topic and the serializer's own schema
+    bool cache_subject_;
+    SerializerPlanCache<ParsedJsonSchema> plans_;
 };
 
 JsonSerializer::JsonSerializer(
@@ -397,7 +467,15 @@ JsonSerializer::~JsonSerializer() = default;
 
 std::vector<uint8_t> JsonSerializer::serialize(const SerializationContext &ctx,
                                                const nlohmann::json &value) {
-    return impl_->serialize(ctx, value);
+    std::vector<uint8_t> out;
+    impl_->serialize(ctx, value, out);
+    return out;
+}
+
+void JsonSerializer::serialize(const SerializationContext &ctx,
+                               const nlohmann::json &value,
+                               std::vector<uint8_t> &out) {
+    impl_->serialize(ctx, value, out);
 }
 
 void JsonSerializer::close() { impl_->close(); }
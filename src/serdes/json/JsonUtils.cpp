@@ -67,6 +67,24 @@ std::unordered_map<std::string, nlohmann::json> resolveNamedSchema(
 // Value transformation implementations
 namespace value_transform {
 
+namespace {
+
+/**
+ * Whether the rule may apply to the field at path, from the inline tags of
+ * its schema and the metadata tags matching it
+ */
+bool visitsField(const RuleContext &ctx, const jsoncons::ojson &field_schema,
+                 const std::string &path) {
+    if (ctx.getRuleTags().empty() ||
+        ctx.appliesTo(schema_navigation::getConfluentTags(field_schema))) {
+        return true;
+    }
+    const auto &tag_index = ctx.getTagIndex();
+    return tag_index && ctx.appliesTo(*tag_index->getMetadataTags(path));
+}
+
+}  // namespace
+
 nlohmann::json transformFields(
     RuleContext &ctx,
     std::shared_ptr<jsoncons::jsonschema::json_schema<jsoncons::ojson>> schema,
@@ -104,6 +122,16 @@ nlohmann::json transformFields(
                         for (const auto &[key, field_value] :
                              instance_node.object_range()) {
                             if (properties.contains(key)) {
+                                // Only fields the rule may apply to are
+                                // transformed, the walk visits nested ones
+                                std::string field_path =
+                                    path_utils::appendToPath(
+                                        instance_location_str, key);
+                                if (!visitsField(ctx, properties[key],
+                                                 field_path)) {
+                                    continue;
+                                }
+
                                 // Create unique location identifier for this
                                 // field
                                 auto field_location = instance_location;
@@ -125,9 +153,6 @@ nlohmann::json transformFields(
                                     field_value.is_string()
                                         ? field_value.as_string()
                                         : "";
-                                std::string field_path =
-                                    path_utils::appendToPath(
-                                        instance_location.to_string(), key);
                                 auto transformed_value =
                                     transformFieldWithContext(
                                         ctx, properties[key], field_path,
@@ -222,27 +247,8 @@ jsoncons::ojson transform(RuleContext &ctx, const jsoncons::ojson &schema,
     if (field_ctx.has_value()) {
         field_ctx->setFieldType(schema_navigation::getFieldType(schema));
 
-        auto rule_tags = ctx.getRule().getTags();
-        std::unordered_set<std::string> rule_tags_set;
-        if (rule_tags.has_value()) {
-            rule_tags_set = std::unordered_set<std::string>(rule_tags->begin(),
-                                                            rule_tags->end());
-        }
-
-        // Check if rule tags overlap with field context tags (empty
-        // rule_tags means apply to all)
-        bool should_apply = !rule_tags.has_value() || rule_tags_set.empty();
-        if (!should_apply) {
-            const auto &field_tags = field_ctx->getTags();
-            for (const auto &field_tag : field_tags) {
-                if (rule_tags_set.find(field_tag) != rule_tags_set.end()) {
-                    should_apply = true;
-                    break;
-                }
-            }
-        }
-
-        if (should_apply) {
+        // Empty rule tags mean apply to all fields
+        if (ctx.appliesTo(field_ctx->getTags())) {
             auto message_value = makeJsonValue(value);
 
             // Get field executor type from the rule
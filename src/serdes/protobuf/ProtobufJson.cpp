@@ -0,0 +1,691 @@
+/**
+ * ProtobufJson
+ * Conversion between protobuf messages and JSON values through reflection,
+ * following the proto3 JSON mapping
+ */
+
+#include <google/protobuf/duration.pb.h>
+#include <google/protobuf/field_mask.pb.h>
+#include <google/protobuf/timestamp.pb.h>
+#include <google/protobuf/util/field_mask_util.h>
+#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/time_util.h>
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/numbers.h"
+#include "schemaregistry/serdes/protobuf/ProtobufUtils.h"
+
+// Fix for Windows GetMessage macro conflict
+#ifdef _WIN32
+#ifdef GetMessage
+#undef GetMessage
+#endif
+#endif
+
+namespace schemaregistry::serdes::protobuf::utils {
+
+namespace {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+bool isWrapper(const std::string &full_name) {
+    return full_name == "google.protobuf.DoubleValue" ||
+           full_name == "google.protobuf.FloatValue" ||
+           full_name == "google.protobuf.Int64Value" ||
+           full_name == "google.protobuf.UInt64Value" ||
+           full_name == "google.protobuf.Int32Value" ||
+           full_name == "google.protobuf.UInt32Value" ||
+           full_name == "google.protobuf.BoolValue" ||
+           full_name == "google.protobuf.StringValue" ||
+           full_name == "google.protobuf.BytesValue";
+}
+
+// Fields set from a JSON null rather than cleared by it
+bool acceptsNull(const FieldDescriptor *fd) {
+    if (fd->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+        return fd->message_type()->full_name() == "google.protobuf.Value";
+    }
+    if (fd->cpp_type() == FieldDescriptor::CPPTYPE_ENUM) {
+        return fd->enum_type()->full_name() == "google.protobuf.NullValue";
+    }
+    return false;
+}
+
+const FieldDescriptor *requireField(const Descriptor *descriptor,
+                                    const std::string &name) {
+    const auto *fd = descriptor->FindFieldByName(name);
+    if (!fd) {
+        throw ProtobufError("Field " + name + " not found in " +
+                            descriptor->full_name());
+    }
+    return fd;
+}
+
+// ---------------------------- To JSON ------------------------------------
+
+nlohmann::json doubleToJson(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "Infinity" : "-Infinity";
+    }
+    return value;
+}
+
+/**
+ * Widen a float to the double of its shortest decimal representation, so
+ * that e.g. 3.45f is 3.45 rather than 3.4500000476837158 in JSON
+ */
+double floatToDouble(float value) {
+    if (!std::isfinite(value)) {
+        return value;
+    }
+    char buffer[32];
+    for (int precision = FLT_DIG; precision <= FLT_DIG + 3; ++precision) {
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (std::strtof(buffer, nullptr) == value) {
+            break;
+        }
+    }
+    return std::strtod(buffer, nullptr);
+}
+
+nlohmann::json enumToJson(const google::protobuf::EnumDescriptor *enum_type,
+                          int number) {
+    if (enum_type->full_name() == "google.protobuf.NullValue") {
+        return nullptr;
+    }
+    const auto *value = enum_type->FindValueByNumber(number);
+    if (!value) {
+        return number;
+    }
+    return value->name();
+}
+
+/**
+ * Value of a singular field, or of the element at index of a repeated field
+ */
+nlohmann::json valueToJson(const Message &message, const FieldDescriptor *fd,
+                           int index) {
+    const Reflection *reflection = message.GetReflection();
+    bool repeated = index >= 0;
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32:
+            return repeated ? reflection->GetRepeatedInt32(message, fd, index)
+                            : reflection->GetInt32(message, fd);
+        case FieldDescriptor::CPPTYPE_UINT32:
+            return repeated ? reflection->GetRepeatedUInt32(message, fd, index)
+                            : reflection->GetUInt32(message, fd);
+        case FieldDescriptor::CPPTYPE_INT64:
+            // 64-bit integers are strings, as JSON numbers may lose precision
+            return std::to_string(
+                repeated ? reflection->GetRepeatedInt64(message, fd, index)
+                         : reflection->GetInt64(message, fd));
+        case FieldDescriptor::CPPTYPE_UINT64:
+            return std::to_string(
+                repeated ? reflection->GetRepeatedUInt64(message, fd, index)
+                         : reflection->GetUInt64(message, fd));
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+            return doubleToJson(
+                repeated ? reflection->GetRepeatedDouble(message, fd, index)
+                         : reflection->GetDouble(message, fd));
+        case FieldDescriptor::CPPTYPE_FLOAT:
+            return doubleToJson(floatToDouble(
+                repeated ? reflection->GetRepeatedFloat(message, fd, index)
+                         : reflection->GetFloat(message, fd)));
+        case FieldDescriptor::CPPTYPE_BOOL:
+            return repeated ? reflection->GetRepeatedBool(message, fd, index)
+                            : reflection->GetBool(message, fd);
+        case FieldDescriptor::CPPTYPE_ENUM:
+            return enumToJson(
+                fd->enum_type(),
+                repeated ? reflection->GetRepeatedEnumValue(message, fd, index)
+                         : reflection->GetEnumValue(message, fd));
+        case FieldDescriptor::CPPTYPE_STRING: {
+            std::string scratch;
+            const std::string &value =
+                repeated ? reflection->GetRepeatedStringReference(
+                               message, fd, index, &scratch)
+                         : reflection->GetStringReference(message, fd,
+                                                          &scratch);
+            if (fd->type() == FieldDescriptor::TYPE_BYTES) {
+                return absl::Base64Escape(value);
+            }
+            return value;
+        }
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+            return messageToJson(
+                repeated ? reflection->GetRepeatedMessage(message, fd, index)
+                         : reflection->GetMessage(message, fd));
+    }
+    throw ProtobufError("Unsupported type of field " + fd->full_name());
+}
+
+std::string mapKeyToString(const Message &entry, const FieldDescriptor *fd) {
+    const Reflection *reflection = entry.GetReflection();
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_BOOL:
+            return reflection->GetBool(entry, fd) ? "true" : "false";
+        case FieldDescriptor::CPPTYPE_STRING:
+            return reflection->GetString(entry, fd);
+        default:
+            // Integer keys, which are strings rather than numbers for int64
+            // keys as well
+            auto key = valueToJson(entry, fd, -1);
+            return key.is_string() ? key.get<std::string>() : key.dump();
+    }
+}
+
+nlohmann::json fieldToJson(const Message &message, const FieldDescriptor *fd) {
+    const Reflection *reflection = message.GetReflection();
+    if (fd->is_map()) {
+        const auto *key_fd = fd->message_type()->map_key();
+        const auto *value_fd = fd->message_type()->map_value();
+        auto json = nlohmann::json::object();
+        for (int i = 0; i < reflection->FieldSize(message, fd); ++i) {
+            const auto &entry = reflection->GetRepeatedMessage(message, fd, i);
+            json[mapKeyToString(entry, key_fd)] =
+                valueToJson(entry, value_fd, -1);
+        }
+        return json;
+    }
+    if (fd->is_repeated()) {
+        auto json = nlohmann::json::array();
+        for (int i = 0; i < reflection->FieldSize(message, fd); ++i) {
+            json.push_back(valueToJson(message, fd, i));
+        }
+        return json;
+    }
+    return valueToJson(message, fd, -1);
+}
+
+/**
+ * Seconds and nanos of a Timestamp or Duration, which may be a dynamic
+ * message of a descriptor in another pool than the generated one
+ */
+template <typename Time>
+Time timeOf(const Message &message) {
+    const auto *descriptor = message.GetDescriptor();
+    const Reflection *reflection = message.GetReflection();
+    Time time;
+    time.set_seconds(
+        reflection->GetInt64(message, requireField(descriptor, "seconds")));
+    time.set_nanos(
+        reflection->GetInt32(message, requireField(descriptor, "nanos")));
+    return time;
+}
+
+/**
+ * JSON of the well-known types with a special representation, or null for
+ * other messages
+ */
+std::optional<nlohmann::json> wellKnownToJson(const Message &message) {
+    const auto *descriptor = message.GetDescriptor();
+    if (descriptor->file()->package() != "google.protobuf") {
+        return std::nullopt;
+    }
+    const std::string &full_name = descriptor->full_name();
+    const Reflection *reflection = message.GetReflection();
+
+    if (full_name == "google.protobuf.Timestamp") {
+        return google::protobuf::util::TimeUtil::ToString(
+            timeOf<google::protobuf::Timestamp>(message));
+    }
+    if (full_name == "google.protobuf.Duration") {
+        return google::protobuf::util::TimeUtil::ToString(
+            timeOf<google::protobuf::Duration>(message));
+    }
+    if (full_name == "google.protobuf.FieldMask") {
+        google::protobuf::FieldMask mask;
+        const auto *paths_fd = requireField(descriptor, "paths");
+        for (int i = 0; i < reflection->FieldSize(message, paths_fd); ++i) {
+            mask.add_paths(reflection->GetRepeatedString(message, paths_fd, i));
+        }
+        std::string json;
+        if (!google::protobuf::util::FieldMaskUtil::ToJsonString(mask,
+                                                                 &json)) {
+            throw ProtobufError("Failed to convert field mask to JSON");
+        }
+        return json;
+    }
+    if (isWrapper(full_name)) {
+        return valueToJson(message, requireField(descriptor, "value"), -1);
+    }
+    if (full_name == "google.protobuf.Struct") {
+        return fieldToJson(message, requireField(descriptor, "fields"));
+    }
+    if (full_name == "google.protobuf.ListValue") {
+        return fieldToJson(message, requireField(descriptor, "values"));
+    }
+    if (full_name == "google.protobuf.Value") {
+        const auto *fd = reflection->GetOneofFieldDescriptor(
+            message, descriptor->oneof_decl(0));
+        if (!fd) {
+            return nlohmann::json(nullptr);
+        }
+        return valueToJson(message, fd, -1);
+    }
+    if (full_name == "google.protobuf.Any") {
+        // Any needs its type resolved, which the library's printer does
+        std::string json;
+        auto status =
+            google::protobuf::util::MessageToJsonString(message, &json);
+        if (!status.ok()) {
+            throw ProtobufError("Failed to convert message to JSON: " +
+                                status.ToString());
+        }
+        return nlohmann::json::parse(json);
+    }
+    return std::nullopt;
+}
+
+// ---------------------------- From JSON ----------------------------------
+
+[[noreturn]] void invalidValue(const FieldDescriptor *fd,
+                               const nlohmann::json &json) {
+    throw ProtobufError("Invalid value " + json.dump() + " for field " +
+                        fd->full_name());
+}
+
+template <typename Int>
+Int intFromJson(const nlohmann::json &json, const FieldDescriptor *fd) {
+    Int value;
+    if (json.is_number_unsigned()) {
+        auto number = json.get<uint64_t>();
+        if (number > static_cast<uint64_t>(std::numeric_limits<Int>::max())) {
+            invalidValue(fd, json);
+        }
+        return static_cast<Int>(number);
+    }
+    if (json.is_number_integer()) {
+        auto number = json.get<int64_t>();
+        if (number < static_cast<int64_t>(std::numeric_limits<Int>::min()) ||
+            (number > 0 &&
+             static_cast<uint64_t>(number) >
+                 static_cast<uint64_t>(std::numeric_limits<Int>::max()))) {
+            invalidValue(fd, json);
+        }
+        return static_cast<Int>(number);
+    }
+    if (json.is_number_float()) {
+        // Integral doubles, e.g. results of arithmetic in rules
+        double number = json.get<double>();
+        if (std::trunc(number) != number ||
+            number < static_cast<double>(std::numeric_limits<Int>::min()) ||
+            number >= std::ldexp(1.0, std::numeric_limits<Int>::digits)) {
+            invalidValue(fd, json);
+        }
+        return static_cast<Int>(number);
+    }
+    if (json.is_string() &&
+        absl::SimpleAtoi(json.get_ref<const std::string &>(), &value)) {
+        return value;
+    }
+    invalidValue(fd, json);
+}
+
+double doubleFromJson(const nlohmann::json &json, const FieldDescriptor *fd) {
+    if (json.is_number()) {
+        return json.get<double>();
+    }
+    if (json.is_string()) {
+        const auto &str = json.get_ref<const std::string &>();
+        if (str == "NaN") {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        if (str == "Infinity") {
+            return std::numeric_limits<double>::infinity();
+        }
+        if (str == "-Infinity") {
+            return -std::numeric_limits<double>::infinity();
+        }
+        double value;
+        if (absl::SimpleAtod(str, &value) && std::isfinite(value)) {
+            return value;
+        }
+    }
+    invalidValue(fd, json);
+}
+
+float floatFromJson(const nlohmann::json &json, const FieldDescriptor *fd) {
+    double value = doubleFromJson(json, fd);
+    if (std::isfinite(value) && std::abs(value) > FLT_MAX) {
+        invalidValue(fd, json);
+    }
+    return static_cast<float>(value);
+}
+
+int enumFromJson(const nlohmann::json &json, const FieldDescriptor *fd) {
+    if (json.is_null()) {
+        // Only google.protobuf.NullValue accepts null
+        return 0;
+    }
+    if (json.is_string()) {
+        const auto *value = fd->enum_type()->FindValueByName(
+            json.get_ref<const std::string &>());
+        if (!value) {
+            invalidValue(fd, json);
+        }
+        return value->number();
+    }
+    return intFromJson<int32_t>(json, fd);
+}
+
+std::string stringFromJson(const nlohmann::json &json,
+                           const FieldDescriptor *fd) {
+    if (!json.is_string()) {
+        invalidValue(fd, json);
+    }
+    const auto &str = json.get_ref<const std::string &>();
+    if (fd->type() != FieldDescriptor::TYPE_BYTES) {
+        return str;
+    }
+    // Either the standard or the URL-safe base64 alphabet
+    std::string bytes;
+    if (!absl::Base64Unescape(str, &bytes) &&
+        !absl::WebSafeBase64Unescape(str, &bytes)) {
+        invalidValue(fd, json);
+    }
+    return bytes;
+}
+
+/**
+ * Set a singular field, or add an element to a repeated field
+ */
+void valueFromJson(const nlohmann::json &json, Message *message,
+                   const FieldDescriptor *fd) {
+    const Reflection *reflection = message->GetReflection();
+    bool repeated = fd->is_repeated();
+    switch (fd->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32: {
+            auto value = intFromJson<int32_t>(json, fd);
+            repeated ? reflection->AddInt32(message, fd, value)
+                     : reflection->SetInt32(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_UINT32: {
+            auto value = intFromJson<uint32_t>(json, fd);
+            repeated ? reflection->AddUInt32(message, fd, value)
+                     : reflection->SetUInt32(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_INT64: {
+            auto value = intFromJson<int64_t>(json, fd);
+            repeated ? reflection->AddInt64(message, fd, value)
+                     : reflection->SetInt64(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_UINT64: {
+            auto value = intFromJson<uint64_t>(json, fd);
+            repeated ? reflection->AddUInt64(message, fd, value)
+                     : reflection->SetUInt64(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_DOUBLE: {
+            auto value = doubleFromJson(json, fd);
+            repeated ? reflection->AddDouble(message, fd, value)
+                     : reflection->SetDouble(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_FLOAT: {
+            auto value = floatFromJson(json, fd);
+            repeated ? reflection->AddFloat(message, fd, value)
+                     : reflection->SetFloat(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_BOOL: {
+            if (!json.is_boolean()) {
+                invalidValue(fd, json);
+            }
+            auto value = json.get<bool>();
+            repeated ? reflection->AddBool(message, fd, value)
+                     : reflection->SetBool(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_ENUM: {
+            auto value = enumFromJson(json, fd);
+            repeated ? reflection->AddEnumValue(message, fd, value)
+                     : reflection->SetEnumValue(message, fd, value);
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_STRING: {
+            auto value = stringFromJson(json, fd);
+            repeated ? reflection->AddString(message, fd, std::move(value))
+                     : reflection->SetString(message, fd, std::move(value));
+            return;
+        }
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+            jsonToMessage(json, repeated ? reflection->AddMessage(message, fd)
+                                         : reflection->MutableMessage(message,
+                                                                      fd));
+            return;
+    }
+    throw ProtobufError("Unsupported type of field " + fd->full_name());
+}
+
+void mapKeyFromString(const std::string &key, Message *entry,
+                      const FieldDescriptor *fd) {
+    if (fd->cpp_type() == FieldDescriptor::CPPTYPE_BOOL) {
+        if (key != "true" && key != "false") {
+            invalidValue(fd, key);
+        }
+        entry->GetReflection()->SetBool(entry, fd, key == "true");
+        return;
+    }
+    // Integer keys are parsed from their string
+    valueFromJson(key, entry, fd);
+}
+
+void fieldFromJson(const nlohmann::json &json, Message *message,
+                   const FieldDescriptor *fd) {
+    const Reflection *reflection = message->GetReflection();
+    if (json.is_null() && !acceptsNull(fd)) {
+        reflection->ClearField(message, fd);
+        return;
+    }
+    if (fd->is_map()) {
+        if (!json.is_object()) {
+            invalidValue(fd, json);
+        }
+        const auto *key_fd = fd->message_type()->map_key();
+        const auto *value_fd = fd->message_type()->map_value();
+        for (const auto &item : json.items()) {
+            auto *entry = reflection->AddMessage(message, fd);
+            mapKeyFromString(item.key(), entry, key_fd);
+            if (!item.value().is_null() || acceptsNull(value_fd)) {
+                valueFromJson(item.value(), entry, value_fd);
+            }
+        }
+        return;
+    }
+    if (fd->is_repeated()) {
+        if (!json.is_array()) {
+            invalidValue(fd, json);
+        }
+        for (const auto &element : json) {
+            if (element.is_null() && !acceptsNull(fd)) {
+                invalidValue(fd, element);
+            }
+            valueFromJson(element, message, fd);
+        }
+        return;
+    }
+    valueFromJson(json, message, fd);
+}
+
+/**
+ * Field of a message by JSON name, original name or, for extensions, by
+ * their bracketed full name
+ */
+const FieldDescriptor *findJsonField(const Descriptor *descriptor,
+                                     const std::string &key) {
+    if (key.size() > 2 && key.front() == '[' && key.back() == ']') {
+        const auto *fd = descriptor->file()->pool()->FindExtensionByName(
+            key.substr(1, key.size() - 2));
+        // Extensions of other messages are unknown fields of this one
+        return fd && fd->containing_type() == descriptor ? fd : nullptr;
+    }
+    const auto *fd = descriptor->FindFieldByCamelcaseName(key);
+    if (fd && fd->json_name() == key) {
+        return fd;
+    }
+    fd = descriptor->FindFieldByName(key);
+    if (fd) {
+        return fd;
+    }
+    // Custom JSON names
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+        if (descriptor->field(i)->json_name() == key) {
+            return descriptor->field(i);
+        }
+    }
+    return nullptr;
+}
+
+template <typename Time>
+void timeFromJson(const nlohmann::json &json, Message *message) {
+    Time time;
+    if (!json.is_string() || !google::protobuf::util::TimeUtil::FromString(
+                                 json.get<std::string>(), &time)) {
+        throw ProtobufError("Invalid " + message->GetTypeName() + " " +
+                            json.dump());
+    }
+    const auto *descriptor = message->GetDescriptor();
+    const Reflection *reflection = message->GetReflection();
+    reflection->SetInt64(message, requireField(descriptor, "seconds"),
+                         time.seconds());
+    reflection->SetInt32(message, requireField(descriptor, "nanos"),
+                         time.nanos());
+}
+
+/**
+ * Set a message of a well-known type with a special representation,
+ * returning false for other messages
+ */
+bool wellKnownFromJson(const nlohmann::json &json, Message *message) {
+    const auto *descriptor = message->GetDescriptor();
+    if (descriptor->file()->package() != "google.protobuf") {
+        return false;
+    }
+    const std::string &full_name = descriptor->full_name();
+    const Reflection *reflection = message->GetReflection();
+
+    if (full_name == "google.protobuf.Timestamp") {
+        timeFromJson<google::protobuf::Timestamp>(json, message);
+        return true;
+    }
+    if (full_name == "google.protobuf.Duration") {
+        timeFromJson<google::protobuf::Duration>(json, message);
+        return true;
+    }
+    if (full_name == "google.protobuf.FieldMask") {
+        google::protobuf::FieldMask mask;
+        if (!json.is_string() ||
+            !google::protobuf::util::FieldMaskUtil::FromJsonString(
+                json.get<std::string>(), &mask)) {
+            throw ProtobufError("Invalid field mask " + json.dump());
+        }
+        const auto *paths_fd = requireField(descriptor, "paths");
+        for (const auto &path : mask.paths()) {
+            reflection->AddString(message, paths_fd, path);
+        }
+        return true;
+    }
+    if (isWrapper(full_name)) {
+        valueFromJson(json, message, requireField(descriptor, "value"));
+        return true;
+    }
+    if (full_name == "google.protobuf.Struct") {
+        fieldFromJson(json, message, requireField(descriptor, "fields"));
+        return true;
+    }
+    if (full_name == "google.protobuf.ListValue") {
+        fieldFromJson(json, message, requireField(descriptor, "values"));
+        return true;
+    }
+    if (full_name == "google.protobuf.Value") {
+        const char *field;
+        if (json.is_null()) {
+            field = "null_value";
+        } else if (json.is_boolean()) {
+            field = "bool_value";
+        } else if (json.is_number()) {
+            field = "number_value";
+        } else if (json.is_string()) {
+            field = "string_value";
+        } else if (json.is_object()) {
+            field = "struct_value";
+        } else {
+            field = "list_value";
+        }
+        valueFromJson(json, message, requireField(descriptor, field));
+        return true;
+    }
+    if (full_name == "google.protobuf.Any") {
+        // Any needs its type resolved, which the library's parser does
+        auto status =
+            google::protobuf::util::JsonStringToMessage(json.dump(), message);
+        if (!status.ok()) {
+            throw ProtobufError("Failed to parse JSON to message: " +
+                                status.ToString());
+        }
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+nlohmann::json messageToJson(const google::protobuf::Message &message) {
+    if (auto json = wellKnownToJson(message)) {
+        return std::move(*json);
+    }
+    // Set fields only, as the JSON printer omits those with default values
+    std::vector<const FieldDescriptor *> fields;
+    message.GetReflection()->ListFields(message, &fields);
+    auto json = nlohmann::json::object();
+    for (const auto *fd : fields) {
+        if (fd->is_extension()) {
+            json["[" + fd->full_name() + "]"] = fieldToJson(message, fd);
+        } else {
+            json[fd->json_name()] = fieldToJson(message, fd);
+        }
+    }
+    return json;
+}
+
+void jsonToMessage(const nlohmann::json &json,
+                   google::protobuf::Message *message) {
+    if (wellKnownFromJson(json, message)) {
+        return;
+    }
+    const auto *descriptor = message->GetDescriptor();
+    if (!json.is_object()) {
+        throw ProtobufError("Expected JSON object for message " +
+                            descriptor->full_name() + " but got " +
+                            json.dump());
+    }
+    for (const auto &item : json.items()) {
+        const auto *fd = findJsonField(descriptor, item.key());
+        if (!fd) {
+            throw ProtobufError("Unknown field " + item.key() +
+                                " in message " + descriptor->full_name());
+        }
+        fieldFromJson(item.value(), message, fd);
+    }
+}
+
+}  // namespace schemaregistry::serdes::protobuf::utils
@@ -28,6 +28,61 @@ namespace schemaregistry::serdes::protobuf {
 
 using namespace utils;
 
+namespace {
+
+// Decode plans kept per serde, least recently used evicted first
+constexpr size_t kMaxCachedDecodePlans = 1000;
+
+// Pools of referenced files kept process-wide, least recently used evicted
+// first
+constexpr size_t kMaxCachedDependencyPools = 256;
+
+/**
+ * Pool of the well-known and Confluent types schemas may import without
+ * references. It is built once and never modified or destroyed after, so
+ * that all schema pools may use it as their underlay.
+ */
+const google::protobuf::DescriptorPool *builtinPool() {
+    static const google::protobuf::DescriptorPool *pool = [] {
+        auto *builtins = new google::protobuf::DescriptorPool();
+        const google::protobuf::FileDescriptor *files[] = {
+            google::protobuf::Any::descriptor()->file(),
+            // Source_context and type are needed by api
+            google::protobuf::SourceContext::descriptor()->file(),
+            google::protobuf::Type::descriptor()->file(),
+            google::protobuf::Api::descriptor()->file(),
+            google::protobuf::DescriptorProto::descriptor()->file(),
+            google::protobuf::Duration::descriptor()->file(),
+            google::protobuf::Empty::descriptor()->file(),
+            google::protobuf::FieldMask::descriptor()->file(),
+            google::protobuf::Struct::descriptor()->file(),
+            google::protobuf::Timestamp::descriptor()->file(),
+            // All wrapper types are in the same file
+            google::protobuf::DoubleValue::descriptor()->file(),
+            confluent::Meta::descriptor()->file(),
+            confluent::type::Decimal::descriptor()->file(),
+        };
+        for (const auto *file : files) {
+            google::protobuf::FileDescriptorProto file_proto;
+            file->CopyTo(&file_proto);
+            builtins->BuildFile(file_proto);
+        }
+        return builtins;
+    }();
+    return pool;
+}
+
+using DependencyPoolCache = schemaregistry::rest::TtlLruCache<
+    std::vector<std::pair<std::string, std::string>>,
+    std::shared_ptr<const google::protobuf::DescriptorPool>>;
+
+DependencyPoolCache &dependencyPoolCache() {
+    static DependencyPoolCache cache(kMaxCachedDependencyPools);
+    return cache;
+}
+
+}  // namespace
+
 // Default reference subject name strategy implementation
 std::string defaultReferenceSubjectNameStrategy(const std::string &ref_name,
                                                 SerdeType serde_type) {
@@ -35,7 +90,11 @@ std::string defaultReferenceSubjectNameStrategy(const std::string &ref_name,
 }
 
 // ProtobufSerde implementation
-ProtobufSerde::ProtobufSerde() {}
+ProtobufSerde::ProtobufSerde()
+    : message_factory_(
+          std::make_unique<google::protobuf::DynamicMessageFactory>()),
+      decode_plans_(kMaxCachedDecodePlans),
+      wire_compatible_(kMaxCachedDecodePlans) {}
 
 std::pair<const google::protobuf::FileDescriptor *,
           const google::protobuf::DescriptorPool *>
@@ -44,87 +103,148 @@ ProtobufSerde::getParsedSchema(
     std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client) {
     std::lock_guard<std::mutex> lock(cache_mutex_);
 
-    // Create cache key from schema content
-    auto schema_str = schema.getSchema();
-    std::string cache_key = schema_str.value_or("");
+    // Key on the schema's memoized content fingerprint
+    auto cache_key = schema.getFingerprint();
 
     auto it = parsed_schemas_cache_.find(cache_key);
     if (it != parsed_schemas_cache_.end()) {
-        return {it->second.first, it->second.second.get()};
+        return {it->second.file, it->second.pool.get()};
     }
 
-    // Parse new schema
-    auto pool = std::make_unique<google::protobuf::DescriptorPool>();
-    initPool(pool.get());
+    // Resolve dependencies first, into a pool shared with other schemas
+    // with the same referenced files
+    ParsedSchema parsed;
+    DependencyFiles files;
     std::unordered_set<std::string> visited;
+    resolveNamedSchema(schema, client, files, visited);
+    parsed.dependencies = getDependencyPool(files);
 
-    // Resolve dependencies first
-    auto references = schema.getReferences();
-    if (references.has_value()) {
-        for (const auto &ref : references.value()) {
-            resolveNamedSchema(schema, client, pool.get(), visited);
+    // Parse main schema in a pool of its own on top of the dependencies
+    parsed.pool = std::make_unique<google::protobuf::DescriptorPool>(
+        parsed.dependencies ? parsed.dependencies.get() : builtinPool());
+    parsed.file = stringToSchema(parsed.pool.get(), "main.proto",
+                                 schema.getSchema().value_or(""));
+
+    const auto &entry =
+        parsed_schemas_cache_.try_emplace(cache_key, std::move(parsed))
+            .first->second;
+    return {entry.file, entry.pool.get()};
+}
+
+std::shared_ptr<const google::protobuf::DescriptorPool>
+ProtobufSerde::getDependencyPool(const DependencyFiles &files) {
+    if (files.empty()) {
+        return nullptr;
+    }
+    auto &cache = dependencyPoolCache();
+    if (auto cached = cache.get(files); cached.has_value()) {
+        return std::move(*cached);
+    }
+
+    auto pool = std::make_shared<google::protobuf::DescriptorPool>(
+        builtinPool());
+    for (const auto &[name, schema_str] : files) {
+        try {
+            stringToSchema(pool.get(), name, schema_str);
+        } catch (const std::exception &e) {
+            throw ProtobufError("Failed to resolve schema reference: " +
+                                name + " - " + e.what());
         }
     }
 
-    // Parse main schema
-    auto file_desc = stringToSchema(pool.get(), "main.proto", cache_key);
+    // Schema pools hold on to their dependencies, so those in use outlive
+    // their eviction
+    cache.put(files, pool);
+    return pool;
+}
+
+std::shared_ptr<const ProtobufDecodePlan> ProtobufSerde::getDecodePlan(
+    const schemaregistry::rest::model::Schema &writer,
+    const std::vector<int32_t> &msg_index,
+    const schemaregistry::rest::model::Schema &reader,
+    std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client) {
+    auto cache_key = std::make_tuple(writer.getFingerprint(), msg_index,
+                                     reader.getFingerprint());
+    if (auto cached = decode_plans_.get(cache_key); cached.has_value()) {
+        return std::move(*cached);
+    }
+
+    auto [writer_file, writer_pool] = getParsedSchema(writer, client);
+    if (!writer_file) {
+        throw ProtobufError("Failed to parse writer schema");
+    }
+    auto plan = std::make_shared<ProtobufDecodePlan>();
+    plan->writer_descriptor =
+        getMessageDescriptorByIndex(writer_pool, writer_file, msg_index);
+    if (!plan->writer_descriptor) {
+        throw ProtobufError("Failed to get writer message descriptor");
+    }
+
+    // Read into the reader type of the same name as the writer type, or
+    // else into the first type of the reader schema
+    auto [reader_file, reader_pool] = getParsedSchema(reader, client);
+    plan->reader_descriptor = reader_pool->FindMessageTypeByName(
+        plan->writer_descriptor->full_name());
+    if (!plan->reader_descriptor) {
+        plan->reader_descriptor =
+            getMessageDescriptorByIndex(reader_pool, reader_file, {0});
+    }
+    if (!plan->reader_descriptor) {
+        throw ProtobufError("Failed to get reader message descriptor");
+    }
 
-    // Store in cache with raw FileDescriptor pointer (owned by pool)
-    parsed_schemas_cache_[cache_key] =
-        std::make_pair(file_desc, std::move(pool));
+    plan->writer_prototype = getPrototype(plan->writer_descriptor);
+    plan->reader_prototype = getPrototype(plan->reader_descriptor);
+    const auto *reader_descriptor = plan->reader_descriptor;
+    plan->field_transformer = std::make_shared<FieldTransformer>(
+        [reader_descriptor](RuleContext &ctx, const std::string &rule_type,
+                            const SerdeValue &value) {
+            return transformFields(ctx, reader_descriptor, value);
+        });
 
-    return {file_desc, parsed_schemas_cache_[cache_key].second.get()};
+    decode_plans_.put(cache_key, plan);
+    return plan;
 }
 
-void ProtobufSerde::addFileToPool(
-    google::protobuf::DescriptorPool *pool,
-    const google::protobuf::FileDescriptor *file_descriptor) {
-    google::protobuf::FileDescriptorProto file_descriptor_proto;
-    file_descriptor->CopyTo(&file_descriptor_proto);
-    pool->BuildFile(file_descriptor_proto);
+const google::protobuf::Message *ProtobufSerde::getPrototype(
+    const google::protobuf::Descriptor *descriptor) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    const auto *prototype = message_factory_->GetPrototype(descriptor);
+    if (!prototype) {
+        throw ProtobufError("Failed to get message prototype for descriptor: " +
+                            descriptor->full_name());
+    }
+    return prototype;
 }
 
-void ProtobufSerde::initPool(google::protobuf::DescriptorPool *pool) {
-    // Add Google's well-known types to the descriptor pool using BuildFile
-    addFileToPool(pool, google::protobuf::Any::descriptor()->file());
-    // Source_context needed by api
-    addFileToPool(pool, google::protobuf::SourceContext::descriptor()->file());
-    // Type needed by api
-    addFileToPool(pool, google::protobuf::Type::descriptor()->file());
-    addFileToPool(pool, google::protobuf::Api::descriptor()->file());
-    addFileToPool(pool,
-                  google::protobuf::DescriptorProto::descriptor()->file());
-    addFileToPool(pool, google::protobuf::Duration::descriptor()->file());
-    addFileToPool(pool, google::protobuf::Empty::descriptor()->file());
-    addFileToPool(pool, google::protobuf::FieldMask::descriptor()->file());
-    addFileToPool(pool, google::protobuf::Struct::descriptor()->file());
-    addFileToPool(pool, google::protobuf::Timestamp::descriptor()->file());
-
-    // Add wrapper types
-    addFileToPool(pool, google::protobuf::DoubleValue::descriptor()->file());
-    addFileToPool(pool, google::protobuf::FloatValue::descriptor()->file());
-    addFileToPool(pool, google::protobuf::Int64Value::descriptor()->file());
-    addFileToPool(pool, google::protobuf::UInt64Value::descriptor()->file());
-    addFileToPool(pool, google::protobuf::Int32Value::descriptor()->file());
-    addFileToPool(pool, google::protobuf::UInt32Value::descriptor()->file());
-    addFileToPool(pool, google::protobuf::BoolValue::descriptor()->file());
-    addFileToPool(pool, google::protobuf::StringValue::descriptor()->file());
-    addFileToPool(pool, google::protobuf::BytesValue::descriptor()->file());
-
-    addFileToPool(pool, confluent::Meta::descriptor()->file());
-    addFileToPool(pool, confluent::type::Decimal::descriptor()->file());
+bool ProtobufSerde::isWireCompatible(
+    const google::protobuf::Descriptor *descriptor,
+    const google::protobuf::Descriptor *generated) {
+    auto key = std::make_pair(descriptor, generated);
+    if (auto cached = wire_compatible_.get(key); cached.has_value()) {
+        return *cached;
+    }
+
+    bool compatible = utils::isWireCompatible(descriptor, generated);
+    // At most one entry per decode plan and generated type
+    wire_compatible_.put(key, compatible);
+    return compatible;
 }
 
 void ProtobufSerde::clear() {
     std::lock_guard<std::mutex> lock(cache_mutex_);
+    decode_plans_.clear();
+    wire_compatible_.clear();
+    // Drop the prototypes before the descriptors they were built from
+    message_factory_ =
+        std::make_unique<google::protobuf::DynamicMessageFactory>();
     parsed_schemas_cache_.clear();
 }
 
 void ProtobufSerde::resolveNamedSchema(
     const schemaregistry::rest::model::Schema &schema,
     std::shared_ptr<schemaregistry::rest::ISchemaRegistryClient> client,
-    google::protobuf::DescriptorPool *pool,
-    std::unordered_set<std::string> &visited) {
+    DependencyFiles &files, std::unordered_set<std::string> &visited) {
     // Implement dependency resolution
     // This recursively resolves schema references
     auto references = schema.getReferences();
@@ -143,9 +263,8 @@ void ProtobufSerde::resolveNamedSchema(
                 auto ref_schema =
                     client->getVersion(subject, version, true, "serialized");
                 auto schema_obj = ref_schema.toSchema();
-                resolveNamedSchema(schema_obj, client, pool, visited);
-                auto schema_content = ref_schema.getSchema().value_or("");
-                stringToSchema(pool, name, schema_content);
+                resolveNamedSchema(schema_obj, client, files, visited);
+                files.emplace_back(name, ref_schema.getSchema().value_or(""));
             } catch (const std::exception &e) {
                 throw ProtobufError("Failed to resolve schema reference: " +
                                     name + " - " + e.what());
@@ -3,9 +3,12 @@
 #include <google/protobuf/dynamic_message.h>
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
-#include <google/protobuf/util/json_util.h>
 
+#include <algorithm>
 #include <memory>  // For std::dynamic_pointer_cast
+#include <set>
+#include <unordered_set>
+#include <utility>
 
 #include "absl/strings/escaping.h"
 #include "confluent/meta.pb.h"
@@ -38,6 +41,191 @@ std::vector<uint8_t> base64_decode(const std::string& encoded_string) {
     }
     return std::vector<uint8_t>(decoded.begin(), decoded.end());
 }
+
+/**
+ * Message type walked for a field, the value type of a map field
+ * @return The message type, or nullptr for fields holding scalars
+ */
+const google::protobuf::Descriptor* walkedMessageType(
+    const google::protobuf::FieldDescriptor* fd) {
+    if (fd->is_map()) {
+        fd = fd->message_type()->map_value();
+    }
+    if (fd->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+        return nullptr;
+    }
+    return fd->message_type();
+}
+
+bool visitsAny(const FieldVisitPlan::Records& records,
+               const std::string& message_name) {
+    auto it = records.find(message_name);
+    return it != records.end() &&
+           std::find(it->second.begin(), it->second.end(), true) !=
+               it->second.end();
+}
+
+/**
+ * Mark in records the fields of descriptor, and of the messages reachable
+ * from it, that hold a field the rule applies to. Messages may be recursive,
+ * so this is repeated until no field changes.
+ */
+using DescriptorSet = std::unordered_set<const google::protobuf::Descriptor*>;
+
+void collectVisits(const RuleContext& ctx, const FieldTagIndex& index,
+                   const google::protobuf::Descriptor* descriptor,
+                   FieldVisitPlan::Records& records, DescriptorSet& seen,
+                   bool& changed) {
+    if (!seen.insert(descriptor).second) {
+        return;
+    }
+    std::string message_name(descriptor->full_name());
+    records.try_emplace(message_name,
+                        std::vector<bool>(descriptor->field_count(), false));
+
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+        const google::protobuf::FieldDescriptor* fd = descriptor->field(i);
+        bool visit;
+        const auto* nested = walkedMessageType(fd);
+        if (nested != nullptr) {
+            collectVisits(ctx, index, nested, records, seen, changed);
+            visit = visitsAny(records, std::string(nested->full_name()));
+        } else {
+            auto tags = getInlineTags(fd);
+            auto metadata_tags =
+                index.getMetadataTags(std::string(fd->full_name()));
+            tags.insert(metadata_tags->begin(), metadata_tags->end());
+            visit = ctx.appliesTo(tags);
+        }
+
+        auto& visits = records[message_name];
+        if (visit && !visits[i]) {
+            visits[i] = true;
+            changed = true;
+        }
+    }
+}
+
+FieldVisitPlan buildVisitPlan(const RuleContext& ctx,
+                              const google::protobuf::Descriptor* descriptor) {
+    FieldVisitPlan::Records records;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        DescriptorSet seen;
+        collectVisits(ctx, *ctx.getTagIndex(), descriptor, records, seen,
+                      changed);
+    }
+    return FieldVisitPlan(std::move(records));
+}
+
+void transformMessageInPlace(RuleContext& ctx, const FieldVisitPlan* plan,
+                             const google::protobuf::Descriptor* descriptor,
+                             google::protobuf::Message* message);
+
+/**
+ * Transform a scalar, or repeated scalar, field of message
+ */
+void transformValueInPlace(RuleContext& ctx,
+                           const google::protobuf::FieldDescriptor* fd,
+                           const std::string& field_name,
+                           google::protobuf::Message* message) {
+    ProtobufVariant value = getMessageFieldValue(message, fd);
+    ProtobufVariant new_value =
+        transformRecursive(ctx, fd->containing_type(), value);
+
+    // Check for condition rules
+    auto rule_kind = ctx.getRule().getKind();
+    if (rule_kind.has_value() && rule_kind.value() == Kind::Condition) {
+        if (new_value.type == ProtobufVariant::ValueType::Bool) {
+            bool condition_result = new_value.get<bool>();
+            if (!condition_result) {
+                throw ProtobufError("Rule condition failed for field: " +
+                                    field_name);
+            }
+        }
+    }
+
+    setMessageField(message, fd, new_value);
+}
+
+void transformFieldInPlace(RuleContext& ctx, const FieldVisitPlan* plan,
+                           const google::protobuf::FieldDescriptor* fd,
+                           const SerdeValue& containing_message,
+                           google::protobuf::Message* message) {
+    const google::protobuf::Reflection* reflection = message->GetReflection();
+    if (fd->containing_oneof() && !reflection->HasField(*message, fd)) {
+        // Skip oneof fields that are not set
+        return;
+    }
+
+    std::string field_name(fd->name());
+    ctx.enterField(containing_message, std::string(fd->full_name()),
+                   field_name, getFieldType(fd), getInlineTags(fd));
+
+    try {
+        if (fd->is_map()) {
+            // Map values are transformed in the context of the map field
+            const auto* value_fd = fd->message_type()->map_value();
+            for (int j = 0; j < reflection->FieldSize(*message, fd); ++j) {
+                auto* entry =
+                    reflection->MutableRepeatedMessage(message, fd, j);
+                if (value_fd->cpp_type() !=
+                    google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+                    transformValueInPlace(ctx, value_fd, field_name, entry);
+                } else if (entry->GetReflection()->HasField(*entry,
+                                                            value_fd)) {
+                    transformMessageInPlace(
+                        ctx, plan, value_fd->message_type(),
+                        entry->GetReflection()->MutableMessage(entry,
+                                                               value_fd));
+                }
+            }
+        } else if (fd->cpp_type() ==
+                   google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+            if (fd->is_repeated()) {
+                for (int j = 0; j < reflection->FieldSize(*message, fd); ++j) {
+                    transformMessageInPlace(
+                        ctx, plan, fd->message_type(),
+                        reflection->MutableRepeatedMessage(message, fd, j));
+                }
+            } else if (reflection->HasField(*message, fd)) {
+                transformMessageInPlace(
+                    ctx, plan, fd->message_type(),
+                    reflection->MutableMessage(message, fd));
+            }
+        } else {
+            transformValueInPlace(ctx, fd, field_name, message);
+        }
+        ctx.exitField();
+    } catch (const std::exception& e) {
+        ctx.exitField();
+        throw;
+    }
+}
+
+void transformMessageInPlace(RuleContext& ctx, const FieldVisitPlan* plan,
+                             const google::protobuf::Descriptor* descriptor,
+                             google::protobuf::Message* message) {
+    std::string message_name(descriptor->full_name());
+    // Field rules see the message as it was before any of its fields were
+    // transformed, so it is copied once, when the first field is visited
+    std::unique_ptr<SerdeValue> original;
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+        if (plan != nullptr && !plan->visits(message_name, i)) {
+            continue;
+        }
+        if (!original) {
+            auto copy =
+                std::unique_ptr<google::protobuf::Message>(message->New());
+            copy->CopyFrom(*message);
+            original =
+                protobuf::makeProtobufValue(ProtobufVariant(std::move(copy)));
+        }
+        transformFieldInPlace(ctx, plan, descriptor->field(i), *original,
+                              message);
+    }
+}
 }  // namespace
 
 std::unique_ptr<SerdeValue> transformFields(
@@ -61,28 +249,18 @@ std::unique_ptr<SerdeValue> transformFields(
                                     message_ptr->GetTypeName());
             }
 
-            // Transform the message using the synchronous method
+            // Transform a copy in place, walking only the fields the
+            // rule's visit plan marks as possibly tagged
             auto message_ptr_copy =
                 std::unique_ptr<google::protobuf::Message>(message_ptr->New());
             message_ptr_copy->CopyFrom(*message_ptr);
-            ProtobufVariant message_variant(std::move(message_ptr_copy));
-            auto transformed_message =
-                transformRecursive(ctx, descriptor, message_variant);
-
-            // Extract the transformed message and create SerdeValue
-            if (transformed_message.type ==
-                    ProtobufVariant::ValueType::Message &&
-                transformed_message
-                    .is<std::unique_ptr<google::protobuf::Message>>()) {
-                return protobuf::makeProtobufValue(transformed_message);
-            }
-
-            // Fallback: return original message
-            auto fallback_msg =
-                std::unique_ptr<google::protobuf::Message>(message_ptr->New());
-            fallback_msg->CopyFrom(*message_ptr);
+            auto plan = ctx.getVisitPlan(
+                std::string(descriptor->full_name()),
+                [&]() { return buildVisitPlan(ctx, descriptor); });
+            transformMessageInPlace(ctx, plan.get(), descriptor,
+                                    message_ptr_copy.get());
             return protobuf::makeProtobufValue(
-                ProtobufVariant(std::move(fallback_msg)));
+                ProtobufVariant(std::move(message_ptr_copy)));
         }
     }
     return value.clone();
@@ -125,18 +303,8 @@ ProtobufVariant transformRecursive(
             auto result =
                 std::unique_ptr<google::protobuf::Message>(msg_ptr->New());
             result->CopyFrom(*msg_ptr);
-
-            for (int i = 0; i < descriptor->field_count(); ++i) {
-                const google::protobuf::FieldDescriptor* fd =
-                    descriptor->field(i);
-                auto field = transformFieldWithContext(ctx, fd, descriptor,
-                                                       result.get());
-                if (field.has_value()) {
-                    // Set the field in the message based on the transformed
-                    // value
-                    setMessageField(result.get(), fd, field.value());
-                }
-            }
+            transformMessageInPlace(ctx, nullptr, result->GetDescriptor(),
+                                    result.get());
             return ProtobufVariant(std::move(result));
         }
         default: {
@@ -144,29 +312,8 @@ ProtobufVariant transformRecursive(
             // String, Bytes, EnumNumber) Field-level transformation logic
             auto field_ctx = ctx.currentField();
             if (field_ctx.has_value()) {
-                auto rule_tags = ctx.getRule().getTags();
-                std::unordered_set<std::string> rule_tags_set;
-                if (rule_tags.has_value()) {
-                    rule_tags_set = std::unordered_set<std::string>(
-                        rule_tags->begin(), rule_tags->end());
-                }
-
-                // Check if rule tags overlap with field context tags (empty
-                // rule_tags means apply to all)
-                bool should_apply =
-                    !rule_tags.has_value() || rule_tags_set.empty();
-                if (!should_apply) {
-                    const auto& field_tags = field_ctx->getTags();
-                    for (const auto& field_tag : field_tags) {
-                        if (rule_tags_set.find(field_tag) !=
-                            rule_tags_set.end()) {
-                            should_apply = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (should_apply) {
+                // Empty rule tags mean apply to all fields
+                if (ctx.appliesTo(field_ctx->getTags())) {
                     // Create a SerdeValue from the current ProtobufVariant
                     auto message_value = makeProtobufValue(message);
 
@@ -214,22 +361,34 @@ std::optional<ProtobufVariant> transformFieldWithContext(
     RuleContext& ctx, const google::protobuf::FieldDescriptor* fd,
     const google::protobuf::Descriptor* desc,
     const google::protobuf::Message* message) {
-    auto temp_message =
-        std::unique_ptr<google::protobuf::Message>(message->New());
-    temp_message->CopyFrom(*message);
-    auto temp_serde_value =
-        protobuf::makeProtobufValue(ProtobufVariant(std::move(temp_message)));
+    if (fd->containing_oneof() &&
+        !message->GetReflection()->HasField(*message, fd)) {
+        // Skip oneof fields that are not set
+        return std::nullopt;
+    }
 
-    ctx.enterField(*temp_serde_value, fd->full_name(), fd->name(),
-                   getFieldType(fd), getInlineTags(fd));
+    auto copy = std::unique_ptr<google::protobuf::Message>(message->New());
+    copy->CopyFrom(*message);
+    auto containing_message =
+        protobuf::makeProtobufValue(ProtobufVariant(std::move(copy)));
+    return transformFieldWithContext(ctx, fd, desc, message,
+                                     *containing_message);
+}
 
+std::optional<ProtobufVariant> transformFieldWithContext(
+    RuleContext& ctx, const google::protobuf::FieldDescriptor* fd,
+    const google::protobuf::Descriptor* desc,
+    const google::protobuf::Message* message,
+    const SerdeValue& containing_message) {
     if (fd->containing_oneof() &&
         !message->GetReflection()->HasField(*message, fd)) {
         // Skip oneof fields that are not set
-        ctx.exitField();
         return std::nullopt;
     }
 
+    ctx.enterField(containing_message, fd->full_name(), fd->name(),
+                   getFieldType(fd), getInlineTags(fd));
+
     try {
         ProtobufVariant value = getMessageFieldValue(message, fd);
         ProtobufVariant new_value = transformRecursive(ctx, desc, value);
@@ -721,6 +880,91 @@ std::unordered_set<std::string> getInlineTags(
     return tag_set;
 }
 
+namespace {
+
+using DescriptorPairs =
+    std::set<std::pair<const google::protobuf::Descriptor*,
+                       const google::protobuf::Descriptor*>>;
+
+bool isEnumWireCompatible(const google::protobuf::EnumDescriptor* descriptor,
+                          const google::protobuf::EnumDescriptor* other) {
+    if (descriptor->full_name() != other->full_name() ||
+        descriptor->value_count() != other->value_count()) {
+        return false;
+    }
+    for (int i = 0; i < descriptor->value_count(); ++i) {
+        const auto* value = descriptor->value(i);
+        const auto* other_value = other->FindValueByNumber(value->number());
+        if (!other_value || other_value->name() != value->name()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isFieldWireCompatible(const google::protobuf::FieldDescriptor* fd,
+                           const google::protobuf::FieldDescriptor* other) {
+    if (fd->name() != other->name() || fd->type() != other->type() ||
+        fd->is_repeated() != other->is_repeated() ||
+        fd->has_presence() != other->has_presence()) {
+        return false;
+    }
+    const auto* oneof = fd->containing_oneof();
+    const auto* other_oneof = other->containing_oneof();
+    if ((oneof == nullptr) != (other_oneof == nullptr) ||
+        (oneof && oneof->name() != other_oneof->name())) {
+        return false;
+    }
+    // Field rules select fields by their inline tags
+    return getInlineTags(fd) == getInlineTags(other);
+}
+
+bool isWireCompatible(const google::protobuf::Descriptor* descriptor,
+                      const google::protobuf::Descriptor* other,
+                      DescriptorPairs& seen) {
+    // Pairs compared already, or being compared higher up in a recursive
+    // type, need not be compared again
+    if (!seen.emplace(descriptor, other).second) {
+        return true;
+    }
+    if (descriptor->full_name() != other->full_name() ||
+        descriptor->field_count() != other->field_count()) {
+        return false;
+    }
+    // Fields are matched by declaration index as well as number, as field
+    // visit plans address fields by index
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+        const auto* fd = descriptor->field(i);
+        const auto* other_fd = other->field(i);
+        if (fd->number() != other_fd->number() ||
+            !isFieldWireCompatible(fd, other_fd)) {
+            return false;
+        }
+        if (fd->cpp_type() ==
+                google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE &&
+            !isWireCompatible(fd->message_type(), other_fd->message_type(),
+                              seen)) {
+            return false;
+        }
+        if (fd->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_ENUM &&
+            !isEnumWireCompatible(fd->enum_type(), other_fd->enum_type())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool isWireCompatible(const google::protobuf::Descriptor* descriptor,
+                      const google::protobuf::Descriptor* other) {
+    if (descriptor == other) {
+        return true;
+    }
+    DescriptorPairs seen;
+    return isWireCompatible(descriptor, other, seen);
+}
+
 std::string schemaToString(const google::protobuf::FileDescriptor* file_desc) {
     std::string serialized;
     google::protobuf::FileDescriptorProto proto;
@@ -773,29 +1017,6 @@ bool isBuiltin(const std::string& name) {
            name.find("google/type/") == 0;
 }
 
-nlohmann::json messageToJson(const google::protobuf::Message& message) {
-    std::string json_string;
-    auto status =
-        google::protobuf::util::MessageToJsonString(message, &json_string);
-    if (!status.ok()) {
-        throw ProtobufError("Failed to convert message to JSON: " +
-                            status.ToString());
-    }
-    return nlohmann::json::parse(json_string);
-}
-
-void jsonToMessage(const nlohmann::json& json_value,
-                   google::protobuf::Message* message) {
-    std::string json_string = json_value.dump();
-    google::protobuf::util::JsonParseOptions options;
-    auto status = google::protobuf::util::JsonStringToMessage(json_string,
-                                                              message, options);
-    if (!status.ok()) {
-        throw ProtobufError("Failed to parse JSON to message: " +
-                            status.ToString());
-    }
-}
-
 FieldType getFieldType(const google::protobuf::FieldDescriptor* field_desc) {
     // Check for map fields first (like the Rust version did)
     if (field_desc->is_map()) {
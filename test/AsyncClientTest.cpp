@@ -0,0 +1,293 @@
+/**
+ * AsyncClientTest
+ * Tests for the event loop, async requests and the async Schema Registry
+ * clients
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "schemaregistry/rest/AsyncSchemaRegistryClient.h"
+#include "schemaregistry/rest/ClientConfiguration.h"
+#include "schemaregistry/rest/EventLoop.h"
+#include "schemaregistry/rest/MockAsyncSchemaRegistryClient.h"
+#include "schemaregistry/rest/RestClient.h"
+#include "schemaregistry/rest/RestException.h"
+
+using namespace schemaregistry::rest;
+
+namespace {
+
+cpr::Response makeResponse(long status_code, const std::string &text = "") {
+    cpr::Response response;
+    response.status_code = status_code;
+    response.text = text;
+    return response;
+}
+
+/**
+ * RestClient whose transport is a handler instead of HTTP, counting the
+ * requests sent to each base URL
+ */
+class StubRestClient : public RestClient {
+  public:
+    using Handler = std::function<cpr::Response(const std::string &base_url,
+                                                const std::string &path)>;
+
+    StubRestClient(std::shared_ptr<const ClientConfiguration> config,
+                   Handler handler)
+        : RestClient(std::move(config)), handler_(std::move(handler)) {}
+
+    int calls(const std::string &base_url) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = calls_.find(base_url);
+        return it == calls_.end() ? 0 : it->second;
+    }
+
+  protected:
+    cpr::Response sendRequest(
+        const std::string &base_url, const std::string &path,
+        const std::string &method,
+        const std::vector<std::pair<std::string, std::string>> &query,
+        const std::map<std::string, std::string> &headers,
+        const std::string &body) const override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            calls_[base_url]++;
+        }
+        return handler_(base_url, path);
+    }
+
+  private:
+    Handler handler_;
+    mutable std::mutex mutex_;
+    mutable std::map<std::string, int> calls_;
+};
+
+std::shared_ptr<const ClientConfiguration> stubConfig(
+    const std::vector<std::string> &urls, std::uint32_t max_retries) {
+    auto config = std::make_shared<ClientConfiguration>(urls);
+    config->setMaxRetries(max_retries);
+    config->setRetriesWaitMs(1);
+    config->setRetriesMaxWaitMs(5);
+    return config;
+}
+
+cpr::Response sendAsync(const RestClient &client) {
+    std::promise<cpr::Response> promise;
+    client.sendRequestUrlsAsync(
+        "/subjects", "GET", {}, {}, "",
+        [&](const cpr::Response &response) { promise.set_value(response); });
+    auto future = promise.get_future();
+    if (future.wait_for(std::chrono::seconds(5)) !=
+        std::future_status::ready) {
+        throw std::runtime_error("request did not complete");
+    }
+    return future.get();
+}
+
+}  // namespace
+
+TEST(EventLoopTest, RunsPostedTasks) {
+    EventLoop loop(2);
+    std::atomic<int> count{0};
+    std::promise<void> done;
+
+    for (int i = 0; i < 10; ++i) {
+        loop.post([&]() {
+            if (++count == 10) {
+                done.set_value();
+            }
+        });
+    }
+
+    auto future = done.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+              std::future_status::ready);
+    EXPECT_EQ(count.load(), 10);
+}
+
+TEST(EventLoopTest, TimersDoNotBlockWorkers) {
+    EventLoop loop(1);
+    std::promise<std::chrono::steady_clock::time_point> delayed;
+    std::promise<std::chrono::steady_clock::time_point> immediate;
+
+    loop.schedule(std::chrono::milliseconds(200), [&]() {
+        delayed.set_value(std::chrono::steady_clock::now());
+    });
+    loop.post(
+        [&]() { immediate.set_value(std::chrono::steady_clock::now()); });
+
+    auto immediate_at = immediate.get_future().get();
+    auto delayed_at = delayed.get_future().get();
+    EXPECT_LT(immediate_at, delayed_at);
+}
+
+TEST(EventLoopTest, FiresTimersInOrder) {
+    EventLoop loop(1);
+    std::vector<int> order;
+    std::promise<void> done;
+
+    loop.schedule(std::chrono::milliseconds(100), [&]() {
+        order.push_back(2);
+        done.set_value();
+    });
+    loop.schedule(std::chrono::milliseconds(10),
+                  [&]() { order.push_back(1); });
+
+    done.get_future().wait();
+    EXPECT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+TEST(EventLoopTest, StopDropsPendingTimers) {
+    std::atomic<bool> ran{false};
+    {
+        EventLoop loop(1);
+        loop.schedule(std::chrono::seconds(60), [&]() { ran = true; });
+    }
+    EXPECT_FALSE(ran.load());
+}
+
+TEST(MockAsyncSchemaRegistryClientTest, RegisterAndLookup) {
+    std::vector<std::string> urls = {"mock://"};
+    auto config = std::make_shared<const ClientConfiguration>(urls);
+    MockAsyncSchemaRegistryClient client(config);
+
+    schemaregistry::rest::model::Schema schema;
+    schema.setSchemaType("AVRO");
+    schema.setSchema(R"({"type": "string"})");
+
+    auto registered = client.registerSchema("test-value", schema).get();
+    ASSERT_TRUE(registered.getId().has_value());
+
+    auto found =
+        client.getBySubjectAndId("test-value", registered.getId().value())
+            .get();
+    EXPECT_EQ(found.getSchema(), schema.getSchema());
+
+    auto latest = client.getLatestVersion("test-value").get();
+    EXPECT_EQ(latest.getVersion(), registered.getVersion());
+
+    EXPECT_THROW(client.getVersion("missing-value", 1).get(), RestException);
+}
+
+TEST(RestClientAsyncTest, RetriesRetriableErrors) {
+    std::atomic<int> attempts{0};
+    StubRestClient client(stubConfig({"http://a"}, 2),
+                          [&](const std::string &, const std::string &) {
+                              return makeResponse(++attempts < 3 ? 503 : 200);
+                          });
+
+    EXPECT_EQ(sendAsync(client).status_code, 200);
+    EXPECT_EQ(client.calls("http://a"), 3);
+}
+
+TEST(RestClientAsyncTest, ReturnsLastErrorOnceRetriesAreExhausted) {
+    StubRestClient client(
+        stubConfig({"http://a"}, 2),
+        [](const std::string &, const std::string &) {
+            return makeResponse(429);
+        });
+
+    EXPECT_EQ(sendAsync(client).status_code, 429);
+    EXPECT_EQ(client.calls("http://a"), 3);
+}
+
+TEST(RestClientAsyncTest, DoesNotRetryClientErrors) {
+    StubRestClient client(
+        stubConfig({"http://a", "http://b"}, 2),
+        [](const std::string &, const std::string &) {
+            return makeResponse(404);
+        });
+
+    EXPECT_EQ(sendAsync(client).status_code, 404);
+    EXPECT_EQ(client.calls("http://a"), 1);
+    EXPECT_EQ(client.calls("http://b"), 0);
+}
+
+TEST(RestClientAsyncTest, FailsOverToNextUrl) {
+    StubRestClient client(
+        stubConfig({"http://a", "http://b"}, 1),
+        [](const std::string &base_url, const std::string &) {
+            // Network error on the first URL
+            return makeResponse(base_url == "http://a" ? 0 : 200);
+        });
+
+    EXPECT_EQ(sendAsync(client).status_code, 200);
+    EXPECT_EQ(client.calls("http://a"), 2);
+    EXPECT_EQ(client.calls("http://b"), 1);
+}
+
+TEST(RestClientAsyncTest, FailsOverWhenTransportThrows) {
+    StubRestClient client(
+        stubConfig({"http://a", "http://b"}, 1),
+        [](const std::string &base_url,
+           const std::string &) -> cpr::Response {
+            if (base_url == "http://a") {
+                throw std::runtime_error("connection refused");
+            }
+            return makeResponse(200);
+        });
+
+    EXPECT_EQ(sendAsync(client).status_code, 200);
+    EXPECT_EQ(client.calls("http://a"), 1);
+    EXPECT_EQ(client.calls("http://b"), 1);
+}
+
+TEST(AsyncSchemaRegistryClientTest, CoalescesAndCachesLookups) {
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto rest_client = std::make_shared<StubRestClient>(
+        stubConfig({"http://a"}, 0),
+        [released](const std::string &, const std::string &path) {
+            released.wait();
+            if (path != "/schemas/ids/1") {
+                return makeResponse(404, "{}");
+            }
+            return makeResponse(
+                200, R"({"schemaType": "AVRO", "schema": "\"string\""})");
+        });
+    AsyncSchemaRegistryClient client(rest_client);
+
+    // Both lookups are in flight until the response is released
+    auto first = client.getBySubjectAndId("test-value", 1);
+    auto second = client.getBySubjectAndId("test-value", 1);
+    release.set_value();
+
+    EXPECT_EQ(first.get().getSchema(), "\"string\"");
+    EXPECT_EQ(second.get().getSchema(), "\"string\"");
+    EXPECT_EQ(rest_client->calls("http://a"), 1);
+
+    // Served from the cache
+    auto cached = client.getBySubjectAndId("test-value", 1);
+    EXPECT_EQ(cached.get().getSchemaType(), "AVRO");
+    EXPECT_EQ(rest_client->calls("http://a"), 1);
+}
+
+TEST(AsyncSchemaRegistryClientTest, FailsWithStatusOfErrorResponse) {
+    auto rest_client = std::make_shared<StubRestClient>(
+        stubConfig({"http://a"}, 0),
+        [](const std::string &, const std::string &) {
+            return makeResponse(
+                404, R"({"error_code": 40401, "message": "not found"})");
+        });
+    AsyncSchemaRegistryClient client(rest_client);
+
+    auto future = client.getVersion("missing-value", 1);
+    try {
+        future.get();
+        FAIL() << "Expected a RestException";
+    } catch (const RestException &e) {
+        EXPECT_EQ(e.getStatus(), 404);
+    }
+}
@@ -4,9 +4,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <vector>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <avro/Compiler.hh>
 #include <avro/ValidSchema.hh>
@@ -15,6 +20,7 @@
 // Project includes
 #include "schemaregistry/rest/MockSchemaRegistryClient.h"
 #include "schemaregistry/rest/ClientConfiguration.h"
+#include "schemaregistry/serdes/avro/AvroCodec.h"
 #include "schemaregistry/serdes/avro/AvroSerializer.h"
 #include "schemaregistry/serdes/avro/AvroDeserializer.h"
 #include "schemaregistry/serdes/avro/AvroUtils.h"
@@ -268,6 +274,507 @@ TEST(AvroTest, GuidInHeader) {
     EXPECT_EQ(bytes_field[2], 3);
 }
 
+TEST(AvroTest, SerializerFollowsLatestVersion) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = SchemaRegistryClient::newClient(client_config);
+
+    auto makeSchema = [](const std::string &doc) {
+        schemaregistry::rest::model::Schema schema;
+        schema.setSchemaType(std::make_optional<std::string>("AVRO"));
+        schema.setSchema(std::make_optional<std::string>(
+            R"({"type": "record", "name": "test", "doc": ")" + doc +
+            R"(", "fields": [{"name": "intField", "type": "int"}]})"));
+        return schema;
+    };
+    auto v1 = client->registerSchema("test-value", makeSchema("v1"), false);
+
+    auto ser_config = SerializerConfig::createDefault();
+    ser_config.auto_register_schemas = false;
+    ser_config.use_schema = SchemaSelector::useLatestVersion();
+    auto rule_registry = std::make_shared<RuleRegistry>();
+    AvroSerializer serializer(client, std::nullopt, rule_registry, ser_config);
+
+    ::avro::ValidSchema avro_schema =
+        AvroSerializer::compileJsonSchema(makeSchema("v1").getSchema().value());
+    ::avro::GenericDatum datum(avro_schema);
+    datum.value<::avro::GenericRecord>().setFieldAt(
+        0, ::avro::GenericDatum(static_cast<int32_t>(7)));
+
+    SerializationContext ser_ctx;
+    ser_ctx.topic = "test";
+    ser_ctx.serde_type = SerdeType::Value;
+    ser_ctx.serde_format = SerdeFormat::Avro;
+
+    auto schemaIdOf = [](const std::vector<uint8_t> &bytes) {
+        SchemaId schema_id(SerdeFormat::Avro);
+        schema_id.readFromBytes(bytes);
+        return schema_id.getId();
+    };
+
+    // Repeated messages reuse the plan built for the latest version
+    auto first = serializer.serialize(ser_ctx, datum);
+    EXPECT_EQ(serializer.serialize(ser_ctx, datum), first);
+    EXPECT_EQ(schemaIdOf(first), v1.getId());
+
+    // A new latest version replaces the plan
+    auto v2 = client->registerSchema("test-value", makeSchema("v2"), false);
+    ASSERT_NE(v2.getId(), v1.getId());
+    EXPECT_EQ(schemaIdOf(serializer.serialize(ser_ctx, datum)), v2.getId());
+
+    // Other topics get plans of their own
+    auto other = client->registerSchema("other-value", makeSchema("v1"), false);
+    ser_ctx.topic = "other";
+    EXPECT_EQ(schemaIdOf(serializer.serialize(ser_ctx, datum)), other.getId());
+    ser_ctx.topic = "test";
+    EXPECT_EQ(schemaIdOf(serializer.serialize(ser_ctx, datum)), v2.getId());
+}
+
+TEST(AvroTest, DeserializerResolvesLatestVersion) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = SchemaRegistryClient::newClient(client_config);
+
+    const std::string v1_str = R"({
+        "type": "record",
+        "name": "test",
+        "fields": [
+            {"name": "intField", "type": "int"},
+            {"name": "stringField", "type": "string"}
+        ]
+    })";
+    const std::string v2_str = R"({
+        "type": "record",
+        "name": "test",
+        "fields": [
+            {"name": "stringField", "type": "string"},
+            {"name": "intField", "type": "long"},
+            {"name": "extraField", "type": "string", "default": "none"}
+        ]
+    })";
+
+    auto rule_registry = std::make_shared<RuleRegistry>();
+    AvroSerializer serializer(client, std::nullopt, rule_registry,
+                              SerializerConfig::createDefault());
+    auto deser_config = DeserializerConfig::createDefault();
+    deser_config.use_schema = SchemaSelector::useLatestVersion();
+    AvroDeserializer deserializer(client, rule_registry, deser_config);
+
+    SerializationContext ser_ctx;
+    ser_ctx.topic = "test";
+    ser_ctx.serde_type = SerdeType::Value;
+    ser_ctx.serde_format = SerdeFormat::Avro;
+
+    ::avro::ValidSchema avro_schema = AvroSerializer::compileJsonSchema(v1_str);
+    ::avro::GenericDatum datum(avro_schema);
+    auto &record = datum.value<::avro::GenericRecord>();
+    record.setFieldAt(0, ::avro::GenericDatum(static_cast<int32_t>(7)));
+    record.setFieldAt(1, ::avro::GenericDatum(std::string("hi")));
+    auto bytes = serializer.serialize(ser_ctx, datum);
+
+    schemaregistry::rest::model::Schema v2;
+    v2.setSchemaType(std::make_optional<std::string>("AVRO"));
+    v2.setSchema(std::make_optional<std::string>(v2_str));
+    client->registerSchema("test-value", v2, false);
+
+    // Decoded straight into the latest version, repeatedly
+    for (int i = 0; i < 2; ++i) {
+        auto result = deserializer.deserialize(ser_ctx, bytes);
+        ASSERT_TRUE(result.value.type() == ::avro::AVRO_RECORD);
+        const auto &resolved = result.value.value<::avro::GenericRecord>();
+        ASSERT_EQ(resolved.fieldCount(), 3);
+        EXPECT_EQ(resolved.fieldAt(0).value<std::string>(), "hi");
+        EXPECT_EQ(resolved.fieldAt(1).value<int64_t>(), 7);
+        EXPECT_EQ(resolved.fieldAt(2).value<std::string>(), "none");
+    }
+}
+
+TEST(AvroTest, SerializeIntoBorrowedBuffers) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = SchemaRegistryClient::newClient(client_config);
+
+    const std::string schema_str = R"({
+        "type": "record",
+        "name": "test",
+        "fields": [
+            {"name": "intField", "type": "int"},
+            {"name": "stringField", "type": "string"}
+        ]
+    })";
+    schemaregistry::rest::model::Schema schema;
+    schema.setSchemaType(std::make_optional<std::string>("AVRO"));
+    schema.setSchema(std::make_optional<std::string>(schema_str));
+
+    ::avro::ValidSchema avro_schema =
+        AvroSerializer::compileJsonSchema(schema_str);
+    ::avro::GenericDatum datum(avro_schema);
+    auto &record = datum.value<::avro::GenericRecord>();
+    record.setFieldAt(0, ::avro::GenericDatum(static_cast<int32_t>(123)));
+    record.setFieldAt(1, ::avro::GenericDatum(std::string(1000, 'x')));
+
+    auto rule_registry = std::make_shared<RuleRegistry>();
+    AvroSerializer serializer(client, std::make_optional(schema),
+                              rule_registry,
+                              SerializerConfig::createDefault());
+    AvroDeserializer deserializer(client, rule_registry,
+                                  DeserializerConfig::createDefault());
+
+    SerializationContext ser_ctx;
+    ser_ctx.topic = "test";
+    ser_ctx.serde_type = SerdeType::Value;
+    ser_ctx.serde_format = SerdeFormat::Avro;
+
+    // Writing into a reused buffer gives the same bytes as a fresh one
+    auto expected = serializer.serialize(ser_ctx, datum);
+    std::vector<uint8_t> buffer(4096, 0xff);
+    serializer.serialize(ser_ctx, datum, buffer);
+    EXPECT_EQ(buffer, expected);
+    serializer.serialize(ser_ctx, datum, buffer);
+    EXPECT_EQ(buffer, expected);
+
+    // Borrowed input, as handed out by a Kafka consumer
+    auto value = deserializer.deserialize(ser_ctx, buffer.data(),
+                                          buffer.size());
+    auto &result = value.value.value<::avro::GenericRecord>();
+    EXPECT_EQ(result.fieldAt(0).value<int32_t>(), 123);
+    EXPECT_EQ(result.fieldAt(1).value<std::string>(), std::string(1000, 'x'));
+
+    // Truncated input is rejected
+    EXPECT_THROW(deserializer.deserialize(ser_ctx, buffer.data(), 3),
+                 SerializationError);
+}
+
+namespace {
+
+const char *kCodecTestSchema = R"({
+    "type": "record",
+    "name": "Node",
+    "fields": [
+        {"name": "id", "type": "long"},
+        {"name": "count", "type": "int"},
+        {"name": "flag", "type": "boolean"},
+        {"name": "ratio", "type": "float"},
+        {"name": "score", "type": "double"},
+        {"name": "name", "type": "string"},
+        {"name": "data", "type": "bytes"},
+        {"name": "hash", "type": {"type": "fixed", "name": "Hash", "size": 4}},
+        {"name": "color", "type": {
+            "type": "enum", "name": "Color", "symbols": ["RED", "GREEN"]}},
+        {"name": "tags", "type": {"type": "array", "items": "string"}},
+        {"name": "attrs", "type": {"type": "map", "values": "int"}},
+        {"name": "note", "type": ["null", "string"]},
+        {"name": "next", "type": ["null", "Node"]}
+    ]
+})";
+
+// Fill a record of kCodecTestSchema, followed by depth nested records
+void fillCodecTestNode(::avro::GenericRecord &record, int64_t id, int depth) {
+    record.field("id").value<int64_t>() = id;
+    record.field("count").value<int32_t>() = -static_cast<int32_t>(id) * 1000;
+    record.field("flag").value<bool>() = id % 2 == 0;
+    record.field("ratio").value<float>() = 0.5f * static_cast<float>(id);
+    record.field("score").value<double>() = -1e10 * static_cast<double>(id);
+    record.field("name").value<std::string>() = "node-" + std::to_string(id);
+    record.field("data").value<std::vector<uint8_t>>() = {0, 1, 0xff};
+    record.field("hash").value<::avro::GenericFixed>().value() = {1, 2, 3, 4};
+    record.field("color").value<::avro::GenericEnum>().set(1);
+    auto &tags = record.field("tags").value<::avro::GenericArray>().value();
+    tags.emplace_back(std::string("a"));
+    tags.emplace_back(std::string());
+    auto &attrs = record.field("attrs").value<::avro::GenericMap>().value();
+    attrs.emplace_back("k", ::avro::GenericDatum(static_cast<int32_t>(id)));
+    if (id % 2 == 1) {
+        auto &note = record.field("note");
+        note.selectBranch(1);
+        note.value<std::string>() = "odd";
+    }
+    if (depth > 0) {
+        auto &next = record.field("next");
+        next.selectBranch(1);
+        fillCodecTestNode(next.value<::avro::GenericRecord>(), id + 1,
+                          depth - 1);
+    }
+}
+
+// A wide record of scalar fields
+::avro::ValidSchema compileWideCodecTestSchema() {
+    const char *types[] = {"long", "string", "double", "boolean"};
+    std::string schema = R"({"type": "record", "name": "Wide", "fields": [)";
+    for (int i = 0; i < 100; ++i) {
+        schema += std::string(i > 0 ? "," : "") + R"({"name": "f)" +
+                  std::to_string(i) + R"(", "type": ")" + types[i % 4] +
+                  "\"}";
+    }
+    schema += "]}";
+    return AvroSerializer::compileJsonSchema(schema);
+}
+
+::avro::GenericDatum makeWideCodecTestDatum(
+    const ::avro::ValidSchema &schema) {
+    ::avro::GenericDatum datum(schema);
+    auto &record = datum.value<::avro::GenericRecord>();
+    for (size_t i = 0; i < record.fieldCount(); ++i) {
+        auto &field = record.fieldAt(i);
+        switch (field.type()) {
+            case ::avro::AVRO_LONG:
+                field.value<int64_t>() = static_cast<int64_t>(i) << 20;
+                break;
+            case ::avro::AVRO_STRING:
+                field.value<std::string>() = "value-" + std::to_string(i);
+                break;
+            case ::avro::AVRO_DOUBLE:
+                field.value<double>() = static_cast<double>(i) / 3;
+                break;
+            default:
+                field.value<bool>() = true;
+                break;
+        }
+    }
+    return datum;
+}
+
+}  // namespace
+
+TEST(AvroTest, CodecMatchesGenericEncoding) {
+    auto avro_schema = AvroSerializer::compileJsonSchema(kCodecTestSchema);
+    AvroCodec codec(avro_schema);
+
+    ::avro::GenericDatum datum(avro_schema);
+    fillCodecTestNode(datum.value<::avro::GenericRecord>(), 1, 3);
+
+    auto expected = utils::serializeAvroData(datum, avro_schema);
+    std::vector<uint8_t> encoded;
+    codec.encode(datum, encoded);
+    EXPECT_EQ(encoded, expected);
+
+    // Decoding gives back a datum with the same encoding
+    auto decoded = codec.decode(encoded.data(), encoded.size());
+    EXPECT_EQ(utils::avroToJson(decoded), utils::avroToJson(datum));
+    std::vector<uint8_t> reencoded;
+    codec.encode(decoded, reencoded);
+    EXPECT_EQ(reencoded, expected);
+
+    // Data written by the generic encoder decodes the same way
+    auto generic = utils::deserializeAvroData(expected, avro_schema);
+    EXPECT_EQ(utils::avroToJson(generic), utils::avroToJson(decoded));
+
+    // Truncated data and datums of another schema are rejected
+    EXPECT_THROW(codec.decode(encoded.data(), encoded.size() - 1), AvroError);
+    std::vector<uint8_t> out;
+    EXPECT_THROW(codec.encode(::avro::GenericDatum(std::string("x")), out),
+                 AvroError);
+}
+
+TEST(AvroTest, CodecMatchesGenericEncodingOfLargeData) {
+    auto wide_schema = compileWideCodecTestSchema();
+    auto wide = makeWideCodecTestDatum(wide_schema);
+    auto nested_schema = AvroSerializer::compileJsonSchema(kCodecTestSchema);
+    ::avro::GenericDatum nested(nested_schema);
+    fillCodecTestNode(nested.value<::avro::GenericRecord>(), 1, 20);
+
+    auto compare = [](const ::avro::ValidSchema &schema,
+                      const ::avro::GenericDatum &datum) {
+        AvroCodec codec(schema);
+        auto bytes = utils::serializeAvroData(datum, schema);
+        std::vector<uint8_t> out;
+        codec.encode(datum, out);
+        EXPECT_EQ(out, bytes);
+
+        auto decoded = codec.decode(bytes.data(), bytes.size());
+        EXPECT_EQ(utils::avroToJson(decoded), utils::avroToJson(datum));
+    };
+    compare(wide_schema, wide);
+    compare(nested_schema, nested);
+}
+
+TEST(AvroTest, CodecEncodesFloatsLittleEndian) {
+    auto float_schema = AvroSerializer::compileJsonSchema(R"("float")");
+    AvroCodec float_codec(float_schema);
+    std::vector<uint8_t> out;
+    float_codec.encode(::avro::GenericDatum(1.0f), out);
+    EXPECT_EQ(out, (std::vector<uint8_t>{0x00, 0x00, 0x80, 0x3f}));
+    EXPECT_EQ(float_codec.decode(out.data(), out.size()).value<float>(),
+              1.0f);
+
+    auto double_schema = AvroSerializer::compileJsonSchema(R"("double")");
+    AvroCodec double_codec(double_schema);
+    out.clear();
+    double_codec.encode(::avro::GenericDatum(-2.5), out);
+    EXPECT_EQ(out, (std::vector<uint8_t>{0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                         0x04, 0xc0}));
+    EXPECT_EQ(double_codec.decode(out.data(), out.size()).value<double>(),
+              -2.5);
+}
+
+TEST(AvroTest, CodecRejectsMinimumBlockCount) {
+    auto schema = AvroSerializer::compileJsonSchema(
+        R"({"type": "array", "items": "int"})");
+    AvroCodec codec(schema);
+    // Zig-zag varint of INT64_MIN, which has no positive counterpart
+    std::vector<uint8_t> bytes(9, 0xff);
+    bytes.push_back(0x01);
+    bytes.push_back(0x00);
+    EXPECT_THROW(codec.decode(bytes.data(), bytes.size()), AvroError);
+}
+
+// Times the codec against the generic encoder and decoder. Run with
+// --gtest_also_run_disabled_tests; timings are recorded as test properties.
+TEST(AvroTest, DISABLED_CodecBenchmark) {
+    auto wide_schema = compileWideCodecTestSchema();
+    auto wide = makeWideCodecTestDatum(wide_schema);
+    auto nested_schema = AvroSerializer::compileJsonSchema(kCodecTestSchema);
+    ::avro::GenericDatum nested(nested_schema);
+    fillCodecTestNode(nested.value<::avro::GenericRecord>(), 1, 20);
+
+    const int rounds = 2000;
+    auto run = [&](const std::string &name, auto op) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            op();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+        RecordProperty(name + "_ns", std::to_string(elapsed.count() / rounds));
+    };
+
+    auto measure = [&](const std::string &name,
+                       const ::avro::ValidSchema &schema,
+                       const ::avro::GenericDatum &datum) {
+        AvroCodec codec(schema);
+        auto bytes = utils::serializeAvroData(datum, schema);
+        std::vector<uint8_t> out;
+
+        run(name + "_encode_generic",
+            [&]() { utils::serializeAvroData(datum, schema); });
+        run(name + "_encode_codec", [&]() {
+            out.clear();
+            codec.encode(datum, out);
+        });
+        run(name + "_decode_generic", [&]() {
+            utils::deserializeAvroData(bytes.data(), bytes.size(), schema);
+        });
+        run(name + "_decode_codec",
+            [&]() { codec.decode(bytes.data(), bytes.size()); });
+    };
+    measure("wide", wide_schema, wide);
+    measure("nested", nested_schema, nested);
+}
+
+namespace {
+
+// Upper-cases string fields, counting the values it is applied to
+class UpperFieldExecutor : public FieldRuleExecutor {
+  public:
+    std::string getType() const override { return "UPPER_FIELD"; }
+
+    std::unique_ptr<SerdeValue> transformField(
+        RuleContext &ctx, const SerdeValue &field_value) override {
+        calls++;
+        auto datum = asAvro(field_value);
+        if (datum.type() != ::avro::AVRO_STRING) {
+            return field_value.clone();
+        }
+        std::string value = datum.value<std::string>();
+        std::transform(value.begin(), value.end(), value.begin(), ::toupper);
+        return makeAvroValue(::avro::GenericDatum(value));
+    }
+
+    int calls = 0;
+};
+
+}  // namespace
+
+TEST(AvroTest, FieldRulesVisitOnlyTaggedFields) {
+    const std::string schema_str = R"({
+        "type": "record",
+        "name": "Outer",
+        "namespace": "test",
+        "fields": [
+            {"name": "id", "type": "string"},
+            {"name": "ssn", "type": "string", "confluent:tags": ["PII"]},
+            {"name": "contacts", "type": {"type": "array", "items": {
+                "type": "record",
+                "name": "Contact",
+                "fields": [
+                    {"name": "phone", "type": "string"},
+                    {"name": "note", "type": "string"}
+                ]
+            }}},
+            {"name": "nickname", "type": ["null", "string"]},
+            {"name": "attrs", "type": {"type": "map", "values": "string"}}
+        ]
+    })";
+    Metadata metadata;
+    metadata.setTags(std::map<std::string, std::vector<std::string>>{
+        {"test.Contact.phone", {"PII"}}, {"test.Outer.nickname", {"PII"}}});
+    auto tag_index = std::make_shared<const FieldTagIndex>(
+        utils::getInlineTags(nlohmann::json::parse(schema_str)), metadata);
+
+    ::avro::ValidSchema avro_schema =
+        AvroSerializer::compileJsonSchema(schema_str);
+    ::avro::GenericDatum datum(avro_schema);
+    auto &record = datum.value<::avro::GenericRecord>();
+    record.setFieldAt(0, ::avro::GenericDatum(std::string("id")));
+    record.setFieldAt(1, ::avro::GenericDatum(std::string("ssn")));
+    auto contact_node = avro_schema.root()->leafAt(2)->leafAt(0);
+    for (const std::string suffix : {"1", "2"}) {
+        ::avro::GenericDatum contact(contact_node);
+        auto &fields = contact.value<::avro::GenericRecord>();
+        fields.setFieldAt(0, ::avro::GenericDatum("phone" + suffix));
+        fields.setFieldAt(1, ::avro::GenericDatum("note" + suffix));
+        record.fieldAt(2).value<::avro::GenericArray>().value().push_back(
+            contact);
+    }
+    record.fieldAt(3).selectBranch(1);
+    record.fieldAt(3).value<std::string>() = "nick";
+    record.fieldAt(4).value<::avro::GenericMap>().value().emplace_back(
+        "key", ::avro::GenericDatum(std::string("value")));
+
+    auto executor = std::make_shared<UpperFieldExecutor>();
+    auto rule_registry = std::make_shared<RuleRegistry>();
+    rule_registry->registerExecutor(executor);
+    Rule rule;
+    rule.setName(std::make_optional<std::string>("upper"));
+    rule.setKind(std::make_optional<Kind>(Kind::Transform));
+    rule.setMode(std::make_optional<Mode>(Mode::Write));
+    rule.setType(std::make_optional<std::string>("UPPER_FIELD"));
+    rule.setTags(std::make_optional<std::vector<std::string>>({"PII"}));
+    SerializationContext ser_ctx("test", SerdeType::Value, SerdeFormat::Avro);
+    std::vector<Rule> rules{rule};
+
+    for (int run = 0; run < 2; ++run) {
+        RuleContext ctx(std::nullopt, ser_ctx, nullptr, nullptr,
+                        "test-value", Mode::Write, rule, 0, rules, tag_index,
+                        nullptr, rule_registry);
+        executor->calls = 0;
+        auto result = utils::transformFields(ctx, avro_schema, datum);
+
+        // Only the tagged values were handed to the executor
+        EXPECT_EQ(executor->calls, 4);
+        auto &fields = result.value<::avro::GenericRecord>();
+        EXPECT_EQ(fields.fieldAt(0).value<std::string>(), "id");
+        EXPECT_EQ(fields.fieldAt(1).value<std::string>(), "SSN");
+        const auto &contacts =
+            fields.fieldAt(2).value<::avro::GenericArray>().value();
+        ASSERT_EQ(contacts.size(), 2u);
+        const auto &contact = contacts[1].value<::avro::GenericRecord>();
+        EXPECT_EQ(contact.fieldAt(0).value<std::string>(), "PHONE2");
+        EXPECT_EQ(contact.fieldAt(1).value<std::string>(), "note2");
+        EXPECT_TRUE(fields.fieldAt(3).isUnion());
+        EXPECT_EQ(fields.fieldAt(3).unionBranch(), 1u);
+        EXPECT_EQ(fields.fieldAt(3).value<std::string>(), "NICK");
+        EXPECT_EQ(fields.fieldAt(4)
+                      .value<::avro::GenericMap>()
+                      .value()[0]
+                      .second.value<std::string>(),
+                  "value");
+
+        // The input is left untouched
+        EXPECT_EQ(record.fieldAt(1).value<std::string>(), "ssn");
+    }
+}
+
 #ifdef SCHEMAREGISTRY_USE_RULES
 
 TEST(AvroTest, CelCondition) {
@@ -648,6 +1155,190 @@ TEST(AvroTest, JsonataWithCelField) {
     EXPECT_EQ(deserialized_record.fieldAt(2).value<int32_t>(), 1);                   // version unchanged
 }
 
+TEST(AvroTest, JsonataExpressionsAreCompiledOnce) {
+    JsonataExecutor executor(2);
+    SerializationContext ser_ctx("test", SerdeType::Value, SerdeFormat::Json);
+    auto transform = [&](const std::string &expr, int32_t size) {
+        Rule rule;
+        rule.setExpr(std::make_optional<std::string>(expr));
+        std::vector<Rule> rules{rule};
+        RuleContext ctx(std::nullopt, ser_ctx, nullptr, nullptr,
+                        "test-value", Mode::Upgrade, rule, 0, rules, nullptr);
+        auto msg = SerdeValue::newJson(SerdeFormat::Json,
+                                       nlohmann::json{{"size", size}});
+        return executor.transform(ctx, *msg)->asJson();
+    };
+
+    const std::string expr = "{'height': size}";
+    EXPECT_EQ(transform(expr, 1)["height"], 1);
+
+    // Concurrent evaluations of the cached expression
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 50; ++i) {
+                if (transform(expr, t * 100 + i)["height"] != t * 100 + i) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+
+    auto stats = executor.getCacheStats();
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.hits, 400);
+    EXPECT_EQ(stats.size, 1);
+
+    // The cache is bounded, the least recently used expression is evicted
+    transform("{'width': size}", 1);
+    transform(expr, 1);
+    transform("{'depth': size}", 1);
+    stats = executor.getCacheStats();
+    EXPECT_EQ(stats.misses, 3);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(stats.size, 2);
+    transform(expr, 1);
+    EXPECT_EQ(executor.getCacheStats().misses, 3);
+}
+
+TEST(AvroTest, CryptorsShareCachedPrimitives) {
+    std::vector<uint8_t> plaintext{'s', 'e', 'c', 'r', 'e', 't'};
+    std::vector<uint8_t> associated_data;
+    for (auto algorithm : {Algorithm::Aes128Gcm, Algorithm::Aes256Gcm,
+                           Algorithm::Aes256Siv}) {
+        Cryptor cryptor(algorithm);
+        auto dek = cryptor.generateKey();
+        auto ciphertext = cryptor.encrypt(dek, plaintext, associated_data);
+
+        // Another cryptor for the same key decrypts with the cached primitive
+        Cryptor other(algorithm);
+        EXPECT_EQ(other.decrypt(dek, ciphertext, associated_data), plaintext);
+        EXPECT_EQ(cryptor.decrypt(dek, ciphertext, associated_data),
+                  plaintext);
+
+        // Another key of the same algorithm gets its own primitive
+        auto other_dek = other.generateKey();
+        EXPECT_THROW(other.decrypt(other_dek, ciphertext, associated_data),
+                     SerdeError);
+        if (cryptor.isDeterministic()) {
+            EXPECT_EQ(other.encrypt(dek, plaintext, associated_data),
+                      ciphertext);
+        }
+    }
+}
+
+TEST(AvroTest, EncryptionTransformsAreReused) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    EncryptionExecutor executor;
+    executor.configure(client_config, {{"secret", "mysecret"}});
+
+    Rule rule;
+    rule.setName(std::make_optional<std::string>("test-encrypt"));
+    rule.setParams(std::make_optional<std::map<std::string, std::string>>(
+        {{"encrypt.kek.name", "kek1"}}));
+    std::vector<Rule> rules{rule};
+    SerializationContext ser_ctx("test", SerdeType::Value, SerdeFormat::Avro);
+    auto context = [&](const std::string &subject, Mode mode) {
+        return RuleContext(std::nullopt, ser_ctx, nullptr, nullptr,
+                           subject, mode, rule, 0, rules, nullptr);
+    };
+
+    auto write_ctx = context("test-value", Mode::Write);
+    auto transform = executor.getTransform(write_ctx);
+    auto same_ctx = context("test-value", Mode::Write);
+    EXPECT_EQ(executor.getTransform(same_ctx), transform);
+
+    // Transforms are per subject and rule mode
+    auto read_ctx = context("test-value", Mode::Read);
+    EXPECT_NE(executor.getTransform(read_ctx), transform);
+    auto other_ctx = context("other-value", Mode::Write);
+    EXPECT_NE(executor.getTransform(other_ctx), transform);
+
+    // Rules with other parameters get their own transform
+    rule.setParams(std::make_optional<std::map<std::string, std::string>>(
+        {{"encrypt.kek.name", "kek2"}}));
+    auto kek2_ctx = context("test-value", Mode::Write);
+    EXPECT_NE(executor.getTransform(kek2_ctx), transform);
+}
+
+TEST(AvroTest, ExpiredDeksAreFetchedAgain) {
+    LocalKmsDriver::registerDriver();
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = SchemaRegistryClient::newClient(client_config);
+
+    const std::string schema_str = R"({
+        "type": "record",
+        "name": "test",
+        "fields": [
+            {"name": "f1", "type": "string", "confluent:tags": ["PII"]}
+        ]
+    })";
+    Rule rule;
+    rule.setName(std::make_optional<std::string>("test-encrypt"));
+    rule.setKind(std::make_optional<Kind>(Kind::Transform));
+    rule.setMode(std::make_optional<Mode>(Mode::WriteRead));
+    rule.setType(std::make_optional<std::string>("ENCRYPT"));
+    rule.setTags(std::make_optional<std::vector<std::string>>({"PII"}));
+    rule.setParams(std::make_optional<std::map<std::string, std::string>>(
+        {{"encrypt.kek.name", "kek1-expiry"},
+         {"encrypt.kms.type", "local-kms"},
+         {"encrypt.kms.key.id", "mykey"},
+         {"encrypt.dek.expiry.days", "1"}}));
+    RuleSet rule_set;
+    rule_set.setDomainRules(std::make_optional<std::vector<Rule>>({rule}));
+    Schema schema;
+    schema.setSchemaType(std::make_optional<std::string>("AVRO"));
+    schema.setSchema(std::make_optional<std::string>(schema_str));
+    schema.setRuleSet(std::make_optional<RuleSet>(rule_set));
+    client->registerSchema("test-value", schema, false);
+
+    // DEKs are stamped with the system time by the mock DEK registry
+    int64_t now = SystemClock().now();
+    auto clock = std::make_shared<FakeClock>(now);
+    auto executor = std::make_shared<FieldEncryptionExecutor>(clock);
+    auto rule_registry = std::make_shared<RuleRegistry>();
+    rule_registry->registerExecutor(executor);
+    SerializerConfig ser_config(
+        false, std::make_optional(SchemaSelector::useLatestVersion()), false,
+        false, {{"secret", "mysecret"}});
+    AvroSerializer ser(client, std::nullopt, rule_registry, ser_config);
+    AvroDeserializer deser(client, rule_registry,
+                           DeserializerConfig::createDefault());
+
+    ::avro::ValidSchema avro_schema =
+        AvroSerializer::compileJsonSchema(schema_str);
+    ::avro::GenericDatum datum(avro_schema);
+    datum.value<::avro::GenericRecord>().setFieldAt(
+        0, ::avro::GenericDatum(std::string("hi")));
+    SerializationContext ser_ctx("test", SerdeType::Value, SerdeFormat::Avro);
+    auto value = deser.deserialize(ser_ctx, ser.serialize(ser_ctx, datum));
+    EXPECT_EQ(value.value.value<::avro::GenericRecord>()
+                  .fieldAt(0)
+                  .value<std::string>(),
+              "hi");
+
+    // Until it expires, the DEK is not fetched again, so dropping it from
+    // the registry goes unnoticed
+    auto dek_client = executor->getClient();
+    ASSERT_NE(dek_client, nullptr);
+    dek_client->clearCaches();
+    clock->setTime(now + 12 * 60 * 60 * 1000);
+    ser.serialize(ser_ctx, datum);
+    EXPECT_ANY_THROW(dek_client->getDek("kek1-expiry", "test-value"));
+
+    // Once expired, the DEK is fetched again, and created as it is missing
+    clock->setTime(now + 3 * 24 * 60 * 60 * 1000LL);
+    ser.serialize(ser_ctx, datum);
+    EXPECT_NO_THROW(dek_client->getDek("kek1-expiry", "test-value"));
+}
+
 TEST(AvroTest, FieldEncryption) {
     // Register local KMS driver
     LocalKmsDriver::registerDriver();
@@ -777,6 +1468,121 @@ TEST(AvroTest, FieldEncryption) {
     EXPECT_EQ(bytes_field[2], 3);
 }
 
+TEST(AvroTest, FieldEncryptionAcrossWriterVersions) {
+    LocalKmsDriver::registerDriver();
+
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = SchemaRegistryClient::newClient(client_config);
+    auto dek_client = std::make_shared<MockDekRegistryClient>(client_config);
+
+    // The tagged field is at a different index in each version
+    const std::string v1_str = R"({
+        "type": "record",
+        "name": "test",
+        "fields": [
+            {"name": "stringField", "type": "string", "confluent:tags": ["PII"]},
+            {"name": "intField", "type": "int"}
+        ]
+    })";
+    const std::string v2_str = R"({
+        "type": "record",
+        "name": "test",
+        "fields": [
+            {"name": "intField", "type": "int"},
+            {"name": "extraField", "type": "string", "default": "none"},
+            {"name": "stringField", "type": "string", "confluent:tags": ["PII"]}
+        ]
+    })";
+    const std::string v3_str = R"({
+        "type": "record",
+        "name": "test",
+        "fields": [
+            {"name": "intField", "type": "int"},
+            {"name": "stringField", "type": "string", "confluent:tags": ["PII"]},
+            {"name": "extraField", "type": "string", "default": "none"}
+        ]
+    })";
+
+    Rule encrypt_rule;
+    encrypt_rule.setName(std::make_optional<std::string>("test-encrypt"));
+    encrypt_rule.setKind(std::make_optional<Kind>(Kind::Transform));
+    encrypt_rule.setMode(std::make_optional<Mode>(Mode::WriteRead));
+    encrypt_rule.setType(std::make_optional<std::string>("ENCRYPT"));
+    encrypt_rule.setTags(std::vector<std::string>{"PII"});
+    encrypt_rule.setParams(std::map<std::string, std::string>{
+        {"encrypt.kek.name", "kek1"},
+        {"encrypt.kms.type", "local-kms"},
+        {"encrypt.kms.key.id", "mykey"}});
+    encrypt_rule.setOnFailure(std::make_optional<std::string>("ERROR,NONE"));
+    RuleSet rule_set;
+    rule_set.setDomainRules(std::vector<Rule>{encrypt_rule});
+
+    auto register_version = [&](const std::string &schema_str) {
+        Schema schema;
+        schema.setSchemaType(std::make_optional<std::string>("AVRO"));
+        schema.setSchema(std::make_optional<std::string>(schema_str));
+        schema.setRuleSet(std::make_optional<RuleSet>(rule_set));
+        return client->registerSchema("test-value", schema, false).getId();
+    };
+
+    auto rule_registry = std::make_shared<RuleRegistry>();
+    auto clock = std::make_shared<SystemClock>();
+    rule_registry->registerExecutor(
+        std::make_shared<FieldEncryptionExecutor>(clock));
+    std::unordered_map<std::string, std::string> rule_config = {
+        {"secret", "mysecret"}};
+
+    SerializationContext ser_ctx;
+    ser_ctx.topic = "test";
+    ser_ctx.serde_type = SerdeType::Value;
+    ser_ctx.serde_format = SerdeFormat::Avro;
+
+    // Serialize one record with each writer version
+    auto serialize_version = [&](const std::string &schema_str,
+                                 const std::vector<::avro::GenericDatum>
+                                     &fields) {
+        auto id = register_version(schema_str);
+        SerializerConfig ser_config(
+            false, std::make_optional(SchemaSelector::useSchemaId(*id)),
+            false, false, rule_config);
+        AvroSerializer serializer(client, std::nullopt, rule_registry,
+                                  ser_config);
+        ::avro::GenericDatum datum(
+            AvroSerializer::compileJsonSchema(schema_str));
+        auto &record = datum.value<::avro::GenericRecord>();
+        for (size_t i = 0; i < fields.size(); ++i) {
+            record.setFieldAt(i, fields[i]);
+        }
+        return serializer.serialize(ser_ctx, datum);
+    };
+    auto bytes1 = serialize_version(
+        v1_str, {::avro::GenericDatum(std::string("first")),
+                 ::avro::GenericDatum(static_cast<int32_t>(1))});
+    auto bytes2 = serialize_version(
+        v2_str, {::avro::GenericDatum(static_cast<int32_t>(2)),
+                 ::avro::GenericDatum(std::string("extra")),
+                 ::avro::GenericDatum(std::string("second"))});
+    register_version(v3_str);
+
+    // Both versions decode into the latest one, sharing its field visit
+    // plan, whichever version decodes first
+    auto deser_config = DeserializerConfig::createDefault();
+    deser_config.use_schema = SchemaSelector::useLatestVersion();
+    AvroDeserializer deserializer(client, rule_registry, deser_config);
+    for (const auto *bytes : {&bytes2, &bytes1, &bytes2}) {
+        auto result = deserializer.deserialize(ser_ctx, *bytes);
+        const auto &record = result.value.value<::avro::GenericRecord>();
+        ASSERT_EQ(record.fieldCount(), 3);
+        bool second = bytes == &bytes2;
+        EXPECT_EQ(record.fieldAt(0).value<int32_t>(), second ? 2 : 1);
+        EXPECT_EQ(record.fieldAt(1).value<std::string>(),
+                  second ? "second" : "first");
+        EXPECT_EQ(record.fieldAt(2).value<std::string>(),
+                  second ? "extra" : "none");
+    }
+}
+
 TEST(AvroTest, PayloadEncryption) {
     // Register local KMS driver
     LocalKmsDriver::registerDriver();
@@ -0,0 +1,153 @@
+/**
+ * FieldTagIndexTest
+ * Tests for the per-schema index of field tags
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "schemaregistry/serdes/FieldTagIndex.h"
+#include "schemaregistry/serdes/Serde.h"
+#include "schemaregistry/serdes/json/JsonValue.h"
+
+using namespace schemaregistry::serdes;
+using schemaregistry::rest::model::Metadata;
+using schemaregistry::rest::model::Rule;
+using schemaregistry::rest::model::Schema;
+
+namespace {
+
+Metadata metadataWithTags(
+    const std::map<std::string, std::vector<std::string>> &tags) {
+    Metadata metadata;
+    metadata.setTags(tags);
+    return metadata;
+}
+
+}  // namespace
+
+TEST(FieldTagIndexTest, MergesInlineAndMetadataTags) {
+    FieldTagIndex index(
+        {{"test.Record.name", {"PII"}}},
+        metadataWithTags({{"test.Record.*", {"SENSITIVE"}},
+                          {"**.ssn", {"PII", "SSN"}}}));
+
+    EXPECT_EQ(*index.getTags("test.Record.name"),
+              FieldTagIndex::TagSet({"PII", "SENSITIVE"}));
+    EXPECT_EQ(*index.getMetadataTags("test.Record.name"),
+              FieldTagIndex::TagSet({"SENSITIVE"}));
+    ASSERT_NE(index.getInlineTags("test.Record.name"), nullptr);
+    EXPECT_EQ(*index.getInlineTags("test.Record.name"),
+              FieldTagIndex::TagSet({"PII"}));
+
+    // Metadata tags are the tag values, not the pattern they are keyed by
+    EXPECT_EQ(*index.getTags("test.Record.nested.ssn"),
+              FieldTagIndex::TagSet({"PII", "SSN"}));
+    EXPECT_EQ(index.getInlineTags("test.Record.nested.ssn"), nullptr);
+    EXPECT_TRUE(index.getTags("other.Record.id")->empty());
+}
+
+TEST(FieldTagIndexTest, LookupsAreMemoized) {
+    FieldTagIndex index({}, metadataWithTags({{"**.name", {"PII"}}}));
+
+    auto first = index.getTags("a.name");
+    auto second = index.getTags("a.name");
+    EXPECT_EQ(first.get(), second.get());
+
+    // Without any tags, every field shares the same empty set
+    FieldTagIndex empty({}, std::nullopt);
+    EXPECT_EQ(empty.getTags("a").get(), empty.getTags("b").get());
+    EXPECT_TRUE(empty.getTags("a")->empty());
+}
+
+TEST(FieldTagIndexTest, ForSchemaIsCachedByContent) {
+    Schema schema;
+    schema.setSchema(std::string("{\"type\": \"string\"}"));
+    schema.setMetadata(metadataWithTags({{"**.name", {"PII"}}}));
+    Schema same = schema;
+
+    auto index = FieldTagIndex::forSchema(schema);
+    EXPECT_EQ(index.get(), FieldTagIndex::forSchema(same).get());
+    EXPECT_EQ(*index->getTags("a.name"), FieldTagIndex::TagSet({"PII"}));
+
+    Schema other = schema;
+    other.setMetadata(metadataWithTags({{"**.name", {"SENSITIVE"}}}));
+    EXPECT_NE(index.get(), FieldTagIndex::forSchema(other).get());
+}
+
+TEST(FieldTagIndexTest, RuleContextUsesIndex) {
+    auto index = std::make_shared<const FieldTagIndex>(
+        std::unordered_map<std::string, FieldTagIndex::TagSet>{
+            {"test.Record.name", {"PII"}}},
+        metadataWithTags({{"test.Record.*", {"SENSITIVE"}}}));
+    SerializationContext ser_ctx("topic", SerdeType::Value, SerdeFormat::Json);
+    Rule rule;
+    std::vector<Rule> rules{rule};
+    RuleContext ctx(std::nullopt, ser_ctx, nullptr, nullptr,
+                    "topic-value", Mode::Write, rule, 0, rules, index);
+
+    auto message = json::makeJsonValue(nlohmann::json::object());
+    ctx.enterField(*message, "test.Record.name", "name", FieldType::String,
+                   {});
+    auto field = ctx.currentField();
+    ASSERT_TRUE(field.has_value());
+    EXPECT_EQ(field->getTags(), FieldTagIndex::TagSet({"PII", "SENSITIVE"}));
+    ctx.exitField();
+
+    // Explicit tags replace the inline tags but keep the metadata tags
+    ctx.enterField(*message, "test.Record.id", "id", FieldType::Int,
+                   {"ID"});
+    EXPECT_EQ(ctx.currentField()->getTags(),
+              FieldTagIndex::TagSet({"ID", "SENSITIVE"}));
+    ctx.exitField();
+
+    EXPECT_EQ(ctx.getTags("test.Record.id"),
+              FieldTagIndex::TagSet({"SENSITIVE"}));
+    EXPECT_FALSE(ctx.getInlineTags("test.Record.id").has_value());
+}
+
+TEST(FieldTagIndexTest, VisitPlansAreCachedPerRuleTags) {
+    auto index = std::make_shared<const FieldTagIndex>(
+        std::unordered_map<std::string, FieldTagIndex::TagSet>{},
+        metadataWithTags({{"test.Record.ssn", {"PII"}}}));
+    SerializationContext ser_ctx("topic", SerdeType::Value, SerdeFormat::Json);
+    int builds = 0;
+    auto build = [&]() {
+        builds++;
+        return FieldVisitPlan({{"test.Record", {false, true}}});
+    };
+
+    Rule rule;
+    rule.setTags(std::vector<std::string>{"PII", "SSN"});
+    std::vector<Rule> rules{rule};
+    RuleContext ctx(std::nullopt, ser_ctx, nullptr, nullptr,
+                    "topic-value", Mode::Write, rule, 0, rules, index);
+    EXPECT_TRUE(ctx.appliesTo({"PII"}));
+    EXPECT_FALSE(ctx.appliesTo({"OTHER"}));
+
+    auto plan = ctx.getVisitPlan("test.Record", build);
+    ASSERT_NE(plan, nullptr);
+    EXPECT_FALSE(plan->visits("test.Record", 0));
+    EXPECT_TRUE(plan->visits("test.Record", 1));
+    EXPECT_TRUE(plan->visits("test.Unknown", 0));
+
+    // Rules with the same tags in another order share the plan
+    Rule reordered;
+    reordered.setTags(std::vector<std::string>{"SSN", "PII"});
+    RuleContext other(std::nullopt, ser_ctx, nullptr, nullptr,
+                      "topic-value", Mode::Write, reordered, 0, rules, index);
+    EXPECT_EQ(other.getVisitPlan("test.Record", build).get(), plan.get());
+    EXPECT_EQ(builds, 1);
+
+    // Rules without tags visit all fields
+    Rule untagged;
+    RuleContext all(std::nullopt, ser_ctx, nullptr, nullptr,
+                    "topic-value", Mode::Write, untagged, 0, rules, index);
+    EXPECT_TRUE(all.appliesTo({}));
+    EXPECT_EQ(all.getVisitPlan("test.Record", build), nullptr);
+    EXPECT_EQ(builds, 1);
+}
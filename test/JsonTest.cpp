@@ -307,6 +307,55 @@ TEST(JsonTest, SerializeReferences) {
     ASSERT_EQ(obj2, obj);
 }
 
+TEST(JsonTest, MigrationPlansAreCached) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = SchemaRegistryClient::newClient(client_config);
+
+    auto make_schema = [](const std::string &schema_str,
+                          std::optional<Rule> migration_rule) {
+        Schema schema;
+        schema.setSchemaType(std::make_optional<std::string>("JSON"));
+        schema.setSchema(std::make_optional<std::string>(schema_str));
+        if (migration_rule.has_value()) {
+            RuleSet rule_set;
+            rule_set.setMigrationRules(
+                std::make_optional<std::vector<Rule>>({*migration_rule}));
+            schema.setRuleSet(std::make_optional<RuleSet>(rule_set));
+        }
+        return schema;
+    };
+    Rule upgrade;
+    upgrade.setName(std::make_optional<std::string>("rename"));
+    upgrade.setKind(std::make_optional<Kind>(Kind::Transform));
+    upgrade.setMode(std::make_optional<Mode>(Mode::Upgrade));
+    upgrade.setType(std::make_optional<std::string>("JSONATA"));
+    upgrade.setExpr(std::make_optional<std::string>("{'height': size}"));
+
+    auto v1 = make_schema(R"({"type": "object"})", std::nullopt);
+    auto v2 = make_schema(R"({"type": "object", "title": "v2"})", upgrade);
+    client->registerSchema("test-value", v1, false);
+    client->registerSchema("test-value", v2, false);
+    auto latest = client->getLatestVersion("test-value", std::nullopt);
+
+    Serde serde(client);
+    auto migrations = serde.getMigrations("test-value", v1, latest);
+    ASSERT_EQ(migrations->size(), 1);
+    const auto &migration = migrations->front();
+    EXPECT_EQ(migration.rule_mode, Mode::Upgrade);
+    EXPECT_TRUE(migration.prepared);
+    ASSERT_EQ(migration.rules.size(), 1);
+    EXPECT_EQ(migration.rules[0].getName(), "rename");
+    ASSERT_TRUE(migration.target_schema.has_value());
+    EXPECT_EQ(migration.target_schema->getSchema(), v2.getSchema());
+
+    // Later messages with the same schemas reuse the plan
+    EXPECT_EQ(serde.getMigrations("test-value", v1, latest), migrations);
+
+    // Writer and reader at the same version need no migration
+    EXPECT_TRUE(serde.getMigrations("test-value", v2, latest)->empty());
+}
+
 #ifdef SCHEMAREGISTRY_USE_RULES
 
 TEST(JsonTest, CelField) {
@@ -0,0 +1,100 @@
+/**
+ * NotFoundCacheTest
+ * Tests for the negative cache of 404 lookups
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "schemaregistry/rest/NotFoundCache.h"
+
+using namespace schemaregistry::rest;
+
+TEST(NotFoundCacheTest, RememberedMissIsRethrown) {
+    NotFoundCache cache(100, std::chrono::seconds(60));
+    int calls = 0;
+    auto lookup = [&]() -> std::string {
+        calls++;
+        throw RestException("Subject 'a' not found.", 404);
+    };
+
+    for (int i = 0; i < 3; ++i) {
+        try {
+            cache.run("a", "GET /subjects/a", lookup);
+            FAIL() << "expected RestException";
+        } catch (const RestException &e) {
+            EXPECT_EQ(e.getStatus(), 404);
+            EXPECT_STREQ(e.what(), "Subject 'a' not found.");
+        }
+    }
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // Other keys are still looked up
+    EXPECT_EQ(cache.run("a", "other", []() { return std::string("ok"); }),
+              "ok");
+}
+
+TEST(NotFoundCacheTest, OnlyNotFoundIsCached) {
+    NotFoundCache cache(100, std::chrono::seconds(60));
+    int calls = 0;
+    auto lookup = [&]() -> std::string {
+        calls++;
+        throw RestException("Internal error", 500);
+    };
+
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_THROW(cache.run("a", "key", lookup), RestException);
+    }
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(NotFoundCacheTest, InvalidateScope) {
+    NotFoundCache cache(100, std::chrono::seconds(60));
+    RestException notFound("not found", 404);
+    cache.put("a", "k1", notFound);
+    cache.put("a", "k2", notFound);
+    cache.put("b", "k1", notFound);
+    EXPECT_EQ(cache.size(), 3u);
+
+    cache.invalidate("a");
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_NO_THROW(cache.check("a", "k1"));
+    EXPECT_NO_THROW(cache.check("a", "k2"));
+    EXPECT_THROW(cache.check("b", "k1"), RestException);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_NO_THROW(cache.check("b", "k1"));
+}
+
+TEST(NotFoundCacheTest, EntriesExpire) {
+    NotFoundCache cache(100, std::chrono::seconds(1));
+    cache.put("a", "key", RestException("not found", 404));
+    EXPECT_THROW(cache.check("a", "key"), RestException);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_NO_THROW(cache.check("a", "key"));
+
+    // A zero TTL disables caching
+    NotFoundCache disabled(100, std::chrono::seconds(0));
+    EXPECT_FALSE(disabled.enabled());
+    disabled.put("a", "key", RestException("not found", 404));
+    EXPECT_EQ(disabled.size(), 0u);
+    EXPECT_NO_THROW(disabled.check("a", "key"));
+}
+
+TEST(NotFoundCacheTest, CapacityIsBounded) {
+    NotFoundCache cache(10, std::chrono::seconds(60));
+    RestException notFound("not found", 404);
+    for (int i = 0; i < 100; ++i) {
+        cache.put("scope" + std::to_string(i % 3), std::to_string(i),
+                  notFound);
+        EXPECT_LE(cache.size(), 10u);
+    }
+    EXPECT_THROW(cache.check("scope0", "99"), RestException);
+}
@@ -21,7 +21,9 @@
 #include "schemaregistry/serdes/protobuf/ProtobufSerializer.h"
 #include "schemaregistry/serdes/protobuf/ProtobufDeserializer.h"
 #include "schemaregistry/serdes/protobuf/ProtobufUtils.h"
+#include "schemaregistry/rest/model/Metadata.h"
 #include "schemaregistry/rest/model/Schema.h"
+#include "schemaregistry/rest/model/ServerConfig.h"
 #include "schemaregistry/rest/model/Rule.h"
 #include "schemaregistry/rest/model/RuleSet.h"
 #include "schemaregistry/serdes/SerdeError.h"
@@ -33,10 +35,18 @@
 #include "schemaregistry/rules/encryption/EncryptionExecutor.h"
 #include "schemaregistry/rules/encryption/localkms/LocalKmsDriver.h"
 #include "schemaregistry/rest/MockDekRegistryClient.h"
+#include "schemaregistry/rules/jsonata/JsonataExecutor.h"
 #endif
 
+#include <google/protobuf/dynamic_message.h>
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/timestamp.pb.h>
+#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/message_differencer.h>
+
 #include "test/dep.pb.h"
 #include "test/example.pb.h"
+#include "test/reading.pb.h"
 #include "test/test.pb.h"
 
 using namespace schemaregistry::serdes;
@@ -48,6 +58,7 @@ using namespace schemaregistry::rest::model;
 using namespace schemaregistry::rules::cel;
 using namespace schemaregistry::rules::encryption;
 using namespace schemaregistry::rules::encryption::localkms;
+using namespace schemaregistry::rules::jsonata;
 #endif
 
 TEST(ProtobufTest, BasicSerialization) {
@@ -115,6 +126,598 @@ TEST(ProtobufTest, BasicSerialization) {
     EXPECT_EQ(obj2->oneof_string(), obj.oneof_string());
 }
 
+namespace {
+
+// File with a Pizza message of the given string fields
+google::protobuf::FileDescriptorProto pizzaFile(
+    const std::vector<std::string> &fields) {
+    google::protobuf::FileDescriptorProto file;
+    file.set_name("pizza.proto");
+    file.set_package("test");
+    file.set_syntax("proto3");
+    auto *pizza = file.add_message_type();
+    pizza->set_name("Pizza");
+    for (size_t i = 0; i < fields.size(); ++i) {
+        auto *field = pizza->add_field();
+        field->set_name(fields[i]);
+        field->set_number(static_cast<int>(i) + 1);
+        field->set_type(google::protobuf::FieldDescriptorProto::TYPE_STRING);
+        field->set_label(
+            google::protobuf::FieldDescriptorProto::LABEL_OPTIONAL);
+    }
+    return file;
+}
+
+Schema pizzaSchema(const std::vector<std::string> &fields) {
+    google::protobuf::DescriptorPool pool;
+    Schema schema;
+    schema.setSchemaType("PROTOBUF");
+    schema.setSchema(utils::schemaToString(pool.BuildFile(pizzaFile(fields))));
+    return schema;
+}
+
+// Schema of an Order message with a field of the referenced Pizza message
+Schema orderSchema(const std::string &field_name) {
+    google::protobuf::DescriptorPool pool;
+    pool.BuildFile(pizzaFile({"size"}));
+    google::protobuf::FileDescriptorProto file;
+    file.set_name("order.proto");
+    file.set_package("test");
+    file.set_syntax("proto3");
+    file.add_dependency("pizza.proto");
+    auto *order = file.add_message_type();
+    order->set_name("Order");
+    auto *field = order->add_field();
+    field->set_name(field_name);
+    field->set_number(1);
+    field->set_type(google::protobuf::FieldDescriptorProto::TYPE_MESSAGE);
+    field->set_type_name(".test.Pizza");
+    field->set_label(google::protobuf::FieldDescriptorProto::LABEL_OPTIONAL);
+
+    SchemaReference ref;
+    ref.setName(std::make_optional<std::string>("pizza.proto"));
+    ref.setSubject(std::make_optional<std::string>("pizza"));
+    ref.setVersion(std::make_optional<int32_t>(1));
+    Schema schema;
+    schema.setSchemaType("PROTOBUF");
+    schema.setReferences(
+        std::make_optional<std::vector<SchemaReference>>({ref}));
+    schema.setSchema(utils::schemaToString(pool.BuildFile(file)));
+    return schema;
+}
+
+// Schema of the Reading message, with its int64 field 2 named count_field
+Schema readingSchema(const std::string &count_field) {
+    const auto *generated = test::Reading::descriptor()->file();
+    google::protobuf::DescriptorPool pool;
+    for (int i = 0; i < generated->dependency_count(); ++i) {
+        google::protobuf::FileDescriptorProto dependency;
+        generated->dependency(i)->CopyTo(&dependency);
+        pool.BuildFile(dependency);
+    }
+    google::protobuf::FileDescriptorProto file;
+    generated->CopyTo(&file);
+    file.mutable_message_type(0)->mutable_field(1)->set_name(count_field);
+    Schema schema;
+    schema.setSchemaType("PROTOBUF");
+    schema.setSchema(utils::schemaToString(pool.BuildFile(file)));
+    return schema;
+}
+
+// Reading with every kind of field set
+test::Reading sampleReading() {
+    test::Reading reading;
+    reading.set_name("probe");
+    reading.set_total(-9007199254740993LL);
+    reading.set_level(test::HIGH);
+    reading.add_history(test::LOW);
+    reading.add_history(test::HIGH);
+    reading.add_history(static_cast<test::Level>(7));
+    (*reading.mutable_labels())[-5] = "negative";
+    (*reading.mutable_labels())[1LL << 40] = "large";
+    (*reading.mutable_flags())[true] = 1;
+    (*reading.mutable_flags())[false] = 0;
+    reading.mutable_limit()->set_value(9007199254740993LL);
+    reading.mutable_note()->set_value("");
+    reading.mutable_elapsed()->set_seconds(90);
+    reading.mutable_elapsed()->set_nanos(500000000);
+    reading.mutable_mask()->add_paths("a.b_c");
+    reading.mutable_mask()->add_paths("d");
+    reading.mutable_at()->set_seconds(1);
+    reading.mutable_at()->set_nanos(500000000);
+    reading.set_data(std::string({0, '\xff'}));
+    return reading;
+}
+
+// Client counting the schemas registered or looked up
+class CountingClient : public MockSchemaRegistryClient {
+  public:
+    using MockSchemaRegistryClient::MockSchemaRegistryClient;
+
+    RegisteredSchema registerSchema(const std::string &subject,
+                                    const Schema &schema,
+                                    bool normalize = false) override {
+        lookups++;
+        return MockSchemaRegistryClient::registerSchema(subject, schema,
+                                                        normalize);
+    }
+
+    RegisteredSchema getBySchema(const std::string &subject,
+                                 const Schema &schema, bool normalize = false,
+                                 bool deleted = false) override {
+        lookups++;
+        return MockSchemaRegistryClient::getBySchema(subject, schema,
+                                                     normalize, deleted);
+    }
+
+    int lookups = 0;
+};
+
+// Executor passing messages through, recording the subjects it ran for
+class SubjectRecordingExecutor : public RuleExecutor {
+  public:
+    std::string getType() const override { return "RECORD_SUBJECT"; }
+
+    std::unique_ptr<SerdeValue> transform(RuleContext &ctx,
+                                          const SerdeValue &msg) override {
+        subjects.push_back(ctx.getSubject());
+        return msg.clone();
+    }
+
+    std::vector<std::string> subjects;
+};
+
+}  // namespace
+
+TEST(ProtobufTest, DescriptorSchemasAreCached) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = std::make_shared<CountingClient>(client_config);
+
+    test::Author author;
+    author.set_name("Kafka");
+    test::DependencyMessage dependency;
+    dependency.set_is_active(true);
+    dependency.mutable_test_message()->set_test_string("hi");
+
+    ProtobufSerializer<google::protobuf::Message> ser(
+        client, std::nullopt, std::make_shared<RuleRegistry>(),
+        SerializerConfig::createDefault(),
+        defaultReferenceSubjectNameStrategy);
+    SerializationContext ser_ctx;
+    ser_ctx.topic = "test";
+    ser_ctx.serde_type = SerdeType::Value;
+    ser_ctx.serde_format = SerdeFormat::Protobuf;
+
+    // Alternating message types rebuild the plan of the topic every time,
+    // but their schemas and references are only resolved the first time
+    auto author_bytes = ser.serialize(ser_ctx, author);
+    auto dependency_bytes = ser.serialize(ser_ctx, dependency);
+    int lookups = client->lookups;
+    EXPECT_GT(lookups, 0);
+    EXPECT_EQ(ser.serialize(ser_ctx, author), author_bytes);
+    EXPECT_EQ(ser.serialize(ser_ctx, dependency), dependency_bytes);
+    EXPECT_EQ(client->lookups, lookups);
+
+    // Other subjects look the schema up again
+    ser_ctx.topic = "other";
+    auto other_bytes = ser.serialize(ser_ctx, author);
+    EXPECT_EQ(client->lookups, lookups + 1);
+    EXPECT_EQ(std::vector<uint8_t>(other_bytes.begin() + 5, other_bytes.end()),
+              std::vector<uint8_t>(author_bytes.begin() + 5,
+                                   author_bytes.end()));
+
+    // Closing the serializer drops the cached schemas
+    ser.close();
+    lookups = client->lookups;
+    EXPECT_EQ(ser.serialize(ser_ctx, author), other_bytes);
+    EXPECT_GT(client->lookups, lookups);
+}
+
+TEST(ProtobufTest, SerializerFollowsLatestVersion) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    for (auto strategy :
+         {SubjectNameStrategyType::Topic, SubjectNameStrategyType::Record}) {
+        SCOPED_TRACE(static_cast<int>(strategy));
+        auto client = std::make_shared<MockSchemaRegistryClient>(client_config);
+        bool by_topic = strategy == SubjectNameStrategyType::Topic;
+        std::string subject = by_topic ? "test-value" : "test.Reading";
+        auto v1 = client->registerSchema(subject, readingSchema("total"));
+
+        auto ser_config = SerializerConfig::createDefault();
+        ser_config.auto_register_schemas = false;
+        ser_config.use_schema = SchemaSelector::useLatestVersion();
+        ser_config.subject_name_strategy_type = strategy;
+        std::optional<Schema> schema;
+        if (!by_topic) {
+            schema = readingSchema("total");
+        }
+        auto executor = std::make_shared<SubjectRecordingExecutor>();
+        auto rule_registry = std::make_shared<RuleRegistry>();
+        rule_registry->registerExecutor(executor);
+        ProtobufSerializer<test::Reading> ser(client, schema, rule_registry,
+                                              ser_config);
+        SerializationContext ser_ctx;
+        ser_ctx.topic = "test";
+        ser_ctx.serde_type = SerdeType::Value;
+        ser_ctx.serde_format = SerdeFormat::Protobuf;
+
+        auto schemaIdOf = [](const std::vector<uint8_t> &bytes) {
+            SchemaId schema_id(SerdeFormat::Protobuf);
+            schema_id.readFromBytes(bytes);
+            return schema_id.getId();
+        };
+        auto reading = sampleReading();
+        EXPECT_EQ(schemaIdOf(ser.serialize(ser_ctx, reading)), v1.getId());
+
+        // A new latest version replaces the cached plan, which its subject
+        // outlives, as the rules of the new version run for it
+        Rule rule;
+        rule.setName(std::make_optional<std::string>("record-subject"));
+        rule.setKind(std::make_optional<Kind>(Kind::Transform));
+        rule.setMode(std::make_optional<Mode>(Mode::Write));
+        rule.setType(std::make_optional<std::string>("RECORD_SUBJECT"));
+        RuleSet rule_set;
+        rule_set.setDomainRules(std::vector<Rule>{rule});
+        Schema v2_schema = readingSchema("count");
+        v2_schema.setRuleSet(rule_set);
+        auto v2 = client->registerSchema(subject, v2_schema);
+        ASSERT_NE(v2.getId(), v1.getId());
+        EXPECT_EQ(schemaIdOf(ser.serialize(ser_ctx, reading)), v2.getId());
+        EXPECT_EQ(schemaIdOf(ser.serialize(ser_ctx, reading)), v2.getId());
+        EXPECT_EQ(executor->subjects,
+                  std::vector<std::string>({subject, subject}));
+    }
+}
+
+TEST(ProtobufTest, DecodePlansAreCached) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = std::make_shared<MockSchemaRegistryClient>(client_config);
+    Schema v1 = pizzaSchema({"size"});
+    Schema v2 = pizzaSchema({"size", "toppings"});
+
+    ProtobufSerde serde;
+    auto plan = serde.getDecodePlan(v1, {0}, v1, client);
+    ASSERT_NE(plan->writer_prototype, nullptr);
+    EXPECT_EQ(plan->writer_prototype->GetDescriptor(), plan->writer_descriptor);
+    EXPECT_EQ(plan->reader_descriptor, plan->writer_descriptor);
+    EXPECT_EQ(plan->reader_prototype, plan->writer_prototype);
+    EXPECT_EQ(serde.getDecodePlan(v1, {0}, v1, client).get(), plan.get());
+
+    // Another reader schema resolves the type of the same name in it
+    auto evolved = serde.getDecodePlan(v1, {0}, v2, client);
+    EXPECT_NE(evolved.get(), plan.get());
+    EXPECT_EQ(evolved->writer_descriptor, plan->writer_descriptor);
+    EXPECT_EQ(evolved->reader_descriptor->full_name(), "test.Pizza");
+    EXPECT_EQ(evolved->reader_descriptor->field_count(), 2);
+    EXPECT_EQ(evolved->reader_prototype->GetDescriptor(),
+              evolved->reader_descriptor);
+
+    // Message indexes outside the writer schema are rejected
+    EXPECT_THROW(serde.getDecodePlan(v1, {1}, v1, client), ProtobufError);
+}
+
+TEST(ProtobufTest, DependencyPoolsAreShared) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = std::make_shared<MockSchemaRegistryClient>(client_config);
+    client->registerSchema("pizza", pizzaSchema({"size"}), false);
+
+    // Schemas with the same references share the pool of referenced files
+    ProtobufSerde serde;
+    ProtobufSerde other_serde;
+    auto [order_file, order_pool] =
+        serde.getParsedSchema(orderSchema("pizza"), client);
+    auto [other_file, other_pool] =
+        other_serde.getParsedSchema(orderSchema("favorite"), client);
+    ASSERT_NE(order_pool, other_pool);
+    const auto *pizza_file = order_pool->FindFileByName("pizza.proto");
+    ASSERT_NE(pizza_file, nullptr);
+    EXPECT_EQ(other_pool->FindFileByName("pizza.proto"), pizza_file);
+    EXPECT_EQ(order_file->message_type(0)->field(0)->message_type(),
+              pizza_file->message_type(0));
+
+    // All schemas share the well-known types, but only those referencing
+    // them see the referenced files
+    auto [plain_file, plain_pool] =
+        serde.getParsedSchema(pizzaSchema({"size", "toppings"}), client);
+    ASSERT_NE(plain_file, nullptr);
+    EXPECT_EQ(plain_pool->FindFileByName("pizza.proto"), nullptr);
+    const auto *timestamp =
+        plain_pool->FindFileByName("google/protobuf/timestamp.proto");
+    ASSERT_NE(timestamp, nullptr);
+    EXPECT_EQ(order_pool->FindFileByName("google/protobuf/timestamp.proto"),
+              timestamp);
+}
+
+TEST(ProtobufTest, WireCompatibility) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = std::make_shared<MockSchemaRegistryClient>(client_config);
+    Schema v1 = pizzaSchema({"size"});
+    Schema v2 = pizzaSchema({"size", "toppings"});
+
+    ProtobufSerde serde;
+    ProtobufSerde other_serde;
+    const auto *pizza = serde.getDecodePlan(v1, {0}, v1, client)
+                            ->reader_descriptor;
+    const auto *same_pizza = other_serde.getDecodePlan(v1, {0}, v1, client)
+                                 ->reader_descriptor;
+    const auto *evolved_pizza = serde.getDecodePlan(v2, {0}, v2, client)
+                                    ->reader_descriptor;
+
+    // Descriptors of the same schema in other pools are compatible
+    ASSERT_NE(pizza, same_pizza);
+    EXPECT_TRUE(utils::isWireCompatible(pizza, same_pizza));
+    EXPECT_TRUE(serde.isWireCompatible(pizza, same_pizza));
+    EXPECT_FALSE(utils::isWireCompatible(pizza, evolved_pizza));
+    EXPECT_FALSE(utils::isWireCompatible(pizza, test::Author::descriptor()));
+
+    // The same fields declared in another order, e.g. after normalization,
+    // are not, as field visit plans address fields by declaration index
+    auto reordered_file = pizzaFile({"size", "toppings"});
+    auto *reordered_fields =
+        reordered_file.mutable_message_type(0)->mutable_field();
+    reordered_fields->SwapElements(0, 1);
+    google::protobuf::DescriptorPool pool;
+    Schema reordered;
+    reordered.setSchemaType("PROTOBUF");
+    reordered.setSchema(utils::schemaToString(pool.BuildFile(reordered_file)));
+    const auto *reordered_pizza =
+        serde.getDecodePlan(reordered, {0}, reordered, client)
+            ->reader_descriptor;
+    EXPECT_EQ(reordered_pizza->field(0)->name(), "toppings");
+    EXPECT_EQ(reordered_pizza->FindFieldByName("toppings")->number(), 2);
+    EXPECT_FALSE(utils::isWireCompatible(evolved_pizza, reordered_pizza));
+    EXPECT_FALSE(utils::isWireCompatible(reordered_pizza, evolved_pizza));
+}
+
+TEST(ProtobufTest, DeserializeOnArena) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = std::make_shared<MockSchemaRegistryClient>(client_config);
+    auto rule_registry = std::make_shared<RuleRegistry>();
+
+    test::Author obj;
+    obj.set_name("Kafka");
+    obj.set_id(123);
+    obj.add_works("Metamorphosis");
+    obj.set_oneof_string("oneof");
+
+    ProtobufSerializer<test::Author> ser(client, std::nullopt, rule_registry,
+                                         SerializerConfig::createDefault(),
+                                         defaultReferenceSubjectNameStrategy);
+    SerializationContext ser_ctx;
+    ser_ctx.topic = "test";
+    ser_ctx.serde_type = SerdeType::Value;
+    ser_ctx.serde_format = SerdeFormat::Protobuf;
+    auto bytes = ser.serialize(ser_ctx, obj);
+
+    ProtobufDeserializer<test::Author> deser(
+        client, rule_registry, DeserializerConfig::createDefault());
+    google::protobuf::Arena arena;
+    test::Author *obj2 =
+        deser.deserialize(ser_ctx, bytes.data(), bytes.size(), &arena);
+    ASSERT_NE(obj2, nullptr);
+    EXPECT_GT(arena.SpaceUsed(), 0u);
+    EXPECT_EQ(obj2->name(), obj.name());
+    EXPECT_EQ(obj2->id(), obj.id());
+    ASSERT_EQ(obj2->works_size(), 1);
+    EXPECT_EQ(obj2->works(0), obj.works(0));
+    EXPECT_EQ(obj2->oneof_string(), obj.oneof_string());
+}
+
+TEST(ProtobufTest, JsonConversion) {
+    test::TestMessage msg;
+    msg.set_test_string("hi");
+    msg.set_test_bool(true);
+    msg.set_test_bytes(std::string({0, 1, 2, '\xff'}));
+    msg.set_test_double(1.5);
+    msg.set_test_float(3.45f);
+    msg.set_test_int32(-7);
+    msg.set_test_int64(-9007199254740993LL);
+    msg.set_test_uint64(18446744073709551615ULL);
+    msg.set_test_fixed64(12);
+
+    auto json = utils::messageToJson(msg);
+    std::string expected;
+    ASSERT_TRUE(google::protobuf::util::MessageToJsonString(msg, &expected)
+                    .ok());
+    EXPECT_EQ(json, nlohmann::json::parse(expected));
+    EXPECT_EQ(json["testInt64"], "-9007199254740993");
+    EXPECT_EQ(json["testBytes"], "AAEC/w==");
+
+    test::TestMessage msg2;
+    utils::jsonToMessage(json, &msg2);
+    EXPECT_EQ(msg2.SerializeAsString(), msg.SerializeAsString());
+
+    // Original field names, numbers for 64-bit integers and URL-safe base64
+    test::TestMessage msg3;
+    utils::jsonToMessage({{"test_int64", 42},
+                          {"testUint32", "7"},
+                          {"testBytes", "AAEC_w"},
+                          {"testString", nullptr}},
+                         &msg3);
+    EXPECT_EQ(msg3.test_int64(), 42);
+    EXPECT_EQ(msg3.test_uint32(), 7u);
+    EXPECT_EQ(msg3.test_bytes(), msg.test_bytes());
+    EXPECT_THROW(utils::jsonToMessage({{"unknown", 1}}, &msg3),
+                 ProtobufError);
+    // An extension of another message
+    EXPECT_THROW(utils::jsonToMessage(
+                     {{"[confluent.field_meta]", {{"tags", {"PII"}}}}}, &msg3),
+                 ProtobufError);
+    EXPECT_THROW(utils::jsonToMessage({{"testInt32", 4294967296LL}}, &msg3),
+                 ProtobufError);
+
+    test::Author author;
+    author.set_id(1);
+    author.add_works("Metamorphosis");
+    author.mutable_oneof_message()->set_size("Large");
+    auto author_json = utils::messageToJson(author);
+    EXPECT_EQ(author_json["works"], nlohmann::json::array({"Metamorphosis"}));
+    EXPECT_EQ(author_json["oneofMessage"]["size"], "Large");
+    test::Author author2;
+    utils::jsonToMessage(author_json, &author2);
+    EXPECT_EQ(author2.SerializeAsString(), author.SerializeAsString());
+
+    google::protobuf::Timestamp timestamp;
+    timestamp.set_seconds(1);
+    timestamp.set_nanos(500000000);
+    EXPECT_EQ(utils::messageToJson(timestamp), "1970-01-01T00:00:01.500Z");
+    google::protobuf::Timestamp timestamp2;
+    utils::jsonToMessage("1970-01-01T00:00:01.500Z", &timestamp2);
+    EXPECT_EQ(timestamp2.SerializeAsString(), timestamp.SerializeAsString());
+
+    google::protobuf::Struct value;
+    auto struct_json =
+        nlohmann::json{{"a", 1.5}, {"b", {true, nullptr}}, {"c", "x"}};
+    utils::jsonToMessage(struct_json, &value);
+    EXPECT_EQ(utils::messageToJson(value), struct_json);
+}
+
+TEST(ProtobufTest, JsonConversionOfDynamicMessages) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = std::make_shared<MockSchemaRegistryClient>(client_config);
+    auto reading = sampleReading();
+
+    // Messages of the schema's own pool, as decoded for migrations
+    ProtobufSerde serde;
+    auto [file, pool] = serde.getParsedSchema(readingSchema("total"), client);
+    ASSERT_NE(file, nullptr);
+    const auto *descriptor = file->FindMessageTypeByName("Reading");
+    ASSERT_NE(descriptor, nullptr);
+    EXPECT_NE(descriptor, test::Reading::descriptor());
+    google::protobuf::DynamicMessageFactory factory;
+    const auto *prototype = factory.GetPrototype(descriptor);
+    std::unique_ptr<google::protobuf::Message> msg(prototype->New());
+    ASSERT_TRUE(msg->ParseFromString(reading.SerializeAsString()));
+
+    auto json = utils::messageToJson(*msg);
+    std::string expected;
+    ASSERT_TRUE(google::protobuf::util::MessageToJsonString(*msg, &expected)
+                    .ok());
+    EXPECT_EQ(json, nlohmann::json::parse(expected));
+    EXPECT_EQ(json["level"], "HIGH");
+    EXPECT_EQ(json["history"], nlohmann::json::array({"LOW", "HIGH", 7}));
+    EXPECT_EQ(json["labels"]["-5"], "negative");
+    EXPECT_EQ(json["labels"]["1099511627776"], "large");
+    EXPECT_EQ(json["flags"]["true"], 1);
+    EXPECT_EQ(json["flags"]["false"], 0);
+    EXPECT_EQ(json["limit"], "9007199254740993");
+    EXPECT_EQ(json["note"], "");
+    EXPECT_EQ(json["elapsed"], "90.500s");
+    EXPECT_EQ(json["mask"], "a.bC,d");
+
+    std::unique_ptr<google::protobuf::Message> back(prototype->New());
+    utils::jsonToMessage(json, back.get());
+    EXPECT_TRUE(
+        google::protobuf::util::MessageDifferencer::Equals(*back, *msg));
+
+    // Enums by number, wrappers from bare values and negative durations
+    std::unique_ptr<google::protobuf::Message> other(prototype->New());
+    utils::jsonToMessage({{"level", 1},
+                          {"history", {2, "LOW"}},
+                          {"labels", {{"7", "seven"}}},
+                          {"flags", {{"false", 3}}},
+                          {"limit", 5},
+                          {"elapsed", "-1.5s"}},
+                         other.get());
+    test::Reading parsed;
+    ASSERT_TRUE(parsed.ParseFromString(other->SerializeAsString()));
+    EXPECT_EQ(parsed.level(), test::LOW);
+    ASSERT_EQ(parsed.history_size(), 2);
+    EXPECT_EQ(parsed.history(0), test::HIGH);
+    EXPECT_EQ(parsed.history(1), test::LOW);
+    EXPECT_EQ(parsed.labels().at(7), "seven");
+    EXPECT_EQ(parsed.flags().at(false), 3);
+    EXPECT_EQ(parsed.limit().value(), 5);
+    EXPECT_EQ(parsed.elapsed().seconds(), -1);
+    EXPECT_EQ(parsed.elapsed().nanos(), -500000000);
+
+    EXPECT_THROW(utils::jsonToMessage({{"level", "MEDIUM"}}, other.get()),
+                 ProtobufError);
+    EXPECT_THROW(utils::jsonToMessage({{"flags", {{"yes", 1}}}}, other.get()),
+                 ProtobufError);
+    EXPECT_THROW(utils::jsonToMessage({{"elapsed", 5}}, other.get()),
+                 ProtobufError);
+}
+
+#ifdef SCHEMAREGISTRY_USE_RULES
+TEST(ProtobufTest, JsonataMigration) {
+    std::vector<std::string> urls = {"mock://"};
+    auto client_config = std::make_shared<const ClientConfiguration>(urls);
+    auto client = SchemaRegistryClient::newClient(client_config);
+    ServerConfig server_config;
+    server_config.setCompatibilityGroup(
+        std::make_optional<std::string>("application.version"));
+    client->updateConfig("test-value", server_config);
+
+    Metadata v1_metadata;
+    v1_metadata.setProperties(std::map<std::string, std::string>{
+        {"application.version", "v1"}});
+    Schema v1 = readingSchema("count");
+    v1.setMetadata(v1_metadata);
+    client->registerSchema("test-value", v1, false);
+
+    // The upgrade renames count to total and upper-cases the name
+    Rule rule;
+    rule.setName(std::make_optional<std::string>("test-jsonata"));
+    rule.setKind(std::make_optional<Kind>(Kind::Transform));
+    rule.setMode(std::make_optional<Mode>(Mode::Upgrade));
+    rule.setType(std::make_optional<std::string>("JSONATA"));
+    rule.setExpr(std::make_optional<std::string>(
+        "$merge([$sift($, function($v, $k) {$k != 'count'}), "
+        "{'total': $.'count', 'name': $uppercase($.'name')}])"));
+    RuleSet rule_set;
+    rule_set.setMigrationRules(std::vector<Rule>{rule});
+    Metadata v2_metadata;
+    v2_metadata.setProperties(std::map<std::string, std::string>{
+        {"application.version", "v2"}});
+    Schema v2 = readingSchema("total");
+    v2.setMetadata(v2_metadata);
+    v2.setRuleSet(rule_set);
+    client->registerSchema("test-value", v2, false);
+
+    auto rule_registry = std::make_shared<RuleRegistry>();
+    rule_registry->registerExecutor(std::make_shared<JsonataExecutor>());
+    std::unordered_map<std::string, std::string> v1_selector = {
+        {"application.version", "v1"}};
+    std::unordered_map<std::string, std::string> v2_selector = {
+        {"application.version", "v2"}};
+    SerializerConfig ser_config(
+        false,
+        std::make_optional(SchemaSelector::useLatestWithMetadata(v1_selector)),
+        false, false, {});
+    DeserializerConfig deser_config(
+        std::make_optional(SchemaSelector::useLatestWithMetadata(v2_selector)),
+        false, {});
+    ProtobufSerializer<test::Reading> ser(client, std::nullopt, rule_registry,
+                                          ser_config,
+                                          defaultReferenceSubjectNameStrategy);
+    ProtobufDeserializer<test::Reading> deser(client, rule_registry,
+                                              deser_config);
+
+    SerializationContext ser_ctx;
+    ser_ctx.topic = "test";
+    ser_ctx.serde_type = SerdeType::Value;
+    ser_ctx.serde_format = SerdeFormat::Protobuf;
+    auto reading = sampleReading();
+    auto bytes = ser.serialize(ser_ctx, reading);
+    auto migrated = deser.deserialize(ser_ctx, bytes);
+    ASSERT_NE(migrated, nullptr);
+
+    // Every field survives the round trip through JSON
+    reading.set_name("PROBE");
+    EXPECT_TRUE(
+        google::protobuf::util::MessageDifferencer::Equals(*migrated, reading))
+        << migrated->DebugString();
+}
+#endif
+
 TEST(ProtobufTest, GuidInHeader) {
     // Create client configuration with mock URL
     std::vector<std::string> urls = {"mock://"};
@@ -0,0 +1,94 @@
+/**
+ * RevalidatingCacheTest
+ * Tests for stale-while-revalidate caching of latest versions
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "schemaregistry/rest/RevalidatingCache.h"
+
+using namespace schemaregistry::rest;
+
+TEST(RevalidatingCacheTest, WithoutStaleTtlBehavesAsTtlCache) {
+    RevalidatingCache<std::string, int> cache(10, std::chrono::seconds(1),
+                                              std::chrono::seconds(0));
+    EXPECT_FALSE(cache.revalidating());
+    EXPECT_FALSE(cache.get("a").value.has_value());
+
+    cache.put("a", 1);
+    auto hit = cache.get("a");
+    EXPECT_EQ(hit.value, 1);
+    EXPECT_FALSE(hit.stale);
+    EXPECT_FALSE(hit.refresh);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_FALSE(cache.get("a").value.has_value());
+}
+
+TEST(RevalidatingCacheTest, StaleValueIsServedAndRefreshedOnce) {
+    RevalidatingCache<std::string, int> cache(10, std::chrono::seconds(1),
+                                              std::chrono::seconds(2));
+    EXPECT_TRUE(cache.revalidating());
+    cache.put("a", 1);
+    EXPECT_FALSE(cache.get("a").stale);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+    // Concurrent readers all get the stale value, one of them refreshes it
+    std::atomic<int> refreshes{0};
+    std::atomic<int> served{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 8; ++t) {
+        readers.emplace_back([&]() {
+            for (int i = 0; i < 100; ++i) {
+                auto lookup = cache.get("a");
+                if (lookup.value == 1 && lookup.stale) {
+                    served++;
+                }
+                if (lookup.refresh) {
+                    refreshes++;
+                }
+            }
+        });
+    }
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(served.load(), 800);
+    EXPECT_EQ(refreshes.load(), 1);
+
+    // The refreshed value is fresh again
+    cache.put("a", 2);
+    auto refreshed = cache.get("a");
+    EXPECT_EQ(refreshed.value, 2);
+    EXPECT_FALSE(refreshed.stale);
+    EXPECT_FALSE(refreshed.refresh);
+}
+
+TEST(RevalidatingCacheTest, FailedRefreshIsRetriedUntilHardExpiry) {
+    RevalidatingCache<std::string, int> cache(10, std::chrono::seconds(1),
+                                              std::chrono::seconds(2));
+    cache.put("a", 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+    EXPECT_TRUE(cache.get("a").refresh);
+    EXPECT_FALSE(cache.get("a").refresh);
+
+    // No value was put back, so the refresh is claimed again later
+    std::this_thread::sleep_for(RevalidatingCache<std::string, int>::
+                                    kRefreshRetryInterval +
+                                std::chrono::milliseconds(100));
+    auto retry = cache.get("a");
+    EXPECT_EQ(retry.value, 1);
+    EXPECT_TRUE(retry.refresh);
+
+    // Past ttl + stale_ttl the value is no longer served
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    EXPECT_FALSE(cache.get("a").value.has_value());
+}
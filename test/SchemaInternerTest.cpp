@@ -0,0 +1,99 @@
+/**
+ * SchemaInternerTest
+ * Tests for shared schema bodies across the interner, models and store
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "schemaregistry/rest/SchemaInterner.h"
+#include "schemaregistry/rest/SchemaStore.h"
+
+using namespace schemaregistry::rest;
+using schemaregistry::rest::model::RegisteredSchema;
+using schemaregistry::rest::model::Schema;
+
+namespace {
+
+Schema makeSchema(const std::string &name) {
+    Schema schema;
+    schema.setSchemaType("AVRO");
+    schema.setSchema(R"({"type": "record", "name": ")" + name +
+                     R"(", "fields": []})");
+    return schema;
+}
+
+}  // namespace
+
+TEST(SchemaInternerTest, EqualSchemasShareOneInstance) {
+    SchemaInterner interner;
+    auto a = interner.intern(makeSchema("A"));
+    auto b = interner.intern(makeSchema("A"));
+    auto c = interner.intern(makeSchema("C"));
+
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_NE(a.get(), c.get());
+    EXPECT_EQ(*a, makeSchema("A"));
+
+    // Adopting an existing handle returns the interned one
+    auto adopted = interner.intern(std::make_shared<const Schema>(
+        makeSchema("A")));
+    EXPECT_EQ(adopted.get(), a.get());
+}
+
+TEST(SchemaInternerTest, DeadEntriesArePurged) {
+    SchemaInterner interner;
+    for (int i = 0; i < 1000; ++i) {
+        interner.intern(makeSchema("R" + std::to_string(i)));
+    }
+    // Nothing holds the schemas, so the table stays bounded
+    EXPECT_LT(interner.size(), 200u);
+
+    auto held = interner.intern(makeSchema("held"));
+    for (int i = 0; i < 1000; ++i) {
+        interner.intern(makeSchema("S" + std::to_string(i)));
+    }
+    EXPECT_EQ(interner.intern(makeSchema("held")).get(), held.get());
+}
+
+TEST(SchemaInternerTest, RegisteredSchemaCopiesShareBody) {
+    RegisteredSchema rs(1, std::string("guid"), std::string("subject"), 1,
+                        makeSchema("A"));
+    RegisteredSchema copy = rs;
+    EXPECT_EQ(copy.getSchemaHandle().get(), rs.getSchemaHandle().get());
+
+    // Setters replace the body of the modified copy only
+    copy.setSchemaType("JSON");
+    EXPECT_NE(copy.getSchemaHandle().get(), rs.getSchemaHandle().get());
+    EXPECT_EQ(rs.getSchemaType(), std::optional<std::string>("AVRO"));
+    EXPECT_EQ(copy.getSchemaType(), std::optional<std::string>("JSON"));
+    EXPECT_EQ(copy.getSchema(), rs.getSchema());
+
+    // JSON round trip keeps all members
+    nlohmann::json j;
+    to_json(j, rs);
+    RegisteredSchema parsed;
+    from_json(j, parsed);
+    EXPECT_EQ(parsed, rs);
+}
+
+TEST(SchemaInternerTest, StoreSharesBodiesAcrossSubjects) {
+    SchemaStore store;
+    Schema schema = makeSchema("Shared");
+    store.setRegisteredSchema(
+        schema, RegisteredSchema(1, std::nullopt, std::string("a"), 1, schema));
+    store.setRegisteredSchema(
+        schema, RegisteredSchema(1, std::nullopt, std::string("b"), 3, schema));
+
+    auto a = store.getSchemaHandleById("a", 1);
+    auto b = store.getSchemaHandleById("b", 1);
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(a->second.get(), b->second.get());
+
+    auto rs = store.getRegisteredByVersion("b", 3);
+    ASSERT_TRUE(rs.has_value());
+    EXPECT_EQ(rs->getSchemaHandle().get(), a->second.get());
+}
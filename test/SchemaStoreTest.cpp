@@ -0,0 +1,173 @@
+/**
+ * SchemaStoreTest
+ * Tests for the snapshot-based schema store
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "schemaregistry/rest/SchemaStore.h"
+
+using namespace schemaregistry::rest;
+using schemaregistry::rest::model::RegisteredSchema;
+using schemaregistry::rest::model::Schema;
+
+namespace {
+
+Schema makeSchema(int i) {
+    Schema schema;
+    schema.setSchemaType("AVRO");
+    schema.setSchema(R"({"type": "record", "name": "R)" + std::to_string(i) +
+                     R"(", "fields": []})");
+    return schema;
+}
+
+}  // namespace
+
+TEST(SchemaStoreTest, SetAndGet) {
+    SchemaStore store;
+    Schema schema = makeSchema(1);
+    RegisteredSchema rs(1, std::string("guid-1"), std::string("subject"), 1,
+                        schema);
+    store.setRegisteredSchema(schema, rs);
+
+    auto byId = store.getSchemaById("subject", 1);
+    ASSERT_TRUE(byId.has_value());
+    EXPECT_EQ(byId->second.getSchema(), schema.getSchema());
+
+    auto byVersion = store.getRegisteredByVersion("subject", 1);
+    ASSERT_TRUE(byVersion.has_value());
+    EXPECT_EQ(byVersion->getId(), 1);
+
+    auto bySchema = store.getRegisteredBySchema("subject", schema);
+    ASSERT_TRUE(bySchema.has_value());
+    EXPECT_EQ(bySchema->getVersion(), 1);
+    EXPECT_EQ(store.getIdBySchema("subject", schema), 1);
+
+    EXPECT_FALSE(store.getSchemaById("other", 1).has_value());
+    EXPECT_FALSE(store.getRegisteredByVersion("subject", 2).has_value());
+
+    store.clear();
+    EXPECT_FALSE(store.getSchemaById("subject", 1).has_value());
+}
+
+TEST(SchemaStoreTest, WritesDoNotAffectOtherSubjects) {
+    SchemaStore store;
+    store.setSchema(std::string("a"), 1, std::nullopt, makeSchema(1));
+    store.setSchema(std::string("b"), 2, std::string("guid-2"), makeSchema(2));
+    store.setSchema(std::string("a"), 3, std::nullopt, makeSchema(3));
+
+    EXPECT_TRUE(store.getSchemaById("a", 1).has_value());
+    EXPECT_TRUE(store.getSchemaById("a", 3).has_value());
+    EXPECT_TRUE(store.getSchemaById("b", 2).has_value());
+    EXPECT_FALSE(store.getSchemaById("b", 1).has_value());
+    EXPECT_TRUE(store.getSchemaByGuid("guid-2").has_value());
+}
+
+TEST(SchemaStoreTest, FingerprintTracksContent) {
+    Schema a = makeSchema(1);
+    Schema b = makeSchema(1);
+    EXPECT_EQ(a.getFingerprint(), b.getFingerprint());
+    EXPECT_NE(a.getFingerprint(), makeSchema(2).getFingerprint());
+
+    // Copies carry the memoized value, setters invalidate it
+    Schema copy = a;
+    EXPECT_EQ(copy.getFingerprint(), a.getFingerprint());
+    copy.setSchemaType("JSON");
+    EXPECT_NE(copy.getFingerprint(), a.getFingerprint());
+    copy.setSchemaType("AVRO");
+    EXPECT_EQ(copy.getFingerprint(), a.getFingerprint());
+
+    // Absent and empty fields are distinct
+    Schema empty;
+    Schema emptyType;
+    emptyType.setSchemaType(std::string(""));
+    EXPECT_NE(empty.getFingerprint(), emptyType.getFingerprint());
+
+    // Fields cannot run into each other
+    Schema split1;
+    split1.setSchemaType(std::string("AV"));
+    split1.setSchema(std::string("RO"));
+    Schema split2;
+    split2.setSchemaType(std::string("AVR"));
+    split2.setSchema(std::string("O"));
+    EXPECT_NE(split1.getFingerprint(), split2.getFingerprint());
+}
+
+TEST(SchemaStoreTest, LookupBySchemaUsesContent) {
+    SchemaStore store;
+    store.setSchema(std::string("subject"), 7, std::nullopt, makeSchema(1));
+
+    // A separately built but equal schema finds the same entry
+    auto id = store.getIdBySchema("subject", makeSchema(1));
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(*id, 7);
+    EXPECT_FALSE(store.getIdBySchema("subject", makeSchema(2)).has_value());
+}
+
+TEST(SchemaStoreTest, ReadsSeeWritesOfEachStore) {
+    // More stores than a thread caches snapshots for, so that they share
+    // cache slots, including stores allocated where others were destroyed
+    for (int round = 0; round < 2; ++round) {
+        std::vector<std::unique_ptr<SchemaStore>> stores;
+        for (int i = 0; i < 20; ++i) {
+            stores.push_back(std::make_unique<SchemaStore>());
+            EXPECT_FALSE(stores[i]->getSchemaById("subject", 1).has_value());
+            stores[i]->setSchema(std::string("subject"), 1, std::nullopt,
+                                 makeSchema(i));
+        }
+        for (int i = 0; i < 20; ++i) {
+            auto result = stores[i]->getSchemaById("subject", 1);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->second.getSchema(), makeSchema(i).getSchema());
+
+            stores[i]->setSchema(std::string("subject"), 2, std::nullopt,
+                                 makeSchema(i));
+            EXPECT_TRUE(stores[i]->getSchemaById("subject", 2).has_value());
+            stores[i]->clear();
+            EXPECT_FALSE(stores[i]->getSchemaById("subject", 1).has_value());
+        }
+    }
+}
+
+TEST(SchemaStoreTest, ConcurrentReadsAndWrites) {
+    SchemaStore store;
+    const int schemas = 200;
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                for (int i = 1; i <= schemas; ++i) {
+                    auto result = store.getSchemaById("subject", i);
+                    if (result.has_value() &&
+                        result->second.getSchema() !=
+                            makeSchema(i).getSchema()) {
+                        inconsistent++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= schemas; ++i) {
+        store.setSchema(std::string("subject"), i, std::nullopt,
+                        makeSchema(i));
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(inconsistent.load(), 0);
+    for (int i = 1; i <= schemas; ++i) {
+        EXPECT_TRUE(store.getSchemaById("subject", i).has_value());
+    }
+}
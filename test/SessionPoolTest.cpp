@@ -0,0 +1,124 @@
+/**
+ * SessionPoolTest
+ * Tests for the HTTP session pool used by RestClient
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "schemaregistry/rest/RestClient.h"
+#include "schemaregistry/rest/SessionPool.h"
+
+using namespace schemaregistry::rest;
+
+TEST(SessionPoolTest, ReusesSessionForSameBaseUrl) {
+    SessionPool pool(4, std::chrono::seconds(60));
+
+    std::shared_ptr<cpr::Session> first;
+    {
+        auto lease = pool.acquire("http://a");
+        first = lease.get();
+    }
+    EXPECT_EQ(pool.size(), 1);
+    EXPECT_EQ(pool.idleCount(), 1);
+
+    auto lease = pool.acquire("http://a");
+    EXPECT_EQ(lease.get(), first);
+    EXPECT_EQ(pool.idleCount(), 0);
+}
+
+TEST(SessionPoolTest, SeparatesSessionsByBaseUrl) {
+    SessionPool pool(4, std::chrono::seconds(60));
+
+    std::shared_ptr<cpr::Session> first;
+    {
+        auto lease = pool.acquire("http://a");
+        first = lease.get();
+    }
+
+    auto lease = pool.acquire("http://b");
+    EXPECT_NE(lease.get(), first);
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_EQ(pool.idleCount(), 1);
+}
+
+TEST(SessionPoolTest, EvictsIdleSessionOfOtherBaseUrlWhenFull) {
+    SessionPool pool(1, std::chrono::seconds(60));
+
+    { auto lease = pool.acquire("http://a"); }
+    EXPECT_EQ(pool.idleCount(), 1);
+
+    auto lease = pool.acquire("http://b");
+    EXPECT_EQ(pool.size(), 1);
+    EXPECT_EQ(pool.idleCount(), 0);
+}
+
+TEST(SessionPoolTest, DropsExpiredIdleSessions) {
+    SessionPool pool(4, std::chrono::seconds(0));
+
+    std::shared_ptr<cpr::Session> first;
+    {
+        auto lease = pool.acquire("http://a");
+        first = lease.get();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    auto lease = pool.acquire("http://a");
+    EXPECT_NE(lease.get(), first);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST(SessionPoolTest, DiscardedSessionIsNotReused) {
+    SessionPool pool(1, std::chrono::seconds(60));
+
+    std::shared_ptr<cpr::Session> first;
+    {
+        auto lease = pool.acquire("http://a");
+        first = lease.get();
+        lease.discard();
+    }
+    EXPECT_EQ(pool.size(), 0);
+
+    auto lease = pool.acquire("http://a");
+    EXPECT_NE(lease.get(), first);
+}
+
+TEST(SessionPoolTest, BoundsConcurrentSessions) {
+    const size_t max_sessions = 3;
+    SessionPool pool(max_sessions, std::chrono::seconds(60));
+
+    std::atomic<int> in_use{0};
+    std::atomic<int> max_in_use{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 20; ++j) {
+                auto lease = pool.acquire("http://a");
+                int current = ++in_use;
+                int prev = max_in_use.load();
+                while (current > prev &&
+                       !max_in_use.compare_exchange_weak(prev, current)) {
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                --in_use;
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    EXPECT_LE(max_in_use.load(), static_cast<int>(max_sessions));
+    EXPECT_LE(pool.size(), max_sessions);
+    EXPECT_EQ(pool.idleCount(), pool.size());
+}
+
+TEST(SessionPoolTest, RestClientWithoutConfiguration) {
+    // The session pool falls back to the default configuration
+    RestClient client;
+    EXPECT_EQ(client.getConfiguration(), nullptr);
+}
@@ -0,0 +1,129 @@
+/**
+ * SingleFlightTest
+ * Tests for coalescing of concurrent calls sharing a key
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "schemaregistry/rest/SingleFlight.h"
+
+using namespace schemaregistry::rest;
+
+TEST(SingleFlightTest, CoalescesConcurrentCalls) {
+    SingleFlight<std::string, int> flights;
+    std::atomic<int> calls{0};
+
+    std::vector<std::thread> threads;
+    std::vector<int> results(16, 0);
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            results[i] = flights.run("key", [&]() {
+                calls++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                return 42;
+            });
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(calls.load(), 1);
+    for (int result : results) {
+        EXPECT_EQ(result, 42);
+    }
+    EXPECT_EQ(flights.size(), 0);
+}
+
+TEST(SingleFlightTest, DistinctKeysRunIndependently) {
+    SingleFlight<std::string, std::string> flights;
+
+    EXPECT_EQ(flights.run("a", []() { return std::string("A"); }), "A");
+    EXPECT_EQ(flights.run("b", []() { return std::string("B"); }), "B");
+    // Completed calls are not cached
+    EXPECT_EQ(flights.run("a", []() { return std::string("C"); }), "C");
+}
+
+TEST(SingleFlightTest, PropagatesExceptionToFollowers) {
+    SingleFlight<std::string, int> flights;
+    std::atomic<int> calls{0};
+    std::atomic<int> failures{0};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&]() {
+            try {
+                flights.run("key", [&]() -> int {
+                    calls++;
+                    std::this_thread::sleep_for(
+                        std::chrono::milliseconds(100));
+                    throw std::runtime_error("not found");
+                });
+            } catch (const std::runtime_error &) {
+                failures++;
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(failures.load(), 8);
+
+    // The failed call is forgotten, so the next call runs again
+    EXPECT_EQ(flights.run("key", []() { return 1; }), 1);
+}
+
+TEST(SingleFlightTest, RunAsyncJoinsCallInFlight) {
+    SingleFlight<std::string, int> flights;
+    std::shared_ptr<SingleFlight<std::string, int>::Completion> pending;
+    int calls = 0;
+    auto start = [&](auto completion) {
+        calls++;
+        pending = completion;
+    };
+
+    auto leader = flights.runAsync("key", start);
+    auto follower = flights.runAsync("key", start);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(flights.size(), 1);
+
+    // Completing from another thread releases the leader and followers
+    std::thread([&]() { pending->setValue(42); }).join();
+    EXPECT_EQ(leader.get(), 42);
+    EXPECT_EQ(follower.get(), 42);
+    EXPECT_EQ(flights.size(), 0);
+
+    // The completed call is forgotten, so the next call starts again
+    flights.runAsync("key", start);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(SingleFlightTest, RunAsyncFailsWhenStartThrows) {
+    SingleFlight<std::string, int> flights;
+
+    auto future = flights.runAsync("key", [](auto) {
+        throw std::runtime_error("not sent");
+    });
+    EXPECT_THROW(future.get(), std::runtime_error);
+    EXPECT_EQ(flights.size(), 0);
+}
+
+TEST(SingleFlightTest, RunAsyncForgetsDroppedCompletion) {
+    SingleFlight<std::string, int> flights;
+
+    // The completion is dropped without being completed
+    auto future = flights.runAsync("key", [](auto) {});
+    EXPECT_THROW(future.get(), std::future_error);
+    EXPECT_EQ(flights.size(), 0);
+}
@@ -0,0 +1,182 @@
+/**
+ * TtlLruCacheTest
+ * Tests and microbenchmark for the sharded TTL LRU cache
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "schemaregistry/rest/TtlLruCache.h"
+
+using namespace schemaregistry::rest;
+
+TEST(TtlLruCacheTest, GetAndPut) {
+    TtlLruCache<std::string, int> cache(10);
+    EXPECT_FALSE(cache.get("a").has_value());
+
+    cache.put("a", 1);
+    cache.put("b", 2);
+    EXPECT_EQ(cache.get("a"), 1);
+    EXPECT_EQ(cache.get("b"), 2);
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.put("a", 3);
+    EXPECT_EQ(cache.get("a"), 3);
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.get("a").has_value());
+}
+
+TEST(TtlLruCacheTest, EvictsLeastRecentlyUsed) {
+    TtlLruCache<std::string, int> cache(2);
+    cache.put("a", 1);
+    cache.put("b", 2);
+
+    // Touch "a" so that "b" becomes the least recently used entry
+    EXPECT_TRUE(cache.get("a").has_value());
+    EXPECT_EQ(cache.put("c", 3), 1);
+
+    EXPECT_TRUE(cache.get("a").has_value());
+    EXPECT_FALSE(cache.get("b").has_value());
+    EXPECT_TRUE(cache.get("c").has_value());
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(TtlLruCacheTest, ExpiresEntries) {
+    TtlLruCache<std::string, int> cache(10, std::chrono::seconds(1));
+    cache.put("a", 1);
+    cache.put("b", 2);
+    EXPECT_EQ(cache.get("a"), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_FALSE(cache.get("a").has_value());
+
+    cache.cleanup_expired();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(TtlLruCacheTest, ShardedCapacityIsBounded) {
+    const size_t capacity = 1000;
+    TtlLruCache<int, int> cache(capacity);
+    EXPECT_GT(cache.shard_count(), 1);
+
+    for (int i = 0; i < 10000; ++i) {
+        cache.put(i, i);
+    }
+    EXPECT_EQ(cache.size(), capacity);
+    // The most recent entries survive in every shard
+    EXPECT_EQ(cache.get(9999), 9999);
+}
+
+TEST(TtlLruCacheTest, ShardedCacheHoldsCapacityEntries) {
+    const size_t capacity = 1000;
+    TtlLruCache<int, int> cache(capacity);
+    EXPECT_GT(cache.shard_count(), 1);
+
+    // However keys spread over shards, none is evicted until the cache is
+    // full, and then one per new key
+    for (int i = 0; i < static_cast<int>(capacity); ++i) {
+        EXPECT_EQ(cache.put(i, i), 0);
+    }
+    EXPECT_EQ(cache.size(), capacity);
+    for (int i = 0; i < static_cast<int>(capacity); ++i) {
+        EXPECT_EQ(cache.get(i), i);
+    }
+    EXPECT_EQ(cache.put(-1, -1), 1);
+    EXPECT_EQ(cache.size(), capacity);
+    EXPECT_EQ(cache.get(-1), -1);
+}
+
+TEST(TtlLruCacheTest, ConcurrentPutsKeepCapacity) {
+    const size_t capacity = 1000;
+    TtlLruCache<int, int> cache(capacity);
+    std::atomic<size_t> evicted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache, &evicted, t]() {
+            for (int i = 0; i < 5000; ++i) {
+                evicted += cache.put(t * 5000 + i, i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(cache.size(), capacity);
+    EXPECT_EQ(evicted.load(), 8 * 5000 - capacity);
+}
+
+TEST(TtlLruCacheTest, RejectsZeroCapacity) {
+    EXPECT_THROW((TtlLruCache<int, int>(0)), std::invalid_argument);
+}
+
+namespace {
+
+// Get keys of names from threads at once, returning the number of misses
+int concurrentGets(TtlLruCache<std::string, int> &cache,
+                   const std::vector<std::string> &names, int threads,
+                   int ops_per_thread) {
+    std::atomic<int> misses{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < ops_per_thread; ++i) {
+                if (!cache.get(names[(i * 31 + t) % names.size()])
+                         .has_value()) {
+                    misses++;
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    return misses.load();
+}
+
+std::vector<std::string> putSubjects(TtlLruCache<std::string, int> &cache,
+                                     int keys) {
+    std::vector<std::string> names;
+    for (int i = 0; i < keys; ++i) {
+        names.push_back("subject-" + std::to_string(i));
+        cache.put(names.back(), i);
+    }
+    return names;
+}
+
+}  // namespace
+
+TEST(TtlLruCacheTest, ConcurrentGetsHitEveryKey) {
+    const int keys = 1000;
+    TtlLruCache<std::string, int> cache(keys, std::chrono::seconds(3600));
+    auto names = putSubjects(cache, keys);
+
+    EXPECT_EQ(concurrentGets(cache, names, 8, 10000), 0);
+}
+
+// Run with --gtest_also_run_disabled_tests; timings are recorded as test
+// properties
+TEST(TtlLruCacheTest, DISABLED_ConcurrentGetThroughput) {
+    const int keys = 1000;
+    const int ops_per_thread = 200000;
+    TtlLruCache<std::string, int> cache(keys, std::chrono::seconds(3600));
+    auto names = putSubjects(cache, keys);
+
+    for (int threads : {1, 8, 32}) {
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(concurrentGets(cache, names, threads, ops_per_thread), 0);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        double total_ops = static_cast<double>(threads) * ops_per_thread;
+        RecordProperty("get_" + std::to_string(threads) + "_threads_ns",
+                       std::to_string(elapsed.count() / total_ops));
+    }
+}
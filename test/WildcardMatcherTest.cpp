@@ -4,6 +4,12 @@
  */
 
 #include <gtest/gtest.h>
+
+#include <chrono>
+#include <regex>
+#include <string>
+#include <vector>
+
 #include "schemaregistry/serdes/WildcardMatcher.h"
 
 using namespace schemaregistry::serdes;
@@ -91,4 +97,108 @@ TEST_F(WildcardMatcherTest, RegexEscaping) {
     EXPECT_TRUE(wildcardMatch("foo|bar", "foo\\|bar"));
     EXPECT_TRUE(wildcardMatch("foo^bar", "foo\\^bar"));
     EXPECT_TRUE(wildcardMatch("foo$bar", "foo\\$bar"));
-} 
\ No newline at end of file
+} 
+namespace {
+
+// The previous implementation, compiling a regex on every call
+bool regexWildcardMatch(const std::string &text, const std::string &matcher) {
+    try {
+        std::regex pattern(wildcardToRegexp(matcher, "."));
+        std::smatch match;
+        if (std::regex_search(text, match, pattern)) {
+            return match.position() == 0 &&
+                   static_cast<size_t>(match.length()) == text.length();
+        }
+        return false;
+    } catch (const std::regex_error &e) {
+        return false;
+    }
+}
+
+}  // namespace
+
+TEST_F(WildcardMatcherTest, MatchesRegexTranslation) {
+    std::vector<std::string> patterns = {
+        "",         "*",         "**",        "?",          "a*",
+        "a**",      "a.*",       "a.**",      "**.b",       "**.*",
+        "a**.*c",   "*.b.*",     "a?c",       "a\\*c",      "a\\?c",
+        "a\\.c",    "a\\",       "a[bc]",     "a\\[b\\]",   "a\\\\b",
+        "a[",       "**x*",      "*a*b",      "a+b",        "(a)"};
+    std::vector<std::string> texts = {
+        "",    "a",     "ab",    "abc",   "a.c",  "a*c",    "a?c",
+        "a.b", "a.b.c", "b",     "x.b",   "a\\",  "ab.x.c", "aa.b",
+        "a+b", "(a)",   "a[b]",  "ac",    "a\nb", "a\n.c",  "a.b.b"};
+
+    for (const auto &pattern : patterns) {
+        for (const auto &text : texts) {
+            EXPECT_EQ(wildcardMatch(text, pattern),
+                      regexWildcardMatch(text, pattern))
+                << "text '" << text << "', pattern '" << pattern << "'";
+        }
+    }
+}
+
+TEST_F(WildcardMatcherTest, CompiledMatchersAreCached) {
+    auto matcher = WildcardMatcher::compile("a.*.c");
+    EXPECT_EQ(WildcardMatcher::compile("a.*.c").get(), matcher.get());
+    EXPECT_NE(WildcardMatcher::compile("a.**").get(), matcher.get());
+    EXPECT_TRUE(matcher->matches("a.b.c"));
+    EXPECT_FALSE(matcher->matches("a.b.b.c"));
+}
+
+namespace {
+
+// Tag patterns matched against the fields of a wide record, as done by
+// RuleContext::getTags for every field
+const std::vector<std::string> kTagPatterns = {
+    "**.ssn", "com.acme.*.name", "com.acme.Person.address.**", "*"};
+
+std::vector<std::string> wideRecordFields() {
+    std::vector<std::string> fields;
+    for (int i = 0; i < 50; ++i) {
+        fields.push_back("com.acme.Person.field" + std::to_string(i));
+    }
+    fields.push_back("com.acme.Person.ssn");
+    fields.push_back("com.acme.Person.address.street");
+    return fields;
+}
+
+template <typename Match>
+int countMatches(const std::vector<std::string> &fields, Match match) {
+    int matched = 0;
+    for (const auto &field : fields) {
+        for (const auto &pattern : kTagPatterns) {
+            matched += match(field, pattern) ? 1 : 0;
+        }
+    }
+    return matched;
+}
+
+}  // namespace
+
+TEST_F(WildcardMatcherTest, MatchesTagPatternsOfRecordFields) {
+    auto fields = wideRecordFields();
+    EXPECT_EQ(countMatches(fields, wildcardMatch),
+              countMatches(fields, regexWildcardMatch));
+    EXPECT_EQ(countMatches(fields, wildcardMatch), 2);
+}
+
+// Run with --gtest_also_run_disabled_tests; timings are recorded as test
+// properties
+TEST_F(WildcardMatcherTest, DISABLED_MatchBenchmark) {
+    auto fields = wideRecordFields();
+    auto run = [&](const std::string &name, auto match, int rounds) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            EXPECT_EQ(countMatches(fields, match), 2);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+        double total = static_cast<double>(rounds) * fields.size() *
+                       kTagPatterns.size();
+        RecordProperty(name + "_ns", std::to_string(elapsed.count() / total));
+    };
+
+    run("regex_per_call", regexWildcardMatch, 20);
+    run("compiled", wildcardMatch, 2000);
+}